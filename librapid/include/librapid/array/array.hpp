@@ -20,13 +20,30 @@
 #include "operations.hpp"
 #include "function.hpp"
 #include "assignOps.hpp"
+#include "evalMany.hpp"
+#include "map.hpp"
+#include "cast.hpp"
 #include "generalArrayView.hpp"
 #include "generalArrayViewToString.hpp"
 #include "arrayFromData.hpp"
 #include "fill.hpp"
 #include "pseudoConstructors.hpp"
 #include "fourierTransform.hpp"
+#include "mask.hpp"
+#include "where.hpp"
+#include "indexing.hpp"
+#include "scatter.hpp"
+#include "reduce.hpp"
+#include "groupBy.hpp"
+#include "sort.hpp"
+#include "search.hpp"
+#include "unique.hpp"
+#include "scan.hpp"
+#include "histogram.hpp"
+#include "quantile.hpp"
+#include "runningStats.hpp"
 
 #include "linalg/linalg.hpp"
+#include "quantize.hpp"
 
 #endif // LIBRAPID_ARRAY
\ No newline at end of file
@@ -228,8 +228,22 @@ namespace librapid {
 			LIBRAPID_ALWAYS_INLINE detail::CommaInitializer<ArrayContainer>
 			operator<<(const T &value);
 
-			// template<typename ScalarTo = Scalar, typename BackendTo = Backend>
-			// LIBRAPID_NODISCARD auto cast() const;
+			/// Return a lazily evaluated copy of this array with each element converted to
+			/// ScalarTo. See ::librapid::cast()
+			/// \tparam ScalarTo The scalar type to convert to
+			/// \return Cast function object
+			template<typename ScalarTo>
+			LIBRAPID_NODISCARD auto cast() const;
+
+			/// Assign `value` to the elements selected by `mask`, leaving the others unchanged.
+			/// Only the selected elements are written, so this can be used to clip values or
+			/// replace NaNs in place. See ::librapid::where() for a lazily evaluated equivalent
+			/// \tparam T The type of the value (a scalar, or an array of the same shape)
+			/// \param mask The elements to assign to
+			/// \param value The value (or values) to assign
+			/// \return A reference to this array
+			template<typename T>
+			ArrayContainer &maskedAssign(const Mask &mask, const T &value);
 
 			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE ArrayContainer copy() const;
 
@@ -293,6 +307,17 @@ namespace librapid {
 			/// \param value The value to write to the array's storage
 			LIBRAPID_ALWAYS_INLINE void writePacket(size_t index, const Packet &value);
 
+			/// Write a Packet object to the array's storage at a specific index using a
+			/// non-temporal store, bypassing the cache. The index must be a multiple of the packet
+			/// width and the storage must be aligned (see detail::canStreamPacket)
+			/// \param index The index to write the packet to
+			/// \param value The value to write to the array's storage
+			LIBRAPID_ALWAYS_INLINE void writePacketStream(size_t index, const Packet &value);
+
+			/// Prefetch the cache line containing the element at a specific index
+			/// \param index The index to prefetch
+			LIBRAPID_ALWAYS_INLINE void prefetch(size_t index) const;
+
 			/// Write a Scalar to the array's storage at a specific index
 			/// \param index The index to write the scalar to
 			/// \param value The value to write to the array's storage
@@ -788,11 +813,17 @@ namespace librapid {
 		ArrayContainer<ShapeType_, StorageType_>::packet(size_t index) const -> Packet {
 			auto ptr = LIBRAPID_ASSUME_ALIGNED(m_storage.begin());
 
+			if constexpr (!std::is_same_v<typename typetraits::SimdScalar<Scalar>::Type,
+										  typename Packet::value_type>) {
+				// The elements are converted as they are loaded (half, for example)
+				return detail::loadConverted<Packet>(ptr + index);
+			} else {
 #if defined(LIBRAPID_NATIVE_ARCH)
-			return xsimd::load_aligned(ptr + index);
+				return xsimd::load_aligned(detail::simdPointer(ptr + index));
 #else
-			return xsimd::load_unaligned(ptr + index);
+				return xsimd::load_unaligned(detail::simdPointer(ptr + index));
 #endif
+			}
 		}
 
 		template<typename ShapeType_, typename StorageType_>
@@ -806,11 +837,29 @@ namespace librapid {
 		ArrayContainer<ShapeType_, StorageType_>::writePacket(size_t index, const Packet &value) {
 			auto ptr = LIBRAPID_ASSUME_ALIGNED(m_storage.begin());
 
+			if constexpr (!std::is_same_v<typename typetraits::SimdScalar<Scalar>::Type,
+										  typename Packet::value_type>) {
+				detail::storeConverted(ptr + index, value);
+			} else {
 #if defined(LIBRAPID_NATIVE_ARCH)
-			value.store_aligned(ptr + index);
+				value.store_aligned(detail::simdPointer(ptr + index));
 #else
-			value.store_unaligned(ptr + index);
+				value.store_unaligned(detail::simdPointer(ptr + index));
 #endif
+			}
+		}
+
+		template<typename ShapeType_, typename StorageType_>
+		LIBRAPID_ALWAYS_INLINE void
+		ArrayContainer<ShapeType_, StorageType_>::writePacketStream(size_t index,
+																	const Packet &value) {
+			detail::streamPacket(m_storage.begin() + index, value);
+		}
+
+		template<typename ShapeType_, typename StorageType_>
+		LIBRAPID_ALWAYS_INLINE void
+		ArrayContainer<ShapeType_, StorageType_>::prefetch(size_t index) const {
+			detail::prefetchRead(m_storage.begin() + index);
 		}
 
 		template<typename ShapeType_, typename StorageType_>
@@ -6,6 +6,89 @@ namespace librapid {
 	// elsewhere. They are defined here.
 
 	namespace detail {
+		/// Returns true if a vectorised assignment of `size` elements to `ptr` should be
+		/// written with non-temporal stores. This is the case when the result is larger than
+		/// global::streamingStoreThreshold (so it would evict the entire cache anyway) and the
+		/// destination is suitably aligned.
+		/// \tparam Packet The packet type being written
+		/// \tparam Scalar The scalar type of the destination
+		/// \param ptr Pointer to the start of the destination
+		/// \param size Number of elements being written
+		/// \return True if streaming stores should be used
+		template<typename Packet, typename Scalar>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool useStreamingStores(const Scalar *ptr,
+																		  int64_t size) {
+			if constexpr (canStreamTo<Scalar, Packet>()) {
+				return static_cast<size_t>(size) * sizeof(Scalar) >=
+						 global::streamingStoreThreshold &&
+					   reinterpret_cast<uintptr_t>(ptr) % sizeof(Packet) == 0;
+			} else {
+				return false;
+			}
+		}
+
+		/// Return the number of elements in a cache line, rounded to a whole number of packets
+		/// \tparam Scalar The scalar type
+		/// \tparam packetWidth The number of elements in a packet
+		/// \return Elements per cache line
+		template<typename Scalar, int64_t packetWidth>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t streamingLineWidth() {
+			const auto lineElements = static_cast<int64_t>(global::cacheLineSize / sizeof(Scalar));
+			return ::librapid::max(packetWidth, lineElements - lineElements % packetWidth);
+		}
+
+		/// Evaluate a function over the range [begin, end) and write the result using
+		/// non-temporal stores, prefetching the function's inputs
+		/// global::streamingPrefetchDistance cache lines ahead. Both `begin` and `end` must be
+		/// multiples of the packet width. A store fence is issued before returning, so the data
+		/// is visible to other threads.
+		/// \tparam ShapeType_ The shape type of the array container
+		/// \tparam StorageScalar The scalar type of the storage object
+		/// \tparam Function The function type
+		/// \param lhs The array container to assign to
+		/// \param function The function to assign
+		/// \param begin First element to assign
+		/// \param end One past the last element to assign
+		template<typename ShapeType_, typename StorageScalar, typename Function>
+		LIBRAPID_ALWAYS_INLINE void
+		assignStreaming(array::ArrayContainer<ShapeType_, Storage<StorageScalar>> &lhs,
+						const Function &function, int64_t begin, int64_t end) {
+			using Scalar =
+			  typename array::ArrayContainer<ShapeType_, Storage<StorageScalar>>::Scalar;
+			using Packet					= typename typetraits::TypeInfo<Scalar>::Packet;
+			constexpr int64_t packetWidth	= typetraits::TypeInfo<Scalar>::packetWidth;
+
+			if constexpr (!canStreamTo<Scalar, Packet>()) {
+				// useStreamingStores() never selects this path for packets which cannot be
+				// streamed, but it must still compile
+				for (int64_t index = begin; index < end; index += packetWidth) {
+					lhs.writePacket(index, function.packet(index));
+				}
+			} else {
+				// Write one cache line per iteration, so each input line is only prefetched once
+				const int64_t lineWidth		   = streamingLineWidth<Scalar, packetWidth>();
+				const int64_t prefetchDistance =
+				  lineWidth * static_cast<int64_t>(global::streamingPrefetchDistance);
+				const int64_t last = static_cast<int64_t>(function.size()) - 1;
+
+				int64_t index = begin;
+				for (; index + lineWidth <= end; index += lineWidth) {
+					if (prefetchDistance > 0) {
+						function.prefetch(::librapid::min(index + prefetchDistance, last));
+					}
+					for (int64_t i = index; i < index + lineWidth; i += packetWidth) {
+						lhs.writePacketStream(i, function.packet(i));
+					}
+				}
+
+				for (; index < end; index += packetWidth) {
+					lhs.writePacketStream(index, function.packet(index));
+				}
+
+				storeFence();
+			}
+		}
+
 		/// Trivial array assignment operator -- assignment can be done with a single vectorised
 		/// loop over contiguous data.
 		/// \tparam ShapeType_ The shape type of the array container
@@ -26,7 +109,7 @@ namespace librapid {
 			constexpr bool allowVectorisation =
 			  typetraits::TypeInfo<
 				detail::Function<descriptor::Trivial, Functor_, Args...>>::allowVectorisation &&
-			  Function::argsAreSameType;
+			  std::is_same_v<Scalar, typename Function::Scalar>;
 			constexpr int64_t packetWidth = []() {
 				if constexpr (allowVectorisation) {
 					return typetraits::TypeInfo<Scalar>::packetWidth;
@@ -49,8 +132,14 @@ namespace librapid {
 										   function.shape());
 
 			if constexpr (allowVectorisation) {
-				for (int64_t index = 0; index < vectorSize; index += packetWidth) {
-					lhs.writePacket(index, function.packet(index));
+				using Packet = typename typetraits::TypeInfo<Scalar>::Packet;
+
+				if (useStreamingStores<Packet>(lhs.storage().begin(), size)) {
+					assignStreaming(lhs, function, 0, vectorSize);
+				} else {
+					for (int64_t index = 0; index < vectorSize; index += packetWidth) {
+						lhs.writePacket(index, function.packet(index));
+					}
 				}
 
 				// Assign the remaining elements
@@ -86,7 +175,7 @@ namespace librapid {
 			constexpr bool allowVectorisation =
 			  typetraits::TypeInfo<
 				detail::Function<descriptor::Trivial, Functor_, Args...>>::allowVectorisation &&
-			  Function::argsAreSameType;
+			  std::is_same_v<Scalar, typename Function::Scalar>;
 			constexpr int64_t packetWidth = []() {
 				if constexpr (allowVectorisation) {
 					return typetraits::TypeInfo<Scalar>::packetWidth;
@@ -147,7 +236,7 @@ namespace librapid {
 			constexpr bool allowVectorisation =
 			  typetraits::TypeInfo<
 				detail::Function<descriptor::Trivial, Functor_, Args...>>::allowVectorisation &&
-			  Function::argsAreSameType;
+			  std::is_same_v<Scalar, typename Function::Scalar>;
 			constexpr int64_t packetWidth = []() {
 				if constexpr (allowVectorisation) {
 					return typetraits::TypeInfo<Scalar>::packetWidth;
@@ -172,10 +261,32 @@ namespace librapid {
 										   function.shape());
 
 			if constexpr (allowVectorisation) {
+				using Packet = typename typetraits::TypeInfo<Scalar>::Packet;
+
+				if (useStreamingStores<Packet>(lhs.storage().begin(), size)) {
+					// Split the work into chunks of whole cache lines, so no two threads write
+					// to the same line, with several chunks per thread for load balancing
+					const int64_t lineWidth = streamingLineWidth<Scalar, packetWidth>();
+					const int64_t numChunks = static_cast<int64_t>(global::numThreads) * 4;
+					const int64_t numLines =
+					  (static_cast<int64_t>(vectorSize) + lineWidth - 1) / lineWidth;
+					const int64_t chunkLines = (numLines + numChunks - 1) / numChunks;
+					const int64_t chunkSize = ::librapid::max(chunkLines, int64_t(1)) * lineWidth;
+
+#pragma omp parallel for shared(vectorSize, lhs, function, numChunks, chunkSize) default(none)     \
+  num_threads(int(global::numThreads))
+					for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+						const int64_t begin = chunk * chunkSize;
+						const int64_t end =
+						  ::librapid::min(begin + chunkSize, static_cast<int64_t>(vectorSize));
+						if (begin < end) { assignStreaming(lhs, function, begin, end); }
+					}
+				} else {
 #pragma omp parallel for shared(vectorSize, lhs, function) default(none)                           \
   num_threads(int(global::numThreads))
-				for (int64_t index = 0; index < vectorSize; index += packetWidth) {
-					lhs.writePacket(index, function.packet(index));
+					for (int64_t index = 0; index < vectorSize; index += packetWidth) {
+						lhs.writePacket(index, function.packet(index));
+					}
 				}
 
 				// Assign the remaining elements
@@ -212,7 +323,7 @@ namespace librapid {
 			constexpr bool allowVectorisation =
 			  typetraits::TypeInfo<
 				detail::Function<descriptor::Trivial, Functor_, Args...>>::allowVectorisation &&
-			  Function::argsAreSameType;
+			  std::is_same_v<Scalar, typename Function::Scalar>;
 			constexpr int64_t packetWidth = []() {
 				if constexpr (allowVectorisation) {
 					return typetraits::TypeInfo<Scalar>::packetWidth;
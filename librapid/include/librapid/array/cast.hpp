@@ -0,0 +1,95 @@
+#ifndef LIBRAPID_ARRAY_CAST_HPP
+#define LIBRAPID_ARRAY_CAST_HPP
+
+/*
+ * Lazily evaluated scalar type conversions. `cast<float>(a)` is an expression like any other,
+ * so `cast<float>(a) * b` converts each element of `a` as it is loaded, without allocating an
+ * intermediate array. On the host, the conversion happens on the packet path (see
+ * typetraits::packetCompatible and detail::loadConverted).
+ */
+
+namespace librapid {
+	namespace detail {
+		/// Functor converting each element of its argument to type T
+		/// \tparam T The type to convert to
+		template<typename T>
+		struct Cast {
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const V &val) const -> T {
+				return static_cast<T>(val);
+			}
+
+			// The argument has already been converted to a packet of T by packetExtractor
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packet(const Packet &val) const {
+				return val;
+			}
+		};
+	} // namespace detail
+
+	namespace typetraits {
+		template<typename T>
+		struct TypeInfo<::librapid::detail::Cast<T>> {
+			static constexpr const char *name		= "cast";
+			static constexpr const char *filename	= "cast";
+			static constexpr const char *kernelName = "cast";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+	} // namespace typetraits
+
+	/// \brief Convert each element of an array to a different scalar type
+	///
+	/// Returns a lazily evaluated function object, so the conversion can be fused into a larger
+	/// expression:
+	///
+	/// \code{.cpp}
+	/// auto a = Array<int32_t>(...);
+	/// auto b = Array<float>(...);
+	/// Array<float> c = cast<float>(a) * b; // No temporary array is created
+	/// \endcode
+	///
+	/// \tparam T The type to convert to
+	/// \tparam VAL Type of the input
+	/// \param val The input array or function
+	/// \return Cast function object
+	template<typename T, class VAL>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto cast(VAL &&val)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>, detail::Cast<T>, VAL> {
+		return detail::makeFunction<typetraits::DescriptorType_t<VAL>, detail::Cast<T>>(
+		  std::forward<VAL>(val));
+	}
+
+	namespace array {
+		template<typename ShapeType_, typename StorageType_>
+		template<typename ScalarTo>
+		auto ArrayContainer<ShapeType_, StorageType_>::cast() const {
+			return ::librapid::cast<ScalarTo>(*this);
+		}
+	} // namespace array
+
+	// There are no device kernels for conversions, so they are evaluated on the host
+#if defined(LIBRAPID_HAS_OPENCL)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename T, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Cast<T>, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL
+
+#if defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename T, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Cast<T>, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_CUDA
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_CAST_HPP
@@ -0,0 +1,269 @@
+#ifndef LIBRAPID_ARRAY_EVAL_MANY_HPP
+#define LIBRAPID_ARRAY_EVAL_MANY_HPP
+
+/*
+ * Fused evaluation of several expressions over the same inputs. Writing
+ *
+ *     evalMany(output(y) = a * b + c, output(z) = a * b - c, output(w) = exp(a));
+ *
+ * computes all three results in a single pass, rather than walking `a`, `b` and `c` from memory
+ * once per assignment. At each index, every expression is evaluated before any result is
+ * stored. Since the packet operations are pure once inlined, and no store can alias the inputs
+ * in between, the compiler is free to load each distinct input once per packet and to compute
+ * shared subexpressions (such as `a * b` above) only once.
+ *
+ * This also means the assignments happen "simultaneously" -- an output may safely appear as an
+ * input to any of the expressions, as long as the expressions are element-wise.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// An assignment which has been recorded but not yet performed. These are created with
+		/// `output(dst) = expr` and performed by evalMany()
+		/// \tparam Dst The type of the array being assigned to
+		/// \tparam Expr The type of the expression being assigned (a reference for lvalues)
+		template<typename Dst, typename Expr>
+		struct PendingAssignment {
+			Dst &dst;
+			Expr expr;
+		};
+
+		/// The left-hand side of a deferred assignment
+		/// \tparam Dst The type of the array being assigned to
+		/// \see output()
+		template<typename Dst>
+		class AssignmentTarget {
+		public:
+			explicit AssignmentTarget(Dst &dst) : m_dst(dst) {}
+
+			/// Record an assignment of `expr` to the target without evaluating it
+			/// \tparam Expr The type of the expression
+			/// \param expr The expression to assign
+			/// \return A PendingAssignment to pass to evalMany()
+			template<typename Expr>
+			LIBRAPID_NODISCARD auto operator=(Expr &&expr) const {
+				return PendingAssignment<Dst, Expr> {m_dst, std::forward<Expr>(expr)};
+			}
+
+		private:
+			Dst &m_dst;
+		};
+
+		/// True if an assignment can take part in a fused evaluation loop. This is the case for
+		/// trivial (element-wise) functions assigned to a host array
+		template<typename Dst, typename Expr>
+		struct IsFusableAssignment : std::false_type {};
+
+		template<typename ShapeType_, typename StorageScalar, typename Functor_, typename... Args>
+		struct IsFusableAssignment<array::ArrayContainer<ShapeType_, Storage<StorageScalar>>,
+								   detail::Function<descriptor::Trivial, Functor_, Args...>>
+				: std::bool_constant<!typetraits::HasCustomEval<
+				  detail::Function<descriptor::Trivial, Functor_, Args...>>::value> {};
+
+		/// Returns true if an assignment can be evaluated with packets, and the packet width
+		/// to use if so
+		template<typename Dst, typename Expr>
+		struct FusedAssignmentInfo {
+			using Function = std::decay_t<Expr>;
+			using Scalar   = typename Dst::Scalar;
+			using Packet   = typename typetraits::TypeInfo<Scalar>::Packet;
+
+			static constexpr bool allowVectorisation =
+			  typetraits::TypeInfo<Function>::allowVectorisation &&
+			  std::is_same_v<Scalar, typename Function::Scalar>;
+			static constexpr int64_t packetWidth = typetraits::TypeInfo<Scalar>::packetWidth;
+			static constexpr bool canStream		 = canStreamTo<Scalar, Packet>();
+		};
+
+		/// Evaluate every assignment over the range [begin, end) with packets. `begin` and `end`
+		/// must be multiples of the packet width. If `stream` is true, results are written with
+		/// non-temporal stores and a store fence is issued before returning.
+		/// \tparam stream Use streaming stores
+		/// \tparam packetWidth The number of elements in a packet
+		/// \tparam Assignments A tuple of PendingAssignment references
+		/// \param assignments The assignments to perform
+		/// \param begin First element to assign
+		/// \param end One past the last element to assign
+		template<bool stream, int64_t packetWidth, typename Assignments, size_t... I>
+		LIBRAPID_ALWAYS_INLINE void evalManyPackets(const Assignments &assignments,
+													std::index_sequence<I...>, int64_t begin,
+													int64_t end) {
+			for (int64_t index = begin; index < end; index += packetWidth) {
+				// Evaluate everything before storing anything, so inputs shared between the
+				// expressions don't need to be reloaded
+				const auto packets =
+				  std::make_tuple(std::get<I>(assignments).expr.packet(index)...);
+
+				if constexpr (stream) {
+					(std::get<I>(assignments).dst.writePacketStream(index, std::get<I>(packets)),
+					 ...);
+				} else {
+					(std::get<I>(assignments).dst.writePacket(index, std::get<I>(packets)), ...);
+				}
+			}
+
+			if constexpr (stream) { storeFence(); }
+		}
+
+		/// Evaluate every assignment at a single index with scalars
+		/// \tparam Assignments A tuple of PendingAssignment references
+		/// \param assignments The assignments to perform
+		/// \param index The element to assign
+		template<typename Assignments, size_t... I>
+		LIBRAPID_ALWAYS_INLINE void evalManyScalar(const Assignments &assignments,
+												   std::index_sequence<I...>, int64_t index) {
+			const auto scalars = std::make_tuple(std::get<I>(assignments).expr.scalar(index)...);
+			(std::get<I>(assignments).dst.write(index, std::get<I>(scalars)), ...);
+		}
+
+		/// Perform several trivial assignments in a single (vectorised and, for large arrays,
+		/// parallel) loop
+		/// \tparam Dst The types of the arrays being assigned to
+		/// \tparam Expr The types of the expressions being assigned
+		/// \param assignments The assignments to perform
+		/// \see evalMany()
+		template<typename... Dst, typename... Expr>
+		void evalManyFused(const PendingAssignment<Dst, Expr> &...assignments) {
+			using FirstInfo =
+			  std::tuple_element_t<0, std::tuple<FusedAssignmentInfo<Dst, Expr>...>>;
+			using FirstScalar = typename FirstInfo::Scalar;
+			using Indices	  = std::index_sequence_for<Dst...>;
+
+			// All results must have the same packet width to share a loop
+			constexpr bool allowVectorisation =
+			  (FusedAssignmentInfo<Dst, Expr>::allowVectorisation && ...) &&
+			  ((FusedAssignmentInfo<Dst, Expr>::packetWidth == FirstInfo::packetWidth) && ...);
+			constexpr bool canStream = (FusedAssignmentInfo<Dst, Expr>::canStream && ...);
+			constexpr int64_t packetWidth = []() {
+				if constexpr (allowVectorisation) {
+					return FirstInfo::packetWidth;
+				} else {
+					return int64_t(1);
+				}
+			}();
+
+			const auto targets		= std::forward_as_tuple(assignments...);
+			const auto &shape		= std::get<0>(targets).expr.shape();
+			const int64_t size		= static_cast<int64_t>(std::get<0>(targets).expr.size());
+			const int64_t vectorSize = size - (size % packetWidth);
+
+			(
+			  [&shape](const auto &assignment) {
+				  LIBRAPID_ASSERT_WITH_EXCEPTION(std::range_error,
+												 assignment.expr.shape() == shape,
+												 "Fused expressions must have the same shape. "
+												 "Expected {}, received {}",
+												 shape,
+												 assignment.expr.shape());
+				  LIBRAPID_ASSERT_WITH_EXCEPTION(std::range_error,
+												 assignment.dst.shape() == shape,
+												 "Shapes must be equal. Expected {}, received {}",
+												 assignment.dst.shape(),
+												 shape);
+			  }(assignments),
+			  ...);
+
+			bool parallel = false;
+#if !defined(LIBRAPID_OPTIMISE_SMALL_ARRAYS)
+			parallel = size > static_cast<int64_t>(global::multithreadThreshold) &&
+					   global::numThreads > 1;
+#endif // LIBRAPID_OPTIMISE_SMALL_ARRAYS
+
+			if constexpr (allowVectorisation) {
+				bool stream = false;
+				if constexpr (canStream) {
+					stream = (useStreamingStores<typename FusedAssignmentInfo<Dst, Expr>::Packet>(
+								assignments.dst.storage().begin(), size) &&
+							  ...);
+				}
+
+				const auto run = [&targets, stream](int64_t begin, int64_t end) {
+					if constexpr (canStream) {
+						if (stream) {
+							evalManyPackets<true, packetWidth>(targets, Indices(), begin, end);
+							return;
+						}
+					}
+					evalManyPackets<false, packetWidth>(targets, Indices(), begin, end);
+				};
+
+				if (parallel) {
+					// Split the work into chunks of whole cache lines, exactly as in
+					// assignParallel, so no two threads write to the same line
+					const int64_t lineWidth = streamingLineWidth<FirstScalar, packetWidth>();
+					const int64_t numChunks = static_cast<int64_t>(global::numThreads) * 4;
+					const int64_t numLines	= (vectorSize + lineWidth - 1) / lineWidth;
+					const int64_t chunkLines = (numLines + numChunks - 1) / numChunks;
+					const int64_t chunkSize = ::librapid::max(chunkLines, int64_t(1)) * lineWidth;
+
+#pragma omp parallel for shared(vectorSize, run, numChunks, chunkSize) default(none)               \
+  num_threads(int(global::numThreads))
+					for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+						const int64_t begin = chunk * chunkSize;
+						const int64_t end	= ::librapid::min(begin + chunkSize, vectorSize);
+						if (begin < end) { run(begin, end); }
+					}
+				} else {
+					run(0, vectorSize);
+				}
+
+				// Assign the remaining elements
+				for (int64_t index = vectorSize; index < size; ++index) {
+					evalManyScalar(targets, Indices(), index);
+				}
+			} else {
+				if (parallel) {
+#pragma omp parallel for shared(targets, size) default(none) num_threads(int(global::numThreads))
+					for (int64_t index = 0; index < size; ++index) {
+						evalManyScalar(targets, Indices(), index);
+					}
+				} else {
+					for (int64_t index = 0; index < size; ++index) {
+						evalManyScalar(targets, Indices(), index);
+					}
+				}
+			}
+		}
+	} // namespace detail
+
+	/// Create the target of a deferred assignment, for use with evalMany(). `output(dst) = expr`
+	/// records the assignment without evaluating `expr`.
+	/// \tparam Dst The type of the array to assign to
+	/// \param dst The array to assign to
+	/// \return An assignment target
+	template<typename Dst>
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto output(Dst &dst) {
+		return detail::AssignmentTarget<Dst>(dst);
+	}
+
+	/// \brief Evaluate several expressions in a single pass
+	///
+	/// Performs each of the given assignments, fusing them into a single loop over their
+	/// inputs. This is faster than assigning each expression separately when the expressions
+	/// share inputs, since each input is only read from memory once:
+	///
+	/// \code{.cpp}
+	/// evalMany(output(y) = a * b + c, output(z) = a * b - c);
+	/// \endcode
+	///
+	/// All expressions must have the same shape as each other and as their outputs. The fused
+	/// loop is used for element-wise expressions assigned to host arrays, and is vectorised and
+	/// parallelised in the same way as a regular assignment. Otherwise, the assignments are
+	/// performed one after another, in order.
+	///
+	/// \tparam Dst The types of the arrays being assigned to
+	/// \tparam Expr The types of the expressions being assigned
+	/// \param assignments The assignments to perform, created with output()
+	template<typename... Dst, typename... Expr>
+	void evalMany(const detail::PendingAssignment<Dst, Expr> &...assignments) {
+		static_assert(sizeof...(Dst) > 0, "evalMany requires at least one assignment");
+
+		if constexpr ((detail::IsFusableAssignment<Dst, std::decay_t<Expr>>::value && ...)) {
+			detail::evalManyFused(assignments...);
+		} else {
+			((assignments.dst = assignments.expr), ...);
+		}
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_EVAL_MANY_HPP
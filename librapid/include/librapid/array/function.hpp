@@ -73,6 +73,86 @@ namespace librapid {
 			using Type			   = decltype(std::declval<IntermediateType>().eval());
 		};
 
+		/// Some functors (such as those created by map()) can only be evaluated with packets for
+		/// certain argument types. By default, a functor supports vectorisation whenever its
+		/// arguments do
+		/// \tparam Functor The functor type
+		/// \tparam Args The argument types passed to the functor
+		template<typename Functor, typename... Args>
+		struct FunctorAllowsVectorisation : std::true_type {};
+
+		// xsimd has no complex cbrt, floor or ceil, so these are evaluated one element at a time
+		template<typename... Args>
+		constexpr bool anyArgIsComplex =
+		  (IsComplex<typename TypeInfo<std::decay_t<Args>>::Scalar>::value || ...);
+
+		template<typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Cbrt, Args...>
+				: std::bool_constant<!anyArgIsComplex<Args...>> {};
+
+		template<typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Floor, Args...>
+				: std::bool_constant<!anyArgIsComplex<Args...>> {};
+
+		template<typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Ceil, Args...>
+				: std::bool_constant<!anyArgIsComplex<Args...>> {};
+
+		/// Returns true if an argument of type Arg can be loaded as a packet of Scalar (the result
+		/// type of the Function it is passed to). Arguments with a different scalar type are
+		/// converted as they are loaded, so mixed-type expressions remain vectorised as long as
+		/// the conversion can be done with packets:
+		///  - Scalars are converted and broadcast
+		///  - Masks are expanded to packets of zeros and ones
+		///  - Host arrays are converted as they are loaded from memory
+		///  - Other expressions are converted with `xsimd::batch_cast`, which requires both
+		///    packets to have the same number of elements
+		/// \tparam Scalar The scalar type of the result
+		/// \tparam Arg The argument type
+		/// \return True if the argument can be used on the packet path
+		template<typename Scalar, typename Arg>
+		constexpr bool packetCompatible() {
+			using ArgType	= std::decay_t<Arg>;
+			using ArgScalar = typename TypeInfo<ArgType>::Scalar;
+
+			if constexpr (std::is_same_v<ArgType, Mask>) {
+				// Masks are expanded to packets of zeros and ones (see Mask::packet)
+				return TypeInfo<Scalar>::allowVectorisation && !IsComplex<Scalar>::value &&
+					   !std::is_same_v<typename TypeInfo<Scalar>::Packet, std::false_type>;
+			} else if constexpr (std::is_same_v<ArgScalar, Scalar>) {
+				return TypeInfo<ArgType>::allowVectorisation;
+			} else if constexpr (IsComplex<Scalar>::value) {
+				// Real operands of a complex expression are given a zero imaginary component
+				if constexpr (!TypeInfo<Scalar>::allowVectorisation ||
+							  !std::is_same_v<ArgScalar, typename Scalar::Scalar>) {
+					return false;
+				} else if constexpr (IsArrayContainer<ArgType>::value) {
+					using StorageType = typename TypeInfo<ArgType>::StorageType;
+					return IsStorage<StorageType>::value || IsFixedStorage<StorageType>::value;
+				} else {
+					return TypeInfo<ArgType>::type == detail::LibRapidType::Scalar ||
+						   TypeInfo<ArgType>::allowVectorisation;
+				}
+			} else if constexpr (!IsPromotable<Scalar>::value || !IsPromotable<ArgScalar>::value) {
+				return false;
+			} else if constexpr (!TypeInfo<Scalar>::allowVectorisation ||
+								 std::is_same_v<typename TypeInfo<Scalar>::Packet,
+												std::false_type>) {
+				return false;
+			} else if constexpr (TypeInfo<ArgType>::type == detail::LibRapidType::Scalar) {
+				return true;
+			} else if constexpr (IsArrayContainer<ArgType>::value) {
+				using StorageType = typename TypeInfo<ArgType>::StorageType;
+				return IsStorage<StorageType>::value || IsFixedStorage<StorageType>::value;
+			} else if constexpr (TypeInfo<ArgType>::allowVectorisation &&
+								 !std::is_same_v<typename TypeInfo<ArgScalar>::Packet,
+												 std::false_type>) {
+				return TypeInfo<ArgScalar>::packetWidth == TypeInfo<Scalar>::packetWidth;
+			} else {
+				return false;
+			}
+		}
+
 		template<typename desc, typename Functor_, typename... Args>
 		struct TypeInfo<::librapid::detail::Function<desc, Functor_, Args...>> {
 			static constexpr detail::LibRapidType type = detail::LibRapidType::ArrayFunction;
@@ -95,7 +175,16 @@ namespace librapid {
 			using ArrayType	  = Array<Scalar, Backend>;
 			using StorageType = typename TypeInfo<ArrayType>::StorageType;
 
-			static constexpr bool allowVectorisation = checkAllowVectorisation<Args...>();
+			// Operands of different types are converted on the packet path for host expressions
+			static constexpr bool allowVectorisation = []() {
+				if constexpr (std::is_same_v<Backend, backend::CPU>) {
+					return (packetCompatible<Scalar, Args>() && ...) &&
+						   FunctorAllowsVectorisation<Functor_, Args...>::value;
+				} else {
+					return checkAllowVectorisation<Args...>() &&
+						   FunctorAllowsVectorisation<Functor_, Args...>::value;
+				}
+			}();
 
 			static constexpr bool supportsArithmetic = TypeInfo<Scalar>::supportsArithmetic;
 			static constexpr bool supportsLogical	 = TypeInfo<Scalar>::supportsLogical;
@@ -109,14 +198,26 @@ namespace librapid {
 	namespace detail {
 		// Descriptor is defined in "forward.hpp"
 
+		// Extract a packet from an argument, converting it to the required packet type if
+		// necessary (see typetraits::packetCompatible)
 		template<typename Packet, typename T>
 		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Packet packetExtractor(const T &obj, size_t index) {
-			if constexpr (detail::IsArrayType<T>::val) {
-				static_assert(std::is_same_v<Packet, decltype(obj.packet(index))>,
-							  "Packet types do not match");
-				return obj.packet(index);
+			using Scalar = typename Packet::value_type;
+
+			if constexpr (std::is_same_v<T, Mask>) {
+				return obj.template packet<Packet>(index);
+			} else if constexpr (detail::IsArrayType<T>::val) {
+				if constexpr (std::is_same_v<Packet, decltype(obj.packet(index))>) {
+					return obj.packet(index);
+				} else if constexpr (typetraits::IsArrayContainer<T>::value) {
+					return loadConverted<Packet>(obj.storage().begin() + index);
+				} else if constexpr (typetraits::IsComplexSIMD<Packet>::value) {
+					return Packet(obj.packet(index));
+				} else {
+					return xsimd::batch_cast<Scalar>(obj.packet(index));
+				}
 			} else {
-				return Packet(obj);
+				return Packet(static_cast<Scalar>(obj));
 			}
 		}
 
@@ -129,6 +230,44 @@ namespace librapid {
 			}
 		}
 
+		/// \return A value of the type in which a scalar of type T is computed on the packet
+		/// path: float for types such as half, which are evaluated with float packets, and T
+		/// otherwise
+		template<typename T>
+		constexpr auto widenedScalarType() {
+			if constexpr (typetraits::IsFloatingPoint<T>::value && !std::is_floating_point_v<T>) {
+				using Packet = typename typetraits::TypeInfo<T>::Packet;
+				if constexpr (!std::is_same_v<Packet, std::false_type>) {
+					return std::type_identity<typename Packet::value_type> {};
+				} else {
+					return std::type_identity<T> {};
+				}
+			} else {
+				return std::type_identity<T> {};
+			}
+		}
+
+		// Extract a scalar from an argument in the type the packet path computes it in, so that
+		// an expression of half values is rounded once (when it is stored), whether it is
+		// evaluated with packets or with scalars
+		template<typename T>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto widenedExtractor(const T &obj,
+																		size_t index) {
+			if constexpr (requires { obj.widenedScalar(index); }) {
+				return obj.widenedScalar(index);
+			} else {
+				const auto value = scalarExtractor(obj, index);
+				using Widened =
+				  typename decltype(widenedScalarType<std::decay_t<decltype(value)>>())::type;
+				return static_cast<Widened>(value);
+			}
+		}
+
+		template<typename T>
+		LIBRAPID_ALWAYS_INLINE void prefetchExtractor(const T &obj, size_t index) {
+			if constexpr (requires { obj.prefetch(index); }) { obj.prefetch(index); }
+		}
+
 		template<typename First, typename... Rest>
 		constexpr auto scalarTypesAreSame() {
 			if constexpr (sizeof...(Rest) == 0) {
@@ -199,6 +338,10 @@ namespace librapid {
 			/// \return The arguments in the Function
 			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto &args() const;
 
+			/// Return the functor applied by the Function
+			/// \return The functor applied by the Function
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto functor() const -> const Functor &;
+
 			/// Return an evaluated Array object
 			/// \return
 			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto eval() const;
@@ -215,6 +358,18 @@ namespace librapid {
 			/// \return The result of the function (scalar).
 			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Scalar scalar(size_t index) const;
 
+			/// Evaluates the function at the given index, without rounding intermediate results
+			/// to types which are computed in a wider type on the packet path (such as half,
+			/// which is computed in float). scalar() rounds this result to Scalar.
+			/// \param index The index to evaluate at.
+			/// \return The result of the function, in the widened type
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto widenedScalar(size_t index) const;
+
+			/// Prefetch the inputs required to evaluate the function at the given index. This
+			/// only has an effect for arguments which are backed by contiguous memory.
+			/// \param index The index to prefetch
+			LIBRAPID_ALWAYS_INLINE void prefetch(size_t index) const;
+
 			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Iterator begin() const;
 			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Iterator end() const;
 
@@ -233,13 +388,13 @@ namespace librapid {
 																		size_t index) const;
 
 			/// Implementation detail -- evaluates the function at the given index,
-			/// returning a Scalar result.
+			/// returning a widened scalar result (see widenedScalar()).
 			/// \tparam I The index sequence.
 			/// \param index The index to evaluate at.
 			/// \return The result of the function (scalar).
 			template<size_t... I>
-			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Scalar scalarImpl(std::index_sequence<I...>,
-																		size_t index) const;
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto scalarImpl(std::index_sequence<I...>,
+																	  size_t index) const;
 
 			Functor m_functor;
 			std::tuple<Args...> m_args;
@@ -275,6 +430,12 @@ namespace librapid {
 			return m_args;
 		}
 
+		template<typename desc, typename Functor, typename... Args>
+		LIBRAPID_ALWAYS_INLINE auto Function<desc, Functor, Args...>::functor() const
+		  -> const Functor & {
+			return m_functor;
+		}
+
 		template<typename desc, typename Functor, typename... Args>
 		LIBRAPID_ALWAYS_INLINE auto
 		Function<desc, Functor, Args...>::operator[](int64_t index) const {
@@ -291,7 +452,13 @@ namespace librapid {
 		template<typename desc, typename Functor, typename... Args>
 		typename Function<desc, Functor, Args...>::Packet LIBRAPID_ALWAYS_INLINE
 		Function<desc, Functor, Args...>::packet(size_t index) const {
-			return packetImpl(std::make_index_sequence<sizeof...(Args)>(), index);
+			if constexpr (requires { m_functor.template packetFromArgs<Packet>(m_args, index); }) {
+				// The functor extracts its own arguments, for those which must not be converted
+				// to the result's packet type
+				return m_functor.template packetFromArgs<Packet>(m_args, index);
+			} else {
+				return packetImpl(std::make_index_sequence<sizeof...(Args)>(), index);
+			}
 		}
 
 		template<typename desc, typename Functor, typename... Args>
@@ -305,15 +472,27 @@ namespace librapid {
 		template<typename desc, typename Functor, typename... Args>
 		LIBRAPID_ALWAYS_INLINE auto Function<desc, Functor, Args...>::scalar(size_t index) const
 		  -> Scalar {
+			return static_cast<Scalar>(widenedScalar(index));
+		}
+
+		template<typename desc, typename Functor, typename... Args>
+		LIBRAPID_ALWAYS_INLINE auto
+		Function<desc, Functor, Args...>::widenedScalar(size_t index) const {
 			return scalarImpl(std::make_index_sequence<sizeof...(Args)>(), index);
 		}
 
 		template<typename desc, typename Functor, typename... Args>
 		template<size_t... I>
 		LIBRAPID_ALWAYS_INLINE auto
-		Function<desc, Functor, Args...>::scalarImpl(std::index_sequence<I...>, size_t index) const
-		  -> Scalar {
-			return m_functor(scalarExtractor(std::get<I>(m_args), index)...);
+		Function<desc, Functor, Args...>::scalarImpl(std::index_sequence<I...>,
+													 size_t index) const {
+			return m_functor(widenedExtractor(std::get<I>(m_args), index)...);
+		}
+
+		template<typename desc, typename Functor, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void Function<desc, Functor, Args...>::prefetch(size_t index) const {
+			std::apply([index](const auto &...args) { (prefetchExtractor(args, index), ...); },
+					   m_args);
 		}
 
 		template<typename desc, typename Functor, typename... Args>
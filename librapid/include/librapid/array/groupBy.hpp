@@ -0,0 +1,365 @@
+#ifndef LIBRAPID_ARRAY_GROUP_BY_HPP
+#define LIBRAPID_ARRAY_GROUP_BY_HPP
+
+/*
+ * Group-by reductions over integer keys. groupReduce(keys, values, op) reduces the values that
+ * share a key, returning the unique keys (in ascending order), the reduced value for each key,
+ * and the number of values in each group.
+ *
+ * There are two implementations, chosen automatically:
+ *
+ *  - If the keys are sorted, each group is a contiguous run of values, which is reduced with
+ *    SIMD packets. The rows are split into chunks which are reduced in parallel, and runs that
+ *    span two chunks are combined afterwards.
+ *  - Otherwise, each thread reduces a chunk of rows into its own open-addressing hash table.
+ *    The tables are then merged in parallel, with each thread merging the keys in one
+ *    partition of the hash space, and the groups are sorted by key.
+ *
+ * If global::reproducibleReductions is set, floating-point values are split into a number of
+ * chunks which depends only on the number of rows (see reproducibleChunks()), so the result
+ * does not depend on the number of threads.
+ */
+
+namespace librapid {
+	/// The reduction applied to each group by groupReduce()
+	enum class GroupOp { Sum, Mean, Min, Max, Count };
+
+	/// \brief The result of groupReduce()
+	///
+	/// Element i of `values` and `counts` correspond to the group with key `keys[i]`
+	/// \tparam Key The key type
+	/// \tparam Value The value type
+	template<typename Key, typename Value>
+	struct GroupReduction {
+		/// The unique keys, in ascending order
+		Array<Key, backend::CPU> keys;
+
+		/// The reduced value of each group
+		Array<Value, backend::CPU> values;
+
+		/// The number of values in each group
+		Array<int64_t, backend::CPU> counts;
+	};
+
+	namespace detail {
+		/// A partial result for one group
+		template<typename Key, typename Value>
+		struct Group {
+			Key key;
+			Value value;
+			int64_t count;
+		};
+
+		/// Combine two packets with the reduction `Op` (see scatter.hpp)
+		template<typename Op, typename Packet>
+		LIBRAPID_ALWAYS_INLINE Packet combinePacket(const Packet &a, const Packet &b) {
+			if constexpr (std::is_same_v<Op, ScatterMaxOp>) {
+				return xsimd::max(a, b);
+			} else if constexpr (std::is_same_v<Op, ScatterMinOp>) {
+				return xsimd::min(a, b);
+			} else {
+				return a + b;
+			}
+		}
+
+		/// Reduce the elements of a packet with the reduction `Op`
+		template<typename Op, typename Packet>
+		LIBRAPID_ALWAYS_INLINE auto reducePacket(const Packet &packet) {
+			if constexpr (std::is_same_v<Op, ScatterMaxOp>) {
+				return xsimd::reduce_max(packet);
+			} else if constexpr (std::is_same_v<Op, ScatterMinOp>) {
+				return xsimd::reduce_min(packet);
+			} else {
+				return xsimd::reduce_add(packet);
+			}
+		}
+
+		/// Reduce `n` contiguous values into `init`, using SIMD packets where possible
+		template<typename Op, typename Value>
+		LIBRAPID_NODISCARD Value reduceContiguous(const Value *data, int64_t n, Value init) {
+			using Packet			= typename typetraits::TypeInfo<Value>::Packet;
+			constexpr int64_t width = typetraits::TypeInfo<Value>::packetWidth;
+
+			int64_t i = 0;
+			if constexpr (width > 1 && std::is_arithmetic_v<Value>) {
+				if (n >= width) {
+					Packet acc = xsimd::load_unaligned(data);
+					for (i = width; i + width <= n; i += width) {
+						acc = combinePacket<Op>(acc, Packet(xsimd::load_unaligned(data + i)));
+					}
+					init = Op::combine(init, static_cast<Value>(reducePacket<Op>(acc)));
+				}
+			}
+
+			for (; i < n; ++i) init = Op::combine(init, data[i]);
+			return init;
+		}
+
+		/// Check whether `n` keys are in ascending order, in parallel for large inputs
+		template<typename Key>
+		LIBRAPID_NODISCARD bool keysSorted(const Key *keys, int64_t n) {
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+			std::vector<char> sorted(numChunks, 1);
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				// Each chunk also checks the boundary with the previous chunk
+				const int64_t begin = ::librapid::max(int64_t(1), chunk * n / numChunks);
+				const int64_t end	= (chunk + 1) * n / numChunks;
+				for (int64_t i = begin; i < end; ++i) {
+					if (keys[i] < keys[i - 1]) {
+						sorted[chunk] = 0;
+						return;
+					}
+				}
+			});
+
+			return std::all_of(sorted.begin(), sorted.end(), [](char s) { return s != 0; });
+		}
+
+		/// \return Whether groups of `Value` are reduced in reproducibleChunks(n) chunks, so the
+		/// rounding does not depend on the number of threads
+		template<typename Value>
+		LIBRAPID_NODISCARD bool groupReproducible() {
+			return std::is_floating_point_v<Value> && global::reproducibleReductions;
+		}
+
+		/// Group-by reduction for sorted keys. Each group is a contiguous run of values
+		template<typename Op, typename Key, typename Value>
+		LIBRAPID_NODISCARD auto groupSorted(const Key *keys, const Value *values, int64_t n,
+											bool reduceValues) {
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) * 4 : 1;
+			if (groupReproducible<Value>()) numChunks = reproducibleChunks(n);
+
+			// Reduce the runs in each chunk
+			std::vector<std::vector<Group<Key, Value>>> partial(numChunks);
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				const int64_t end = (chunk + 1) * n / numChunks;
+				for (int64_t begin = chunk * n / numChunks; begin < end;) {
+					int64_t runEnd = begin + 1;
+					while (runEnd < end && keys[runEnd] == keys[begin]) ++runEnd;
+
+					Value value = Op::template identity<Value>();
+					if (reduceValues) {
+						value = reduceContiguous<Op>(values + begin, runEnd - begin, value);
+					}
+					partial[chunk].push_back({keys[begin], value, runEnd - begin});
+					begin = runEnd;
+				}
+			});
+
+			// Concatenate the chunks, combining runs which span a chunk boundary
+			std::vector<Group<Key, Value>> groups;
+			for (const auto &chunk : partial) {
+				for (const auto &group : chunk) {
+					if (!groups.empty() && groups.back().key == group.key) {
+						groups.back().value = Op::combine(groups.back().value, group.value);
+						groups.back().count += group.count;
+					} else {
+						groups.push_back(group);
+					}
+				}
+			}
+			return groups;
+		}
+
+		/// An open-addressing (linear probing) hash table accumulating one Group per key
+		template<typename Key, typename Value>
+		class GroupTable {
+		public:
+			explicit GroupTable(const Value &identity = Value()) : m_identity(identity) {
+				rehash(16);
+			}
+
+			/// Hash a key. The low bits select a slot, and the high bits a partition
+			LIBRAPID_NODISCARD static LIBRAPID_ALWAYS_INLINE uint64_t hash(const Key &key) {
+				const uint64_t h = static_cast<uint64_t>(key) * 0x9E3779B97F4A7C15ull;
+				return h ^ (h >> 29);
+			}
+
+			/// Combine a value (or partial group) into the group for `key`
+			template<typename Op>
+			LIBRAPID_ALWAYS_INLINE void add(const Key &key, const Value &value, int64_t count) {
+				Group<Key, Value> &group = find(key);
+				group.value				 = Op::combine(group.value, value);
+				group.count += count;
+			}
+
+			LIBRAPID_NODISCARD const std::vector<Group<Key, Value>> &groups() const {
+				return m_groups;
+			}
+
+		private:
+			LIBRAPID_ALWAYS_INLINE Group<Key, Value> &find(const Key &key) {
+				uint64_t slot = hash(key) & m_mask;
+				while (m_slots[slot] >= 0) {
+					Group<Key, Value> &group = m_groups[m_slots[slot]];
+					if (group.key == key) return group;
+					slot = (slot + 1) & m_mask;
+				}
+
+				// Keep the table at most half full
+				if (static_cast<int64_t>(m_groups.size() + 1) * 2 > static_cast<int64_t>(m_mask)) {
+					rehash((m_mask + 1) * 2);
+					return find(key);
+				}
+
+				m_slots[slot] = static_cast<int64_t>(m_groups.size());
+				m_groups.push_back({key, m_identity, 0});
+				return m_groups.back();
+			}
+
+			void rehash(uint64_t capacity) {
+				m_mask = capacity - 1;
+				m_slots.assign(capacity, -1);
+				for (int64_t i = 0; i < static_cast<int64_t>(m_groups.size()); ++i) {
+					uint64_t slot = hash(m_groups[i].key) & m_mask;
+					while (m_slots[slot] >= 0) slot = (slot + 1) & m_mask;
+					m_slots[slot] = i;
+				}
+			}
+
+			Value m_identity;
+			uint64_t m_mask = 0;
+			std::vector<int64_t> m_slots;
+			std::vector<Group<Key, Value>> m_groups;
+		};
+
+		/// Group-by reduction for unsorted keys, using per-thread hash tables
+		template<typename Op, typename Key, typename Value>
+		LIBRAPID_NODISCARD auto groupHashed(const Key *keys, const Value *values, int64_t n,
+											bool reduceValues) {
+			using Table = GroupTable<Key, Value>;
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			int64_t numChunks	 = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+			const Value identity = Op::template identity<Value>();
+			if (groupReproducible<Value>()) numChunks = reproducibleChunks(n);
+
+			// Each chunk of rows is reduced into its own table
+			std::vector<Table> local(numChunks, Table(identity));
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				Table &table	  = local[chunk];
+				const int64_t end = (chunk + 1) * n / numChunks;
+				for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+					table.template add<Op>(keys[i], reduceValues ? values[i] : identity, 1);
+				}
+			});
+
+			std::vector<Group<Key, Value>> groups;
+			if (numChunks == 1) {
+				groups = local[0].groups();
+			} else {
+				// Merge the tables, with each thread handling one partition of the hash space
+				std::vector<Table> merged(numChunks, Table(identity));
+				int64_t work = 0;
+				for (const auto &table : local) work += table.groups().size();
+
+				indexingFor(numChunks, work * numChunks, [&](int64_t partition) {
+					Table &table = merged[partition];
+					for (const auto &source : local) {
+						for (const auto &group : source.groups()) {
+							if (static_cast<int64_t>((Table::hash(group.key) >> 40) % numChunks) ==
+								partition) {
+								table.template add<Op>(group.key, group.value, group.count);
+							}
+						}
+					}
+				});
+
+				for (const auto &table : merged) {
+					groups.insert(groups.end(), table.groups().begin(), table.groups().end());
+				}
+			}
+
+			std::sort(groups.begin(), groups.end(), [](const auto &a, const auto &b) {
+				return a.key < b.key;
+			});
+			return groups;
+		}
+
+		template<typename Op, typename Key, typename Value>
+		LIBRAPID_NODISCARD auto groupReduceImpl(const Key *keys, const Value *values, int64_t n,
+												bool reduceValues) {
+			if (keysSorted(keys, n)) return groupSorted<Op>(keys, values, n, reduceValues);
+			return groupHashed<Op>(keys, values, n, reduceValues);
+		}
+	} // namespace detail
+
+	/// \brief Reduce values grouped by an integer key
+	///
+	/// Every value with the same key is combined with `op`, and the result contains one entry
+	/// per unique key, in ascending order of key. For example, the total revenue per customer:
+	///
+	/// \code{.cpp}
+	/// auto perCustomer = lrc::groupReduce(customerIds, revenue, lrc::GroupOp::Sum);
+	/// // perCustomer.keys[i] is a customer ID, and perCustomer.values[i] their revenue
+	/// \endcode
+	///
+	/// Sorted keys are detected and reduced as contiguous runs, which is faster than the
+	/// general (hash table) case. GroupOp::Mean divides in the value type, so use a
+	/// floating-point value type for fractional means. GroupOp::Count does not read the values.
+	///
+	/// \tparam Keys The type of the keys (std::vector or Array of integers)
+	/// \tparam Values The type of the values (std::vector or Array)
+	/// \param keys The key of each value
+	/// \param values The values to reduce
+	/// \param op The reduction to apply to each group
+	/// \return The unique keys, the reduced value of each group and the size of each group
+	template<typename Keys, typename Values>
+	LIBRAPID_NODISCARD auto groupReduce(const Keys &keys, const Values &values, GroupOp op) {
+		const auto [keyData, keyShape]	   = detail::indexListData(keys);
+		const auto [valueData, valueShape] = detail::indexListData(values);
+		using Key	= std::decay_t<decltype(*keyData)>;
+		using Value = std::decay_t<decltype(*valueData)>;
+		static_assert(std::is_integral_v<Key>, "Keys must be integers");
+
+		const int64_t n = static_cast<int64_t>(keyShape.size());
+		if (static_cast<int64_t>(valueShape.size()) != n) {
+			throw std::range_error(fmt::format(
+			  "groupReduce() received {} keys, but {} values", n, valueShape.size()));
+		}
+
+		std::vector<detail::Group<Key, Value>> groups;
+		switch (op) {
+			case GroupOp::Min:
+				groups = detail::groupReduceImpl<detail::ScatterMinOp>(keyData, valueData, n, true);
+				break;
+			case GroupOp::Max:
+				groups = detail::groupReduceImpl<detail::ScatterMaxOp>(keyData, valueData, n, true);
+				break;
+			default:
+				groups = detail::groupReduceImpl<detail::ScatterAddOp>(
+				  keyData, valueData, n, op != GroupOp::Count);
+				break;
+		}
+
+		const int64_t numGroups = static_cast<int64_t>(groups.size());
+		GroupReduction<Key, Value> result {Array<Key, backend::CPU>(Shape({numGroups})),
+										   Array<Value, backend::CPU>(Shape({numGroups})),
+										   Array<int64_t, backend::CPU>(Shape({numGroups}))};
+		Key *outKeys	   = result.keys.storage().data();
+		Value *outValues   = result.values.storage().data();
+		int64_t *outCounts = result.counts.storage().data();
+
+		detail::indexingFor(numGroups, numGroups, [&](int64_t g) {
+			const auto &group = groups[g];
+			outKeys[g]		  = group.key;
+			outCounts[g]	  = group.count;
+			if (op == GroupOp::Mean) {
+				outValues[g] = static_cast<Value>(group.value / static_cast<Value>(group.count));
+			} else if (op == GroupOp::Count) {
+				outValues[g] = static_cast<Value>(group.count);
+			} else {
+				outValues[g] = group.value;
+			}
+		});
+
+		return result;
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_GROUP_BY_HPP
@@ -0,0 +1,555 @@
+#ifndef LIBRAPID_ARRAY_HISTOGRAM_HPP
+#define LIBRAPID_ARRAY_HISTOGRAM_HPP
+
+/*
+ * Histograms:
+ *
+ *  - histogram(values, ...) counts (or sums the weights of) the values falling in each bin,
+ *    where the bins are given by their edges, or as a number of uniform bins over a range.
+ *  - histogram2d(x, y, ...) does the same for pairs of values, over a grid of bins.
+ *  - bincount(values) counts the occurrences of each non-negative integer.
+ *
+ * Bin i contains the values in [edges[i], edges[i + 1]), except for the last bin, which also
+ * contains its right edge. Values outside the edges (and NaNs) are ignored. Values are compared
+ * with the edges in the common type of the two, as for searchsorted().
+ *
+ * Values are binned with a detail::SortedSearch over the edges (see search.hpp), which
+ * computes the bin of uniformly spaced edges arithmetically, and otherwise uses a branchless
+ * search. Each thread accumulates its share of the values into its own copy of the bins, and
+ * the copies are summed at the end. When there are few bins, each thread also spreads
+ * consecutive values over several interleaved copies, so that runs of values in the same bin
+ * do not wait on each other's increments. If private copies would be larger than the input,
+ * the bins are instead updated with atomic operations (see scatter.hpp).
+ *
+ * If global::reproducibleReductions is set, floating-point weights are instead accumulated in
+ * a number of chunks which depends only on the number of values and bins, so weighted
+ * histograms do not depend on the number of threads.
+ */
+
+namespace librapid {
+	/// \brief The result of histogram()
+	/// \tparam Count The type of the counts (int64_t, or the type of the weights)
+	/// \tparam Edge The type of the edges
+	template<typename Count, typename Edge>
+	struct HistogramResult {
+		/// The count (or total weight) of each bin
+		Array<Count, backend::CPU> counts;
+
+		/// The edges of the bins, with one more element than `counts`
+		Array<Edge, backend::CPU> edges;
+	};
+
+	/// \brief The result of histogram2d()
+	/// \tparam Count The type of the counts (int64_t, or the type of the weights)
+	/// \tparam Edge The type of the edges
+	template<typename Count, typename Edge>
+	struct Histogram2DResult {
+		/// The count (or total weight) of each bin, with shape [x bins, y bins]
+		Array<Count, backend::CPU> counts;
+
+		/// The edges of the bins along x
+		Array<Edge, backend::CPU> xEdges;
+
+		/// The edges of the bins along y
+		Array<Edge, backend::CPU> yEdges;
+	};
+
+	namespace detail {
+		/// The type of the edges of bins over values of type T. Integers use double edges
+		template<typename T>
+		using HistogramEdge = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+		/// With at most this many bins, each thread accumulates into several interleaved
+		/// copies of the bins
+		constexpr int64_t histogramInterleaveMaxBins = 4096;
+
+		/// The number of interleaved copies of small histograms
+		constexpr int64_t histogramInterleave = 4;
+
+		/// The bins of a histogram along one dimension
+		template<typename Edge>
+		class HistogramBins {
+		public:
+			/// \param edges Pointer to the edges, in ascending order
+			/// \param n The number of edges (at least 2)
+			HistogramBins(const Edge *edges, int64_t n) : m_search(edges, n) {
+				if (n < 2) {
+					throw std::invalid_argument(
+					  fmt::format("A histogram requires at least 2 edges. Received {}", n));
+				}
+			}
+
+			/// \return The number of bins
+			LIBRAPID_NODISCARD int64_t size() const { return m_search.size() - 1; }
+
+			/// \return The edges of the bins
+			LIBRAPID_NODISCARD const Edge *edges() const { return m_search.edges(); }
+
+			/// \return The bin containing \p value, or -1 if it is outside the edges (or NaN).
+			/// The value is compared with the edges in their common type (see SearchCompare),
+			/// so it is never truncated
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t operator()(const T &value) const {
+				using Compare	  = SearchCompare<Edge, T>;
+				const Compare x	  = static_cast<Compare>(value);
+				const int64_t bin = m_search.find(x, SearchSide::Right) - 1;
+				if (bin < size()) return bin;
+				return x == static_cast<Compare>(m_search.edges()[size()]) ? size() - 1 : -1;
+			}
+
+		private:
+			SortedSearch<Edge> m_search;
+		};
+
+		/// \return `numBins + 1` uniformly spaced edges from \p lo to \p hi
+		template<typename Edge>
+		LIBRAPID_NODISCARD std::vector<Edge> uniformEdges(int64_t numBins, Edge lo, Edge hi) {
+			if (numBins <= 0) {
+				throw std::invalid_argument(
+				  fmt::format("A histogram requires at least one bin. Received {}", numBins));
+			}
+			const bool finite =
+			  std::isfinite(static_cast<double>(lo)) && std::isfinite(static_cast<double>(hi));
+			if (!finite || !(lo < hi)) {
+				throw std::invalid_argument(
+				  fmt::format("Invalid histogram range [{}, {}]", lo, hi));
+			}
+
+			std::vector<Edge> edges(numBins + 1);
+			const Edge width = (hi - lo) / static_cast<Edge>(numBins);
+			for (int64_t i = 0; i < numBins; ++i) edges[i] = lo + width * static_cast<Edge>(i);
+			edges[numBins] = hi;
+			return edges;
+		}
+
+		/// The smallest and largest of `n` values, ignoring NaNs. If every value is NaN (or
+		/// there are none), the range is [0, 1]. If the values are all equal, the range is
+		/// widened by 0.5 either side
+		template<typename Edge, typename T>
+		LIBRAPID_NODISCARD std::pair<Edge, Edge> histogramRange(const T *data, int64_t n) {
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+			std::vector<std::pair<Edge, Edge>> partial(
+			  numChunks,
+			  {std::numeric_limits<Edge>::infinity(), -std::numeric_limits<Edge>::infinity()});
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				auto [lo, hi]	  = partial[chunk];
+				const int64_t end = (chunk + 1) * n / numChunks;
+				for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+					const Edge x = static_cast<Edge>(data[i]);
+					lo			 = x < lo ? x : lo;
+					hi			 = x > hi ? x : hi;
+				}
+				partial[chunk] = {lo, hi};
+			});
+
+			Edge lo = partial[0].first, hi = partial[0].second;
+			for (const auto &[chunkLo, chunkHi] : partial) {
+				lo = ::librapid::min(lo, chunkLo);
+				hi = ::librapid::max(hi, chunkHi);
+			}
+
+			if (lo > hi) return {Edge(0), Edge(1)};
+			if (lo == hi) return {lo - Edge(0.5), hi + Edge(0.5)};
+			return {lo, hi};
+		}
+
+		/// Add `weightOf(i)` to bin `binOf(i)` of `out` for each i in [0, n), skipping values
+		/// whose bin is negative. `out` is overwritten
+		template<typename Count, typename BinFunc, typename WeightFunc>
+		void accumulateBins(Count *out, int64_t numBins, int64_t n, BinFunc &&binOf,
+							WeightFunc &&weightOf) {
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t copies =
+			  numBins <= histogramInterleaveMaxBins ? histogramInterleave : int64_t(1);
+			int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+			// In reproducible mode, floating-point weights are accumulated in a number of chunks
+			// which depends only on `n` and `numBins`, and never with atomics
+			const bool reproducible =
+			  std::is_floating_point_v<Count> && global::reproducibleReductions;
+			if (reproducible) {
+				numChunks = ::librapid::max(
+				  int64_t(1), ::librapid::min(reproducibleChunks(n), n / (numBins * copies)));
+			}
+
+			if constexpr (scatterAllowsAtomics<Count>) {
+				if (!reproducible && parallel && numBins * copies * numChunks > n) {
+					indexingFor(numBins, numBins, [&](int64_t bin) { out[bin] = Count(0); });
+					indexingFor(n, n, [&](int64_t i) {
+						const int64_t bin = binOf(i);
+						if (bin >= 0) scatterAtomic<ScatterAddOp>(out[bin], Count(weightOf(i)));
+					});
+					return;
+				}
+			}
+
+			if (numChunks * copies == 1) {
+				std::fill_n(out, numBins, Count(0));
+				for (int64_t i = 0; i < n; ++i) {
+					const int64_t bin = binOf(i);
+					if (bin >= 0) out[bin] += Count(weightOf(i));
+				}
+				return;
+			}
+
+			// Element i of a chunk goes to interleaved copy i % copies of the chunk's bins
+			const int64_t stride = numBins * copies;
+			std::vector<Count> local(stride * numChunks, Count(0));
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				Count *bins		  = local.data() + chunk * stride;
+				const int64_t end = (chunk + 1) * n / numChunks;
+				for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+					const int64_t bin = binOf(i);
+					if (bin >= 0) bins[(i % copies) * numBins + bin] += Count(weightOf(i));
+				}
+			});
+
+			indexingFor(numBins, parallel ? stride * numChunks : 0, [&](int64_t bin) {
+				Count total = Count(0);
+				for (int64_t copy = 0; copy < copies * numChunks; ++copy) {
+					total += local[copy * numBins + bin];
+				}
+				out[bin] = total;
+			});
+		}
+
+		/// Return a 1D array holding `n` edges
+		template<typename T>
+		LIBRAPID_NODISCARD auto edgeArray(const T *data, int64_t n) -> Array<T, backend::CPU> {
+			Array<T, backend::CPU> result(Shape({n}));
+			std::copy_n(data, n, result.storage().data());
+			return result;
+		}
+
+		/// Check that a list of weights has one weight per value
+		template<typename Weights>
+		LIBRAPID_NODISCARD auto histogramWeights(const Weights &weights, int64_t n) {
+			const auto [data, shape] = indexListData(weights);
+			if (static_cast<int64_t>(shape.size()) != n) {
+				throw std::invalid_argument(
+				  fmt::format("Received {} values, but {} weights", n, shape.size()));
+			}
+			return data;
+		}
+
+		/// One-dimensional histogram of `n` values, with weights if `weights` is not null
+		template<typename Count, typename T, typename Edge, typename Weight>
+		LIBRAPID_NODISCARD auto histogramImpl(const T *data, int64_t n,
+											  const HistogramBins<Edge> &bins,
+											  const Weight *weights)
+		  -> HistogramResult<Count, Edge> {
+			HistogramResult<Count, Edge> result {
+			  Array<Count, backend::CPU>(Shape({bins.size()})),
+			  edgeArray(bins.edges(), bins.size() + 1)};
+			Count *out = result.counts.storage().data();
+
+			if (weights) {
+				accumulateBins(
+				  out,
+				  bins.size(),
+				  n,
+				  [&](int64_t i) { return bins(data[i]); },
+				  [&](int64_t i) { return weights[i]; });
+			} else {
+				accumulateBins(
+				  out, bins.size(), n, [&](int64_t i) { return bins(data[i]); }, [](int64_t) {
+					  return 1;
+				  });
+			}
+			return result;
+		}
+
+		/// Two-dimensional histogram of `n` pairs, with weights if `weights` is not null
+		template<typename Count, typename T, typename Edge, typename Weight>
+		LIBRAPID_NODISCARD auto histogram2dImpl(const T *x, const T *y, int64_t n,
+												const HistogramBins<Edge> &xBins,
+												const HistogramBins<Edge> &yBins,
+												const Weight *weights)
+		  -> Histogram2DResult<Count, Edge> {
+			const int64_t nx = xBins.size(), ny = yBins.size();
+			Histogram2DResult<Count, Edge> result {Array<Count, backend::CPU>(Shape({nx, ny})),
+												   edgeArray(xBins.edges(), nx + 1),
+												   edgeArray(yBins.edges(), ny + 1)};
+
+			auto binOf = [&](int64_t i) {
+				const int64_t bx = xBins(x[i]);
+				const int64_t by = yBins(y[i]);
+				return (bx < 0 || by < 0) ? int64_t(-1) : bx * ny + by;
+			};
+
+			Count *out = result.counts.storage().data();
+			if (weights) {
+				accumulateBins(out, nx * ny, n, binOf, [&](int64_t i) { return weights[i]; });
+			} else {
+				accumulateBins(out, nx * ny, n, binOf, [](int64_t) { return 1; });
+			}
+			return result;
+		}
+
+		/// Check that two lists of values have the same length, returning their data and length
+		template<typename Values>
+		LIBRAPID_NODISCARD auto histogram2dValues(const Values &x, const Values &y) {
+			const auto [xData, xShape] = indexListData(x);
+			const auto [yData, yShape] = indexListData(y);
+			if (xShape.size() != yShape.size()) {
+				throw std::invalid_argument(fmt::format(
+				  "Received {} x values, but {} y values", xShape.size(), yShape.size()));
+			}
+			return std::make_tuple(xData, yData, static_cast<int64_t>(xShape.size()));
+		}
+
+		template<typename Count, typename Values>
+		LIBRAPID_NODISCARD auto bincountImpl(const Values &values, int64_t minLength,
+											 const Count *weights) -> Array<Count, backend::CPU> {
+			const auto [data, shape] = indexListData(values);
+			using Scalar			 = std::decay_t<decltype(*data)>;
+			static_assert(std::is_integral_v<Scalar>, "bincount() requires integer values");
+
+			const int64_t n = static_cast<int64_t>(shape.size());
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			int64_t numBins = ::librapid::max(minLength, int64_t(0));
+			if (n > 0) {
+				const auto [lo, hi] =
+				  integerRange(data, n, parallel ? static_cast<int64_t>(global::numThreads) : 1);
+				if (lo < 0) {
+					throw std::invalid_argument(
+					  fmt::format("bincount() requires non-negative values. Received {}", lo));
+				}
+				numBins = ::librapid::max(numBins, static_cast<int64_t>(hi) + 1);
+			}
+
+			Array<Count, backend::CPU> result(Shape({numBins}));
+			auto binOf = [&](int64_t i) { return static_cast<int64_t>(data[i]); };
+			if (weights) {
+				accumulateBins(result.storage().data(), numBins, n, binOf, [&](int64_t i) {
+					return weights[i];
+				});
+			} else {
+				accumulateBins(
+				  result.storage().data(), numBins, n, binOf, [](int64_t) { return 1; });
+			}
+			return result;
+		}
+	} // namespace detail
+
+	/// \brief Compute the histogram of a list of values over the given bin edges
+	///
+	/// \code{.cpp}
+	/// std::vector<double> edges = {0.0, 0.1, 0.5, 1.0};
+	/// auto [counts, binEdges] = lrc::histogram(latencies, edges);
+	/// \endcode
+	///
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \tparam Edges The type of the edges (std::vector or host Array of floating point values)
+	/// \param values The values to count
+	/// \param edges The edges of the bins, in ascending order
+	/// \return The count of each bin, and the edges
+	template<typename Values, typename Edges>
+		requires(!std::is_arithmetic_v<Edges>)
+	LIBRAPID_NODISCARD auto histogram(const Values &values, const Edges &edges) {
+		const auto [data, shape]		 = detail::indexListData(values);
+		const auto [edgeData, numEdges] = detail::searchEdges(edges);
+		using Edge						 = detail::SearchScalar<Edges>;
+		return detail::histogramImpl<int64_t>(data,
+											  static_cast<int64_t>(shape.size()),
+											  detail::HistogramBins<Edge>(edgeData, numEdges),
+											  static_cast<const int64_t *>(nullptr));
+	}
+
+	/// \brief Compute the weighted histogram of a list of values over the given bin edges
+	///
+	/// Each bin holds the total weight of the values it contains.
+	///
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \tparam Edges The type of the edges (std::vector or host Array of floating point values)
+	/// \tparam Weights The type of the weights (std::vector or host Array)
+	/// \param values The values to count
+	/// \param edges The edges of the bins, in ascending order
+	/// \param weights The weight of each value
+	/// \return The total weight of each bin, and the edges
+	template<typename Values, typename Edges, typename Weights>
+		requires(!std::is_arithmetic_v<Edges>)
+	LIBRAPID_NODISCARD auto histogram(const Values &values, const Edges &edges,
+									  const Weights &weights) {
+		const auto [data, shape]		 = detail::indexListData(values);
+		const auto [edgeData, numEdges] = detail::searchEdges(edges);
+		const int64_t n					 = static_cast<int64_t>(shape.size());
+		const auto *weightData			 = detail::histogramWeights(weights, n);
+		using Edge						 = detail::SearchScalar<Edges>;
+		using Weight					 = std::decay_t<decltype(*weightData)>;
+		return detail::histogramImpl<Weight>(
+		  data, n, detail::HistogramBins<Edge>(edgeData, numEdges), weightData);
+	}
+
+	/// \brief Compute the histogram of a list of values over `numBins` uniform bins from
+	/// \p lo to \p hi
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \param values The values to count
+	/// \param numBins The number of bins
+	/// \param lo The left edge of the first bin
+	/// \param hi The right edge of the last bin
+	/// \return The count of each bin, and the edges
+	template<typename Values>
+	LIBRAPID_NODISCARD auto histogram(const Values &values, int64_t numBins, double lo,
+									  double hi) {
+		const auto [data, shape] = detail::indexListData(values);
+		using Edge				 = detail::HistogramEdge<std::decay_t<decltype(*data)>>;
+		const auto edges =
+		  detail::uniformEdges(numBins, static_cast<Edge>(lo), static_cast<Edge>(hi));
+		return histogram(values, edges);
+	}
+
+	/// \brief Compute the weighted histogram of a list of values over `numBins` uniform bins
+	/// from \p lo to \p hi
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \tparam Weights The type of the weights (std::vector or host Array)
+	/// \param values The values to count
+	/// \param numBins The number of bins
+	/// \param lo The left edge of the first bin
+	/// \param hi The right edge of the last bin
+	/// \param weights The weight of each value
+	/// \return The total weight of each bin, and the edges
+	template<typename Values, typename Weights>
+	LIBRAPID_NODISCARD auto histogram(const Values &values, int64_t numBins, double lo, double hi,
+									  const Weights &weights) {
+		const auto [data, shape] = detail::indexListData(values);
+		using Edge				 = detail::HistogramEdge<std::decay_t<decltype(*data)>>;
+		const auto edges =
+		  detail::uniformEdges(numBins, static_cast<Edge>(lo), static_cast<Edge>(hi));
+		return histogram(values, edges, weights);
+	}
+
+	/// \brief Compute the histogram of a list of values over `numBins` uniform bins spanning
+	/// the values
+	///
+	/// NaNs are ignored when finding the range of the values.
+	///
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \param values The values to count
+	/// \param numBins The number of bins
+	/// \return The count of each bin, and the edges
+	template<typename Values>
+	LIBRAPID_NODISCARD auto histogram(const Values &values, int64_t numBins) {
+		const auto [data, shape] = detail::indexListData(values);
+		using Edge				 = detail::HistogramEdge<std::decay_t<decltype(*data)>>;
+		const auto [lo, hi] =
+		  detail::histogramRange<Edge>(data, static_cast<int64_t>(shape.size()));
+		return histogram(values, detail::uniformEdges(numBins, lo, hi));
+	}
+
+	/// \brief Compute the two-dimensional histogram of pairs of values
+	///
+	/// Bin (i, j) of the result counts the pairs with `x` in bin i of \p xEdges and `y` in bin
+	/// j of \p yEdges.
+	///
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \tparam Edges The type of the edges (std::vector or host Array of floating point values)
+	/// \param x The first value of each pair
+	/// \param y The second value of each pair
+	/// \param xEdges The edges of the bins along x, in ascending order
+	/// \param yEdges The edges of the bins along y, in ascending order
+	/// \return The count of each bin, with shape [x bins, y bins], and the edges
+	template<typename Values, typename Edges>
+		requires(!std::is_arithmetic_v<Edges>)
+	LIBRAPID_NODISCARD auto histogram2d(const Values &x, const Values &y, const Edges &xEdges,
+										const Edges &yEdges) {
+		const auto [xData, yData, n] = detail::histogram2dValues(x, y);
+		const auto [xEdgeData, nx]	 = detail::searchEdges(xEdges);
+		const auto [yEdgeData, ny]	 = detail::searchEdges(yEdges);
+		using Edge					 = detail::SearchScalar<Edges>;
+		return detail::histogram2dImpl<int64_t>(xData,
+												yData,
+												n,
+												detail::HistogramBins<Edge>(xEdgeData, nx),
+												detail::HistogramBins<Edge>(yEdgeData, ny),
+												static_cast<const int64_t *>(nullptr));
+	}
+
+	/// \brief Compute the weighted two-dimensional histogram of pairs of values
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \tparam Edges The type of the edges (std::vector or host Array of floating point values)
+	/// \tparam Weights The type of the weights (std::vector or host Array)
+	/// \param x The first value of each pair
+	/// \param y The second value of each pair
+	/// \param xEdges The edges of the bins along x, in ascending order
+	/// \param yEdges The edges of the bins along y, in ascending order
+	/// \param weights The weight of each pair
+	/// \return The total weight of each bin, with shape [x bins, y bins], and the edges
+	template<typename Values, typename Edges, typename Weights>
+		requires(!std::is_arithmetic_v<Edges>)
+	LIBRAPID_NODISCARD auto histogram2d(const Values &x, const Values &y, const Edges &xEdges,
+										const Edges &yEdges, const Weights &weights) {
+		const auto [xData, yData, n] = detail::histogram2dValues(x, y);
+		const auto [xEdgeData, nx]	 = detail::searchEdges(xEdges);
+		const auto [yEdgeData, ny]	 = detail::searchEdges(yEdges);
+		const auto *weightData		 = detail::histogramWeights(weights, n);
+		using Edge					 = detail::SearchScalar<Edges>;
+		using Weight				 = std::decay_t<decltype(*weightData)>;
+		return detail::histogram2dImpl<Weight>(xData,
+											   yData,
+											   n,
+											   detail::HistogramBins<Edge>(xEdgeData, nx),
+											   detail::HistogramBins<Edge>(yEdgeData, ny),
+											   weightData);
+	}
+
+	/// \brief Compute the two-dimensional histogram of pairs of values over uniform bins
+	/// spanning the values
+	/// \tparam Values The type of the values (std::vector or host Array)
+	/// \param x The first value of each pair
+	/// \param y The second value of each pair
+	/// \param xBins The number of bins along x
+	/// \param yBins The number of bins along y
+	/// \return The count of each bin, with shape [x bins, y bins], and the edges
+	template<typename Values>
+	LIBRAPID_NODISCARD auto histogram2d(const Values &x, const Values &y, int64_t xBins,
+										int64_t yBins) {
+		const auto [xData, yData, n] = detail::histogram2dValues(x, y);
+		using Edge					 = detail::HistogramEdge<std::decay_t<decltype(*xData)>>;
+		const auto [xLo, xHi]		 = detail::histogramRange<Edge>(xData, n);
+		const auto [yLo, yHi]		 = detail::histogramRange<Edge>(yData, n);
+		return histogram2d(
+		  x, y, detail::uniformEdges(xBins, xLo, xHi), detail::uniformEdges(yBins, yLo, yHi));
+	}
+
+	/// \brief Count the occurrences of each non-negative integer
+	///
+	/// Element i of the result is the number of values equal to i. The result has
+	/// `max(values) + 1` elements, or \p minLength if that is larger.
+	///
+	/// \tparam Values The type of the values (std::vector or host Array of integers)
+	/// \param values The values to count, which must be non-negative
+	/// \param minLength The minimum length of the result
+	/// \return The count of each integer
+	template<typename Values>
+	LIBRAPID_NODISCARD auto bincount(const Values &values, int64_t minLength = 0)
+	  -> Array<int64_t, backend::CPU> {
+		return detail::bincountImpl(values, minLength, static_cast<const int64_t *>(nullptr));
+	}
+
+	/// \brief Sum the weights of each non-negative integer
+	///
+	/// Element i of the result is the total weight of the values equal to i.
+	///
+	/// \tparam Values The type of the values (std::vector or host Array of integers)
+	/// \tparam Weights The type of the weights (std::vector or host Array)
+	/// \param values The values, which must be non-negative
+	/// \param weights The weight of each value
+	/// \param minLength The minimum length of the result
+	/// \return The total weight of each integer
+	template<typename Values, typename Weights>
+		requires(!std::is_arithmetic_v<Weights>)
+	LIBRAPID_NODISCARD auto bincount(const Values &values, const Weights &weights,
+									 int64_t minLength = 0) {
+		const auto [data, shape] = detail::indexListData(values);
+		return detail::bincountImpl(
+		  values, minLength, detail::histogramWeights(weights, static_cast<int64_t>(shape.size())));
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_HISTOGRAM_HPP
@@ -0,0 +1,372 @@
+#ifndef LIBRAPID_ARRAY_INDEXING_HPP
+#define LIBRAPID_ARRAY_INDEXING_HPP
+
+/*
+ * Index-list and mask based selection ("fancy indexing") for host arrays:
+ *
+ *  - take(array, indices, axis) selects the slices of `array` at the given positions along an
+ *    axis. Slices of more than one element are copied with memcpy, and single elements are
+ *    read with the AVX2/AVX-512 gather instructions (see detail::cpu::dispatch::gather).
+ *  - put(array, indices, values, axis) is the inverse, writing slices to the given positions.
+ *    Large puts into a single slice (a 1D array, or along axis 0) are split between threads
+ *    by target position, so repeated indices are still written in order.
+ *  - compress(array, mask) returns the elements selected by a Mask as a vector. The mask is
+ *    counted in parallel, a prefix sum gives each thread its output offset, and the selected
+ *    elements are then copied in parallel.
+ *
+ * Negative indices count from the end of the axis. Out-of-range indices and axes throw
+ * std::out_of_range in every build (not only when asserts are enabled), since they would
+ * otherwise read or write outside the array.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// Return a pointer to the data of a list of indices, and its shape
+		template<typename Index>
+		LIBRAPID_NODISCARD auto indexListData(const std::vector<Index> &indices) {
+			return std::make_pair(indices.data(), Shape({indices.size()}));
+		}
+
+		template<typename ShapeType, typename Index>
+		LIBRAPID_NODISCARD auto
+		indexListData(const array::ArrayContainer<ShapeType, Storage<Index>> &indices) {
+			return std::make_pair(indices.storage().data(), Shape(indices.shape()));
+		}
+
+		/// Check a list of indices into an axis of length `extent`, returning a pointer to
+		/// equivalent non-negative int64_t indices. If the input already satisfies this, it is
+		/// returned directly. Otherwise, the indices are converted into `buffer`
+		/// \tparam Index The integer type of the indices
+		/// \param indices The indices to check
+		/// \param n The number of indices
+		/// \param extent The length of the axis being indexed
+		/// \param buffer Storage for converted indices
+		/// \return Pointer to n valid indices
+		template<typename Index>
+		LIBRAPID_NODISCARD const int64_t *normaliseIndices(const Index *indices, int64_t n,
+														   int64_t extent,
+														   std::vector<int64_t> &buffer) {
+			static_assert(std::is_integral_v<Index>, "Indices must be integers");
+
+			bool direct = std::is_same_v<Index, int64_t>;
+			for (int64_t i = 0; i < n; ++i) {
+				const int64_t index = static_cast<int64_t>(indices[i]);
+				if (index < -extent || index >= extent) {
+					throw std::out_of_range(fmt::format(
+					  "Index {} out of range for axis of length {}", index, extent));
+				}
+				direct &= index >= 0;
+			}
+
+			if constexpr (std::is_same_v<Index, int64_t>) {
+				if (direct) return indices;
+			}
+
+			buffer.resize(n);
+			for (int64_t i = 0; i < n; ++i) {
+				const int64_t index = static_cast<int64_t>(indices[i]);
+				buffer[i]			= index < 0 ? index + extent : index;
+			}
+			return buffer.data();
+		}
+
+		/// Split an array into (outer, extent, inner) around an axis, where `extent` is the
+		/// length of the axis, and `outer` and `inner` are the products of the dimensions
+		/// before and after it
+		/// \param shape The shape of the array
+		/// \param axis The axis (negative values count from the end)
+		/// \return The normalised axis, outer, extent and inner sizes
+		template<typename ShapeType>
+		LIBRAPID_NODISCARD auto splitAxis(const ShapeType &shape, int64_t axis) {
+			const int64_t ndim = shape.ndim();
+			if (axis < 0) axis += ndim;
+			if (axis < 0 || axis >= ndim) {
+				throw std::out_of_range(fmt::format(
+				  "Axis {} out of range for array with {} dimensions", axis, ndim));
+			}
+
+			int64_t outer = 1, inner = 1;
+			for (int64_t i = 0; i < axis; ++i) outer *= shape[i];
+			for (int64_t i = axis + 1; i < ndim; ++i) inner *= shape[i];
+			return std::make_tuple(axis, outer, static_cast<int64_t>(shape[axis]), inner);
+		}
+
+		/// Copy n elements from arbitrary positions: out[i] = src[indices[i]]. Elements of 4 or
+		/// 8 bytes are copied bit for bit with the vectorised integer gather kernels, which
+		/// only access memory through the gather instructions and memcpy, so they may be used
+		/// for any trivially copyable type (see cpu::dispatch::gather)
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void gatherElements(int64_t n, Scalar *__restrict out,
+												   const Scalar *__restrict src,
+												   const int64_t *__restrict indices) {
+			if constexpr (std::is_trivially_copyable_v<Scalar> && sizeof(Scalar) == 4) {
+				cpu::dispatch::gather(n,
+									  reinterpret_cast<uint32_t *>(out),
+									  reinterpret_cast<const uint32_t *>(src),
+									  indices);
+			} else if constexpr (std::is_trivially_copyable_v<Scalar> && sizeof(Scalar) == 8) {
+				cpu::dispatch::gather(n,
+									  reinterpret_cast<uint64_t *>(out),
+									  reinterpret_cast<const uint64_t *>(src),
+									  indices);
+			} else {
+				for (int64_t i = 0; i < n; ++i) out[i] = src[indices[i]];
+			}
+		}
+
+		/// Copy n contiguous elements, using memcpy where possible
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void copyElements(Scalar *__restrict dst,
+												 const Scalar *__restrict src, int64_t n) {
+			if constexpr (std::is_trivially_copyable_v<Scalar>) {
+				std::memcpy(dst, src, n * sizeof(Scalar));
+			} else {
+				std::copy_n(src, n, dst);
+			}
+		}
+
+		/// Run `func(i)` for every i in [0, n), in parallel if `work` (the number of elements
+		/// processed) is large enough
+		template<typename Func>
+		LIBRAPID_ALWAYS_INLINE void indexingFor(int64_t n, int64_t work, Func &&func) {
+			if (static_cast<size_t>(work) > global::multithreadThreshold &&
+				global::numThreads > 1) {
+#pragma omp parallel for shared(n, func) default(none) num_threads(int(global::numThreads))
+				for (int64_t i = 0; i < n; ++i) { func(i); }
+			} else {
+				for (int64_t i = 0; i < n; ++i) { func(i); }
+			}
+		}
+
+		/// Run `write(o, j)` for every outer slice o and index j of a put(), so that repeated
+		/// indices are written in order. Each outer slice is written by one thread. A single
+		/// slice is instead split by target: each thread scans every index, and writes those
+		/// in its own range of the axis
+		template<typename Write>
+		void putFor(int64_t outer, int64_t n, int64_t inner, int64_t extent,
+					const int64_t *index, Write &&write) {
+			const int64_t work = outer * n * inner;
+			if (outer > 1) {
+				indexingFor(outer, work, [&](int64_t o) {
+					for (int64_t j = 0; j < n; ++j) write(o, j);
+				});
+				return;
+			}
+
+			const bool parallel =
+			  static_cast<size_t>(work) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numParts =
+			  parallel ? ::librapid::min(static_cast<int64_t>(global::numThreads), extent) : 1;
+			indexingFor(numParts, parallel ? work : 0, [&](int64_t part) {
+				const int64_t lo = part * extent / numParts;
+				const int64_t hi = (part + 1) * extent / numParts;
+				for (int64_t j = 0; j < n; ++j) {
+					if (index[j] >= lo && index[j] < hi) write(0, j);
+				}
+			});
+		}
+	} // namespace detail
+
+	/// \brief Select slices of an array at the given positions along an axis
+	///
+	/// The result has the shape of `array`, with dimension `axis` replaced by the shape of
+	/// `indices`. For example, selecting rows of a matrix:
+	///
+	/// \code{.cpp}
+	/// auto rows = lrc::take(matrix, std::vector<int64_t> {4, 0, 4}); // 3 x cols
+	/// \endcode
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \tparam Indices The type of the index list (std::vector or Array of integers)
+	/// \param array The array to select from
+	/// \param indices The positions to select
+	/// \param axis The axis to select along
+	/// \return A new array containing the selected slices
+	template<typename ShapeType, typename Scalar, typename Indices>
+	LIBRAPID_NODISCARD auto take(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								 const Indices &indices, int64_t axis = 0)
+	  -> Array<Scalar, backend::CPU> {
+		int64_t axis_, outer, extent, inner;
+		std::tie(axis_, outer, extent, inner) = detail::splitAxis(array.shape(), axis);
+		const auto [indexData, indexShape] = detail::indexListData(indices);
+		const int64_t n					   = static_cast<int64_t>(indexShape.size());
+
+		std::vector<int64_t> buffer;
+		const int64_t *index = detail::normaliseIndices(indexData, n, extent, buffer);
+
+		// Replace the axis with the dimensions of the index list
+		std::vector<int64_t> dims;
+		for (int64_t i = 0; i < axis_; ++i) dims.push_back(array.shape()[i]);
+		for (int64_t i = 0; i < indexShape.ndim(); ++i) dims.push_back(indexShape[i]);
+		for (int64_t i = axis_ + 1; i < array.shape().ndim(); ++i) dims.push_back(array.shape()[i]);
+		if (dims.size() > Shape::MaxDimensions) {
+			throw std::invalid_argument(
+			  fmt::format("Result of take() has too many dimensions ({})", dims.size()));
+		}
+
+		Array<Scalar, backend::CPU> result((Shape(dims)));
+		Scalar *out		  = result.storage().data();
+		const Scalar *src = array.storage().data();
+
+		if (inner == 1) {
+			// Gather blocks of single elements
+			constexpr int64_t blockSize = 4096;
+			const int64_t blocksPerRow	= (n + blockSize - 1) / blockSize;
+			detail::indexingFor(outer * blocksPerRow, outer * n, [&](int64_t block) {
+				const int64_t o		= block / blocksPerRow;
+				const int64_t begin = (block % blocksPerRow) * blockSize;
+				detail::gatherElements(::librapid::min(blockSize, n - begin),
+									   out + o * n + begin,
+									   src + o * extent,
+									   index + begin);
+			});
+		} else {
+			// Copy whole slices
+			detail::indexingFor(outer * n, outer * n * inner, [&](int64_t row) {
+				const int64_t o = row / n;
+				const int64_t j = row % n;
+				detail::copyElements(
+				  out + row * inner, src + (o * extent + index[j]) * inner, inner);
+			});
+		}
+
+		return result;
+	}
+
+	/// \brief Write slices of an array at the given positions along an axis
+	///
+	/// The inverse of take(): slice j of `values` (along `axis`) is written to position
+	/// `indices[j]` of `array`. `values` may be an array with the shape take() would return, or
+	/// a scalar, which is written to every selected position. If an index is repeated, the last
+	/// write wins.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \tparam Indices The type of the index list (std::vector or Array of integers)
+	/// \tparam Values The type of the values (a host array or a scalar)
+	/// \param array The array to write to
+	/// \param indices The positions to write to
+	/// \param values The values to write
+	/// \param axis The axis to write along
+	template<typename ShapeType, typename Scalar, typename Indices, typename Values>
+	void put(array::ArrayContainer<ShapeType, Storage<Scalar>> &array, const Indices &indices,
+			 const Values &values, int64_t axis = 0) {
+		int64_t axis_, outer, extent, inner;
+		std::tie(axis_, outer, extent, inner) = detail::splitAxis(array.shape(), axis);
+		const auto [indexData, indexShape] = detail::indexListData(indices);
+		const int64_t n					   = static_cast<int64_t>(indexShape.size());
+
+		std::vector<int64_t> buffer;
+		const int64_t *index = detail::normaliseIndices(indexData, n, extent, buffer);
+		Scalar *dst			 = array.storage().data();
+
+		// Repeated indices are written in order (see detail::putFor)
+		if constexpr (IsArrayType<Values>::value) {
+			if (static_cast<int64_t>(values.size()) != outer * n * inner) {
+				throw std::range_error(fmt::format(
+				  "put() expected {} values, but received {}", outer * n * inner, values.size()));
+			}
+			const Scalar *src = values.storage().data();
+
+			detail::putFor(outer, n, inner, extent, index, [&](int64_t o, int64_t j) {
+				detail::copyElements(
+				  dst + (o * extent + index[j]) * inner, src + (o * n + j) * inner, inner);
+			});
+		} else {
+			const Scalar value = static_cast<Scalar>(values);
+			detail::putFor(outer, n, inner, extent, index, [&](int64_t o, int64_t j) {
+				std::fill_n(dst + (o * extent + index[j]) * inner, inner, value);
+			});
+		}
+	}
+
+	/// \brief Return the elements of an array selected by a Mask
+	///
+	/// The array is treated as flat, and the result is a vector of the selected elements in
+	/// order. This is evaluated in two parallel passes: each thread counts the selected
+	/// elements in its part of the mask with popcount, a prefix sum of the counts gives each
+	/// thread its output offset, and the threads then copy their elements.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to select from
+	/// \param mask The elements to select
+	/// \return A vector of the selected elements
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto compress(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									 const Mask &mask) -> Array<Scalar, backend::CPU> {
+		if (mask.size() != static_cast<int64_t>(array.size())) {
+			throw std::range_error(
+			  fmt::format("Mask of shape {} cannot be applied to an array of shape {}",
+						  mask.shape(),
+						  array.shape()));
+		}
+
+		using Word			   = Mask::ElementType;
+		constexpr int64_t wordBits = Mask::bitsPerElement;
+		const Word *words		   = mask.data();
+		const int64_t numWords	   = mask.numWords();
+		const bool parallel =
+		  array.size() > global::multithreadThreshold && global::numThreads > 1;
+		const int64_t numChunks	  = parallel ? static_cast<int64_t>(global::numThreads) * 4 : 1;
+		const int64_t wordsPerChunk = (numWords + numChunks - 1) / numChunks;
+		const int64_t work		  = parallel ? static_cast<int64_t>(array.size()) : 0;
+
+		// Pass 1: count the selected elements in each chunk of words
+		std::vector<int64_t> offsets(numChunks + 1, 0);
+		detail::indexingFor(numChunks, work, [&](int64_t chunk) {
+			const int64_t end = ::librapid::min(numWords, (chunk + 1) * wordsPerChunk);
+			int64_t count	  = 0;
+			for (int64_t w = chunk * wordsPerChunk; w < end; ++w) count += std::popcount(words[w]);
+			offsets[chunk + 1] = count;
+		});
+
+		for (int64_t chunk = 0; chunk < numChunks; ++chunk) offsets[chunk + 1] += offsets[chunk];
+
+		// Pass 2: copy the selected elements of each chunk to its offset in the output
+		Array<Scalar, backend::CPU> result(Shape({offsets[numChunks]}));
+		Scalar *out		  = result.storage().data();
+		const Scalar *src = array.storage().data();
+
+		detail::indexingFor(numChunks, work, [&](int64_t chunk) {
+			const int64_t end = ::librapid::min(numWords, (chunk + 1) * wordsPerChunk);
+			Scalar *dst		  = out + offsets[chunk];
+			for (int64_t w = chunk * wordsPerChunk; w < end; ++w) {
+				Word word			= words[w];
+				const int64_t first = w * wordBits;
+				if (word == ~Word(0)) {
+					detail::copyElements(dst, src + first, wordBits);
+					dst += wordBits;
+					continue;
+				}
+
+				while (word) {
+					*dst++ = src[first + std::countr_zero(word)];
+					word &= word - 1;
+				}
+			}
+		});
+
+		return result;
+	}
+
+	/// \brief Return the elements of an array for which a condition is true
+	///
+	/// Equivalent to `compress(array, Mask(condition))`
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \tparam Condition The type of the condition expression
+	/// \param array The array to select from
+	/// \param condition The condition (such as `array > 0`)
+	/// \return A vector of the selected elements
+	template<typename ShapeType, typename Scalar, typename Condition>
+		requires(IsArrayType<std::decay_t<Condition>>::value)
+	LIBRAPID_NODISCARD auto compress(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									 const Condition &condition) -> Array<Scalar, backend::CPU> {
+		return compress(array, Mask(condition));
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_INDEXING_HPP
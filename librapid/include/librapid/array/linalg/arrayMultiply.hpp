@@ -416,7 +416,17 @@ namespace librapid {
 
 			switch (matmulClass) {
 				case MatmulClass::DOT: {
-					LIBRAPID_NOT_IMPLEMENTED;
+					if constexpr (std::is_same_v<Backend, backend::CPU>) {
+						// c = alpha * dot(a, b) + beta * c
+						auto n	   = int64_t(m_a.shape()[0]);
+						Scalar res = static_cast<Scalar>(m_alpha) * detail::dotContiguous(n, a, b);
+						if (m_beta != ScalarB(0)) res += static_cast<Scalar>(m_beta) * c[0];
+						c[0] = res;
+					} else {
+						LIBRAPID_NOT_IMPLEMENTED;
+					}
+
+					break;
 				}
 				case MatmulClass::GEMV: {
 					auto m = int64_t(m_a.shape()[m_transA]);
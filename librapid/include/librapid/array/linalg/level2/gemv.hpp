@@ -1,6 +1,145 @@
 #ifndef LIBRAPID_ARRAY_LINALG_LEVEL2_GEMV_HPP
 #define LIBRAPID_ARRAY_LINALG_LEVEL2_GEMV_HPP
 
+#if defined(LIBRAPID_RUNTIME_DISPATCH) && !defined(LIBRAPID_HAS_BLAS)
+namespace librapid::detail::cpu {
+    /// Row-major GEMV for float and double built on the runtime-dispatched dot and axpy kernels.
+    /// This replaces cxxblas' generic implementation when no BLAS library is available.
+    /// \return True if the call was handled, false if the generic implementation must be used
+    template<typename Scalar, typename Int>
+    bool gemvDispatched(bool trans, Int m, Int n, Scalar alpha, const Scalar *a, Int lda,
+                        const Scalar *x, Int incX, Scalar beta, Scalar *y, Int incY) {
+        if (!trans) {
+            // y_i = alpha * dot(A_i, x) + beta * y_i
+            if (incX != 1) return false;
+
+            auto row = [&](int64_t i) {
+                Scalar res = alpha * dispatch::dot(n, a + i * lda, x);
+                y[i * incY] = beta == Scalar(0) ? res : res + beta * y[i * incY];
+            };
+
+            if (m >= global::gemvMultithreadThreshold && global::numThreads > 1) {
+#    pragma omp parallel for shared(m, row) default(none) num_threads((int)global::numThreads)
+                for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+            } else {
+                for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+            }
+        } else {
+            // y = beta * y + sum_i (alpha * x_i) * A_i
+            if (incY != 1) return false;
+
+            dispatch::scal(n, beta, y);
+            for (int64_t i = 0; i < (int64_t)m; ++i) {
+                dispatch::axpy(n, alpha * x[i * incX], a + i * lda, y);
+            }
+        }
+
+        return true;
+    }
+} // namespace librapid::detail::cpu
+#endif // LIBRAPID_RUNTIME_DISPATCH && !LIBRAPID_HAS_BLAS
+
+namespace librapid::detail::cpu {
+    /// Row-major GEMV for bfloat16 inputs, accumulating in single precision. The output may be
+    /// float or bfloat16; in the latter case, each result is rounded once, after accumulation
+    template<typename Out, typename Int>
+    void gemvMixed(bool trans, Int m, Int n, float alpha, const bfloat16 *a, Int lda,
+                   const bfloat16 *x, Int incX, float beta, Out *y, Int incY) {
+        if (!trans) {
+            // y_i = alpha * dot(A_i, x) + beta * y_i
+            auto row = [&](int64_t i) {
+                float res;
+                if (incX == 1) {
+                    res = alpha * dispatch::dot(n, a + i * lda, x);
+                } else {
+                    res = 0;
+                    for (int64_t j = 0; j < (int64_t)n; ++j) {
+                        res += float(a[i * lda + j]) * float(x[j * incX]);
+                    }
+                    res *= alpha;
+                }
+                y[i * incY] = Out(beta == 0.0f ? res : res + beta * float(y[i * incY]));
+            };
+
+            if (m >= global::gemvMultithreadThreshold && global::numThreads > 1) {
+#    pragma omp parallel for shared(m, row) default(none) num_threads((int)global::numThreads)
+                for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+            } else {
+                for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+            }
+        } else {
+            // y = beta * y + sum_i (alpha * x_i) * A_i, accumulated in a contiguous float vector
+            bool direct = false;
+            if constexpr (std::is_same_v<Out, float>) { direct = incY == 1; }
+
+            std::vector<float> buffer;
+            float *acc = nullptr;
+            if constexpr (std::is_same_v<Out, float>) {
+                if (direct) { acc = y; }
+            }
+
+            if (direct) {
+                dispatch::scal(n, beta, acc);
+            } else {
+                buffer.resize(n);
+                acc = buffer.data();
+                for (int64_t j = 0; j < (int64_t)n; ++j) {
+                    acc[j] = beta == 0.0f ? 0.0f : beta * float(y[j * incY]);
+                }
+            }
+
+            for (int64_t i = 0; i < (int64_t)m; ++i) {
+                dispatch::axpy(n, alpha * float(x[i * incX]), a + i * lda, acc);
+            }
+
+            if (!direct) {
+                for (int64_t j = 0; j < (int64_t)n; ++j) { y[j * incY] = Out(acc[j]); }
+            }
+        }
+    }
+
+    /// Row-major GEMV for 8-bit integer inputs, accumulating exactly in 32-bit integers
+    template<typename TA, typename TX, typename Int>
+    void gemvInt8(bool trans, Int m, Int n, int32_t alpha, const TA *a, Int lda, const TX *x,
+                  Int incX, int32_t beta, int32_t *y, Int incY) {
+        if (!trans) {
+            // y_i = alpha * dot(A_i, x) + beta * y_i
+            std::vector<TX> packedX;
+            if (incX != 1) {
+                packedX.resize(n);
+                for (int64_t j = 0; j < (int64_t)n; ++j) { packedX[j] = x[j * incX]; }
+                x = packedX.data();
+            }
+
+            auto row = [&](int64_t i) {
+                int32_t res = alpha * dotInt8(n, a + i * lda, x);
+                y[i * incY] = beta == 0 ? res : res + beta * y[i * incY];
+            };
+
+            if (m >= global::gemvMultithreadThreshold && global::numThreads > 1) {
+#    pragma omp parallel for shared(m, row) default(none) num_threads((int)global::numThreads)
+                for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+            } else {
+                for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+            }
+        } else {
+            // y = beta * y + alpha * sum_i x_i * A_i. The rows are accumulated into a contiguous
+            // int32 vector, which the compiler vectorises
+            std::vector<int32_t> acc(n, 0);
+            for (int64_t i = 0; i < (int64_t)m; ++i) {
+                const int32_t xi = x[i * incX];
+                if (xi == 0) continue;
+                for (int64_t j = 0; j < (int64_t)n; ++j) { acc[j] += xi * int32_t(a[i * lda + j]); }
+            }
+
+            for (int64_t j = 0; j < (int64_t)n; ++j) {
+                int32_t res = alpha * acc[j];
+                y[j * incY] = beta == 0 ? res : res + beta * y[j * incY];
+            }
+        }
+    }
+} // namespace librapid::detail::cpu
+
 namespace librapid::linalg {
     /// \brief General matrix-vector multiplication.
     ///
@@ -30,18 +169,60 @@ namespace librapid::linalg {
         // On the CPU, cxxblas provides a generic implementation for all types along with BLAS
         // implementations where available
 
-        cxxblas::gemv(cxxblas::StorageOrder::RowMajor,
-                      (trans ? cxxblas::Transpose::Trans : cxxblas::Transpose::NoTrans),
-                      static_cast<int32_t>(m),
-                      static_cast<int32_t>(n),
-                      alpha,
-                      a,
-                      static_cast<int32_t>(lda),
-                      x,
-                      static_cast<int32_t>(incX),
-                      beta,
-                      y,
-                      static_cast<int32_t>(incY));
+        // bfloat16 inputs are accumulated in single precision
+        if constexpr (std::is_same_v<std::remove_const_t<A>, bfloat16> &&
+                      std::is_same_v<std::remove_const_t<X>, bfloat16> &&
+                      (std::is_same_v<Y, float> || std::is_same_v<Y, bfloat16>)) {
+            detail::cpu::gemvMixed(trans,
+                                   m,
+                                   n,
+                                   static_cast<float>(alpha),
+                                   a,
+                                   lda,
+                                   x,
+                                   incX,
+                                   static_cast<float>(beta),
+                                   y,
+                                   incY);
+        } else if constexpr (detail::cpu::isInt8Pair<A, X>() && std::is_same_v<Y, int32_t>) {
+            // 8-bit integer inputs are accumulated exactly in 32 bits
+            detail::cpu::gemvInt8(trans,
+                                  m,
+                                  n,
+                                  detail::cpu::int8Scale(alpha, "alpha"),
+                                  a,
+                                  lda,
+                                  x,
+                                  incX,
+                                  detail::cpu::int8Scale(beta, "beta"),
+                                  y,
+                                  incY);
+        } else {
+#if defined(LIBRAPID_RUNTIME_DISPATCH) && !defined(LIBRAPID_HAS_BLAS)
+            using Scalar = std::remove_const_t<A>;
+            if constexpr ((std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>) &&
+                          std::is_same_v<std::remove_const_t<X>, Scalar> &&
+                          std::is_same_v<Y, Scalar>) {
+                if (detail::cpu::gemvDispatched<Scalar>(
+                      trans, m, n, Scalar(alpha), a, lda, x, incX, Scalar(beta), y, incY)) {
+                    return;
+                }
+            }
+#endif // LIBRAPID_RUNTIME_DISPATCH && !LIBRAPID_HAS_BLAS
+
+            cxxblas::gemv(cxxblas::StorageOrder::RowMajor,
+                          (trans ? cxxblas::Transpose::Trans : cxxblas::Transpose::NoTrans),
+                          static_cast<int32_t>(m),
+                          static_cast<int32_t>(n),
+                          alpha,
+                          a,
+                          static_cast<int32_t>(lda),
+                          x,
+                          static_cast<int32_t>(incX),
+                          beta,
+                          y,
+                          static_cast<int32_t>(incY));
+        }
     }
 
 #if defined(LIBRAPID_HAS_OPENCL)
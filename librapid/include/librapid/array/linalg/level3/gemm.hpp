@@ -1,6 +1,200 @@
 #ifndef LIBRAPID_ARRAY_LINALG_LEVEL3_GEMM_HPP
 #define LIBRAPID_ARRAY_LINALG_LEVEL3_GEMM_HPP
 
+#if defined(LIBRAPID_RUNTIME_DISPATCH) && !defined(LIBRAPID_HAS_BLAS)
+namespace librapid::detail::cpu {
+    /// Row-major GEMM for float and double built on the runtime-dispatched dot and axpy kernels.
+    /// This replaces cxxblas' generic implementation when no BLAS library is available.
+    /// \return True if the call was handled, false if the generic implementation must be used
+    template<typename Scalar, typename Int>
+    bool gemmDispatched(bool transA, bool transB, Int m, Int n, Int k, Scalar alpha,
+                        const Scalar *a, Int lda, const Scalar *b, Int ldb, Scalar beta,
+                        Scalar *c, Int ldc) {
+        // Both operands transposed has no contiguous inner loop, so leave it to cxxblas
+        if (transA && transB) return false;
+
+        auto row = [&](int64_t i) {
+            Scalar *cRow = c + i * ldc;
+
+            if (!transB) {
+                // C_i = beta * C_i + sum_p (alpha * op(A)_ip) * B_p
+                dispatch::scal(n, beta, cRow);
+                for (int64_t p = 0; p < (int64_t)k; ++p) {
+                    Scalar aip = transA ? a[p * lda + i] : a[i * lda + p];
+                    dispatch::axpy(n, alpha * aip, b + p * ldb, cRow);
+                }
+            } else {
+                // C_ij = alpha * dot(A_i, B_j) + beta * C_ij
+                for (int64_t j = 0; j < (int64_t)n; ++j) {
+                    Scalar res = alpha * dispatch::dot(k, a + i * lda, b + j * ldb);
+                    cRow[j]    = beta == Scalar(0) ? res : res + beta * cRow[j];
+                }
+            }
+        };
+
+        if (n >= global::gemmMultithreadThreshold && global::numThreads > 1) {
+#    pragma omp parallel for shared(m, row) default(none) num_threads((int)global::numThreads)
+            for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+        } else {
+            for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+        }
+
+        return true;
+    }
+} // namespace librapid::detail::cpu
+#endif // LIBRAPID_RUNTIME_DISPATCH && !LIBRAPID_HAS_BLAS
+
+namespace librapid::detail::cpu {
+    /// Row-major GEMM for bfloat16 inputs, accumulating in single precision. The output may be
+    /// float or bfloat16; in the latter case, each result is rounded once, after accumulation
+    template<typename Out, typename Int>
+    void gemmMixed(bool transA, bool transB, Int m, Int n, Int k, float alpha, const bfloat16 *a,
+                   Int lda, const bfloat16 *b, Int ldb, float beta, Out *c, Int ldc) {
+        auto row = [&](int64_t i) {
+            Out *cRow = c + i * ldc;
+
+            if (!transB) {
+                // C_i = beta * C_i + sum_p (alpha * op(A)_ip) * B_p, accumulated in float
+                std::vector<float> buffer;
+                float *acc;
+                if constexpr (std::is_same_v<Out, float>) {
+                    acc = cRow;
+                    dispatch::scal(n, beta, acc);
+                } else {
+                    buffer.resize(n);
+                    acc = buffer.data();
+                    for (int64_t j = 0; j < (int64_t)n; ++j) {
+                        acc[j] = beta == 0.0f ? 0.0f : beta * float(cRow[j]);
+                    }
+                }
+
+                for (int64_t p = 0; p < (int64_t)k; ++p) {
+                    float aip = float(transA ? a[p * lda + i] : a[i * lda + p]);
+                    dispatch::axpy(n, alpha * aip, b + p * ldb, acc);
+                }
+
+                if constexpr (!std::is_same_v<Out, float>) {
+                    for (int64_t j = 0; j < (int64_t)n; ++j) { cRow[j] = Out(acc[j]); }
+                }
+            } else {
+                // C_ij = alpha * dot(op(A)_i, B_j) + beta * C_ij
+                for (int64_t j = 0; j < (int64_t)n; ++j) {
+                    float res;
+                    if (!transA) {
+                        res = dispatch::dot(k, a + i * lda, b + j * ldb);
+                    } else {
+                        res = 0;
+                        for (int64_t p = 0; p < (int64_t)k; ++p) {
+                            res += float(a[p * lda + i]) * float(b[j * ldb + p]);
+                        }
+                    }
+                    res *= alpha;
+                    cRow[j] = Out(beta == 0.0f ? res : res + beta * float(cRow[j]));
+                }
+            }
+        };
+
+        if (n >= global::gemmMultithreadThreshold && global::numThreads > 1) {
+#    pragma omp parallel for shared(m, row) default(none) num_threads((int)global::numThreads)
+            for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+        } else {
+            for (int64_t i = 0; i < (int64_t)m; ++i) { row(i); }
+        }
+    }
+
+    /// True if A and B are 8-bit integer types with a dispatched int32-accumulating dot product
+    template<typename A, typename B>
+    constexpr bool isInt8Pair() {
+        using TA = std::remove_const_t<A>;
+        using TB = std::remove_const_t<B>;
+        return (std::is_same_v<TA, int8_t> && std::is_same_v<TB, int8_t>) ||
+               (std::is_same_v<TA, uint8_t> && std::is_same_v<TB, int8_t>) ||
+               (std::is_same_v<TA, int8_t> && std::is_same_v<TB, uint8_t>);
+    }
+
+    /// Convert alpha or beta of an 8-bit integer product to the int32 the result is scaled by.
+    /// Throws std::invalid_argument if the value is not an int32, rather than truncating it
+    /// (which would turn alpha = 0.5 into zero)
+    /// \param value The scale factor
+    /// \param name The name of the scale factor, for the error message
+    /// \return The scale factor as an int32
+    template<typename T>
+    LIBRAPID_NODISCARD int32_t int8Scale(const T &value, const char *name) {
+        const double scale = static_cast<double>(value);
+        if (!(scale == std::trunc(scale) &&
+              scale >= static_cast<double>(std::numeric_limits<int32_t>::min()) &&
+              scale <= static_cast<double>(std::numeric_limits<int32_t>::max()))) {
+            throw std::invalid_argument(fmt::format(
+              "8-bit integer products require an integral {}, but received {}", name, scale));
+        }
+        return static_cast<int32_t>(scale);
+    }
+
+    /// Dot product of two contiguous 8-bit integer vectors, accumulated exactly in int32
+    template<typename TA, typename TB>
+    LIBRAPID_ALWAYS_INLINE int32_t dotInt8(int64_t n, const TA *a, const TB *b) {
+        if constexpr (std::is_same_v<TB, uint8_t>) {
+            return dispatch::dot(n, b, a); // The unsigned operand always comes first
+        } else {
+            return dispatch::dot(n, a, b);
+        }
+    }
+
+    /// Row-major GEMM for 8-bit integer inputs, accumulating exactly in 32-bit integers. The
+    /// accumulator for each element is passed to `epilogue(i, j, acc)`, and the result is
+    /// stored to C_ij, so scaling and requantization are fused into the same pass.
+    ///
+    /// The kernel computes dot products of the rows of op(A) and the columns of op(B), so the
+    /// operands are repacked first unless op(A) is A and op(B) is B^T.
+    template<typename TA, typename TB, typename Out, typename Int, typename Epilogue>
+    void gemmInt8(bool transA, bool transB, Int m, Int n, Int k, const TA *a, Int lda,
+                  const TB *b, Int ldb, Out *c, Int ldc, const Epilogue &epilogue) {
+        std::vector<TA> packedA;
+        std::vector<TB> packedB;
+
+        if (transA) {
+            packedA.resize(m * k);
+            for (int64_t p = 0; p < (int64_t)k; ++p) {
+                for (int64_t i = 0; i < (int64_t)m; ++i) { packedA[i * k + p] = a[p * lda + i]; }
+            }
+            a   = packedA.data();
+            lda = k;
+        }
+
+        if (!transB) {
+            packedB.resize(n * k);
+            for (int64_t p = 0; p < (int64_t)k; ++p) {
+                for (int64_t j = 0; j < (int64_t)n; ++j) { packedB[j * k + p] = b[p * ldb + j]; }
+            }
+            b   = packedB.data();
+            ldb = k;
+        }
+
+        auto element = [&](int64_t i, int64_t j) {
+            c[i * ldc + j] = epilogue(i, j, dotInt8(k, a + i * lda, b + j * ldb));
+        };
+
+        if (n >= global::gemmMultithreadThreshold && global::numThreads > 1) {
+            if (m == 1) {
+                // A single row is a matrix-vector product, so the columns are shared out instead
+#    pragma omp parallel for shared(n, element) default(none)                                      \
+      num_threads((int)global::numThreads)
+                for (int64_t j = 0; j < (int64_t)n; ++j) { element(0, j); }
+            } else {
+#    pragma omp parallel for shared(m, n, element) default(none)                                   \
+      num_threads((int)global::numThreads)
+                for (int64_t i = 0; i < (int64_t)m; ++i) {
+                    for (int64_t j = 0; j < (int64_t)n; ++j) { element(i, j); }
+                }
+            }
+        } else {
+            for (int64_t i = 0; i < (int64_t)m; ++i) {
+                for (int64_t j = 0; j < (int64_t)n; ++j) { element(i, j); }
+            }
+        }
+    }
+} // namespace librapid::detail::cpu
+
 namespace librapid::linalg {
     /// \brief General matrix-matrix multiplication
     ///
@@ -32,20 +226,81 @@ namespace librapid::linalg {
     template<typename Int, typename Alpha, typename A, typename B, typename Beta, typename C>
     void gemm(bool transA, bool transB, Int m, Int n, Int k, Alpha alpha, A *a, Int lda, B *b,
               Int ldb, Beta beta, C *c, Int ldc, backend::CPU backend = backend::CPU()) {
-        cxxblas::gemm(cxxblas::StorageOrder::RowMajor,
-                      (transA ? cxxblas::Transpose::Trans : cxxblas::Transpose::NoTrans),
-                      (transB ? cxxblas::Transpose::Trans : cxxblas::Transpose::NoTrans),
-                      m,
-                      n,
-                      k,
-                      alpha,
-                      a,
-                      lda,
-                      b,
-                      ldb,
-                      beta,
-                      c,
-                      ldc);
+        // bfloat16 inputs are accumulated in single precision
+        if constexpr (std::is_same_v<std::remove_const_t<A>, bfloat16> &&
+                      std::is_same_v<std::remove_const_t<B>, bfloat16> &&
+                      (std::is_same_v<C, float> || std::is_same_v<C, bfloat16>)) {
+            detail::cpu::gemmMixed(transA,
+                                   transB,
+                                   m,
+                                   n,
+                                   k,
+                                   static_cast<float>(alpha),
+                                   a,
+                                   lda,
+                                   b,
+                                   ldb,
+                                   static_cast<float>(beta),
+                                   c,
+                                   ldc);
+        } else if constexpr (detail::cpu::isInt8Pair<A, B>() && std::is_same_v<C, int32_t>) {
+            // 8-bit integer inputs are accumulated exactly in 32 bits
+            const int32_t alphaInt = detail::cpu::int8Scale(alpha, "alpha");
+            const int32_t betaInt  = detail::cpu::int8Scale(beta, "beta");
+            detail::cpu::gemmInt8(
+              transA,
+              transB,
+              m,
+              n,
+              k,
+              a,
+              lda,
+              b,
+              ldb,
+              c,
+              ldc,
+              [alphaInt, betaInt, c, ldc](int64_t i, int64_t j, int32_t acc) -> int32_t {
+                  return betaInt == 0 ? alphaInt * acc : alphaInt * acc + betaInt * c[i * ldc + j];
+              });
+        } else {
+#if defined(LIBRAPID_RUNTIME_DISPATCH) && !defined(LIBRAPID_HAS_BLAS)
+            using Scalar = std::remove_const_t<A>;
+            if constexpr ((std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>) &&
+                          std::is_same_v<std::remove_const_t<B>, Scalar> &&
+                          std::is_same_v<C, Scalar>) {
+                if (detail::cpu::gemmDispatched<Scalar>(transA,
+                                                        transB,
+                                                        m,
+                                                        n,
+                                                        k,
+                                                        Scalar(alpha),
+                                                        a,
+                                                        lda,
+                                                        b,
+                                                        ldb,
+                                                        Scalar(beta),
+                                                        c,
+                                                        ldc)) {
+                    return;
+                }
+            }
+#endif // LIBRAPID_RUNTIME_DISPATCH && !LIBRAPID_HAS_BLAS
+
+            cxxblas::gemm(cxxblas::StorageOrder::RowMajor,
+                          (transA ? cxxblas::Transpose::Trans : cxxblas::Transpose::NoTrans),
+                          (transB ? cxxblas::Transpose::Trans : cxxblas::Transpose::NoTrans),
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          a,
+                          lda,
+                          b,
+                          ldb,
+                          beta,
+                          c,
+                          ldc);
+        }
     }
 
 #if defined(LIBRAPID_HAS_OPENCL)
@@ -17,7 +17,8 @@ namespace librapid {
 	} // namespace typetraits
 
 	namespace kernels {
-#if defined(LIBRAPID_NATIVE_ARCH)
+		// With runtime dispatch enabled, the kernels in simdDispatch.cpp are used instead
+#if defined(LIBRAPID_NATIVE_ARCH) && !defined(LIBRAPID_RUNTIME_DISPATCH)
 #	if !defined(LIBRAPID_APPLE) && LIBRAPID_ARCH >= ARCH_AVX2
 #		define LIBRAPID_F64_TRANSPOSE_KERNEL_SIZE 4
 #		define LIBRAPID_F32_TRANSPOSE_KERNEL_SIZE 8
@@ -220,7 +221,7 @@ namespace librapid {
 			vst1q_f64(&out[1 * cols], vmulq_f64(t1, alphaVec));
 		}
 #	endif
-#endif // LIBRAPID_NATIVE_ARCH
+#endif // LIBRAPID_NATIVE_ARCH && !LIBRAPID_RUNTIME_DISPATCH
 
 		// Ensure the kernel size is always defined, even if the above code doesn't define it
 #ifndef LIBRAPID_F32_TRANSPOSE_KERNEL_SIZE
@@ -362,6 +363,81 @@ namespace librapid {
 				}
 			}
 #endif // LIBRAPID_F64_TRANSPOSE_KERNEL_SIZE > 0
+
+#if defined(LIBRAPID_RUNTIME_DISPATCH)
+			/// Transpose a float or double matrix using the SIMD kernels selected at runtime. When
+			/// multithreading, each thread transposes a contiguous band of input rows, the height
+			/// of which is a multiple of every kernel's block size.
+			template<typename Scalar>
+			LIBRAPID_ALWAYS_INLINE void transposeDispatched(Scalar *__restrict out,
+															const Scalar *__restrict in,
+															int64_t rows, int64_t cols,
+															Scalar alpha) {
+#	if !defined(LIBRAPID_OPTIMISE_SMALL_ARRAYS)
+				if (rows * cols > global::multithreadThreshold && global::numThreads > 1) {
+					constexpr int64_t bandHeight = 64;
+					int64_t numBands			 = (rows + bandHeight - 1) / bandHeight;
+
+#		pragma omp parallel for shared(rows, cols, in, out, alpha, numBands) default(none)        \
+		  num_threads((int)global::numThreads)
+					for (int64_t band = 0; band < numBands; ++band) {
+						int64_t rowBegin = band * bandHeight;
+						int64_t rowEnd	 = ::librapid::min(rows, rowBegin + bandHeight);
+						dispatch::transpose(out, in, rows, cols, alpha, rowBegin, rowEnd);
+					}
+					return;
+				}
+#	endif // LIBRAPID_OPTIMISE_SMALL_ARRAYS
+
+				dispatch::transpose(out, in, rows, cols, alpha, 0, rows);
+			}
+
+			template<typename Alpha>
+			LIBRAPID_ALWAYS_INLINE void transposeImpl(float *__restrict out, float *__restrict in,
+													  int64_t rows, int64_t cols, Alpha alpha,
+													  int64_t) {
+				transposeDispatched<float>(out, in, rows, cols, static_cast<float>(alpha));
+			}
+
+			template<typename Alpha>
+			LIBRAPID_ALWAYS_INLINE void transposeImpl(double *__restrict out, double *__restrict in,
+													  int64_t rows, int64_t cols, Alpha alpha,
+													  int64_t) {
+				transposeDispatched<double>(out, in, rows, cols, static_cast<double>(alpha));
+			}
+#endif // LIBRAPID_RUNTIME_DISPATCH
+
+			/// Transpose a half or bfloat16 matrix. The elements are moved as raw 16-bit values,
+			/// so no conversions are required unless the result is scaled, in which case the
+			/// output is scaled in place using float packets (see detail::loadConverted)
+			template<typename Scalar, typename Alpha>
+				requires(std::is_same_v<Scalar, half> || std::is_same_v<Scalar, bfloat16>)
+			LIBRAPID_ALWAYS_INLINE void transposeImpl(Scalar *__restrict out, Scalar *__restrict in,
+													  int64_t rows, int64_t cols, Alpha alpha,
+													  int64_t blockSize) {
+				transposeImpl(reinterpret_cast<uint16_t *>(out),
+							  reinterpret_cast<const uint16_t *>(in),
+							  rows,
+							  cols,
+							  uint16_t(1),
+							  blockSize);
+
+				const float scale = static_cast<float>(alpha);
+				if (scale == 1.0f) { return; }
+
+				using Packet				  = typename typetraits::TypeInfo<Scalar>::Packet;
+				constexpr int64_t packetWidth = typetraits::TypeInfo<Scalar>::packetWidth;
+				const int64_t size			  = rows * cols;
+				const int64_t vectorSize	  = size - (size % packetWidth);
+
+				for (int64_t i = 0; i < vectorSize; i += packetWidth) {
+					storeConverted(out + i, loadConverted<Packet>(out + i) * scale);
+				}
+
+				for (int64_t i = vectorSize; i < size; ++i) {
+					out[i] = Scalar(static_cast<float>(out[i]) * scale);
+				}
+			}
 		} // namespace cpu
 
 #if defined(LIBRAPID_HAS_OPENCL)
@@ -0,0 +1,381 @@
+#ifndef LIBRAPID_ARRAY_MAP_HPP
+#define LIBRAPID_ARRAY_MAP_HPP
+
+/*
+ * User-defined element-wise operations. map(f, args...) wraps an arbitrary callable in a lazily
+ * evaluated detail::Function, so it can be combined with any other array expression and
+ * assigned (or fused with evalMany()) like one of the built-in operations.
+ *
+ * If `f` can be called with xsimd batches -- for example, a generic lambda which only uses
+ * arithmetic operators and LibRapid's math functions -- the result is evaluated with packets.
+ * Otherwise, it is evaluated one element at a time.
+ *
+ * Note that generic lambdas with deduced return types are not SFINAE-friendly, so a lambda
+ * whose body does not compile for batches (e.g. one using `std::clamp`) will cause an error
+ * rather than falling back to scalar evaluation. Declare the parameter types explicitly, or use
+ * mapScalar(), in that case.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// Functor wrapping a user-defined element-wise operation
+		/// \tparam Lambda The callable type
+		/// \tparam vectorise If false, never evaluate the callable with packets
+		template<typename Lambda, bool vectorise>
+		struct Map {
+			Lambda lambda;
+
+			/// Source of a device kernel implementing the operation (may be empty)
+			std::string kernelSource;
+
+			/// Name of the device kernel implementing the operation (may be empty)
+			std::string kernelName;
+
+			template<typename... T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const T &...args) const {
+				return lambda(args...);
+			}
+
+			template<typename... Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packet(const Packet &...args) const {
+				return lambda(args...);
+			}
+		};
+
+		/// Returns true if a mapped callable can be evaluated with packets. This requires all
+		/// arguments to share a vectorisable scalar type, the result to have the same type, and
+		/// the callable to accept (and return) packets of that type
+		/// \tparam Lambda The callable type
+		/// \tparam Args The argument types
+		/// \return True if the callable can be vectorised
+		template<typename Lambda, typename... Args>
+		constexpr bool mapAcceptsPackets() {
+			if constexpr (!typetraits::checkAllowVectorisation<Args...>()) {
+				return false;
+			} else {
+				using First  = std::decay_t<std::tuple_element_t<0, std::tuple<Args...>>>;
+				using Scalar = typename typetraits::TypeInfo<First>::Scalar;
+				using Packet = typename typetraits::TypeInfo<Scalar>::Packet;
+				using Result = std::decay_t<std::invoke_result_t<
+				  const Lambda &, const typename typetraits::ScalarTypeHelper<Args>::Type &...>>;
+
+				if constexpr (!std::is_same_v<Result, Scalar>) {
+					return false;
+				} else {
+					// Every argument is passed as a Packet (scalars are broadcast)
+					return std::is_invocable_r_v<Packet, const Lambda &,
+												 const std::conditional_t<true, Packet, Args> &...>;
+				}
+			}
+		}
+
+		/// Return the shape of the first array in a list of map() arguments, checking that all
+		/// other arrays have the same shape
+		template<typename First, typename... Rest>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto mapShape(const First &first,
+																const Rest &...rest) {
+			if constexpr (::librapid::IsArrayType<First>::value) {
+				(
+				  [&first](const auto &arg) {
+					  if constexpr (::librapid::IsArrayType<std::decay_t<decltype(arg)>>::value) {
+						  LIBRAPID_ASSERT_WITH_EXCEPTION(
+							std::range_error,
+							first.shape() == arg.shape(),
+							"Shapes must match for mapped operations. {} vs {}",
+							first.shape(),
+							arg.shape());
+					  }
+				  }(rest),
+				  ...);
+				return first.shape();
+			} else {
+				return mapShape(rest...);
+			}
+		}
+	} // namespace detail
+
+	namespace typetraits {
+		template<typename Lambda, bool vectorise>
+		struct TypeInfo<::librapid::detail::Map<Lambda, vectorise>> {
+			static constexpr const char *name		= "map";
+			static constexpr const char *filename	= "map";
+			static constexpr const char *kernelName = "map";
+
+			template<typename... Args>
+			LIBRAPID_NODISCARD static LIBRAPID_ALWAYS_INLINE auto
+			getShape(const std::tuple<Args...> &args) {
+				return std::apply(
+				  [](const auto &...arg) { return ::librapid::detail::mapShape(arg...); }, args);
+			}
+		};
+
+		template<typename Lambda, bool vectorise, typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Map<Lambda, vectorise>, Args...>
+				: std::bool_constant<vectorise &&
+									 ::librapid::detail::mapAcceptsPackets<Lambda, Args...>()> {};
+	} // namespace typetraits
+
+	/// \brief Apply a user-defined function to each element of one or more arrays
+	///
+	/// Returns a lazily evaluated function object which applies `f` to corresponding elements
+	/// of `args`. Scalars are broadcast to every element. For example:
+	///
+	/// \code{.cpp}
+	/// auto smooth = map([](auto x) { return x * x * (3.0f - 2.0f * x); }, a);
+	/// \endcode
+	///
+	/// If `f` can also be called with SIMD packets, the result is vectorised.
+	///
+	/// On OpenCL and CUDA arrays, the arguments are copied to the host, evaluated there and
+	/// copied back. Use mapKernel() to evaluate on the device instead.
+	///
+	/// \tparam Lambda The callable type
+	/// \tparam Args The argument types
+	/// \param f The function to apply
+	/// \param args The arrays (and scalars) to pass to `f`
+	/// \return Function object applying `f` element-wise
+	template<typename Lambda, typename... Args>
+		requires((IsArrayType<std::decay_t<Args>>::value || ...))
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto map(Lambda &&f, Args &&...args)
+	  -> detail::Function<typetraits::DescriptorType_t<Args...>,
+						  detail::Map<std::decay_t<Lambda>, true>, Args...> {
+		using Functor = detail::Map<std::decay_t<Lambda>, true>;
+		return detail::Function<typetraits::DescriptorType_t<Args...>, Functor, Args...>(
+		  Functor {std::forward<Lambda>(f), {}, {}}, std::forward<Args>(args)...);
+	}
+
+	/// \brief Apply a user-defined function to each element, without vectorisation
+	///
+	/// Identical to map(), except `f` is only ever called with scalars
+	///
+	/// \tparam Lambda The callable type
+	/// \tparam Args The argument types
+	/// \param f The function to apply
+	/// \param args The arrays (and scalars) to pass to `f`
+	/// \return Function object applying `f` element-wise
+	/// \see map()
+	template<typename Lambda, typename... Args>
+		requires((IsArrayType<std::decay_t<Args>>::value || ...))
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto mapScalar(Lambda &&f, Args &&...args)
+	  -> detail::Function<typetraits::DescriptorType_t<Args...>,
+						  detail::Map<std::decay_t<Lambda>, false>, Args...> {
+		using Functor = detail::Map<std::decay_t<Lambda>, false>;
+		return detail::Function<typetraits::DescriptorType_t<Args...>, Functor, Args...>(
+		  Functor {std::forward<Lambda>(f), {}, {}}, std::forward<Args>(args)...);
+	}
+
+	/// \brief Apply a user-defined function to each element, with a custom device kernel
+	///
+	/// Identical to map(), except that OpenCL and CUDA arrays are evaluated on the device by
+	/// the kernel `kernelName`, defined in `kernelSource`, rather than on the host. `f` is
+	/// still used for host arrays. The kernel is compiled the first time it is used.
+	///
+	/// OpenCL kernels are launched with one work-item per element and receive the output
+	/// buffer followed by each argument (a buffer for arrays, a value for scalars):
+	///
+	/// \code{.c}
+	/// __kernel void clip(__global float *dst, __global const float *x) { ... }
+	/// \endcode
+	///
+	/// CUDA kernels receive the number of elements, the output pointer and the arguments, and
+	/// are instantiated with the output scalar type followed by the argument scalar types:
+	///
+	/// \code{.cpp}
+	/// template<typename Dst, typename X>
+	/// __global__ void clip(size_t elements, Dst *dst, const X *x) { ... }
+	/// \endcode
+	///
+	/// \tparam Lambda The callable type
+	/// \tparam Args The argument types
+	/// \param kernelSource Source code of the device kernel
+	/// \param kernelName Name of the device kernel
+	/// \param f The function to apply on the host
+	/// \param args The arrays (and scalars) to pass to `f`
+	/// \return Function object applying `f` element-wise
+	/// \see map()
+	template<typename Lambda, typename... Args>
+		requires((IsArrayType<std::decay_t<Args>>::value || ...))
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto
+	mapKernel(const std::string &kernelSource, const std::string &kernelName, Lambda &&f,
+			  Args &&...args)
+	  -> detail::Function<typetraits::DescriptorType_t<Args...>,
+						  detail::Map<std::decay_t<Lambda>, true>, Args...> {
+		using Functor = detail::Map<std::decay_t<Lambda>, true>;
+		return detail::Function<typetraits::DescriptorType_t<Args...>, Functor, Args...>(
+		  Functor {std::forward<Lambda>(f), kernelSource, kernelName}, std::forward<Args>(args)...);
+	}
+
+#if defined(LIBRAPID_HAS_OPENCL) || defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+#	if defined(LIBRAPID_HAS_OPENCL)
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void mapCopyToHost(Scalar *dst,
+												  const OpenCLStorage<Scalar> &src) {
+			global::openCLQueue.enqueueReadBuffer(
+			  src.data(), CL_TRUE, 0, src.size() * sizeof(Scalar), dst);
+		}
+
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void mapCopyFromHost(OpenCLStorage<Scalar> &dst, const Scalar *src) {
+			global::openCLQueue.enqueueWriteBuffer(
+			  dst.data(), CL_TRUE, 0, dst.size() * sizeof(Scalar), src);
+		}
+#	endif // LIBRAPID_HAS_OPENCL
+
+#	if defined(LIBRAPID_HAS_CUDA)
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void mapCopyToHost(Scalar *dst, const CudaStorage<Scalar> &src) {
+			cudaSafeCall(cudaMemcpyAsync(dst,
+										 src.begin(),
+										 src.size() * sizeof(Scalar),
+										 cudaMemcpyDeviceToHost,
+										 global::cudaStream));
+			cudaSafeCall(cudaStreamSynchronize(global::cudaStream));
+		}
+
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void mapCopyFromHost(CudaStorage<Scalar> &dst, const Scalar *src) {
+			cudaSafeCall(cudaMemcpyAsync(dst.begin(),
+										 src,
+										 dst.size() * sizeof(Scalar),
+										 cudaMemcpyHostToDevice,
+										 global::cudaStream));
+		}
+#	endif // LIBRAPID_HAS_CUDA
+
+		/// Copy an argument of a mapped function to the host. Nested functions are evaluated
+		/// on the device first. Scalars and masks are already on the host.
+		/// \tparam T The argument type
+		/// \param arg The argument to copy
+		/// \return A host array (or the scalar itself)
+		template<typename T>
+		LIBRAPID_NODISCARD auto mapArgToHost(const T &arg) {
+			if constexpr (typetraits::TypeInfo<T>::type == LibRapidType::Scalar ||
+						  typetraits::TypeInfo<T>::type == LibRapidType::Mask) {
+				return arg;
+			} else if constexpr (typetraits::TypeInfo<T>::type == LibRapidType::ArrayFunction) {
+				return mapArgToHost(arg.eval());
+			} else {
+				using Scalar = typename typetraits::TypeInfo<T>::Scalar;
+				Array<Scalar, backend::CPU> result(arg.shape());
+				mapCopyToHost(result.storage().begin(), arg.storage());
+				return result;
+			}
+		}
+
+		/// Evaluate a mapped function on the host and copy the result into a device array
+		/// \tparam Dst The destination array type
+		/// \tparam Functor The Map functor type
+		/// \tparam Args The argument types
+		/// \param lhs The array to assign to
+		/// \param function The function to evaluate
+		template<typename Dst, typename Functor, typename... Args>
+		void
+		mapAssignOnHost(Dst &lhs,
+						const detail::Function<descriptor::Trivial, Functor, Args...> &function) {
+			auto host = std::apply(
+			  [&function](const auto &...args) {
+				  using HostFunction = detail::Function<descriptor::Trivial,
+														Functor,
+														decltype(mapArgToHost(args))...>;
+				  return HostFunction(Functor(function.functor()), mapArgToHost(args)...).eval();
+			  },
+			  function.args());
+
+			mapCopyFromHost(lhs.storage(), host.storage().begin());
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL || LIBRAPID_HAS_CUDA
+
+#if defined(LIBRAPID_HAS_OPENCL)
+	namespace detail {
+		/// Compile (or fetch from the cache) an OpenCL program for a mapped function. The cache
+		/// is shared by every host thread, so lookups and insertions are serialised by a mutex.
+		/// Entries are never erased, so the returned reference stays valid after the lock is
+		/// released.
+		/// \param source The kernel source
+		/// \return The compiled program
+		inline const cl::Program &mapOpenCLProgram(const std::string &source) {
+			static std::map<std::string, cl::Program> programs;
+			static std::mutex mutex;
+			std::lock_guard<std::mutex> lock(mutex);
+
+			auto it = programs.find(source);
+			if (it == programs.end()) {
+				cl::Program program(global::openCLContext, source);
+				cl_int err = program.build({global::openCLDevice});
+				LIBRAPID_ASSERT(err == CL_SUCCESS,
+								"Failed to build mapped OpenCL kernel: {}",
+								program.getBuildInfo<CL_PROGRAM_BUILD_LOG>(global::openCLDevice));
+				it = programs.emplace(source, program).first;
+			}
+			return it->second;
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename Lambda, bool vectorise,
+				 typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Map<Lambda, vectorise>, Args...>
+				 &function) {
+			const auto &functor = function.functor();
+			if (functor.kernelName.empty()) {
+				mapAssignOnHost(lhs, function);
+				return;
+			}
+
+			cl::Kernel kernel(mapOpenCLProgram(functor.kernelSource), functor.kernelName.c_str());
+			std::apply(
+			  [&](const auto &...args) {
+				  opencl::setKernelArgs<StorageScalar>(
+					kernel,
+					std::make_tuple(lhs.storage().data(),
+									opencl::dataSourceExtractor(
+									  opencl::openCLTupleEvaluatorImpl(args))...),
+					std::make_index_sequence<sizeof...(Args) + 1>());
+			  },
+			  function.args());
+
+			auto err = global::openCLQueue.enqueueNDRangeKernel(
+			  kernel, cl::NullRange, cl::NDRange(function.size()), cl::NullRange);
+			LIBRAPID_ASSERT(err == CL_SUCCESS,
+							"OpenCL kernel execution failed with error code {}: {}",
+							err,
+							opencl::getOpenCLErrorString(err));
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL
+
+#if defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename Lambda, bool vectorise,
+				 typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Map<Lambda, vectorise>, Args...>
+				 &function) {
+			const auto &functor = function.functor();
+			if (functor.kernelName.empty()) {
+				mapAssignOnHost(lhs, function);
+				return;
+			}
+
+			std::apply(
+			  [&](const auto &...args) {
+				  cuda::runKernelString<
+					StorageScalar,
+					typename typetraits::TypeInfo<std::decay_t<Args>>::Scalar...>(
+					functor.kernelSource,
+					functor.kernelName,
+					function.size(),
+					function.size(),
+					lhs.storage().begin(),
+					cuda::dataSourceExtractor(cuda::cudaTupleEvaluatorImpl(args))...);
+			  },
+			  function.args());
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_CUDA
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_MAP_HPP
@@ -0,0 +1,491 @@
+#ifndef LIBRAPID_ARRAY_MASK_HPP
+#define LIBRAPID_ARRAY_MASK_HPP
+
+/*
+ * Bit-packed boolean arrays. Comparisons such as `a < b` evaluate to arrays of the operand type,
+ * which is wasteful when the result is only used to select elements: a mask over 1e9 doubles
+ * costs 8 GB. A Mask stores one bit per element instead (64x smaller for doubles), using the
+ * same 64-bit word layout as BitSet, but with a size chosen at runtime.
+ *
+ * Masks are built directly from comparison expressions. The operands are compared packet by
+ * packet and the resulting xsimd::batch_bool is reduced to an integer with a movemask, so the
+ * intermediate array of zeros and ones is never created.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// True if Functor is one of the element-wise comparison functors
+		template<typename Functor>
+		struct IsComparisonFunctor : std::false_type {};
+
+		template<>
+		struct IsComparisonFunctor<LessThan> : std::true_type {};
+
+		template<>
+		struct IsComparisonFunctor<GreaterThan> : std::true_type {};
+
+		template<>
+		struct IsComparisonFunctor<LessThanEqual> : std::true_type {};
+
+		template<>
+		struct IsComparisonFunctor<GreaterThanEqual> : std::true_type {};
+
+		template<>
+		struct IsComparisonFunctor<ElementWiseEqual> : std::true_type {};
+
+		template<>
+		struct IsComparisonFunctor<ElementWiseNotEqual> : std::true_type {};
+
+		template<typename T>
+		struct IsComparisonFunction : std::false_type {};
+
+		template<typename desc, typename Functor, typename... Args>
+		struct IsComparisonFunction<Function<desc, Functor, Args...>>
+				: IsComparisonFunctor<Functor> {};
+
+		/// True if a Mask can be built from T with packets. This is the case for host
+		/// expressions with a vectorised, non-complex scalar type
+		template<typename T>
+		constexpr bool maskAllowsVectorisation() {
+			using Scalar = typename typetraits::TypeInfo<T>::Scalar;
+			if constexpr (!std::is_same_v<typename typetraits::TypeInfo<T>::Backend,
+										  backend::CPU>) {
+				return false;
+			} else if constexpr (IsComplex<Scalar>::value ||
+								 typetraits::TypeInfo<Scalar>::packetWidth <= 1) {
+				return false;
+			} else {
+				return typetraits::TypeInfo<T>::allowVectorisation;
+			}
+		}
+
+		/// Evaluate one packet of an expression as booleans, returning one bit per element (the
+		/// first element in the lowest bit). Comparisons compare the packets of their operands
+		/// directly, and any other expression is compared against zero
+		/// \tparam T The expression type
+		/// \param expr The expression to evaluate
+		/// \param index The index of the first element in the packet
+		/// \return The packed bits
+		template<typename T>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE uint64_t maskPacketBits(const T &expr,
+																		 size_t index) {
+			if constexpr (IsComparisonFunction<T>::value) {
+				using Packet = typename T::Packet;
+				const auto &[lhs, rhs] = expr.args();
+				return static_cast<uint64_t>(expr.functor()
+											   .packetMask(packetExtractor<Packet>(lhs, index),
+														   packetExtractor<Packet>(rhs, index))
+											   .mask());
+			} else {
+				using Packet = std::decay_t<decltype(expr.packet(index))>;
+				using Scalar = typename Packet::value_type;
+				return static_cast<uint64_t>((expr.packet(index) != Packet(Scalar(0))).mask());
+			}
+		}
+	} // namespace detail
+
+	/// A bit-packed array of booleans, typically produced by a comparison:
+	///
+	/// \code{.cpp}
+	/// auto a = lrc::Array<double>::fromData({1, 5, 2, 8});
+	/// lrc::Mask mask(a > 3); // 0, 1, 0, 1
+	/// for (int64_t i : mask.setIndices()) { ... } // 1, 3
+	/// \endcode
+	///
+	/// Element i is stored in bit `i % 64` of word `i / 64`. Bits past the end of the mask are
+	/// always zero.
+	class Mask {
+	public:
+		using ElementType						 = uint64_t;
+		using ShapeType							 = Shape;
+		static constexpr int64_t bitsPerElement = sizeof(ElementType) * 8;
+
+		/// Iterates over the indices of the set bits in a Mask, in increasing order. Each word
+		/// is scanned with a count-trailing-zeros instruction, so runs of unset bits are skipped
+		/// 64 at a time
+		class SetIndexIterator {
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type		= int64_t;
+			using difference_type	= std::ptrdiff_t;
+			using pointer			= const int64_t *;
+			using reference			= int64_t;
+
+			SetIndexIterator() = default;
+
+			/// Construct an iterator pointing to the first set bit in word `wordIndex` or later
+			/// \param words The words of the Mask
+			/// \param numWords The number of words in the Mask
+			/// \param wordIndex The index of the first word to scan
+			SetIndexIterator(const ElementType *words, int64_t numWords, int64_t wordIndex) :
+					m_words(words), m_numWords(numWords), m_wordIndex(wordIndex),
+					m_word(wordIndex < numWords ? words[wordIndex] : 0) {
+				skipEmptyWords();
+			}
+
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t operator*() const {
+				return m_wordIndex * bitsPerElement + std::countr_zero(m_word);
+			}
+
+			LIBRAPID_ALWAYS_INLINE SetIndexIterator &operator++() {
+				m_word &= m_word - 1; // Clear the lowest set bit
+				skipEmptyWords();
+				return *this;
+			}
+
+			LIBRAPID_ALWAYS_INLINE SetIndexIterator operator++(int) {
+				SetIndexIterator tmp = *this;
+				++(*this);
+				return tmp;
+			}
+
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool
+			operator==(const SetIndexIterator &other) const {
+				return m_wordIndex == other.m_wordIndex && m_word == other.m_word;
+			}
+
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool
+			operator!=(const SetIndexIterator &other) const {
+				return !(*this == other);
+			}
+
+		private:
+			LIBRAPID_ALWAYS_INLINE void skipEmptyWords() {
+				while (m_word == 0 && m_wordIndex < m_numWords) {
+					if (++m_wordIndex < m_numWords) { m_word = m_words[m_wordIndex]; }
+				}
+			}
+
+			const ElementType *m_words = nullptr;
+			int64_t m_numWords		   = 0;
+			int64_t m_wordIndex		   = 0;
+			ElementType m_word		   = 0;
+		};
+
+		/// A range over the indices of the set bits in a Mask. See Mask::setIndices()
+		class SetIndexRange {
+		public:
+			SetIndexRange(const ElementType *words, int64_t numWords) :
+					m_words(words), m_numWords(numWords) {}
+
+			LIBRAPID_NODISCARD SetIndexIterator begin() const {
+				return SetIndexIterator(m_words, m_numWords, 0);
+			}
+
+			LIBRAPID_NODISCARD SetIndexIterator end() const {
+				return SetIndexIterator(m_words, m_numWords, m_numWords);
+			}
+
+		private:
+			const ElementType *m_words;
+			int64_t m_numWords;
+		};
+
+		/// Construct an empty Mask
+		Mask() = default;
+
+		/// Construct a Mask with the given shape, with every element set to `value`
+		/// \param shape The shape of the Mask
+		/// \param value The initial value of every element
+		explicit Mask(const ShapeType &shape, bool value = false) :
+				m_shape(shape), m_size(static_cast<int64_t>(shape.size())),
+				m_data(numWordsFor(m_size), value ? ~ElementType(0) : ElementType(0)) {
+			clearHighBits();
+		}
+
+		/// Construct a Mask from an array or expression. Element i is set if the i'th element of
+		/// the expression is nonzero (or true, for comparisons). Comparisons evaluated on the
+		/// host are converted to bits one packet at a time, without creating a temporary array
+		/// \tparam T The type of the expression
+		/// \param expr The expression to evaluate
+		template<typename T>
+			requires(typetraits::TypeInfo<std::decay_t<T>>::type ==
+					   detail::LibRapidType::ArrayContainer ||
+					 typetraits::TypeInfo<std::decay_t<T>>::type ==
+					   detail::LibRapidType::ArrayFunction)
+		explicit Mask(const T &expr) : Mask(ShapeType(expr.shape())) {
+			if constexpr (typetraits::TypeInfo<T>::type == detail::LibRapidType::ArrayFunction &&
+						  !std::is_same_v<typename typetraits::TypeInfo<T>::Backend,
+										  backend::CPU>) {
+				// Evaluate on the device first, rather than evaluating each element separately
+				fill(expr.eval());
+			} else {
+				fill(expr);
+			}
+		}
+
+		Mask(const Mask &other)				   = default;
+		Mask(Mask &&other) noexcept			   = default;
+		Mask &operator=(const Mask &other)	   = default;
+		Mask &operator=(Mask &&other) noexcept = default;
+
+		/// \return The shape of the Mask
+		LIBRAPID_NODISCARD const ShapeType &shape() const { return m_shape; }
+
+		/// \return The number of elements in the Mask
+		LIBRAPID_NODISCARD int64_t size() const { return m_size; }
+
+		/// \return The number of 64-bit words used to store the Mask
+		LIBRAPID_NODISCARD int64_t numWords() const { return static_cast<int64_t>(m_data.size()); }
+
+		/// \return A pointer to the packed words
+		LIBRAPID_NODISCARD const ElementType *data() const { return m_data.data(); }
+		LIBRAPID_NODISCARD ElementType *data() { return m_data.data(); }
+
+		/// Return the value of an element, without bounds checking. This allows a Mask to be
+		/// passed to element-wise functions, such as where()
+		/// \param index The (flat) index of the element
+		/// \return True if the element is set
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool scalar(size_t index) const {
+			return (m_data[index / bitsPerElement] >> (index % bitsPerElement)) & 1;
+		}
+
+		/// Expand `Packet::size` elements, starting at `index`, into a packet of booleans
+		/// \tparam Packet The packet type whose boolean packet is returned
+		/// \param index The (flat) index of the first element
+		/// \return The expanded packet
+		template<typename Packet>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packetBool(size_t index) const {
+			using PacketBool	= typename Packet::batch_bool_type;
+			const size_t word	= index / bitsPerElement;
+			const size_t offset = index % bitsPerElement;
+
+			ElementType bits = m_data[word] >> offset;
+			if (offset + Packet::size > static_cast<size_t>(bitsPerElement)) {
+				// The packet spans two words (only possible if index is not a multiple of the
+				// packet width)
+				bits |= m_data[word + 1] << (bitsPerElement - offset);
+			}
+
+			return PacketBool::from_mask(bits);
+		}
+
+		/// Expand `Packet::size` elements, starting at `index`, into a packet of zeros and ones
+		/// \tparam Packet The packet type to return
+		/// \param index The (flat) index of the first element
+		/// \return The expanded packet
+		template<typename Packet>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Packet packet(size_t index) const {
+			using Scalar = typename Packet::value_type;
+			return xsimd::select(packetBool<Packet>(index), Packet(Scalar(1)), Packet(Scalar(0)));
+		}
+
+		/// Return the value of an element
+		/// \param index The (flat) index of the element
+		/// \return True if the element is set
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool get(int64_t index) const {
+			checkIndex(index);
+			return scalar(static_cast<size_t>(index));
+		}
+
+		/// Set the value of an element
+		/// \param index The (flat) index of the element
+		/// \param value The value to set
+		/// \return A reference to this Mask
+		LIBRAPID_ALWAYS_INLINE Mask &set(int64_t index, bool value = true) {
+			checkIndex(index);
+			const ElementType bit = ElementType(1) << (index % bitsPerElement);
+			if (value) {
+				m_data[index / bitsPerElement] |= bit;
+			} else {
+				m_data[index / bitsPerElement] &= ~bit;
+			}
+			return *this;
+		}
+
+		/// \return The number of set elements, counted with popcount
+		LIBRAPID_NODISCARD int64_t countNonzero() const {
+			int64_t res = 0;
+			for (const ElementType word : m_data) { res += std::popcount(word); }
+			return res;
+		}
+
+		/// \return True if any element is set
+		LIBRAPID_NODISCARD bool any() const {
+			for (const ElementType word : m_data) {
+				if (word) return true;
+			}
+			return false;
+		}
+
+		/// \return True if every element is set
+		LIBRAPID_NODISCARD bool all() const { return countNonzero() == m_size; }
+
+		/// \return True if no elements are set
+		LIBRAPID_NODISCARD bool none() const { return !any(); }
+
+		/// Return a range over the indices of the set elements, in increasing order
+		/// \return A SetIndexRange
+		LIBRAPID_NODISCARD SetIndexRange setIndices() const {
+			return SetIndexRange(m_data.data(), numWords());
+		}
+
+		LIBRAPID_NODISCARD Mask operator&(const Mask &other) const {
+			return combine(other, [](const auto &a, const auto &b) { return a & b; });
+		}
+
+		LIBRAPID_NODISCARD Mask operator|(const Mask &other) const {
+			return combine(other, [](const auto &a, const auto &b) { return a | b; });
+		}
+
+		LIBRAPID_NODISCARD Mask operator^(const Mask &other) const {
+			return combine(other, [](const auto &a, const auto &b) { return a ^ b; });
+		}
+
+		LIBRAPID_NODISCARD Mask operator~() const {
+			Mask res(*this);
+			apply(res.m_data.data(),
+				  m_data.data(),
+				  m_data.data(),
+				  numWords(),
+				  [](const auto &a, const auto &) { return ~a; });
+			res.clearHighBits();
+			return res;
+		}
+
+		Mask &operator&=(const Mask &other) { return *this = *this & other; }
+		Mask &operator|=(const Mask &other) { return *this = *this | other; }
+		Mask &operator^=(const Mask &other) { return *this = *this ^ other; }
+
+		LIBRAPID_NODISCARD bool operator==(const Mask &other) const {
+			return m_size == other.m_size && m_data == other.m_data;
+		}
+
+		LIBRAPID_NODISCARD bool operator!=(const Mask &other) const { return !(*this == other); }
+
+	private:
+		LIBRAPID_NODISCARD static int64_t numWordsFor(int64_t size) {
+			return (size + bitsPerElement - 1) / bitsPerElement;
+		}
+
+		/// Throw std::out_of_range if `index` is not a valid element index. This is checked in
+		/// every build, since an invalid index would access memory outside the Mask
+		void checkIndex(int64_t index) const {
+			if (index < 0 || index >= m_size) {
+				throw std::out_of_range(
+				  fmt::format("Mask index {} out of range for size {}", index, m_size));
+			}
+		}
+
+		/// Clear the bits past the end of the Mask, so they never appear in popcounts or set
+		/// index iteration
+		void clearHighBits() {
+			if (m_size % bitsPerElement != 0) {
+				m_data.back() &= (ElementType(1) << (m_size % bitsPerElement)) - 1;
+			}
+		}
+
+		/// Apply a bitwise operation to n words, one packet of words at a time
+		template<typename Op>
+		static void apply(ElementType *out, const ElementType *a, const ElementType *b, int64_t n,
+						  Op &&op) {
+			using Packet		   = typename typetraits::TypeInfo<ElementType>::Packet;
+			constexpr int64_t step = Packet::size;
+
+			int64_t i = 0;
+			for (; i + step <= n; i += step) {
+				op(Packet::load_unaligned(a + i), Packet::load_unaligned(b + i))
+				  .store_unaligned(out + i);
+			}
+			for (; i < n; ++i) { out[i] = op(a[i], b[i]); }
+		}
+
+		template<typename Op>
+		LIBRAPID_NODISCARD Mask combine(const Mask &other, Op &&op) const {
+			if (m_size != other.m_size) {
+				throw std::range_error(
+				  fmt::format("Mask sizes must match. {} vs {}", m_shape, other.m_shape));
+			}
+			Mask res(m_shape);
+			apply(res.m_data.data(), m_data.data(), other.m_data.data(), numWords(), op);
+			return res;
+		}
+
+		/// Fill one word from the elements [begin, begin + count) of an expression
+		template<typename T>
+		LIBRAPID_NODISCARD static ElementType fillWord(const T &expr, int64_t begin,
+													   int64_t count) {
+			ElementType word = 0;
+			int64_t i		 = 0;
+
+			if constexpr (detail::maskAllowsVectorisation<T>()) {
+				// Packets hold a power of two elements (at most 64), so they never straddle
+				// two words
+				using Packet = std::decay_t<decltype(expr.packet(0))>;
+				constexpr int64_t packetWidth = Packet::size;
+				for (; i + packetWidth <= count; i += packetWidth) {
+					word |= detail::maskPacketBits(expr, begin + i) << i;
+				}
+			}
+
+			for (; i < count; ++i) {
+				using Scalar = typename typetraits::TypeInfo<T>::Scalar;
+				if (expr.scalar(begin + i) != Scalar(0)) { word |= ElementType(1) << i; }
+			}
+
+			return word;
+		}
+
+		template<typename T>
+		void fill(const T &expr) {
+			const int64_t numWords = this->numWords();
+			const int64_t size	   = m_size;
+			ElementType *data	   = m_data.data();
+
+			auto fillWords = [&](int64_t begin, int64_t end) {
+				for (int64_t w = begin; w < end; ++w) {
+					const int64_t first = w * bitsPerElement;
+					data[w] = fillWord(expr, first, ::librapid::min(bitsPerElement, size - first));
+				}
+			};
+
+			if (static_cast<size_t>(size) > global::multithreadThreshold &&
+				global::numThreads > 1) {
+				// Each thread writes whole words, so no synchronisation is needed
+#pragma omp parallel for shared(numWords, fillWords) default(none)                                 \
+  num_threads(int(global::numThreads))
+				for (int64_t w = 0; w < numWords; ++w) { fillWords(w, w + 1); }
+			} else {
+				fillWords(0, numWords);
+			}
+		}
+
+		ShapeType m_shape;
+		int64_t m_size = 0;
+		std::vector<ElementType> m_data;
+	};
+
+	namespace typetraits {
+		template<>
+		struct TypeInfo<Mask> {
+			static constexpr detail::LibRapidType type = detail::LibRapidType::Mask;
+			using Scalar							   = bool;
+			using Packet							   = std::false_type;
+			using Backend							   = backend::CPU;
+			using ShapeType							   = Shape;
+			static constexpr int64_t packetWidth	   = 1;
+			static constexpr bool supportsArithmetic   = false;
+			static constexpr bool supportsLogical	   = true;
+			static constexpr bool supportsBinary	   = true;
+			static constexpr bool allowVectorisation   = true;
+			static constexpr bool canAlign			   = false;
+			static constexpr int64_t canMemcpy		   = false;
+		};
+	} // namespace typetraits
+
+	namespace detail {
+		template<>
+		struct IsArrayType<Mask> {
+			static constexpr bool val = true;
+		};
+	} // namespace detail
+
+	/// Count the set elements of a Mask
+	/// \param mask The Mask
+	/// \return The number of set elements
+	LIBRAPID_NODISCARD inline int64_t countNonzero(const Mask &mask) {
+		return mask.countNonzero();
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_MASK_HPP
@@ -6,7 +6,12 @@
 		template<typename T, typename V>                                                           \
 		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const T &lhs,                    \
 																  const V &rhs) const {            \
-			return lhs OP_ rhs;                                                                    \
+			if constexpr (typetraits::CanPromote<T, V>) {                                          \
+				using Type = typetraits::Promote_t<T, V>;                                          \
+				return static_cast<Type>(static_cast<Type>(lhs) OP_ static_cast<Type>(rhs));       \
+			} else {                                                                               \
+				return lhs OP_ rhs;                                                                \
+			}                                                                                      \
 		}                                                                                          \
                                                                                                    \
 		template<typename Packet>                                                                  \
@@ -21,13 +26,30 @@
 		template<typename T, typename V>                                                           \
 		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const T &lhs,                    \
 																  const V &rhs) const {            \
-			return (typename std::common_type_t<T, V>)(lhs OP_ rhs);                               \
+			if constexpr (typetraits::CanPromote<T, V>) {                                          \
+				using Type = typetraits::Promote_t<T, V>;                                          \
+				return static_cast<Type>(static_cast<Type>(lhs) OP_ static_cast<Type>(rhs));       \
+			} else {                                                                               \
+				return (typename std::common_type_t<T, V>)(lhs OP_ rhs);                           \
+			}                                                                                      \
 		}                                                                                          \
                                                                                                    \
 		template<typename Packet>                                                                  \
 		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packet(const Packet &lhs,                   \
 															  const Packet &rhs) const {           \
-			return Packet(lhs OP_ rhs);                                                            \
+			if constexpr (typetraits::IsComplexSIMD<Packet>::value) {                              \
+				using Real = typename Packet::real_batch;                                          \
+				return Packet(xsimd::select(lhs OP_ rhs, Real(1), Real(0)));                       \
+			} else {                                                                               \
+				return Packet(lhs OP_ rhs);                                                        \
+			}                                                                                      \
+		}                                                                                          \
+                                                                                                   \
+		/* Compare two packets, returning the xsimd::batch_bool (used to build packed masks) */    \
+		template<typename Packet>                                                                  \
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packetMask(const Packet &lhs,               \
+																  const Packet &rhs) const {       \
+			return lhs OP_ rhs;                                                                    \
 		}                                                                                          \
 	}
 
@@ -178,6 +200,26 @@ namespace librapid {
 		LIBRAPID_UNARY_FUNCTOR(Floor, ::librapid::floor); // floor(a)
 		LIBRAPID_UNARY_FUNCTOR(Ceil, ::librapid::ceil);	  // ceil(a)
 
+		LIBRAPID_UNARY_FUNCTOR(Conj, ::librapid::conj); // conj(a)
+		LIBRAPID_UNARY_FUNCTOR(Arg, ::librapid::arg);	// arg(a)
+
+		// polar(rho, theta). On the packet path, both arguments arrive as complex packets with
+		// a zero imaginary component
+		struct Polar {
+			template<typename T, typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const T &rho,
+																	  const V &theta) const {
+				using Type = typetraits::Promote_t<T, V>;
+				return ::librapid::polar(static_cast<Type>(rho), static_cast<Type>(theta));
+			}
+
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packet(const Packet &rho,
+																  const Packet &theta) const {
+				return Packet(xsimd::polar(rho.real(), theta.real()));
+			}
+		};
+
 	} // namespace detail
 
 	namespace typetraits {
@@ -591,6 +633,30 @@ namespace librapid {
 			LIBRAPID_UNARY_KERNEL_GETTER
 			LIBRAPID_UNARY_SHAPE_EXTRACTOR
 		};
+
+		template<>
+		struct TypeInfo<::librapid::detail::Conj> {
+			static constexpr const char *name		= "conjugate";
+			static constexpr const char *filename	= "complex";
+			static constexpr const char *kernelName = "conj";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+
+		template<>
+		struct TypeInfo<::librapid::detail::Arg> {
+			static constexpr const char *name		= "argument";
+			static constexpr const char *filename	= "complex";
+			static constexpr const char *kernelName = "arg";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+
+		template<>
+		struct TypeInfo<::librapid::detail::Polar> {
+			static constexpr const char *name		= "polar";
+			static constexpr const char *filename	= "complex";
+			static constexpr const char *kernelName = "polar";
+			LIBRAPID_BINARY_SHAPE_EXTRACTOR
+		};
 	} // namespace typetraits
 
 	namespace detail {
@@ -1278,6 +1344,109 @@ namespace librapid {
 		return detail::makeFunction<typetraits::DescriptorType_t<VAL>, detail::Ceil>(
 		  std::forward<VAL>(val));
 	}
+
+	/// \brief Compute the complex conjugate of each element in the array
+	///
+	/// \f$R = \{ R_0, R_1, R_2, ... \} \f$ \text{ where } \f$R_i = \overline{A_i}\f$
+	///
+	/// \tparam VAL Type of the input
+	/// \param val The input array or function
+	/// \return Conjugate function object
+	template<class VAL>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto conj(VAL &&val)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>, detail::Conj, VAL> {
+		return detail::makeFunction<typetraits::DescriptorType_t<VAL>, detail::Conj>(
+		  std::forward<VAL>(val));
+	}
+
+	/// \brief Compute the argument (phase angle) of each element in a complex array
+	///
+	/// \f$R = \{ R_0, R_1, R_2, ... \} \f$ \text{ where } \f$R_i = \arg(A_i)\f$
+	///
+	/// The result has the same (complex) type as the input, with a zero imaginary component.
+	///
+	/// \tparam VAL Type of the input
+	/// \param val The input array or function
+	/// \return Argument function object
+	template<class VAL>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto arg(VAL &&val)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>, detail::Arg, VAL> {
+		return detail::makeFunction<typetraits::DescriptorType_t<VAL>, detail::Arg>(
+		  std::forward<VAL>(val));
+	}
+
+	/// \brief Construct a complex array from magnitudes and phase angles
+	///
+	/// \f$R = \{ R_0, R_1, R_2, ... \} \f$ \text{ where } \f$R_i = \rho_i e^{i \theta_i}\f$
+	///
+	/// Either argument may be a scalar.
+	///
+	/// \tparam RHO Type of the magnitudes
+	/// \tparam THETA Type of the phase angles
+	/// \param rho The magnitudes
+	/// \param theta The phase angles
+	/// \return Polar function object
+	template<class RHO, class THETA>
+		requires(detail::IsArrayOpArray<RHO, THETA> || detail::IsArrayOpWithScalar<RHO, THETA>)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto polar(RHO &&rho, THETA &&theta)
+	  -> detail::Function<typetraits::DescriptorType_t<RHO, THETA>, detail::Polar, RHO, THETA> {
+		return detail::makeFunction<typetraits::DescriptorType_t<RHO, THETA>, detail::Polar>(
+		  std::forward<RHO>(rho), std::forward<THETA>(theta));
+	}
+
+	// There are no device kernels for conj(), arg() and polar(), so they are evaluated on the host
+	// (see mapAssignOnHost() in map.hpp)
+#if defined(LIBRAPID_HAS_OPENCL)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Conj, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Arg, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Polar, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL
+
+#if defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Conj, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Arg, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Polar, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_CUDA
 } // namespace librapid
 
 #endif // LIBRAPID_ARRAY_OPERATIONS_HPP
\ No newline at end of file
@@ -0,0 +1,277 @@
+#ifndef LIBRAPID_ARRAY_QUANTILE_HPP
+#define LIBRAPID_ARRAY_QUANTILE_HPP
+
+/*
+ * Quantiles along an axis: quantile(), percentile() and median().
+ *
+ * The quantile q of a row of n values lies at the (virtual) position h = q * (n - 1) of the
+ * sorted row, and is found from the elements at positions floor(h) and ceil(h), as selected by
+ * a QuantileMethod. Rather than sorting the row, only the elements at the positions needed by
+ * every requested quantile are selected: the middle position is selected with introselect
+ * (std::nth_element), which partitions the row around it, and the positions on either side
+ * are then selected recursively within their own part. m quantiles of n values take
+ * O(n log m) time, and a single quantile O(n).
+ *
+ * Rows along the axis are copied into a buffer and processed in parallel. As with NumPy, the
+ * quantiles of a row containing a NaN are NaN.
+ */
+
+namespace librapid {
+	/// How a quantile between two elements of the sorted data is computed. `i` and `j` are the
+	/// positions of the elements either side of the quantile, with fractional position `h`
+	enum class QuantileMethod {
+		Linear,	 ///< Interpolate linearly between elements i and j
+		Lower,	 ///< Element i
+		Higher,	 ///< Element j
+		Nearest, ///< Whichever of elements i and j is nearest (i if `h` is halfway, and even)
+		Midpoint ///< The mean of elements i and j
+	};
+
+	namespace detail {
+		/// The type of the quantiles of values of type T. Integers give double quantiles
+		template<typename T>
+		using QuantileScalar = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+
+		/// Rearrange `data[begin:end]` so that the element at each of the `count` (sorted)
+		/// positions is the one which would be there if the range were sorted
+		template<typename Scalar>
+		void multiSelect(Scalar *data, int64_t begin, int64_t end, const int64_t *positions,
+						 int64_t count) {
+			if (count == 0 || end - begin < 2) return;
+
+			// Partition around the middle position, then select the others within the side
+			// of the partition containing them
+			const int64_t mid = count / 2;
+			const int64_t kth = positions[mid];
+			std::nth_element(data + begin, data + kth, data + end, SortLess());
+			multiSelect(data, begin, kth, positions, mid);
+			multiSelect(data, kth + 1, end, positions + mid + 1, count - mid - 1);
+		}
+
+		/// Compute quantile `q` of `n` values, where the elements at positions floor(h) and
+		/// ceil(h) (for h = q * (n - 1)) have been selected
+		template<typename Out, typename Scalar>
+		LIBRAPID_NODISCARD Out quantileValue(const Scalar *selected, int64_t n, double q,
+											 QuantileMethod method) {
+			const double h	 = q * static_cast<double>(n - 1);
+			const int64_t lo = static_cast<int64_t>(std::floor(h));
+			const int64_t hi = static_cast<int64_t>(std::ceil(h));
+			const Out a		 = static_cast<Out>(selected[lo]);
+			const Out b		 = static_cast<Out>(selected[hi]);
+			const double t	 = h - static_cast<double>(lo);
+
+			switch (method) {
+				case QuantileMethod::Lower: return a;
+				case QuantileMethod::Higher: return b;
+				case QuantileMethod::Nearest:
+					if (t == 0.5) return lo % 2 == 0 ? a : b;
+					return t < 0.5 ? a : b;
+				case QuantileMethod::Midpoint:
+					if (lo == hi) return a;
+					if (std::isinf(a) || std::isinf(b)) return a + b;
+					return a + (b - a) / Out(2);
+				default:
+					// An element on its own is returned exactly (b - a may be NaN if it is
+					// infinite), and an infinite element dominates the interpolation (opposite
+					// infinities give NaN)
+					if (lo == hi) return a;
+					if (std::isinf(a) || std::isinf(b)) return a + b;
+
+					// Interpolate from the nearer element, so that t = 1 gives exactly b
+					if (t >= 0.5) return b - (b - a) * static_cast<Out>(1 - t);
+					return a + (b - a) * static_cast<Out>(t);
+			}
+		}
+
+		/// Compute the quantiles `qs` of each row of an array along `axis`. Quantile i of row r
+		/// is written to `out[outLayout.base(r) + i * outLayout.inner]`, where `outLayout` has
+		/// the rows of the input with an extent of `qs.size()`
+		template<typename ShapeType, typename Scalar>
+		void quantileImpl(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+						  const std::vector<double> &qs, int64_t axis, QuantileMethod method,
+						  QuantileScalar<Scalar> *out) {
+			using Out			   = QuantileScalar<Scalar>;
+			const RowLayout layout = rowLayout(array.shape(), axis);
+			const int64_t n		   = layout.extent;
+			const int64_t numQs	   = static_cast<int64_t>(qs.size());
+			const RowLayout outLayout {layout.numRows, numQs, layout.inner};
+
+			// The positions of the elements needed by every quantile, in ascending order
+			std::vector<int64_t> positions;
+			for (const double q : qs) {
+				// Checked in every build, since the positions index into each row
+				if (!(q >= 0 && q <= 1)) {
+					throw std::invalid_argument(
+					  fmt::format("Quantiles must be in the range [0, 1]. Received {}", q));
+				}
+				const double h = q * static_cast<double>(n - 1);
+				positions.push_back(static_cast<int64_t>(std::floor(h)));
+				positions.push_back(static_cast<int64_t>(std::ceil(h)));
+			}
+			std::sort(positions.begin(), positions.end());
+			positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+
+			const Scalar *src = array.storage().data();
+
+			// Find the quantiles of one row, using `buffer` (n elements) as scratch space
+			auto quantileRow = [&](int64_t row, Scalar *buffer) {
+				Out *rowOut = out + outLayout.base(row);
+				if (n == 0) {
+					for (int64_t i = 0; i < numQs; ++i) {
+						rowOut[i * layout.inner] = std::numeric_limits<Out>::quiet_NaN();
+					}
+					return;
+				}
+
+				const Scalar *rowData = src + layout.base(row);
+				bool hasNan			  = false;
+				for (int64_t j = 0; j < n; ++j) {
+					buffer[j] = rowData[j * layout.inner];
+					if constexpr (std::is_floating_point_v<Scalar>) {
+						hasNan |= buffer[j] != buffer[j];
+					}
+				}
+
+				if (hasNan) {
+					for (int64_t i = 0; i < numQs; ++i) {
+						rowOut[i * layout.inner] = std::numeric_limits<Out>::quiet_NaN();
+					}
+					return;
+				}
+
+				multiSelect(buffer, 0, n, positions.data(), static_cast<int64_t>(positions.size()));
+				for (int64_t i = 0; i < numQs; ++i) {
+					rowOut[i * layout.inner] = quantileValue<Out>(buffer, n, qs[i], method);
+				}
+			};
+
+			// Rows are split into one chunk per thread, and each chunk copies its rows into its
+			// own buffer, which is freed when the call returns
+			const int64_t work = layout.numRows * n;
+			const bool parallel =
+			  static_cast<size_t>(work) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numChunks =
+			  parallel ? ::librapid::min(static_cast<int64_t>(global::numThreads), layout.numRows)
+					   : int64_t(1);
+			indexingFor(numChunks, parallel ? work : 0, [&](int64_t chunk) {
+				std::vector<Scalar> buffer(n);
+				const int64_t end = (chunk + 1) * layout.numRows / numChunks;
+				for (int64_t row = chunk * layout.numRows / numChunks; row < end; ++row) {
+					quantileRow(row, buffer.data());
+				}
+			});
+		}
+	} // namespace detail
+
+	/// \brief Compute several quantiles along an axis
+	///
+	/// The result has the shape of `array`, with the length of `axis` replaced by the number of
+	/// quantiles. Every quantile of a row is found in one selection pass, without sorting the
+	/// row.
+	///
+	/// \code{.cpp}
+	/// // p50, p95 and p99 of each row of a [services, requests] matrix of latencies
+	/// auto tail = lrc::quantile(latencies, {0.5, 0.95, 0.99}); // [services, 3]
+	/// \endcode
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array
+	/// \param qs The quantiles to compute, each in the range [0, 1]
+	/// \param axis The axis to compute the quantiles along (negative values count from the end)
+	/// \param method How to compute quantiles which lie between two elements
+	/// \return The quantiles (double for integer arrays)
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto quantile(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									 const std::vector<double> &qs, int64_t axis = -1,
+									 QuantileMethod method = QuantileMethod::Linear)
+	  -> Array<detail::QuantileScalar<Scalar>, backend::CPU> {
+		const int64_t normAxis = std::get<0>(detail::splitAxis(array.shape(), axis));
+		Array<detail::QuantileScalar<Scalar>, backend::CPU> result(
+		  detail::replaceAxis(array.shape(), normAxis, static_cast<int64_t>(qs.size())));
+		detail::quantileImpl(array, qs, axis, method, result.storage().data());
+		return result;
+	}
+
+	/// \brief Compute a quantile along an axis
+	///
+	/// The result has the shape of `array` with `axis` removed.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array
+	/// \param q The quantile to compute, in the range [0, 1]
+	/// \param axis The axis to compute the quantile along (negative values count from the end)
+	/// \param method How to compute a quantile which lies between two elements
+	/// \return The quantile of each row (double for integer arrays)
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto quantile(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									 double q, int64_t axis = -1,
+									 QuantileMethod method = QuantileMethod::Linear)
+	  -> Array<detail::QuantileScalar<Scalar>, backend::CPU> {
+		const int64_t normAxis = std::get<0>(detail::splitAxis(array.shape(), axis));
+		Array<detail::QuantileScalar<Scalar>, backend::CPU> result(
+		  detail::replaceAxis(array.shape(), normAxis, -1));
+		detail::quantileImpl(array, {q}, axis, method, result.storage().data());
+		return result;
+	}
+
+	/// \brief Compute several percentiles along an axis
+	///
+	/// Equivalent to quantile() with each percentile divided by 100.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array
+	/// \param ps The percentiles to compute, each in the range [0, 100]
+	/// \param axis The axis to compute the percentiles along (negative values count from the
+	/// end)
+	/// \param method How to compute percentiles which lie between two elements
+	/// \return The percentiles (double for integer arrays)
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto
+	percentile(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+			   const std::vector<double> &ps, int64_t axis = -1,
+			   QuantileMethod method = QuantileMethod::Linear)
+	  -> Array<detail::QuantileScalar<Scalar>, backend::CPU> {
+		std::vector<double> qs(ps.size());
+		std::transform(ps.begin(), ps.end(), qs.begin(), [](double p) { return p / 100; });
+		return quantile(array, qs, axis, method);
+	}
+
+	/// \brief Compute a percentile along an axis
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array
+	/// \param p The percentile to compute, in the range [0, 100]
+	/// \param axis The axis to compute the percentile along (negative values count from the
+	/// end)
+	/// \param method How to compute a percentile which lies between two elements
+	/// \return The percentile of each row (double for integer arrays)
+	/// \see quantile()
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto
+	percentile(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array, double p,
+			   int64_t axis = -1, QuantileMethod method = QuantileMethod::Linear)
+	  -> Array<detail::QuantileScalar<Scalar>, backend::CPU> {
+		return quantile(array, p / 100, axis, method);
+	}
+
+	/// \brief Compute the median along an axis
+	///
+	/// The median of an even number of values is the mean of the middle two.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array
+	/// \param axis The axis to compute the median along (negative values count from the end)
+	/// \return The median of each row (double for integer arrays)
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto median(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								   int64_t axis = -1)
+	  -> Array<detail::QuantileScalar<Scalar>, backend::CPU> {
+		return quantile(array, 0.5, axis, QuantileMethod::Midpoint);
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_QUANTILE_HPP
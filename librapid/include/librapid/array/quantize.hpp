@@ -0,0 +1,444 @@
+#ifndef LIBRAPID_ARRAY_QUANTIZE_HPP
+#define LIBRAPID_ARRAY_QUANTIZE_HPP
+
+/*
+ * Affine quantization of floating point arrays to 8-bit integers, used to shrink weight
+ * matrices (and the memory bandwidth needed to read them) for inference. A real value x is
+ * represented by the integer
+ *
+ *     q = clamp(round(x / scale) + zeroPoint, qmin, qmax)
+ *
+ * and is recovered, approximately, as (q - zeroPoint) * scale. int8_t uses the symmetric range
+ * [-127, 127] with a zero point of 0, and uint8_t uses [0, 255] with a zero point chosen so that
+ * 0 is represented exactly.
+ *
+ * Quantized matrices are multiplied with integer kernels which accumulate exactly in 32 bits
+ * (see detail::cpu::gemmInt8), and the results are rescaled or requantized as they are stored.
+ */
+
+namespace librapid {
+	/// The scale and zero point of an affine quantization
+	struct QuantizationParams {
+		float scale		  = 1.0f;
+		int32_t zeroPoint = 0;
+	};
+
+	/// Whether a QuantizedMatrix uses one set of QuantizationParams, or one per row
+	enum class QuantizationGranularity { PerTensor, PerRow };
+
+	namespace detail {
+		/// The range of integers used to represent quantized values of type T
+		template<typename T>
+		struct QuantizedRange;
+
+		template<>
+		struct QuantizedRange<int8_t> {
+			static constexpr int32_t min = -127;
+			static constexpr int32_t max = 127;
+		};
+
+		template<>
+		struct QuantizedRange<uint8_t> {
+			static constexpr int32_t min = 0;
+			static constexpr int32_t max = 255;
+		};
+
+		/// Quantize a single value. NaNs are mapped to the zero point
+		/// \tparam T The quantized type
+		/// \param val The value to quantize
+		/// \param params The quantization parameters
+		/// \return The quantized value
+		template<typename T>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE T
+		quantizeScalar(float val, const QuantizationParams &params) {
+			if (val != val) { return static_cast<T>(params.zeroPoint); }
+			const float q = std::nearbyint(val / params.scale) + float(params.zeroPoint);
+			return static_cast<T>(::librapid::clamp(
+			  q, float(QuantizedRange<T>::min), float(QuantizedRange<T>::max)));
+		}
+
+		/// Functor quantizing each element of its argument to type T
+		/// \tparam T The quantized type
+		template<typename T>
+		struct Quantize {
+			QuantizationParams params;
+
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const V &val) const -> T {
+				return quantizeScalar<T>(static_cast<float>(val), params);
+			}
+		};
+
+		/// Functor converting each element of its argument from its quantized representation
+		struct Dequantize {
+			QuantizationParams params;
+
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const V &val) const
+			  -> float {
+				return (static_cast<float>(val) - float(params.zeroPoint)) * params.scale;
+			}
+
+			// The argument has already been converted to a float packet by packetExtractor
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto packet(const Packet &val) const {
+				return (val - Packet(float(params.zeroPoint))) * Packet(params.scale);
+			}
+		};
+	} // namespace detail
+
+	namespace typetraits {
+		template<typename T>
+		struct TypeInfo<::librapid::detail::Quantize<T>> {
+			static constexpr const char *name		= "quantize";
+			static constexpr const char *filename	= "quantize";
+			static constexpr const char *kernelName = "quantize";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+
+		template<>
+		struct TypeInfo<::librapid::detail::Dequantize> {
+			static constexpr const char *name		= "dequantize";
+			static constexpr const char *filename	= "dequantize";
+			static constexpr const char *kernelName = "dequantize";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+
+		// Quantization narrows floats to bytes, which can't be done within one packet type
+		template<typename T, typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Quantize<T>, Args...>
+				: std::false_type {};
+	} // namespace typetraits
+
+	/// \brief Choose quantization parameters for values in a range
+	///
+	/// The range is first extended to include zero, so that zero is always represented exactly.
+	/// For int8_t, the parameters are symmetric (the zero point is 0).
+	///
+	/// \tparam T The quantized type (int8_t or uint8_t)
+	/// \param minVal The smallest value to represent
+	/// \param maxVal The largest value to represent
+	/// \return The quantization parameters
+	template<typename T>
+	LIBRAPID_NODISCARD QuantizationParams quantizationParams(float minVal, float maxVal) {
+		minVal = ::librapid::min(minVal, 0.0f);
+		maxVal = ::librapid::max(maxVal, 0.0f);
+
+		if constexpr (std::is_same_v<T, int8_t>) {
+			const float absMax = ::librapid::max(-minVal, maxVal);
+			return {absMax > 0 ? absMax / 127.0f : 1.0f, 0};
+		} else {
+			static_assert(std::is_same_v<T, uint8_t>, "Quantized type must be int8_t or uint8_t");
+			const float range = maxVal - minVal;
+			if (range <= 0) { return {1.0f, 0}; }
+
+			const float scale = range / 255.0f;
+			return {scale, ::librapid::clamp(int32_t(std::nearbyint(-minVal / scale)), 0, 255)};
+		}
+	}
+
+	/// \brief Quantize each element of an array
+	///
+	/// Returns a lazily evaluated function object, so it can be fused into a larger expression
+	/// (for example, `quantize<int8_t>(a * b, params)`).
+	///
+	/// \tparam T The quantized type (int8_t or uint8_t)
+	/// \tparam VAL Type of the input
+	/// \param val The input array or function
+	/// \param params The quantization parameters
+	/// \return Quantize function object
+	/// \see quantizationParams()
+	template<typename T, class VAL>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto quantize(VAL &&val,
+															const QuantizationParams &params)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>, detail::Quantize<T>, VAL> {
+		using Functor = detail::Quantize<T>;
+		return detail::Function<typetraits::DescriptorType_t<VAL>, Functor, VAL>(
+		  Functor {params}, std::forward<VAL>(val));
+	}
+
+	/// \brief Convert each element of a quantized array back to a float
+	///
+	/// Returns a lazily evaluated function object. On the host, this is vectorised.
+	///
+	/// \tparam VAL Type of the input
+	/// \param val The quantized array or function
+	/// \param params The quantization parameters used to create `val`
+	/// \return Dequantize function object
+	template<class VAL>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto dequantize(VAL &&val,
+															  const QuantizationParams &params)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>, detail::Dequantize, VAL> {
+		using Functor = detail::Dequantize;
+		return detail::Function<typetraits::DescriptorType_t<VAL>, Functor, VAL>(
+		  Functor {params}, std::forward<VAL>(val));
+	}
+
+	/// \brief A row-major matrix of 8-bit integers with per-tensor or per-row quantization
+	///
+	/// Quantizing each row separately (for example, each output channel of a weight matrix)
+	/// preserves more precision when the rows have very different magnitudes.
+	///
+	/// \tparam T The quantized type (int8_t or uint8_t)
+	template<typename T>
+	class QuantizedMatrix {
+	public:
+		static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, uint8_t>,
+					  "QuantizedMatrix requires int8_t or uint8_t elements");
+
+		using Scalar	= T;
+		using ArrayType = Array<T, backend::CPU>;
+		using ShapeType = typename ArrayType::ShapeType;
+
+		/// Default constructor
+		QuantizedMatrix() = default;
+
+		/// Quantize a floating point matrix, choosing the parameters from the range of its
+		/// elements (or of each row)
+		/// \param matrix The matrix to quantize
+		/// \param granularity Whether to quantize the whole matrix or each row separately
+		template<typename ShapeType_, typename StorageScalar>
+		explicit QuantizedMatrix(
+		  const array::ArrayContainer<ShapeType_, Storage<StorageScalar>> &matrix,
+		  QuantizationGranularity granularity = QuantizationGranularity::PerRow);
+
+		/// Construct a QuantizedMatrix from data which has already been quantized
+		/// \param data The quantized matrix
+		/// \param params The parameters, either one for the whole matrix or one per row
+		QuantizedMatrix(ArrayType data, std::vector<QuantizationParams> params);
+
+		/// \return The number of rows
+		LIBRAPID_NODISCARD int64_t rows() const { return m_rows; }
+
+		/// \return The number of columns
+		LIBRAPID_NODISCARD int64_t cols() const { return m_cols; }
+
+		/// \return The quantized values
+		LIBRAPID_NODISCARD const ArrayType &data() const { return m_data; }
+
+		/// \return Whether the matrix is quantized per tensor or per row
+		LIBRAPID_NODISCARD QuantizationGranularity granularity() const {
+			return m_params.size() == 1 ? QuantizationGranularity::PerTensor
+										: QuantizationGranularity::PerRow;
+		}
+
+		/// Return the quantization parameters of a row
+		/// \param row The row index
+		/// \return The parameters used to quantize the row
+		LIBRAPID_NODISCARD const QuantizationParams &params(int64_t row) const {
+			return m_params[m_params.size() == 1 ? 0 : row];
+		}
+
+		/// Convert the matrix back to single precision
+		/// \return The dequantized matrix
+		LIBRAPID_NODISCARD Array<float, backend::CPU> dequantize() const;
+
+	private:
+		ArrayType m_data;
+		std::vector<QuantizationParams> m_params;
+		int64_t m_rows = 0;
+		int64_t m_cols = 0;
+	};
+
+	template<typename T>
+	template<typename ShapeType_, typename StorageScalar>
+	QuantizedMatrix<T>::QuantizedMatrix(
+	  const array::ArrayContainer<ShapeType_, Storage<StorageScalar>> &matrix,
+	  QuantizationGranularity granularity) {
+		LIBRAPID_ASSERT_WITH_EXCEPTION(std::invalid_argument,
+									   matrix.ndim() == 2,
+									   "Only matrices can be quantized. Received {} dimensions",
+									   matrix.ndim());
+
+		m_rows = static_cast<int64_t>(matrix.shape()[0]);
+		m_cols = static_cast<int64_t>(matrix.shape()[1]);
+		m_data = ArrayType(ShapeType({m_rows, m_cols}));
+
+		const auto *src = matrix.storage().begin();
+		auto *dst		= m_data.storage().begin();
+
+		// Find the range of each group of elements, then quantize them
+		const bool perRow		= granularity == QuantizationGranularity::PerRow;
+		const int64_t groups	= perRow ? m_rows : 1;
+		const int64_t groupSize = perRow ? m_cols : m_rows * m_cols;
+		m_params.resize(groups);
+
+		for (int64_t group = 0; group < groups; ++group) {
+			const int64_t begin = group * groupSize;
+
+			float minVal = 0, maxVal = 0;
+			for (int64_t i = begin; i < begin + groupSize; ++i) {
+				const float val = static_cast<float>(src[i]);
+				minVal			= ::librapid::min(minVal, val);
+				maxVal			= ::librapid::max(maxVal, val);
+			}
+
+			m_params[group] = quantizationParams<T>(minVal, maxVal);
+			for (int64_t i = begin; i < begin + groupSize; ++i) {
+				dst[i] = detail::quantizeScalar<T>(static_cast<float>(src[i]), m_params[group]);
+			}
+		}
+	}
+
+	template<typename T>
+	QuantizedMatrix<T>::QuantizedMatrix(ArrayType data, std::vector<QuantizationParams> params) :
+			m_data(std::move(data)), m_params(std::move(params)) {
+		LIBRAPID_ASSERT_WITH_EXCEPTION(std::invalid_argument,
+									   m_data.ndim() == 2,
+									   "Quantized data must be a matrix. Received {} dimensions",
+									   m_data.ndim());
+
+		m_rows = static_cast<int64_t>(m_data.shape()[0]);
+		m_cols = static_cast<int64_t>(m_data.shape()[1]);
+
+		LIBRAPID_ASSERT_WITH_EXCEPTION(
+		  std::invalid_argument,
+		  m_params.size() == 1 || static_cast<int64_t>(m_params.size()) == m_rows,
+		  "Expected 1 or {} sets of quantization parameters. Received {}",
+		  m_rows,
+		  m_params.size());
+	}
+
+	template<typename T>
+	auto QuantizedMatrix<T>::dequantize() const -> Array<float, backend::CPU> {
+		using ResultType = Array<float, backend::CPU>;
+		ResultType res(typename ResultType::ShapeType({m_rows, m_cols}));
+
+		const auto *src = m_data.storage().begin();
+		auto *dst		= res.storage().begin();
+		for (int64_t row = 0; row < m_rows; ++row) {
+			const detail::Dequantize functor {params(row)};
+			for (int64_t col = 0; col < m_cols; ++col) {
+				dst[row * m_cols + col] = functor(src[row * m_cols + col]);
+			}
+		}
+
+		return res;
+	}
+
+	namespace linalg {
+		/// \brief Multiply quantized matrices
+		///
+		/// Computes \f$ \mathbf{C} = \mathbf{X} \mathbf{W}^T \f$ for an `m x k` matrix of
+		/// activations \f$ \mathbf{X} \f$ and an `n x k` matrix of weights \f$ \mathbf{W} \f$,
+		/// with one row per output, as in a fully connected layer. Since both operands are
+		/// stored row by row, each element of the result is the dot product of two contiguous
+		/// rows, accumulated exactly in 32 bits.
+		///
+		/// The zero points and scales are applied to each accumulator before it is stored:
+		/// - If `Out` is `float`, the result is dequantized
+		/// - If `Out` is `int8_t` or `uint8_t`, the result is requantized with `outParams`
+		///
+		/// A single row of activations computes a matrix-vector product.
+		///
+		/// \tparam Out The result type
+		/// \tparam TX The type of the quantized activations (int8_t or uint8_t)
+		/// \param x The activations
+		/// \param w The weights
+		/// \param outParams The quantization parameters of the result (if `Out` is an integer)
+		/// \return The `m x n` result
+		template<typename Out = float, typename TX>
+		LIBRAPID_NODISCARD auto quantizedMatmul(const QuantizedMatrix<TX> &x,
+												const QuantizedMatrix<int8_t> &w,
+												const QuantizationParams &outParams = {})
+		  -> Array<Out, backend::CPU> {
+			static_assert(std::is_same_v<Out, float> || std::is_same_v<Out, int8_t> ||
+							std::is_same_v<Out, uint8_t>,
+						  "quantizedMatmul can only produce float, int8_t or uint8_t results");
+			LIBRAPID_ASSERT_WITH_EXCEPTION(std::invalid_argument,
+										   x.cols() == w.cols(),
+										   "Inner dimensions must match. Received {} and {}",
+										   x.cols(),
+										   w.cols());
+
+			const int64_t m = x.rows(), n = w.rows(), k = x.cols();
+			Array<Out, backend::CPU> res(typename Array<Out, backend::CPU>::ShapeType({m, n}));
+
+			// sum_p (x_ip - zx_i)(w_jp - zw_j)
+			//   = sum_p x_ip w_jp - zw_j sum_p x_ip - zx_i sum_p w_jp + k zx_i zw_j
+			// so the zero points only require the row sums of each operand
+			const auto rowSums = [k](const auto &matrix) {
+				const auto *data = matrix.data().storage().begin();
+				std::vector<int32_t> sums(matrix.rows());
+				for (int64_t i = 0; i < matrix.rows(); ++i) {
+					int32_t sum = 0;
+					for (int64_t p = 0; p < k; ++p) { sum += int32_t(data[i * k + p]); }
+					sums[i] = sum;
+				}
+				return sums;
+			};
+			const std::vector<int32_t> xSums = rowSums(x);
+			const std::vector<int32_t> wSums = rowSums(w);
+
+			detail::cpu::gemmInt8(
+			  false,
+			  true,
+			  m,
+			  n,
+			  k,
+			  x.data().storage().begin(),
+			  k,
+			  w.data().storage().begin(),
+			  k,
+			  res.storage().begin(),
+			  n,
+			  [&](int64_t i, int64_t j, int32_t acc) -> Out {
+				  const QuantizationParams &px = x.params(i);
+				  const QuantizationParams &pw = w.params(j);
+				  const int64_t exact		   = int64_t(acc) - int64_t(pw.zeroPoint) * xSums[i] -
+									   int64_t(px.zeroPoint) * wSums[j] +
+									   k * int64_t(px.zeroPoint) * int64_t(pw.zeroPoint);
+				  const float val = float(exact) * (px.scale * pw.scale);
+
+				  if constexpr (std::is_same_v<Out, float>) {
+					  return val;
+				  } else {
+					  return detail::quantizeScalar<Out>(val, outParams);
+				  }
+			  });
+
+			return res;
+		}
+	} // namespace linalg
+
+	// There are no device kernels for quantization, so it is evaluated on the host
+#if defined(LIBRAPID_HAS_OPENCL)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename T, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Quantize<T>, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Dequantize, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL
+
+#if defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename T, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Quantize<T>, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Dequantize, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_CUDA
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_QUANTIZE_HPP
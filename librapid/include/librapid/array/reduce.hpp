@@ -0,0 +1,182 @@
+#ifndef LIBRAPID_ARRAY_REDUCE_HPP
+#define LIBRAPID_ARRAY_REDUCE_HPP
+
+/*
+ * Whole-array reductions: sum() and the vector dot product, and the reproducible reduction
+ * mode.
+ *
+ * By default, a large reduction is split into one chunk per thread, each chunk is reduced with
+ * the runtime-dispatched SIMD kernels, and the partial results are added. Floating-point
+ * addition is not associative, so the result depends on global::numThreads (and on the
+ * instruction set selected at runtime).
+ *
+ * If global::reproducibleReductions is set (see setReproducibleReductions()), the data is
+ * instead split into blocks of a fixed size. Each block is reduced into a fixed number of
+ * interleaved accumulators, which are added in a fixed order, and the blocks are then added in
+ * a fixed pairwise tree. The blocks are still reduced in parallel, but neither the partitioning
+ * nor the order of any addition depends on the number of threads or the SIMD width, so the
+ * result is identical, bit for bit, for any number of threads on any processor running the
+ * same binary. The pairwise tree also keeps the rounding error to O(log n).
+ *
+ * The same mode makes RunningStats, RunningColumnStats, cumsum(), cumprod(), groupReduce() and
+ * weighted histogram(), histogram2d() and bincount() independent of the number of threads, by
+ * splitting them into reproducibleChunks() chunks, and makes ScatterStrategy::Auto behave as
+ * ScatterStrategy::Deterministic for floating-point values. Matrix products are independent
+ * of it in either mode, since each element is computed by a single thread.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// In reproducible mode, reductions are split into blocks of this many elements
+		constexpr int64_t reproducibleBlockSize = 4096;
+
+		/// In reproducible mode, each block is reduced into this many interleaved accumulators,
+		/// whatever the SIMD width. The compiler vectorises the accumulation
+		constexpr int64_t reproducibleLanes = 16;
+
+		/// In reproducible mode, reductions which keep a partial result per chunk (such as
+		/// groupReduce() and histogram()) use at most this many chunks
+		constexpr int64_t reproducibleMaxChunks = 64;
+
+		/// \return The number of chunks a reproducible reduction of `n` elements is split into:
+		/// one per reproducibleBlockSize elements, up to reproducibleMaxChunks. It depends only
+		/// on `n`, so the partial results are the same for any number of threads
+		LIBRAPID_NODISCARD inline int64_t reproducibleChunks(int64_t n) {
+			const int64_t blocks = (n + reproducibleBlockSize - 1) / reproducibleBlockSize;
+			return ::librapid::max(int64_t(1), ::librapid::min(blocks, reproducibleMaxChunks));
+		}
+
+		/// Combine `n` values with `combine`, in a pairwise tree which depends only on `n`
+		/// \return The combination of the values, or a value-initialised T if `n` is zero
+		template<typename T, typename Combine>
+		LIBRAPID_NODISCARD T pairwiseReduce(const T *values, int64_t n, Combine &&combine) {
+			if (n == 0) return T {};
+			if (n == 1) return values[0];
+			const int64_t half = n / 2;
+			return combine(pairwiseReduce(values, half, combine),
+						   pairwiseReduce(values + half, n - half, combine));
+		}
+
+		/// Add `n` values in a fixed pairwise order
+		template<typename T>
+		LIBRAPID_NODISCARD T pairwiseSum(const T *values, int64_t n) {
+			return pairwiseReduce(values, n, [](const T &a, const T &b) { return a + b; });
+		}
+
+		/// Add `term(i)` for i in [0, n) in a fixed order: term i is added to accumulator
+		/// i % reproducibleLanes, and the accumulators are then added pairwise
+		template<typename Scalar, typename Term>
+		LIBRAPID_NODISCARD Scalar reproducibleBlock(int64_t n, Term &&term) {
+			Scalar acc[reproducibleLanes] = {};
+			int64_t i					  = 0;
+			for (; i + reproducibleLanes <= n; i += reproducibleLanes) {
+				for (int64_t lane = 0; lane < reproducibleLanes; ++lane) {
+					acc[lane] += term(i + lane);
+				}
+			}
+			for (int64_t lane = 0; i < n; ++i, ++lane) acc[lane] += term(i);
+			return pairwiseSum(acc, reproducibleLanes);
+		}
+
+		/// Reduce `n` elements in reproducible mode. Blocks of reproducibleBlockSize elements
+		/// are reduced in parallel with `reduceBlock(begin, count)`, and the results are added
+		/// in a fixed pairwise order
+		template<typename Scalar, typename ReduceBlock>
+		LIBRAPID_NODISCARD Scalar reproducibleReduce(int64_t n, ReduceBlock &&reduceBlock) {
+			const int64_t numBlocks = (n + reproducibleBlockSize - 1) / reproducibleBlockSize;
+			std::vector<Scalar> partials(numBlocks);
+			indexingFor(numBlocks, n, [&](int64_t block) {
+				const int64_t begin = block * reproducibleBlockSize;
+				partials[block] =
+				  reduceBlock(begin, ::librapid::min(reproducibleBlockSize, n - begin));
+			});
+			return pairwiseSum(partials.data(), numBlocks);
+		}
+
+		/// Reduce `n` elements in the default mode. One chunk per thread is reduced with
+		/// `reduceChunk(begin, count)`, and the results are added in order
+		template<typename Scalar, typename ReduceChunk>
+		LIBRAPID_NODISCARD Scalar chunkedReduce(int64_t n, ReduceChunk &&reduceChunk) {
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+			std::vector<Scalar> partials(numChunks);
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				const int64_t begin = chunk * n / numChunks;
+				partials[chunk]		= reduceChunk(begin, (chunk + 1) * n / numChunks - begin);
+			});
+
+			Scalar total = Scalar(0);
+			for (const auto &partial : partials) total += partial;
+			return total;
+		}
+
+		/// \return The sum of `n` contiguous values
+		template<typename Scalar>
+		LIBRAPID_NODISCARD Scalar sumContiguous(const Scalar *data, int64_t n) {
+			if constexpr (std::is_floating_point_v<Scalar>) {
+				if (global::reproducibleReductions) {
+					return reproducibleReduce<Scalar>(n, [&](int64_t begin, int64_t count) {
+						return reproducibleBlock<Scalar>(
+						  count, [&](int64_t i) { return data[begin + i]; });
+					});
+				}
+			}
+
+			return chunkedReduce<Scalar>(n, [&](int64_t begin, int64_t count) {
+				if constexpr (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>) {
+					return cpu::dispatch::sum(count, data + begin);
+				} else {
+					Scalar total = Scalar(0);
+					for (int64_t i = begin; i < begin + count; ++i) total += data[i];
+					return total;
+				}
+			});
+		}
+
+		/// \return The dot product of `n` contiguous elements of `x` and `y`
+		template<typename ScalarX, typename ScalarY>
+		LIBRAPID_NODISCARD auto dotContiguous(int64_t n, const ScalarX *x, const ScalarY *y) {
+			using Scalar = decltype(std::declval<ScalarX>() * std::declval<ScalarY>());
+			if constexpr (std::is_floating_point_v<Scalar>) {
+				if (global::reproducibleReductions) {
+					return reproducibleReduce<Scalar>(n, [&](int64_t begin, int64_t count) {
+						return reproducibleBlock<Scalar>(count, [&](int64_t i) {
+							return static_cast<Scalar>(x[begin + i] * y[begin + i]);
+						});
+					});
+				}
+			}
+
+			return chunkedReduce<Scalar>(n, [&](int64_t begin, int64_t count) {
+				if constexpr (std::is_same_v<ScalarX, ScalarY> &&
+							  (std::is_same_v<Scalar, float> || std::is_same_v<Scalar, double>)) {
+					return cpu::dispatch::dot(count, x + begin, y + begin);
+				} else {
+					Scalar total = Scalar(0);
+					for (int64_t i = begin; i < begin + count; ++i) total += x[i] * y[i];
+					return total;
+				}
+			});
+		}
+	} // namespace detail
+
+	/// \brief Sum every element of an array
+	///
+	/// Large arrays are summed in parallel. By default, the rounding of a floating-point sum
+	/// depends on the number of threads; call setReproducibleReductions(true) to make it
+	/// independent of the number of threads, at some cost in speed.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to sum
+	/// \return The sum of the elements
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD Scalar sum(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array) {
+		return detail::sumContiguous(array.storage().data(),
+									 static_cast<int64_t>(array.shape().size()));
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_REDUCE_HPP
@@ -0,0 +1,617 @@
+#ifndef LIBRAPID_ARRAY_RUNNING_STATS_HPP
+#define LIBRAPID_ARRAY_RUNNING_STATS_HPP
+
+/*
+ * Streaming statistics: RunningStats accumulates the count, mean, variance, skewness, kurtosis,
+ * minimum and maximum of a stream of values without storing them, and RunningColumnStats does
+ * the same for each column of a stream of blocks of rows.
+ *
+ * The state of a set of n values is n, the mean and the central moment sums M2, M3 and M4 (the
+ * sums of the second, third and fourth powers of the deviations from the mean). Values are
+ * consumed in blocks small enough to stay in cache: the mean of a block is found in one SIMD
+ * pass and the central moment sums about it in a second, and the block is then merged into the
+ * state with the pairwise update of Chan et al., extended to the higher moments by Pebay. A
+ * single value is merged in the same way, which reduces to Welford's update.
+ *
+ * The same update merges two accumulators, so statistics computed separately over parts of a
+ * stream (on different threads, say) combine into the statistics of the whole stream, to within
+ * rounding. Large blocks are themselves split between threads, and the partial results merged
+ * in order. In reproducible mode (see reduce.hpp), the split does not depend on the number of
+ * threads. NaNs propagate into every statistic.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// Contiguous values are consumed in blocks of this many
+		constexpr int64_t statsBlockSize = 1024;
+
+		/// Columns are consumed in blocks of this many columns by this many rows
+		constexpr int64_t statsBlockWidth = 256;
+		constexpr int64_t statsBlockRows  = 64;
+
+		/// In reproducible mode, blocks of rows are split into chunks of about this many elements
+		constexpr int64_t statsReproducibleChunk = 65536;
+
+		/// The count, mean, central moment sums, minimum and maximum of a set of values
+		template<typename Scalar>
+		struct StatsMoments {
+			int64_t count = 0;
+			Scalar mean	  = 0;
+			Scalar m2	  = 0;
+			Scalar m3	  = 0;
+			Scalar m4	  = 0;
+			Scalar min	  = ScanMinOp::identity<Scalar>();
+			Scalar max	  = ScanMaxOp::identity<Scalar>();
+
+			LIBRAPID_NODISCARD Scalar sum() const { return mean * static_cast<Scalar>(count); }
+
+			LIBRAPID_NODISCARD Scalar variance(int64_t ddof) const {
+				if (count <= ddof) return std::numeric_limits<Scalar>::quiet_NaN();
+				return m2 / static_cast<Scalar>(count - ddof);
+			}
+
+			/// The (biased) sample skewness, m3 / m2^1.5
+			LIBRAPID_NODISCARD Scalar skewness() const {
+				if (count == 0) return std::numeric_limits<Scalar>::quiet_NaN();
+				return std::sqrt(static_cast<Scalar>(count)) * m3 / (m2 * std::sqrt(m2));
+			}
+
+			/// The (biased) excess kurtosis, m4 / m2^2 - 3
+			LIBRAPID_NODISCARD Scalar kurtosis() const {
+				if (count == 0) return std::numeric_limits<Scalar>::quiet_NaN();
+				return static_cast<Scalar>(count) * m4 / (m2 * m2) - Scalar(3);
+			}
+
+			LIBRAPID_NODISCARD Scalar minimum() const {
+				return count == 0 ? std::numeric_limits<Scalar>::quiet_NaN() : min;
+			}
+
+			LIBRAPID_NODISCARD Scalar maximum() const {
+				return count == 0 ? std::numeric_limits<Scalar>::quiet_NaN() : max;
+			}
+		};
+
+		/// Merge the moments of another set of values into `a`, so that `a` holds the moments
+		/// of both sets
+		template<typename Scalar>
+		LIBRAPID_ALWAYS_INLINE void mergeMoments(StatsMoments<Scalar> &a,
+												 const StatsMoments<Scalar> &b) {
+			if (b.count == 0) return;
+			if (a.count == 0) {
+				a = b;
+				return;
+			}
+
+			const Scalar na	   = static_cast<Scalar>(a.count);
+			const Scalar nb	   = static_cast<Scalar>(b.count);
+			const Scalar nab   = na * nb;
+			const Scalar delta = b.mean - a.mean;
+			const Scalar dn	   = delta / (na + nb);
+			const Scalar dn2   = dn * dn;
+
+			// Each moment is updated from the lower moments of `a`, so update the highest first
+			a.m4 += b.m4 + delta * dn * dn2 * nab * (na * na - nab + nb * nb) +
+					Scalar(6) * dn2 * (na * na * b.m2 + nb * nb * a.m2) +
+					Scalar(4) * dn * (na * b.m3 - nb * a.m3);
+			a.m3 += b.m3 + delta * dn2 * nab * (na - nb) + Scalar(3) * dn * (na * b.m2 - nb * a.m2);
+			a.m2 += b.m2 + delta * dn * nab;
+			a.mean += dn * nb;
+			a.count += b.count;
+			a.min = ScanMinOp::combine(a.min, b.min);
+			a.max = ScanMaxOp::combine(a.max, b.max);
+		}
+
+		/// \return `data` as Scalars: `data` itself if its elements are Scalars, and otherwise a
+		/// contiguous copy of its `numRows` rows of `width` elements (with consecutive rows
+		/// `stride` elements apart) in `buffer`, in which case `stride` is set to `width`. Each
+		/// task passes its own buffer, which is freed when the task finishes
+		template<typename Scalar, typename T>
+		LIBRAPID_NODISCARD const Scalar *statsData(const T *data, int64_t numRows,
+												   int64_t &stride, int64_t width,
+												   std::vector<Scalar> &buffer) {
+			if constexpr (std::is_same_v<T, Scalar>) {
+				return data;
+			} else {
+				buffer.resize(numRows * width);
+				for (int64_t r = 0; r < numRows; ++r) {
+					for (int64_t k = 0; k < width; ++k) {
+						buffer[r * width + k] = static_cast<Scalar>(data[r * stride + k]);
+					}
+				}
+				stride = width;
+				return buffer.data();
+			}
+		}
+
+		/// \return The moments of `n` contiguous values
+		template<typename Scalar>
+		LIBRAPID_NODISCARD StatsMoments<Scalar> blockMoments(const Scalar *data, int64_t n) {
+			StatsMoments<Scalar> result;
+			result.count = n;
+			if (n == 0) return result;
+
+			// First pass: the sum, minimum and maximum
+			Scalar sum = 0;
+			int64_t i  = 0;
+			if constexpr (scanVectorisable<Scalar>) {
+				using Packet			= typename typetraits::TypeInfo<Scalar>::Packet;
+				constexpr int64_t width = typetraits::TypeInfo<Scalar>::packetWidth;
+				if (n >= width) {
+					Packet sums = xsimd::load_unaligned(data);
+					Packet mins = sums;
+					Packet maxs = sums;
+					for (i = width; i + width <= n; i += width) {
+						const Packet values = xsimd::load_unaligned(data + i);
+						sums += values;
+						mins = ScanMinOp::combinePacket(mins, values);
+						maxs = ScanMaxOp::combinePacket(maxs, values);
+					}
+
+					Scalar lanes[width];
+					sum = xsimd::reduce_add(sums);
+					mins.store_unaligned(lanes);
+					for (int64_t lane = 0; lane < width; ++lane) {
+						result.min = ScanMinOp::combine(result.min, lanes[lane]);
+					}
+					maxs.store_unaligned(lanes);
+					for (int64_t lane = 0; lane < width; ++lane) {
+						result.max = ScanMaxOp::combine(result.max, lanes[lane]);
+					}
+				}
+			}
+			for (; i < n; ++i) {
+				sum += data[i];
+				result.min = ScanMinOp::combine(result.min, data[i]);
+				result.max = ScanMaxOp::combine(result.max, data[i]);
+			}
+			result.mean = sum / static_cast<Scalar>(n);
+
+			// Second pass: the central moment sums
+			i = 0;
+			if constexpr (scanVectorisable<Scalar>) {
+				using Packet			= typename typetraits::TypeInfo<Scalar>::Packet;
+				constexpr int64_t width = typetraits::TypeInfo<Scalar>::packetWidth;
+				const Packet mean(result.mean);
+				Packet m2(Scalar(0)), m3(Scalar(0)), m4(Scalar(0));
+				for (; i + width <= n; i += width) {
+					const Packet d	= Packet(xsimd::load_unaligned(data + i)) - mean;
+					const Packet d2 = d * d;
+					m2 += d2;
+					m3 += d2 * d;
+					m4 += d2 * d2;
+				}
+				result.m2 = xsimd::reduce_add(m2);
+				result.m3 = xsimd::reduce_add(m3);
+				result.m4 = xsimd::reduce_add(m4);
+			}
+			for (; i < n; ++i) {
+				const Scalar d	= data[i] - result.mean;
+				const Scalar d2 = d * d;
+				result.m2 += d2;
+				result.m3 += d2 * d;
+				result.m4 += d2 * d2;
+			}
+			return result;
+		}
+
+		/// Merge `n` contiguous values into `moments`
+		template<typename Scalar, typename T>
+		void accumulateMoments(const T *data, int64_t n, StatsMoments<Scalar> &moments) {
+			if (global::reproducibleReductions) {
+				// Merge the blocks in a fixed pairwise order, whatever the number of threads
+				const int64_t numBlocks = (n + statsBlockSize - 1) / statsBlockSize;
+				std::vector<StatsMoments<Scalar>> blocks(numBlocks);
+				indexingFor(numBlocks, n, [&](int64_t index) {
+					const int64_t i		= index * statsBlockSize;
+					const int64_t count = ::librapid::min(statsBlockSize, n - i);
+					int64_t stride		= count;
+					std::vector<Scalar> buffer;
+					const Scalar *block = statsData<Scalar>(data + i, 1, stride, count, buffer);
+					blocks[index]		= blockMoments(block, count);
+				});
+
+				mergeMoments(moments,
+							 pairwiseReduce(blocks.data(), numBlocks, [](auto a, const auto &b) {
+								 mergeMoments(a, b);
+								 return a;
+							 }));
+				return;
+			}
+
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+			std::vector<StatsMoments<Scalar>> partials(numChunks);
+			indexingFor(numChunks, parallel ? n : 0, [&](int64_t chunk) {
+				std::vector<Scalar> buffer;
+				const int64_t end = (chunk + 1) * n / numChunks;
+				for (int64_t i = chunk * n / numChunks; i < end; i += statsBlockSize) {
+					const int64_t count = ::librapid::min(statsBlockSize, end - i);
+					int64_t stride		= count;
+					const Scalar *block = statsData<Scalar>(data + i, 1, stride, count, buffer);
+					mergeMoments(partials[chunk], blockMoments(block, count));
+				}
+			});
+
+			for (const auto &partial : partials) mergeMoments(moments, partial);
+		}
+
+		/// Merge each of `width` columns of `numRows` rows, with consecutive rows `stride`
+		/// elements apart, into the corresponding element of `columns`
+		template<typename Scalar, typename T>
+		void accumulateColumnBlock(const T *data, int64_t numRows, int64_t stride, int64_t width,
+								   StatsMoments<Scalar> *columns) {
+			using Packet				  = typename typetraits::TypeInfo<Scalar>::Packet;
+			constexpr int64_t packetWidth = typetraits::TypeInfo<Scalar>::packetWidth;
+
+			std::vector<Scalar> buffer;
+			for (int64_t first = 0; first < numRows; first += statsBlockRows) {
+				const int64_t rows	= ::librapid::min(statsBlockRows, numRows - first);
+				int64_t rowStride	= stride;
+				const Scalar *block =
+				  statsData<Scalar>(data + first * stride, rows, rowStride, width, buffer);
+
+				// First pass: the sum (in `mean`), minimum and maximum of each column
+				Scalar mean[statsBlockWidth], lo[statsBlockWidth], hi[statsBlockWidth];
+				std::copy_n(block, width, mean);
+				std::copy_n(block, width, lo);
+				std::copy_n(block, width, hi);
+				for (int64_t r = 1; r < rows; ++r) {
+					const Scalar *row = block + r * rowStride;
+					int64_t k		  = 0;
+					if constexpr (scanVectorisable<Scalar>) {
+						for (; k + packetWidth <= width; k += packetWidth) {
+							const Packet values = xsimd::load_unaligned(row + k);
+							(Packet(xsimd::load_unaligned(mean + k)) + values)
+							  .store_unaligned(mean + k);
+							ScanMinOp::combinePacket(Packet(xsimd::load_unaligned(lo + k)), values)
+							  .store_unaligned(lo + k);
+							ScanMaxOp::combinePacket(Packet(xsimd::load_unaligned(hi + k)), values)
+							  .store_unaligned(hi + k);
+						}
+					}
+					for (; k < width; ++k) {
+						mean[k] += row[k];
+						lo[k] = ScanMinOp::combine(lo[k], row[k]);
+						hi[k] = ScanMaxOp::combine(hi[k], row[k]);
+					}
+				}
+				for (int64_t k = 0; k < width; ++k) mean[k] /= static_cast<Scalar>(rows);
+
+				// Second pass: the central moment sums of each column
+				Scalar m2[statsBlockWidth], m3[statsBlockWidth], m4[statsBlockWidth];
+				std::fill_n(m2, width, Scalar(0));
+				std::fill_n(m3, width, Scalar(0));
+				std::fill_n(m4, width, Scalar(0));
+				for (int64_t r = 0; r < rows; ++r) {
+					const Scalar *row = block + r * rowStride;
+					int64_t k		  = 0;
+					if constexpr (scanVectorisable<Scalar>) {
+						for (; k + packetWidth <= width; k += packetWidth) {
+							const Packet d = Packet(xsimd::load_unaligned(row + k)) -
+											 Packet(xsimd::load_unaligned(mean + k));
+							const Packet d2 = d * d;
+							const Packet d3 = d2 * d;
+							const Packet d4 = d2 * d2;
+							(Packet(xsimd::load_unaligned(m2 + k)) + d2).store_unaligned(m2 + k);
+							(Packet(xsimd::load_unaligned(m3 + k)) + d3).store_unaligned(m3 + k);
+							(Packet(xsimd::load_unaligned(m4 + k)) + d4).store_unaligned(m4 + k);
+						}
+					}
+					for (; k < width; ++k) {
+						const Scalar d	= row[k] - mean[k];
+						const Scalar d2 = d * d;
+						m2[k] += d2;
+						m3[k] += d2 * d;
+						m4[k] += d2 * d2;
+					}
+				}
+
+				for (int64_t k = 0; k < width; ++k) {
+					const StatsMoments<Scalar> moments {
+					  rows, mean[k], m2[k], m3[k], m4[k], lo[k], hi[k]};
+					mergeMoments(columns[k], moments);
+				}
+			}
+		}
+
+		/// Merge each of the `width` contiguous columns of `numRows` contiguous rows into the
+		/// corresponding element of `columns`
+		template<typename Scalar, typename T>
+		void accumulateColumns(const T *data, int64_t numRows, int64_t width,
+							   StatsMoments<Scalar> *columns) {
+			const int64_t size	= numRows * width;
+			const bool parallel = static_cast<size_t>(size) > global::multithreadThreshold &&
+								  global::numThreads > 1;
+			const int64_t threads	= static_cast<int64_t>(global::numThreads);
+			const int64_t numBlocks = (width + statsBlockWidth - 1) / statsBlockWidth;
+			auto blockWidth			= [&](int64_t block) {
+				return ::librapid::min(statsBlockWidth, width - block * statsBlockWidth);
+			};
+			if (size == 0) return;
+
+			const bool reproducible = global::reproducibleReductions;
+			if (!reproducible && (!parallel || numBlocks >= threads || numRows < 2)) {
+				indexingFor(numBlocks, parallel ? size : 0, [&](int64_t block) {
+					const int64_t column = block * statsBlockWidth;
+					accumulateColumnBlock(
+					  data + column, numRows, width, blockWidth(block), columns + column);
+				});
+				return;
+			}
+
+			// There are too few blocks of columns to occupy every thread, so split the rows into
+			// chunks, accumulate each separately, and merge them in order. In reproducible mode,
+			// the chunks have a fixed size instead, so the result does not depend on the number
+			// of threads
+			const int64_t chunkRows =
+			  ::librapid::max(statsBlockRows, statsReproducibleChunk / ::librapid::max(width, 1));
+			const int64_t numChunks = reproducible ? (numRows + chunkRows - 1) / chunkRows
+												   : ::librapid::min(threads, numRows);
+			std::vector<StatsMoments<Scalar>> partials(numChunks * width);
+			indexingFor(numChunks * numBlocks, size, [&](int64_t task) {
+				const int64_t chunk	 = task / numBlocks;
+				const int64_t block	 = task % numBlocks;
+				const int64_t column = block * statsBlockWidth;
+				const int64_t first	 = chunk * numRows / numChunks;
+				accumulateColumnBlock(data + first * width + column,
+									  (chunk + 1) * numRows / numChunks - first,
+									  width,
+									  blockWidth(block),
+									  partials.data() + chunk * width + column);
+			});
+
+			indexingFor(width, size, [&](int64_t k) {
+				for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+					mergeMoments(columns[k], partials[chunk * width + k]);
+				}
+			});
+		}
+	} // namespace detail
+
+	/// \brief Running statistics of a stream of values
+	///
+	/// Values are added with update(), singly or a whole array at a time, and the statistics of
+	/// every value added so far can be read at any point. Only a few scalars are stored, however
+	/// many values are added. Two accumulators can be merged, so a stream can be split between
+	/// threads and the partial statistics combined afterwards.
+	///
+	/// \code{.cpp}
+	/// lrc::RunningStats<double> stats;
+	/// while (source.read(chunk)) stats.update(chunk);
+	/// fmt::print("{} +/- {} (n = {})\n", stats.mean(), stats.stddev(), stats.count());
+	/// \endcode
+	///
+	/// \tparam Scalar The floating-point type the statistics are computed in
+	template<typename Scalar = double>
+	class RunningStats {
+	public:
+		static_assert(std::is_floating_point_v<Scalar>,
+					  "RunningStats must be computed in a floating-point type");
+
+		RunningStats() = default;
+
+		/// Add a value
+		template<typename T>
+			requires(std::is_arithmetic_v<T>)
+		RunningStats &update(T value) {
+			const Scalar x = static_cast<Scalar>(value);
+			detail::mergeMoments(m_moments, detail::StatsMoments<Scalar> {1, x, 0, 0, 0, x, x});
+			return *this;
+		}
+
+		/// Add `n` contiguous values
+		template<typename T>
+		RunningStats &update(const T *data, int64_t n) {
+			detail::accumulateMoments(data, n, m_moments);
+			return *this;
+		}
+
+		/// Add the elements of a vector
+		template<typename T>
+		RunningStats &update(const std::vector<T> &values) {
+			return update(values.data(), static_cast<int64_t>(values.size()));
+		}
+
+		/// Add every element of an array
+		template<typename ShapeType, typename T>
+		RunningStats &update(const array::ArrayContainer<ShapeType, Storage<T>> &array) {
+			return update(array.storage().data(), static_cast<int64_t>(array.shape().size()));
+		}
+
+		/// Add the values accumulated by another RunningStats
+		RunningStats &merge(const RunningStats &other) {
+			detail::mergeMoments(m_moments, other.m_moments);
+			return *this;
+		}
+
+		/// Remove every value
+		void reset() { m_moments = {}; }
+
+		/// \return The number of values added
+		LIBRAPID_NODISCARD int64_t count() const { return m_moments.count; }
+
+		/// \return The sum of the values
+		LIBRAPID_NODISCARD Scalar sum() const { return m_moments.sum(); }
+
+		/// \return The mean of the values (NaN if there are none)
+		LIBRAPID_NODISCARD Scalar mean() const {
+			return count() == 0 ? std::numeric_limits<Scalar>::quiet_NaN() : m_moments.mean;
+		}
+
+		/// \param ddof Delta degrees of freedom: the sum of squared deviations is divided by
+		/// `count() - ddof` (1 gives the unbiased sample variance)
+		/// \return The variance of the values
+		LIBRAPID_NODISCARD Scalar variance(int64_t ddof = 0) const {
+			return m_moments.variance(ddof);
+		}
+
+		/// \return The standard deviation of the values
+		/// \see variance()
+		LIBRAPID_NODISCARD Scalar stddev(int64_t ddof = 0) const {
+			return std::sqrt(variance(ddof));
+		}
+
+		/// \return The (biased) skewness of the values
+		LIBRAPID_NODISCARD Scalar skewness() const { return m_moments.skewness(); }
+
+		/// \return The (biased) excess kurtosis of the values, which is 0 for a normal
+		/// distribution
+		LIBRAPID_NODISCARD Scalar kurtosis() const { return m_moments.kurtosis(); }
+
+		/// \return The smallest value (NaN if there are none)
+		LIBRAPID_NODISCARD Scalar min() const { return m_moments.minimum(); }
+
+		/// \return The largest value (NaN if there are none)
+		LIBRAPID_NODISCARD Scalar max() const { return m_moments.maximum(); }
+
+	private:
+		detail::StatsMoments<Scalar> m_moments;
+	};
+
+	/// \brief Running statistics of each column of a stream of rows
+	///
+	/// Each update adds a block of rows: an array with the shape of a row, or with an extra
+	/// leading dimension counting the rows. Every statistic is returned as an array with the
+	/// shape of a row, holding the statistic of each column. As with RunningStats, accumulators
+	/// over the same shape of row can be merged.
+	///
+	/// \code{.cpp}
+	/// // Per-feature statistics of a stream of [batch, features] blocks
+	/// lrc::RunningColumnStats<float> stats(lrc::Shape({features}));
+	/// for (const auto &batch : batches) stats.update(batch);
+	/// auto normalised = (x - stats.mean()) / stats.stddev();
+	/// \endcode
+	///
+	/// \tparam Scalar The floating-point type the statistics are computed in
+	template<typename Scalar = double>
+	class RunningColumnStats {
+	public:
+		static_assert(std::is_floating_point_v<Scalar>,
+					  "RunningColumnStats must be computed in a floating-point type");
+
+		/// Accumulate statistics of rows with the shape `rowShape`
+		explicit RunningColumnStats(const Shape &rowShape) :
+				m_shape(rowShape), m_columns(rowShape.size()) {}
+
+		/// Add `numRows` contiguous rows, each of `shape().size()` contiguous elements
+		template<typename T>
+		RunningColumnStats &update(const T *data, int64_t numRows) {
+			detail::accumulateColumns(
+			  data, numRows, static_cast<int64_t>(m_columns.size()), m_columns.data());
+			m_count += numRows;
+			return *this;
+		}
+
+		/// Add a row, or a block of rows along the first axis
+		template<typename ShapeType, typename T>
+		RunningColumnStats &update(const array::ArrayContainer<ShapeType, Storage<T>> &rows) {
+			const auto &shape	= rows.shape();
+			const int64_t extra = static_cast<int64_t>(shape.ndim()) - m_shape.ndim();
+			bool matches		= extra == 0 || extra == 1;
+			for (int64_t i = 0; matches && i < m_shape.ndim(); ++i) {
+				matches = static_cast<int64_t>(shape[extra + i]) == m_shape[i];
+			}
+			if (!matches) {
+				throw std::invalid_argument(
+				  fmt::format("Expected rows of shape {}. Received an array of shape {}",
+							  m_shape,
+							  shape));
+			}
+
+			return update(rows.storage().data(),
+						  extra == 0 ? 1 : static_cast<int64_t>(shape[0]));
+		}
+
+		/// Add the rows accumulated by another RunningColumnStats with the same shape of row
+		RunningColumnStats &merge(const RunningColumnStats &other) {
+			if (!(m_shape == other.m_shape)) {
+				throw std::invalid_argument(fmt::format(
+				  "Cannot merge statistics of rows of shape {} into statistics of rows of shape {}",
+				  other.m_shape,
+				  m_shape));
+			}
+
+			for (size_t k = 0; k < m_columns.size(); ++k) {
+				detail::mergeMoments(m_columns[k], other.m_columns[k]);
+			}
+			m_count += other.m_count;
+			return *this;
+		}
+
+		/// Remove every row
+		void reset() {
+			std::fill(m_columns.begin(), m_columns.end(), detail::StatsMoments<Scalar>());
+			m_count = 0;
+		}
+
+		/// \return The shape of a row
+		LIBRAPID_NODISCARD const Shape &shape() const { return m_shape; }
+
+		/// \return The number of rows added
+		LIBRAPID_NODISCARD int64_t count() const { return m_count; }
+
+		/// \return The sum of each column
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> sum() const {
+			return columnStatistic([](const auto &moments) { return moments.sum(); });
+		}
+
+		/// \return The mean of each column (NaN if there are no rows)
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> mean() const {
+			return columnStatistic([](const auto &moments) {
+				return moments.count == 0 ? std::numeric_limits<Scalar>::quiet_NaN()
+										  : moments.mean;
+			});
+		}
+
+		/// \param ddof Delta degrees of freedom
+		/// \return The variance of each column
+		/// \see RunningStats::variance()
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> variance(int64_t ddof = 0) const {
+			return columnStatistic([ddof](const auto &moments) { return moments.variance(ddof); });
+		}
+
+		/// \return The standard deviation of each column
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> stddev(int64_t ddof = 0) const {
+			return columnStatistic(
+			  [ddof](const auto &moments) { return std::sqrt(moments.variance(ddof)); });
+		}
+
+		/// \return The (biased) skewness of each column
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> skewness() const {
+			return columnStatistic([](const auto &moments) { return moments.skewness(); });
+		}
+
+		/// \return The (biased) excess kurtosis of each column
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> kurtosis() const {
+			return columnStatistic([](const auto &moments) { return moments.kurtosis(); });
+		}
+
+		/// \return The smallest value in each column (NaN if there are no rows)
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> min() const {
+			return columnStatistic([](const auto &moments) { return moments.minimum(); });
+		}
+
+		/// \return The largest value in each column (NaN if there are no rows)
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> max() const {
+			return columnStatistic([](const auto &moments) { return moments.maximum(); });
+		}
+
+	private:
+		/// \return An array with the shape of a row, holding `func` of each column's moments
+		template<typename Func>
+		LIBRAPID_NODISCARD Array<Scalar, backend::CPU> columnStatistic(Func &&func) const {
+			Array<Scalar, backend::CPU> result(m_shape);
+			Scalar *out = result.storage().data();
+			for (size_t k = 0; k < m_columns.size(); ++k) out[k] = func(m_columns[k]);
+			return result;
+		}
+
+		Shape m_shape;
+		std::vector<detail::StatsMoments<Scalar>> m_columns;
+		int64_t m_count = 0;
+	};
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_RUNNING_STATS_HPP
@@ -0,0 +1,486 @@
+#ifndef LIBRAPID_ARRAY_SCAN_HPP
+#define LIBRAPID_ARRAY_SCAN_HPP
+
+/*
+ * Prefix scans along an axis: cumsum(), cumprod(), cummax() and cummin(). Each returns an array
+ * with the shape of its input, where element j along the axis combines elements 0 to j of the
+ * input (an inclusive scan), or elements 0 to j - 1 (an exclusive scan, which starts from the
+ * identity of the operation).
+ *
+ * The input is viewed as [outer, extent, inner], where extent is the length of the axis:
+ *
+ *  - Along the last axis (inner == 1), each row is scanned one SIMD packet at a time. The
+ *    prefix within a packet is computed in registers with log2(width) shift-and-combine steps,
+ *    and the running total is carried from one packet to the next.
+ *  - Along any other axis, the columns are independent, so consecutive rows along the axis are
+ *    combined elementwise, one packet of columns at a time.
+ *
+ * Independent rows (or blocks of columns) are scanned in parallel. If there are fewer of them
+ * than threads, as for a long 1D array, the axis itself is split into chunks. The total of each
+ * chunk is computed in parallel, the totals are scanned, and then each chunk is scanned in
+ * parallel starting from the total of the chunks before it. The input is read twice and the
+ * output written once, so large scans are limited by memory bandwidth.
+ *
+ * Floating-point sums and products are not combined strictly in order, so they may round
+ * differently to a sequential loop, and by default depend on the number of threads. In
+ * reproducible mode (see reduce.hpp), a long axis is always split into chunks of a fixed
+ * size, so the result does not. cummax() and cummin() propagate NaNs.
+ *
+ * An invalid axis throws std::out_of_range in every build (see detail::splitAxis), rather than
+ * only when asserts are enabled, since scanning along it would read outside the array.
+ */
+
+namespace librapid {
+	namespace detail {
+		struct ScanSumOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				return T(0);
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return static_cast<T>(a + b);
+			}
+
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static Packet
+			combinePacket(const Packet &a, const Packet &b) {
+				return a + b;
+			}
+		};
+
+		struct ScanProdOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				return T(1);
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return static_cast<T>(a * b);
+			}
+
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static Packet
+			combinePacket(const Packet &a, const Packet &b) {
+				return a * b;
+			}
+		};
+
+		struct ScanMaxOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				if constexpr (std::numeric_limits<T>::has_infinity) {
+					return -std::numeric_limits<T>::infinity();
+				} else {
+					return std::numeric_limits<T>::lowest();
+				}
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return (a > b || a != a) ? a : b;
+			}
+
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static Packet
+			combinePacket(const Packet &a, const Packet &b) {
+				if constexpr (std::is_floating_point_v<typename Packet::value_type>) {
+					return xsimd::select((a > b) | xsimd::isnan(a), a, b);
+				} else {
+					return xsimd::max(a, b);
+				}
+			}
+		};
+
+		struct ScanMinOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				if constexpr (std::numeric_limits<T>::has_infinity) {
+					return std::numeric_limits<T>::infinity();
+				} else {
+					return std::numeric_limits<T>::max();
+				}
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return (a < b || a != a) ? a : b;
+			}
+
+			template<typename Packet>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static Packet
+			combinePacket(const Packet &a, const Packet &b) {
+				if constexpr (std::is_floating_point_v<typename Packet::value_type>) {
+					return xsimd::select((a < b) | xsimd::isnan(a), a, b);
+				} else {
+					return xsimd::min(a, b);
+				}
+			}
+		};
+
+		/// True if scans of T can use SIMD packets
+		template<typename T>
+		constexpr bool scanVectorisable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+										  (typetraits::TypeInfo<T>::packetWidth > 1);
+
+		/// True if combining values of type T with `Op` rounds, so that the result of a scan
+		/// depends on the order in which the values are combined
+		template<typename Op, typename T>
+		constexpr bool scanRounds =
+		  !std::is_integral_v<T> &&
+		  (std::is_same_v<Op, ScanSumOp> || std::is_same_v<Op, ScanProdOp>);
+
+		/// Move each lane of a packet `Shift` lanes higher, filling the lowest lanes with the
+		/// corresponding lanes of `fill`
+		template<int64_t Shift, typename Packet>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Packet shiftLanesUp(const Packet &packet,
+																	  const Packet &fill) {
+			constexpr unsigned bytes = Shift * sizeof(typename Packet::value_type);
+			return xsimd::slide_left<bytes>(packet) | (fill ^ xsimd::slide_left<bytes>(fill));
+		}
+
+		/// Inclusive scan of the lanes of a packet, in log2(width) steps
+		template<typename Op, int64_t Shift = 1, typename Packet>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Packet prefixPacket(const Packet &packet,
+																	  const Packet &identity) {
+			if constexpr (Shift < static_cast<int64_t>(Packet::size)) {
+				return prefixPacket<Op, Shift * 2>(
+				  Op::combinePacket(packet, shiftLanesUp<Shift>(packet, identity)), identity);
+			} else {
+				return packet;
+			}
+		}
+
+		/// Scan `n` contiguous elements, starting from `carry`. `src` and `dst` may be the same
+		/// \return The combination of `carry` and every element
+		template<typename Op, typename Scalar>
+		Scalar scanContiguous(const Scalar *src, Scalar *dst, int64_t n, Scalar carry,
+							  bool exclusive) {
+			int64_t i = 0;
+			if constexpr (scanVectorisable<Scalar>) {
+				using Packet			= typename typetraits::TypeInfo<Scalar>::Packet;
+				constexpr int64_t width = typetraits::TypeInfo<Scalar>::packetWidth;
+				const Packet identity(Op::template identity<Scalar>());
+
+				for (; i + width <= n; i += width) {
+					const Scalar last	= src[i + width - 1];
+					const Packet values = xsimd::load_unaligned(src + i);
+					const Packet prefix =
+					  Op::combinePacket(Packet(carry), prefixPacket<Op>(values, identity));
+
+					if (exclusive) {
+						shiftLanesUp<1>(prefix, Packet(carry)).store_unaligned(dst + i);
+						carry = Op::combine(dst[i + width - 1], last);
+					} else {
+						prefix.store_unaligned(dst + i);
+						carry = dst[i + width - 1];
+					}
+				}
+			}
+
+			for (; i < n; ++i) {
+				const Scalar value = src[i];
+				if (exclusive) dst[i] = carry;
+				carry = Op::combine(carry, value);
+				if (!exclusive) dst[i] = carry;
+			}
+			return carry;
+		}
+
+		/// Combine `n` contiguous elements
+		template<typename Op, typename Scalar>
+		LIBRAPID_NODISCARD Scalar scanTotal(const Scalar *src, int64_t n) {
+			Scalar total = Op::template identity<Scalar>();
+			int64_t i	 = 0;
+			if constexpr (scanVectorisable<Scalar>) {
+				using Packet			= typename typetraits::TypeInfo<Scalar>::Packet;
+				constexpr int64_t width = typetraits::TypeInfo<Scalar>::packetWidth;
+				if (n >= width) {
+					Packet acc = xsimd::load_unaligned(src);
+					for (i = width; i + width <= n; i += width) {
+						acc = Op::combinePacket(acc, Packet(xsimd::load_unaligned(src + i)));
+					}
+
+					Scalar lanes[width];
+					acc.store_unaligned(lanes);
+					for (int64_t lane = 0; lane < width; ++lane) {
+						total = Op::combine(total, lanes[lane]);
+					}
+				}
+			}
+
+			for (; i < n; ++i) total = Op::combine(total, src[i]);
+			return total;
+		}
+
+		/// Scan `numRows` rows of `width` contiguous columns, with consecutive rows `stride`
+		/// elements apart. `carry` holds the running value of each column, and is updated. If
+		/// `Store` is false, nothing is written to `dst`
+		template<typename Op, bool Store, typename Scalar>
+		void scanColumns(const Scalar *src, Scalar *dst, int64_t numRows, int64_t stride,
+						 int64_t width, Scalar *carry, bool exclusive) {
+			for (int64_t j = 0; j < numRows; ++j) {
+				const Scalar *in = src + j * stride;
+				Scalar *out		 = dst + j * stride;
+
+				int64_t k = 0;
+				if constexpr (scanVectorisable<Scalar>) {
+					using Packet				  = typename typetraits::TypeInfo<Scalar>::Packet;
+					constexpr int64_t packetWidth = typetraits::TypeInfo<Scalar>::packetWidth;
+					for (; k + packetWidth <= width; k += packetWidth) {
+						const Packet current = xsimd::load_unaligned(carry + k);
+						const Packet next =
+						  Op::combinePacket(current, Packet(xsimd::load_unaligned(in + k)));
+						if constexpr (Store) (exclusive ? current : next).store_unaligned(out + k);
+						next.store_unaligned(carry + k);
+					}
+				}
+
+				for (; k < width; ++k) {
+					const Scalar current = carry[k];
+					carry[k]			 = Op::combine(current, in[k]);
+					if constexpr (Store) out[k] = exclusive ? current : carry[k];
+				}
+			}
+		}
+
+		/// Columns along a non-final axis are scanned in blocks of this many
+		constexpr int64_t scanBlockWidth = 256;
+
+		/// Scan `src`, viewed as [outer, extent, inner], along the middle dimension. `src` and
+		/// `dst` may be the same
+		template<typename Op, typename Scalar>
+		void scanImpl(const Scalar *src, Scalar *dst, int64_t outer, int64_t extent, int64_t inner,
+					  bool exclusive) {
+			const int64_t size	= outer * extent * inner;
+			const bool parallel = static_cast<size_t>(size) > global::multithreadThreshold &&
+								  global::numThreads > 1;
+			const int64_t threads	   = static_cast<int64_t>(global::numThreads);
+			const int64_t blocksPerRow = (inner + scanBlockWidth - 1) / scanBlockWidth;
+			const int64_t numTasks	   = outer * blocksPerRow;
+			const Scalar identity	   = Op::template identity<Scalar>();
+			if (size == 0) return;
+
+			// Scan (or, if `store` is false, combine) `numRows` rows of one block of columns,
+			// starting at row `first`
+			auto scanTask = [&](int64_t task, int64_t first, int64_t numRows, Scalar *carry,
+								bool store) {
+				const int64_t column = (task % blocksPerRow) * scanBlockWidth;
+				const int64_t offset = ((task / blocksPerRow) * extent + first) * inner + column;
+				if (inner == 1) {
+					if (store) {
+						carry[0] = scanContiguous<Op>(
+						  src + offset, dst + offset, numRows, carry[0], exclusive);
+					} else {
+						carry[0] = Op::combine(carry[0], scanTotal<Op>(src + offset, numRows));
+					}
+				} else {
+					const int64_t width = ::librapid::min(scanBlockWidth, inner - column);
+					if (store) {
+						scanColumns<Op, true>(
+						  src + offset, dst + offset, numRows, inner, width, carry, exclusive);
+					} else {
+						scanColumns<Op, false>(
+						  src + offset, dst + offset, numRows, inner, width, carry, exclusive);
+					}
+				}
+			};
+
+			// In reproducible mode, a rounding scan splits the axis into chunks of a fixed size
+			// (if it is long enough to split at all), so that it does not depend on the number
+			// of threads
+			const bool reproducible = global::reproducibleReductions && scanRounds<Op, Scalar>;
+			const bool fixedChunks	= reproducible && extent > reproducibleBlockSize;
+
+			if (reproducible ? !fixedChunks : (!parallel || numTasks >= threads || extent < 2)) {
+				indexingFor(numTasks, parallel ? size : 0, [&](int64_t task) {
+					Scalar carry[scanBlockWidth];
+					std::fill_n(carry, scanBlockWidth, identity);
+					scanTask(task, 0, extent, carry, true);
+				});
+				return;
+			}
+
+			// There are too few tasks to occupy every thread (or the chunks must have a fixed
+			// size), so split the axis into chunks
+			const int64_t numChunks =
+			  fixedChunks ? (extent + reproducibleBlockSize - 1) / reproducibleBlockSize
+						  : ::librapid::min(threads, extent);
+			std::vector<Scalar> carries(numChunks * scanBlockWidth);
+			for (int64_t task = 0; task < numTasks; ++task) {
+				indexingFor(numChunks, size, [&](int64_t chunk) {
+					Scalar *carry		= carries.data() + chunk * scanBlockWidth;
+					const int64_t first = chunk * extent / numChunks;
+					std::fill_n(carry, scanBlockWidth, identity);
+					scanTask(task, first, (chunk + 1) * extent / numChunks - first, carry, false);
+				});
+
+				// Replace the total of each chunk with the total of the chunks before it
+				for (int64_t k = 0; k < scanBlockWidth; ++k) {
+					Scalar running = identity;
+					for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+						const Scalar total					= carries[chunk * scanBlockWidth + k];
+						carries[chunk * scanBlockWidth + k] = running;
+						running								= Op::combine(running, total);
+					}
+				}
+
+				indexingFor(numChunks, size, [&](int64_t chunk) {
+					const int64_t first = chunk * extent / numChunks;
+					scanTask(task,
+							 first,
+							 (chunk + 1) * extent / numChunks - first,
+							 carries.data() + chunk * scanBlockWidth,
+							 true);
+				});
+			}
+		}
+
+		/// Scan an array on the host along `axis`, writing the result to `dst` (which may be
+		/// the array's own storage)
+		template<typename Op, typename ShapeType, typename Scalar>
+		void scanArray(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+					   Scalar *dst, int64_t axis, bool exclusive) {
+			int64_t outer, extent, inner;
+			std::tie(axis, outer, extent, inner) = splitAxis(array.shape(), axis);
+			scanImpl<Op>(array.storage().data(), dst, outer, extent, inner, exclusive);
+		}
+
+		template<typename Op, typename ShapeType, typename Scalar>
+		LIBRAPID_NODISCARD auto scan(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									 int64_t axis, bool exclusive) -> Array<Scalar, backend::CPU> {
+			Array<Scalar, backend::CPU> result((Shape(array.shape())));
+			scanArray<Op>(array, result.storage().data(), axis, exclusive);
+			return result;
+		}
+
+		/// Scan an evaluated expression in place
+		template<typename Op, typename ShapeType, typename Scalar>
+		LIBRAPID_NODISCARD auto scan(array::ArrayContainer<ShapeType, Storage<Scalar>> &&array,
+									 int64_t axis, bool exclusive) {
+			scanArray<Op>(array, array.storage().data(), axis, exclusive);
+			return std::move(array);
+		}
+
+		/// An array expression which must be evaluated before it can be scanned
+		template<typename T>
+		concept IsScanExpression =
+		  IsArrayOp<T> && !typetraits::IsArrayContainer<std::decay_t<T>>::value;
+	} // namespace detail
+
+	/// \brief Cumulative sum along an axis
+	///
+	/// Element j along `axis` of the result is the sum of elements 0 to j of the input, or of
+	/// elements 0 to j - 1 if `exclusive` is true. An exclusive scan of counts gives the offset
+	/// of each group in a packed output:
+	///
+	/// \code{.cpp}
+	/// auto offsets = lrc::cumsum(counts, -1, true); // {3, 1, 2} -> {0, 3, 4}
+	/// \endcode
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to scan
+	/// \param axis The axis to scan along (negative values count from the end)
+	/// \param exclusive Exclude each element from its own result
+	/// \return An array with the shape of the input
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto cumsum(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								   int64_t axis = -1, bool exclusive = false)
+	  -> Array<Scalar, backend::CPU> {
+		return detail::scan<detail::ScanSumOp>(array, axis, exclusive);
+	}
+
+	/// \brief Cumulative sum of an array expression along an axis. The expression is evaluated
+	/// once, and scanned in place
+	/// \see cumsum()
+	template<class VAL>
+		requires(detail::IsScanExpression<VAL>)
+	LIBRAPID_NODISCARD auto cumsum(VAL &&val, int64_t axis = -1, bool exclusive = false) {
+		return detail::scan<detail::ScanSumOp>(val.eval(), axis, exclusive);
+	}
+
+	/// \brief Cumulative product along an axis
+	///
+	/// Element j along `axis` of the result is the product of elements 0 to j of the input, or
+	/// of elements 0 to j - 1 (starting from 1) if `exclusive` is true.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to scan
+	/// \param axis The axis to scan along (negative values count from the end)
+	/// \param exclusive Exclude each element from its own result
+	/// \return An array with the shape of the input
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto cumprod(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									int64_t axis = -1, bool exclusive = false)
+	  -> Array<Scalar, backend::CPU> {
+		return detail::scan<detail::ScanProdOp>(array, axis, exclusive);
+	}
+
+	/// \brief Cumulative product of an array expression along an axis
+	/// \see cumprod()
+	template<class VAL>
+		requires(detail::IsScanExpression<VAL>)
+	LIBRAPID_NODISCARD auto cumprod(VAL &&val, int64_t axis = -1, bool exclusive = false) {
+		return detail::scan<detail::ScanProdOp>(val.eval(), axis, exclusive);
+	}
+
+	/// \brief Running maximum along an axis
+	///
+	/// Element j along `axis` of the result is the largest of elements 0 to j of the input, or
+	/// of elements 0 to j - 1 if `exclusive` is true (the first is then the lowest value of the
+	/// type, or -infinity). Once a NaN is reached, every later element is NaN.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to scan
+	/// \param axis The axis to scan along (negative values count from the end)
+	/// \param exclusive Exclude each element from its own result
+	/// \return An array with the shape of the input
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto cummax(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								   int64_t axis = -1, bool exclusive = false)
+	  -> Array<Scalar, backend::CPU> {
+		return detail::scan<detail::ScanMaxOp>(array, axis, exclusive);
+	}
+
+	/// \brief Running maximum of an array expression along an axis
+	/// \see cummax()
+	template<class VAL>
+		requires(detail::IsScanExpression<VAL>)
+	LIBRAPID_NODISCARD auto cummax(VAL &&val, int64_t axis = -1, bool exclusive = false) {
+		return detail::scan<detail::ScanMaxOp>(val.eval(), axis, exclusive);
+	}
+
+	/// \brief Running minimum along an axis
+	///
+	/// Element j along `axis` of the result is the smallest of elements 0 to j of the input,
+	/// or of elements 0 to j - 1 if `exclusive` is true (the first is then the largest value of
+	/// the type, or infinity). Once a NaN is reached, every later element is NaN.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to scan
+	/// \param axis The axis to scan along (negative values count from the end)
+	/// \param exclusive Exclude each element from its own result
+	/// \return An array with the shape of the input
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto cummin(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								   int64_t axis = -1, bool exclusive = false)
+	  -> Array<Scalar, backend::CPU> {
+		return detail::scan<detail::ScanMinOp>(array, axis, exclusive);
+	}
+
+	/// \brief Running minimum of an array expression along an axis
+	/// \see cummin()
+	template<class VAL>
+		requires(detail::IsScanExpression<VAL>)
+	LIBRAPID_NODISCARD auto cummin(VAL &&val, int64_t axis = -1, bool exclusive = false) {
+		return detail::scan<detail::ScanMinOp>(val.eval(), axis, exclusive);
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_SCAN_HPP
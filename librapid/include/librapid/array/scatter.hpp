@@ -0,0 +1,309 @@
+#ifndef LIBRAPID_ARRAY_SCATTER_HPP
+#define LIBRAPID_ARRAY_SCATTER_HPP
+
+/*
+ * Scatter-reductions (index_add / segment_sum). scatterAdd(out, indices, values) computes
+ * out[indices[i]] += values[i] for every i, and scatterMax and scatterMin do the same with max
+ * and min. Repeated indices accumulate. Each entry may also be a whole slice: if `out` has
+ * shape (m, ...), `values` has shape (n, ...) and row i of `values` is accumulated into row
+ * indices[i] of `out`.
+ *
+ * There are several ways to run this in parallel without two threads writing to the same
+ * element at once (see ScatterStrategy). By default, one is chosen based on the size of the
+ * output relative to the input.
+ *
+ * Out-of-range indices throw std::out_of_range in every build (see detail::normaliseIndices),
+ * since they would otherwise write outside `out`.
+ */
+
+namespace librapid {
+	/// How a scatter-reduction is evaluated
+	enum class ScatterStrategy {
+		/// Choose the fastest strategy based on the sizes of the input and output. Floating-point
+		/// values use the Deterministic strategy if global::reproducibleReductions is set
+		Auto,
+
+		/// Produce exactly the same result as a serial loop over the entries, independent of
+		/// the number of threads (uses the Sorted strategy when running in parallel)
+		Deterministic,
+
+		/// Each thread accumulates its entries into a private copy of the output, and the
+		/// copies are combined at the end. Fast when the output is small
+		Privatised,
+
+		/// Entries are grouped by target with a counting sort, and each group is reduced by one
+		/// thread, in order. Deterministic, and uses memory proportional to the input
+		Sorted,
+
+		/// Entries are accumulated directly into the output with atomic operations. Uses no
+		/// extra memory, but is slow when many entries share a target
+		Atomic
+	};
+
+	namespace detail {
+		struct ScatterAddOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				return T(0);
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return static_cast<T>(a + b);
+			}
+		};
+
+		struct ScatterMaxOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				return std::numeric_limits<T>::lowest();
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return b > a ? b : a;
+			}
+		};
+
+		struct ScatterMinOp {
+			template<typename T>
+			LIBRAPID_NODISCARD static constexpr T identity() {
+				return std::numeric_limits<T>::max();
+			}
+
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE static T combine(const T &a, const T &b) {
+				return b < a ? b : a;
+			}
+		};
+
+		/// True if a scatter-reduction into type T can use private accumulators and atomics
+		template<typename T>
+		constexpr bool scatterAllowsAtomics = []() {
+			if constexpr (std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8) {
+				return std::atomic_ref<T>::required_alignment == alignof(T);
+			} else {
+				return false;
+			}
+		}();
+
+		/// Atomically set `dst` to `Op::combine(dst, value)`
+		template<typename Op, typename T>
+		LIBRAPID_ALWAYS_INLINE void scatterAtomic(T &dst, const T &value) {
+			std::atomic_ref<T> ref(dst);
+			if constexpr (std::is_same_v<Op, ScatterAddOp>) {
+				ref.fetch_add(value, std::memory_order_relaxed);
+			} else {
+				T current = ref.load(std::memory_order_relaxed);
+				while (!ref.compare_exchange_weak(
+				  current, Op::combine(current, value), std::memory_order_relaxed)) {}
+			}
+		}
+
+		/// Choose the strategy for a scatter-reduction of `numEntries` slices of `inner`
+		/// elements into an output of `outSize` elements
+		template<typename Scalar>
+		LIBRAPID_NODISCARD ScatterStrategy scatterStrategy(ScatterStrategy requested,
+														   int64_t numEntries, int64_t inner,
+														   int64_t outSize) {
+			const int64_t work	= numEntries * inner;
+			const bool parallel = static_cast<size_t>(work) > global::multithreadThreshold &&
+								  global::numThreads > 1;
+
+			// A serial loop is both the fastest and deterministic for small inputs. Types
+			// without atomics use the sort, which has no requirements on the scalar type
+			if (requested == ScatterStrategy::Auto || requested == ScatterStrategy::Deterministic) {
+				if (!parallel) return ScatterStrategy::Deterministic;
+				// In reproducible mode, floating-point values are always reduced deterministically
+				if (requested == ScatterStrategy::Deterministic ||
+					(std::is_floating_point_v<Scalar> && global::reproducibleReductions)) {
+					return ScatterStrategy::Sorted;
+				}
+				if constexpr (!scatterAllowsAtomics<Scalar>) {
+					return ScatterStrategy::Sorted;
+				} else {
+					// Merging the private copies should cost no more than accumulating them
+					const int64_t copies = static_cast<int64_t>(global::numThreads);
+					if (outSize * copies <= work) return ScatterStrategy::Privatised;
+					return ScatterStrategy::Atomic;
+				}
+			}
+
+			if constexpr (!scatterAllowsAtomics<Scalar>) {
+				if (requested == ScatterStrategy::Privatised ||
+					requested == ScatterStrategy::Atomic) {
+					return ScatterStrategy::Sorted;
+				}
+			}
+			return requested;
+		}
+
+		/// Implementation of the scatter-reductions
+		/// \tparam Op The reduction (ScatterAddOp, ScatterMaxOp or ScatterMinOp)
+		/// \param out The array to accumulate into
+		/// \param indices The target of each entry
+		/// \param values The values to accumulate (an array, or a scalar used for every entry)
+		/// \param strategy How to evaluate the reduction
+		template<typename Op, typename ShapeType, typename Scalar, typename Indices,
+				 typename Values>
+		void scatterReduce(array::ArrayContainer<ShapeType, Storage<Scalar>> &out,
+						   const Indices &indices, const Values &values,
+						   ScatterStrategy strategy) {
+			int64_t axis, outer, extent, inner;
+			std::tie(axis, outer, extent, inner) = splitAxis(out.shape(), 0);
+			const auto [indexData, indexShape]	 = indexListData(indices);
+			const int64_t n						 = static_cast<int64_t>(indexShape.size());
+			const int64_t outSize				 = extent * inner;
+
+			std::vector<int64_t> buffer;
+			const int64_t *index = normaliseIndices(indexData, n, extent, buffer);
+			Scalar *dst			 = out.storage().data();
+
+			const Scalar *src = nullptr;
+			Scalar fill {};
+			if constexpr (IsArrayType<Values>::value) {
+				if (static_cast<int64_t>(values.size()) != n * inner) {
+					throw std::range_error(
+					  fmt::format("Scatter-reduction expected {} values, but received {}",
+								  n * inner,
+								  values.size()));
+				}
+				src = values.storage().data();
+			} else {
+				fill = static_cast<Scalar>(values);
+			}
+
+			// Accumulate entry i into a copy of the output starting at `target`
+			auto accumulate = [&](Scalar *target, int64_t i) {
+				Scalar *row = target + index[i] * inner;
+				for (int64_t k = 0; k < inner; ++k) {
+					row[k] = Op::combine(row[k], src ? src[i * inner + k] : fill);
+				}
+			};
+
+			switch (scatterStrategy<Scalar>(strategy, n, inner, outSize)) {
+				case ScatterStrategy::Privatised: {
+					if constexpr (scatterAllowsAtomics<Scalar>) {
+						// Each chunk of entries has its own copy of the output
+						const int64_t numChunks = static_cast<int64_t>(global::numThreads);
+						std::vector<Scalar> copies(numChunks * outSize,
+												   Op::template identity<Scalar>());
+						indexingFor(numChunks, n * inner, [&](int64_t chunk) {
+							const int64_t end = (chunk + 1) * n / numChunks;
+							for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+								accumulate(copies.data() + chunk * outSize, i);
+							}
+						});
+
+						indexingFor(outSize, outSize * numChunks, [&](int64_t j) {
+							for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+								dst[j] = Op::combine(dst[j], copies[chunk * outSize + j]);
+							}
+						});
+					}
+					break;
+				}
+				case ScatterStrategy::Atomic: {
+					if constexpr (scatterAllowsAtomics<Scalar>) {
+						indexingFor(n, n * inner, [&](int64_t i) {
+							Scalar *row = dst + index[i] * inner;
+							for (int64_t k = 0; k < inner; ++k) {
+								scatterAtomic<Op>(row[k], src ? src[i * inner + k] : fill);
+							}
+						});
+					}
+					break;
+				}
+				case ScatterStrategy::Sorted: {
+					// Stable counting sort of the entries by target, so each target is reduced
+					// in the original order
+					std::vector<int64_t> offsets(extent + 1, 0);
+					for (int64_t i = 0; i < n; ++i) ++offsets[index[i] + 1];
+					for (int64_t t = 0; t < extent; ++t) offsets[t + 1] += offsets[t];
+
+					std::vector<int64_t> order(n);
+					std::vector<int64_t> position(offsets.begin(), offsets.end() - 1);
+					for (int64_t i = 0; i < n; ++i) order[position[index[i]]++] = i;
+
+					indexingFor(extent, n * inner, [&](int64_t t) {
+						for (int64_t e = offsets[t]; e < offsets[t + 1]; ++e) {
+							accumulate(dst, order[e]);
+						}
+					});
+					break;
+				}
+				default: {
+					for (int64_t i = 0; i < n; ++i) accumulate(dst, i);
+					break;
+				}
+			}
+		}
+	} // namespace detail
+
+	/// \brief Add values to an array at the given indices
+	///
+	/// For every entry i, computes `out[indices[i]] += values[i]`. Repeated indices accumulate,
+	/// which makes this suitable for segment sums and histograms. If `out` has more than one
+	/// dimension, `values` holds one slice (of the shape of `out[0]`) per index. `values` may
+	/// also be a scalar, which is added for every index.
+	///
+	/// \code{.cpp}
+	/// // Sum the values in each segment
+	/// auto sums = lrc::zeros<float>(lrc::Shape({numSegments}));
+	/// lrc::scatterAdd(sums, segmentIds, values);
+	/// \endcode
+	///
+	/// \tparam ShapeType The shape type of the output
+	/// \tparam Scalar The scalar type of the output
+	/// \tparam Indices The type of the index list (std::vector or Array of integers)
+	/// \tparam Values The type of the values (a host array or a scalar)
+	/// \param out The array to accumulate into
+	/// \param indices The position to accumulate each value into
+	/// \param values The values to accumulate
+	/// \param strategy How to evaluate the reduction in parallel (see ScatterStrategy)
+	template<typename ShapeType, typename Scalar, typename Indices, typename Values>
+	void scatterAdd(array::ArrayContainer<ShapeType, Storage<Scalar>> &out, const Indices &indices,
+					const Values &values, ScatterStrategy strategy = ScatterStrategy::Auto) {
+		detail::scatterReduce<detail::ScatterAddOp>(out, indices, values, strategy);
+	}
+
+	/// \brief Take the maximum of an array and values at the given indices
+	///
+	/// For every entry i, computes `out[indices[i]] = max(out[indices[i]], values[i])`. See
+	/// scatterAdd() for details.
+	///
+	/// \tparam ShapeType The shape type of the output
+	/// \tparam Scalar The scalar type of the output
+	/// \tparam Indices The type of the index list (std::vector or Array of integers)
+	/// \tparam Values The type of the values (a host array or a scalar)
+	/// \param out The array to accumulate into
+	/// \param indices The position to accumulate each value into
+	/// \param values The values to accumulate
+	/// \param strategy How to evaluate the reduction in parallel (see ScatterStrategy)
+	template<typename ShapeType, typename Scalar, typename Indices, typename Values>
+	void scatterMax(array::ArrayContainer<ShapeType, Storage<Scalar>> &out, const Indices &indices,
+					const Values &values, ScatterStrategy strategy = ScatterStrategy::Auto) {
+		detail::scatterReduce<detail::ScatterMaxOp>(out, indices, values, strategy);
+	}
+
+	/// \brief Take the minimum of an array and values at the given indices
+	///
+	/// For every entry i, computes `out[indices[i]] = min(out[indices[i]], values[i])`. See
+	/// scatterAdd() for details.
+	///
+	/// \tparam ShapeType The shape type of the output
+	/// \tparam Scalar The scalar type of the output
+	/// \tparam Indices The type of the index list (std::vector or Array of integers)
+	/// \tparam Values The type of the values (a host array or a scalar)
+	/// \param out The array to accumulate into
+	/// \param indices The position to accumulate each value into
+	/// \param values The values to accumulate
+	/// \param strategy How to evaluate the reduction in parallel (see ScatterStrategy)
+	template<typename ShapeType, typename Scalar, typename Indices, typename Values>
+	void scatterMin(array::ArrayContainer<ShapeType, Storage<Scalar>> &out, const Indices &indices,
+					const Values &values, ScatterStrategy strategy = ScatterStrategy::Auto) {
+		detail::scatterReduce<detail::ScatterMinOp>(out, indices, values, strategy);
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_SCATTER_HPP
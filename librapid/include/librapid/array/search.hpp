@@ -0,0 +1,468 @@
+#ifndef LIBRAPID_ARRAY_SEARCH_HPP
+#define LIBRAPID_ARRAY_SEARCH_HPP
+
+/*
+ * Searching in sorted edges:
+ *
+ *  - searchsorted(edges, values, side) returns the position at which each value would be
+ *    inserted into `edges` to keep them sorted.
+ *  - digitize(values, bins, right) returns the index of the bin containing each value.
+ *  - interp(x, xp, fp) evaluates the piecewise-linear function through the points (xp, fp).
+ *
+ * The edges are copied into a detail::SortedSearch table when the function is called. Queries
+ * use a branchless binary search over the edges in Eytzinger (breadth-first) order: the top
+ * levels of the tree share a few cache lines, every query takes the same number of steps, and
+ * the nodes four levels down are prefetched while the current level is compared. If the edges
+ * are (close to) uniformly spaced, the position is instead computed directly and corrected
+ * with one or two comparisons.
+ *
+ * All three return lazily evaluated detail::Function objects, so they fuse with the
+ * surrounding expression (for example, `lrc::digitize(x * scale, bins)`) and are evaluated in
+ * parallel over the queries. NaNs are treated as larger than every edge.
+ *
+ * Values of a different type to the edges are compared with them in the common type of the two
+ * (see detail::SearchCompare), so a value of 10.5 is placed after an integer edge of 10, rather
+ * than being truncated to it.
+ */
+
+namespace librapid {
+	/// Which position searchsorted() returns for values equal to an edge
+	enum class SearchSide {
+		Left, ///< The first suitable position, so that `edges[i - 1] < value <= edges[i]`
+		Right ///< The last suitable position, so that `edges[i - 1] <= value < edges[i]`
+	};
+
+	namespace detail {
+		/// The element type of a list of edges (a std::vector or a host Array)
+		template<typename Edges>
+		using SearchScalar = std::remove_cv_t<
+		  std::remove_pointer_t<decltype(indexListData(std::declval<const Edges &>()).first)>>;
+
+		/// The type in which a value of type V is compared with edges of type Scalar
+		template<typename Scalar, typename V>
+		using SearchCompare =
+		  typename std::conditional_t<std::is_arithmetic_v<Scalar> && std::is_arithmetic_v<V>,
+									  std::common_type<Scalar, V>,
+									  std::type_identity<Scalar>>::type;
+
+		/// Return a pointer to a list of edges, and the number of edges. The edges must be
+		/// one-dimensional
+		template<typename Edges>
+		LIBRAPID_NODISCARD auto searchEdges(const Edges &edges) {
+			const auto [data, shape] = indexListData(edges);
+			if (shape.ndim() != 1) {
+				throw std::invalid_argument(
+				  fmt::format("Edges must be one-dimensional. Received shape {}", shape));
+			}
+			return std::make_pair(data, static_cast<int64_t>(shape.size()));
+		}
+
+		/// A sorted list of edges, arranged for fast searching
+		/// \tparam Scalar The type of the edges
+		template<typename Scalar>
+		class SortedSearch {
+		public:
+			/// Copy and index a list of edges, which must be in ascending order and (for
+			/// floating point types) must not contain NaNs
+			/// \param edges Pointer to the edges
+			/// \param n The number of edges
+			SortedSearch(const Scalar *edges, int64_t n) : m_edges(edges, edges + n), m_size(n) {
+				for (int64_t i = 0; i < n; ++i) {
+					if (edges[i] != edges[i] || (i > 0 && edges[i] < edges[i - 1])) {
+						throw std::invalid_argument(
+						  fmt::format("Edges must be sorted in ascending order and must not "
+									  "contain NaNs. Found {} at position {}",
+									  edges[i],
+									  i));
+					}
+				}
+
+				if (!detectUniform()) buildTree();
+			}
+
+			/// \return The number of edges
+			LIBRAPID_NODISCARD int64_t size() const { return m_size; }
+
+			/// \return The edges, in ascending order
+			LIBRAPID_NODISCARD const Scalar *edges() const { return m_edges.data(); }
+
+			/// \return True if the edges are uniformly spaced, so queries skip the search
+			LIBRAPID_NODISCARD bool uniform() const { return m_uniform; }
+
+			/// Find the position at which `value` would be inserted into the edges. The value is
+			/// compared with the edges in SearchCompare<Scalar, V>, and is never converted to
+			/// Scalar
+			/// \tparam V The type of the value
+			/// \param value The value to search for
+			/// \param side Which position to return for values equal to an edge
+			/// \return The position, in the range [0, size()]
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t find(const V &value,
+																  SearchSide side) const {
+				using Compare		= SearchCompare<Scalar, V>;
+				const Compare query = static_cast<Compare>(value);
+				if (query != query) return m_size;
+				if (m_uniform) return findUniform(query, side);
+				return side == SearchSide::Left ? findTree<false>(query) : findTree<true>(query);
+			}
+
+		private:
+			/// The tree is padded with the largest value of the type, so that it is complete
+			LIBRAPID_NODISCARD static constexpr Scalar padding() {
+				if constexpr (std::numeric_limits<Scalar>::has_infinity) {
+					return std::numeric_limits<Scalar>::infinity();
+				} else {
+					return std::numeric_limits<Scalar>::max();
+				}
+			}
+
+			/// Store the edges in the breadth-first order of a complete binary search tree of
+			/// 2^levels - 1 nodes, with the root at index 1 and the children of node k at 2k
+			/// and 2k + 1
+			void buildTree() {
+				m_levels			= std::bit_width(static_cast<uint64_t>(m_size));
+				const int64_t nodes = int64_t(1) << m_levels;
+				m_tree.assign(nodes, padding());
+
+				int64_t next = 0;
+				fillTree(1, next);
+			}
+
+			/// Visit the subtree rooted at \p node in order, assigning it the edges from
+			/// position \p next onwards
+			/// \param node The root of the subtree
+			/// \param next The position of the next edge to assign (updated)
+			void fillTree(int64_t node, int64_t &next) {
+				if (node >= static_cast<int64_t>(m_tree.size())) return;
+				fillTree(2 * node, next);
+				if (next < m_size) m_tree[node] = m_edges[next];
+				++next;
+				fillTree(2 * node + 1, next);
+			}
+
+			/// Check whether every edge lies within a quarter of a step of a uniform grid
+			/// between the first and last edges
+			/// \return True if the edges are uniform
+			bool detectUniform() {
+				if (m_size < 2) return false;
+
+				const double first = static_cast<double>(m_edges.front());
+				const double step =
+				  (static_cast<double>(m_edges.back()) - first) / static_cast<double>(m_size - 1);
+				if (!(step > 0) || !std::isfinite(step)) return false;
+
+				for (int64_t i = 0; i < m_size; ++i) {
+					const double expected = first + static_cast<double>(i) * step;
+					if (std::abs(static_cast<double>(m_edges[i]) - expected) > step * 0.25) {
+						return false;
+					}
+				}
+
+				m_first	  = first;
+				m_invStep = 1.0 / step;
+				m_uniform = true;
+				return true;
+			}
+
+			/// Search the tree. After `levels` steps, the position of the node reached among
+			/// the 2^levels gaps between nodes is the number of edges less than the value (or
+			/// less than or equal to it, for SearchSide::Right)
+			template<bool Right, typename Compare>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t findTree(Compare value) const {
+				const Scalar *tree = m_tree.data();
+				uint64_t node	   = 1;
+				for (int64_t level = 0; level < m_levels; ++level) {
+					// The descendants of a node four levels down are contiguous
+					prefetchRead(tree + 16 * node);
+					const Compare edge = static_cast<Compare>(tree[node]);
+					const bool goRight = Right ? !(value < edge) : edge < value;
+					node			   = 2 * node + goRight;
+				}
+				const int64_t pos = static_cast<int64_t>(node - (uint64_t(1) << m_levels));
+				return ::librapid::min(pos, m_size);
+			}
+
+			/// Compute the position of a value on the uniform grid, then correct it with the
+			/// actual edges, so the result is exact even if the edges are not quite uniform
+			template<typename Compare>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t findUniform(Compare value,
+																		 SearchSide side) const {
+				const double guess = (static_cast<double>(value) - m_first) * m_invStep + 1;
+				int64_t pos =
+				  static_cast<int64_t>(::librapid::clamp(guess, 0.0, static_cast<double>(m_size)));
+
+				auto edge = [this](int64_t i) { return static_cast<Compare>(m_edges[i]); };
+				if (side == SearchSide::Left) {
+					while (pos > 0 && !(edge(pos - 1) < value)) --pos;
+					while (pos < m_size && edge(pos) < value) ++pos;
+				} else {
+					while (pos > 0 && value < edge(pos - 1)) --pos;
+					while (pos < m_size && !(value < edge(pos))) ++pos;
+				}
+				return pos;
+			}
+
+			std::vector<Scalar> m_edges;
+			std::vector<Scalar> m_tree;
+			int64_t m_size	 = 0;
+			int64_t m_levels = 0;
+			bool m_uniform	 = false;
+			double m_first	 = 0;
+			double m_invStep = 0;
+		};
+
+		/// A piecewise-linear function through a list of points, evaluated by interp()
+		/// \tparam Scalar The (floating point) type of the points
+		template<typename Scalar>
+		class PiecewiseLinear {
+		public:
+			static_assert(std::is_floating_point_v<Scalar>,
+						  "Interpolation requires floating point values");
+
+			/// \param xp The x coordinates of the points, in ascending order
+			/// \param fp The y coordinates of the points
+			/// \param n The number of points (at least one)
+			/// \param left The value returned for x < xp[0]
+			/// \param right The value returned for x > xp[n - 1]
+			PiecewiseLinear(const Scalar *xp, const Scalar *fp, int64_t n, Scalar left,
+							Scalar right) :
+					m_search(xp, n),
+					m_fp(fp, fp + n), m_slopes(n, Scalar(0)), m_left(left), m_right(right) {
+				// Segments of zero width are never evaluated, so their slope is left as zero
+				for (int64_t i = 0; i + 1 < n; ++i) {
+					const Scalar width = xp[i + 1] - xp[i];
+					if (width > Scalar(0)) m_slopes[i] = (fp[i + 1] - fp[i]) / width;
+				}
+			}
+
+			/// Evaluate the function at `value`, which is compared with the points in
+			/// SearchCompare<Scalar, V>
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Scalar operator()(const V &value) const {
+				using Compare	= SearchCompare<Scalar, V>;
+				const Compare x = static_cast<Compare>(value);
+				if (x != x) return static_cast<Scalar>(x);
+
+				// The number of points with xp <= x, so xp[i - 1] <= x < xp[i]
+				const int64_t i		= m_search.find(x, SearchSide::Right);
+				const int64_t n		= m_search.size();
+				const Scalar *edges = m_search.edges();
+				if (i == 0) return m_left;
+				if (i == n) return x == static_cast<Compare>(edges[n - 1]) ? m_fp[n - 1] : m_right;
+
+				const Compare offset = x - static_cast<Compare>(edges[i - 1]);
+				return static_cast<Scalar>(m_fp[i - 1] + m_slopes[i - 1] * offset);
+			}
+
+		private:
+			SortedSearch<Scalar> m_search;
+			std::vector<Scalar> m_fp;
+			std::vector<Scalar> m_slopes;
+			Scalar m_left;
+			Scalar m_right;
+		};
+
+		/// Functor finding the position of each element of its argument in a SortedSearch.
+		/// The table is shared, so copying the functor (and the Function holding it) is cheap
+		/// \tparam Scalar The type of the edges
+		template<typename Scalar>
+		struct SearchSorted {
+			std::shared_ptr<const SortedSearch<Scalar>> table;
+			SearchSide side;
+
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const V &val) const
+			  -> int64_t {
+				return table->find(val, side);
+			}
+		};
+
+		/// Functor evaluating a PiecewiseLinear function at each element of its argument
+		/// \tparam Scalar The type of the points
+		template<typename Scalar>
+		struct Interp {
+			std::shared_ptr<const PiecewiseLinear<Scalar>> table;
+
+			template<typename V>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const V &val) const
+			  -> Scalar {
+				return (*table)(val);
+			}
+		};
+	} // namespace detail
+
+	namespace typetraits {
+		template<typename Scalar>
+		struct TypeInfo<::librapid::detail::SearchSorted<Scalar>> {
+			static constexpr const char *name		= "searchsorted";
+			static constexpr const char *filename	= "searchsorted";
+			static constexpr const char *kernelName = "searchsorted";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+
+		template<typename Scalar>
+		struct TypeInfo<::librapid::detail::Interp<Scalar>> {
+			static constexpr const char *name		= "interp";
+			static constexpr const char *filename	= "interp";
+			static constexpr const char *kernelName = "interp";
+			LIBRAPID_UNARY_SHAPE_EXTRACTOR
+		};
+
+		// Each element is a separate search through a table, which has no packet equivalent
+		template<typename Scalar, typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::SearchSorted<Scalar>, Args...>
+				: std::false_type {};
+
+		template<typename Scalar, typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Interp<Scalar>, Args...>
+				: std::false_type {};
+	} // namespace typetraits
+
+	/// \brief Find the positions at which values would be inserted into a sorted list of edges
+	///
+	/// Returns a lazily evaluated function object of int64_t positions. For SearchSide::Left,
+	/// the position `i` of a value satisfies `edges[i - 1] < value <= edges[i]`, and for
+	/// SearchSide::Right, `edges[i - 1] <= value < edges[i]`. NaNs are placed after every edge.
+	///
+	/// \code{.cpp}
+	/// std::vector<float> edges = {0.0f, 1.0f, 2.5f};
+	/// auto pos = lrc::searchsorted(edges, values); // Array of positions in [0, 3]
+	/// \endcode
+	///
+	/// \tparam Edges The type of the edges (std::vector or host Array)
+	/// \tparam VAL The type of the values
+	/// \param edges The edges, in ascending order
+	/// \param values The array or function of values to search for
+	/// \param side Which position to return for values equal to an edge
+	/// \return SearchSorted function object
+	template<typename Edges, class VAL>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD auto searchsorted(const Edges &edges, VAL &&values,
+										 SearchSide side = SearchSide::Left)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>,
+						  detail::SearchSorted<detail::SearchScalar<Edges>>, VAL> {
+		using Scalar			 = detail::SearchScalar<Edges>;
+		using Functor			 = detail::SearchSorted<Scalar>;
+		const auto [data, count] = detail::searchEdges(edges);
+		return detail::Function<typetraits::DescriptorType_t<VAL>, Functor, VAL>(
+		  Functor {std::make_shared<const detail::SortedSearch<Scalar>>(data, count), side},
+		  std::forward<VAL>(values));
+	}
+
+	/// \brief Find the bin containing each value
+	///
+	/// The bins are given by their ascending edges. Value `x` is in bin `i` if
+	/// `bins[i - 1] <= x < bins[i]`, or `bins[i - 1] < x <= bins[i]` if \p right is true. Values
+	/// below the first edge are in bin 0, and values above the last edge are in bin
+	/// `bins.size()`.
+	///
+	/// \tparam VAL The type of the values
+	/// \tparam Bins The type of the edges (std::vector or host Array)
+	/// \param values The array or function of values
+	/// \param bins The bin edges, in ascending order
+	/// \param right Whether the bins include their right edge instead of their left
+	/// \return SearchSorted function object
+	template<class VAL, typename Bins>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD auto digitize(VAL &&values, const Bins &bins, bool right = false) {
+		return searchsorted(
+		  bins, std::forward<VAL>(values), right ? SearchSide::Left : SearchSide::Right);
+	}
+
+	/// \brief Evaluate the piecewise-linear function through a list of points
+	///
+	/// Values of \p x below `xp[0]` return \p left, and values above the last point return
+	/// \p right. The function is returned lazily, and the table of points and slopes is shared
+	/// by every element.
+	///
+	/// \tparam VAL The type of the x values
+	/// \tparam Points The type of the points (std::vector or host Array)
+	/// \param x The array or function of x coordinates to evaluate the function at
+	/// \param xp The x coordinates of the points, in ascending order
+	/// \param fp The y coordinates of the points
+	/// \param left The value for x below `xp[0]`
+	/// \param right The value for x above the last point
+	/// \return Interp function object
+	template<class VAL, typename Points>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD auto interp(VAL &&x, const Points &xp, const Points &fp,
+								   detail::SearchScalar<Points> left,
+								   detail::SearchScalar<Points> right)
+	  -> detail::Function<typetraits::DescriptorType_t<VAL>,
+						  detail::Interp<detail::SearchScalar<Points>>, VAL> {
+		using Scalar  = detail::SearchScalar<Points>;
+		using Functor = detail::Interp<Scalar>;
+
+		const auto [xData, xCount] = detail::searchEdges(xp);
+		const auto [fData, fCount] = detail::searchEdges(fp);
+		if (xCount != fCount || xCount == 0) {
+			throw std::invalid_argument(
+			  fmt::format("xp and fp must be non-empty and have the same length. Received {} "
+						  "and {}",
+						  xCount,
+						  fCount));
+		}
+
+		return detail::Function<typetraits::DescriptorType_t<VAL>, Functor, VAL>(
+		  Functor {std::make_shared<const detail::PiecewiseLinear<Scalar>>(
+			xData, fData, xCount, left, right)},
+		  std::forward<VAL>(x));
+	}
+
+	/// \brief Evaluate the piecewise-linear function through a list of points, using the first
+	/// and last values of \p fp outside the range of \p xp
+	/// \tparam VAL The type of the x values
+	/// \tparam Points The type of the points (std::vector or host Array)
+	/// \param x The array or function of x coordinates to evaluate the function at
+	/// \param xp The x coordinates of the points, in ascending order
+	/// \param fp The y coordinates of the points
+	/// \return Interp function object
+	template<class VAL, typename Points>
+		requires(detail::IsArrayOp<VAL>)
+	LIBRAPID_NODISCARD auto interp(VAL &&x, const Points &xp, const Points &fp) {
+		const auto [fData, fCount] = detail::searchEdges(fp);
+		if (fCount == 0) throw std::invalid_argument("fp must contain at least one value");
+		return interp(std::forward<VAL>(x), xp, fp, fData[0], fData[fCount - 1]);
+	}
+
+	// There are no device kernels for searching, so it is evaluated on the host
+#if defined(LIBRAPID_HAS_OPENCL)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename Scalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, SearchSorted<Scalar>, Args...>
+				 &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename Scalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Interp<Scalar>, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL
+
+#if defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename Scalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, SearchSorted<Scalar>, Args...>
+				 &function) {
+			mapAssignOnHost(lhs, function);
+		}
+
+		template<typename ShapeType_, typename StorageScalar, typename Scalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Interp<Scalar>, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_CUDA
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_SEARCH_HPP
@@ -0,0 +1,629 @@
+#ifndef LIBRAPID_ARRAY_SORT_HPP
+#define LIBRAPID_ARRAY_SORT_HPP
+
+/*
+ * Sorting and selection along an axis of a host array: sort(), stableSort(), argsort(),
+ * stableArgsort(), partition(), nthElement() and topK(). Each row (the elements along the axis,
+ * for every position in the other dimensions) is processed independently, and many rows are
+ * processed in parallel. A single long row is sorted in parallel instead.
+ *
+ * The algorithm depends on the length of the rows and the scalar type:
+ *
+ *  - Many short rows (up to 16 elements) of arithmetic types are sorted with a Batcher
+ *    odd-even merge sorting network, with one SIMD lane per row (except by stableSort()).
+ *  - Long rows of integers and floating point values are sorted with an LSD radix sort on
+ *    8-bit digits (skipping digits which are the same for every key). This is stable, and is
+ *    parallelised by giving each thread its own histograms.
+ *  - Other rows, and other types, use comparison sorts. Long rows are sorted in chunks, which
+ *    are then merged in parallel.
+ *
+ * NaNs are ordered after every other value.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// Less-than comparison which orders NaNs after all other values
+		struct SortLess {
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool operator()(const T &a,
+																	  const T &b) const {
+				if constexpr (std::is_floating_point_v<T>) {
+					return a < b || (b != b && a == a);
+				} else {
+					return a < b;
+				}
+			}
+		};
+
+		/// Rows shorter than this are sorted by comparison, rather than with a radix sort
+		constexpr int64_t radixSortThreshold = 256;
+
+		/// Rows up to this length may be sorted with a sorting network
+		constexpr int64_t sortingNetworkMaxSize = 16;
+
+		/// True if T can be sorted with a radix sort
+		template<typename T>
+		constexpr bool radixSortable =
+		  std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+		/// The unsigned integer type used as the radix sort key for T
+		template<typename T>
+		using RadixKey = std::conditional_t<
+		  sizeof(T) == 1, uint8_t,
+		  std::conditional_t<sizeof(T) == 2, uint16_t,
+							 std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+		/// Map a value to an unsigned integer with the same ordering (see SortLess)
+		template<typename T>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE RadixKey<T> toRadixKey(const T &value) {
+			using Key			  = RadixKey<T>;
+			constexpr Key signBit = Key(1) << (sizeof(T) * 8 - 1);
+			if constexpr (std::is_floating_point_v<T>) {
+				if (value != value) return ~Key(0);
+				const Key bits = std::bit_cast<Key>(value);
+				return (bits & signBit) ? Key(~bits) : Key(bits | signBit);
+			} else if constexpr (std::is_signed_v<T>) {
+				return static_cast<Key>(static_cast<Key>(value) ^ signBit);
+			} else {
+				return static_cast<Key>(value);
+			}
+		}
+
+		/// The inverse of toRadixKey() (NaNs are returned as a quiet NaN)
+		template<typename T>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE T fromRadixKey(const RadixKey<T> &key) {
+			using Key			  = RadixKey<T>;
+			constexpr Key signBit = Key(1) << (sizeof(T) * 8 - 1);
+			if constexpr (std::is_floating_point_v<T>) {
+				return std::bit_cast<T>((key & signBit) ? Key(key & ~signBit) : Key(~key));
+			} else {
+				return static_cast<T>(key ^ (std::is_signed_v<T> ? signBit : Key(0)));
+			}
+		}
+
+		/// Stable LSD radix sort of `n` keys, moving `indices` (if not null) with them. The keys
+		/// are split into `numChunks` chunks, each with its own histogram, which are processed
+		/// in parallel
+		template<typename Key>
+		void radixSort(Key *keys, int64_t *indices, int64_t n, int64_t numChunks) {
+			constexpr int64_t radix = 256;
+			const int64_t work		= numChunks > 1 ? n : 0;
+			std::vector<Key> keyBuffer(n);
+			std::vector<int64_t> indexBuffer(indices ? n : 0);
+			std::vector<int64_t> counts(numChunks * radix);
+
+			Key *src = keys, *dst = keyBuffer.data();
+			int64_t *indexSrc = indices, *indexDst = indexBuffer.data();
+
+			for (int64_t shift = 0; shift < static_cast<int64_t>(sizeof(Key)) * 8; shift += 8) {
+				std::fill(counts.begin(), counts.end(), 0);
+				indexingFor(numChunks, work, [&](int64_t chunk) {
+					int64_t *count	  = counts.data() + chunk * radix;
+					const int64_t end = (chunk + 1) * n / numChunks;
+					for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+						++count[(src[i] >> shift) & (radix - 1)];
+					}
+				});
+
+				// Convert the counts into the position of each chunk's first key with each
+				// digit, skipping the pass if every key has the same digit
+				bool skip		= false;
+				int64_t running = 0;
+				for (int64_t digit = 0; digit < radix; ++digit) {
+					const int64_t first = running;
+					for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+						const int64_t count			  = counts[chunk * radix + digit];
+						counts[chunk * radix + digit] = running;
+						running += count;
+					}
+					skip |= running - first == n;
+				}
+				if (skip) continue;
+
+				indexingFor(numChunks, work, [&](int64_t chunk) {
+					int64_t *offset	  = counts.data() + chunk * radix;
+					const int64_t end = (chunk + 1) * n / numChunks;
+					for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+						const int64_t pos = offset[(src[i] >> shift) & (radix - 1)]++;
+						dst[pos]		  = src[i];
+						if (indexSrc) indexDst[pos] = indexSrc[i];
+					}
+				});
+
+				std::swap(src, dst);
+				std::swap(indexSrc, indexDst);
+			}
+
+			if (src != keys) {
+				std::copy_n(src, n, keys);
+				if (indices) std::copy_n(indexSrc, n, indices);
+			}
+		}
+
+		/// Sort `n` elements. With more than one chunk, the chunks are sorted in parallel and
+		/// then merged in pairs, in parallel
+		template<typename T, typename Compare>
+		void mergeSort(T *data, int64_t n, Compare comp, bool stable, int64_t numChunks) {
+			auto sortRange = [&](T *begin, T *end) {
+				if (stable) {
+					std::stable_sort(begin, end, comp);
+				} else {
+					std::sort(begin, end, comp);
+				}
+			};
+
+			if (numChunks <= 1 || n < numChunks * 2) {
+				sortRange(data, data + n);
+				return;
+			}
+
+			const int64_t chunkSize = (n + numChunks - 1) / numChunks;
+			indexingFor(numChunks, n, [&](int64_t chunk) {
+				const int64_t begin = ::librapid::min(n, chunk * chunkSize);
+				sortRange(data + begin, data + ::librapid::min(n, begin + chunkSize));
+			});
+
+			// std::merge takes equal elements from the first range first, so merging is stable
+			std::vector<T> buffer(n);
+			T *src = data, *dst = buffer.data();
+			for (int64_t width = chunkSize; width < n; width *= 2) {
+				const int64_t numPairs = (n + 2 * width - 1) / (2 * width);
+				indexingFor(numPairs, n, [&](int64_t pair) {
+					const int64_t begin = pair * 2 * width;
+					const int64_t mid	= ::librapid::min(n, begin + width);
+					const int64_t end	= ::librapid::min(n, begin + 2 * width);
+					std::merge(src + begin, src + mid, src + mid, src + end, dst + begin, comp);
+				});
+				std::swap(src, dst);
+			}
+
+			if (src != data) std::copy_n(src, n, data);
+		}
+
+		/// Return the comparators of a Batcher odd-even merge sorting network for n elements
+		LIBRAPID_NODISCARD inline auto sortingNetwork(int64_t n) {
+			// Build the network for the next power of two. Padding elements compare greater
+			// than everything, so any comparator involving them can be dropped
+			int64_t size = 1;
+			while (size < n) size *= 2;
+
+			std::vector<std::pair<int64_t, int64_t>> network;
+			for (int64_t p = 1; p < size; p *= 2) {
+				for (int64_t k = p; k >= 1; k /= 2) {
+					for (int64_t j = k % p; j + k < size; j += 2 * k) {
+						for (int64_t i = 0; i < ::librapid::min(k, size - j - k); ++i) {
+							const int64_t a = i + j, b = i + j + k;
+							if (a / (2 * p) == b / (2 * p) && b < n) network.emplace_back(a, b);
+						}
+					}
+				}
+			}
+			return network;
+		}
+
+		/// The rows along an axis of an array. Row r starts at element base(r), and consecutive
+		/// elements of a row are `inner` elements apart
+		struct RowLayout {
+			int64_t numRows;
+			int64_t extent;
+			int64_t inner;
+
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t base(int64_t row) const {
+				return (row / inner) * extent * inner + row % inner;
+			}
+		};
+
+		template<typename ShapeType>
+		LIBRAPID_NODISCARD RowLayout rowLayout(const ShapeType &shape, int64_t &axis) {
+			int64_t outer, extent, inner;
+			std::tie(axis, outer, extent, inner) = splitAxis(shape, axis);
+			return {outer * inner, extent, inner};
+		}
+
+		/// Return `shape`, with the dimension `axis` replaced by `extent`, or removed if
+		/// `extent` is negative
+		template<typename ShapeType>
+		LIBRAPID_NODISCARD Shape replaceAxis(const ShapeType &shape, int64_t axis,
+											 int64_t extent) {
+			std::vector<int64_t> dims;
+			for (int64_t i = 0; i < shape.ndim(); ++i) {
+				if (i != axis) {
+					dims.push_back(shape[i]);
+				} else if (extent >= 0) {
+					dims.push_back(extent);
+				}
+			}
+			if (dims.empty()) dims.push_back(1);
+			return Shape(dims);
+		}
+
+		/// Call `func(row, buffer, numChunks)` for every row, where `buffer` holds a contiguous
+		/// copy of the row (or points to the row itself, if it is contiguous), and `numChunks`
+		/// is the number of threads available to process the row. Changes made to the buffer
+		/// are written back to `data`
+		template<typename Scalar, typename Func>
+		void forEachRow(Scalar *data, const RowLayout &layout, Func &&func) {
+			const int64_t size	= layout.numRows * layout.extent;
+			const bool parallel = static_cast<size_t>(size) > global::multithreadThreshold &&
+								  global::numThreads > 1;
+			const int64_t threads = static_cast<int64_t>(global::numThreads);
+
+			auto processRow = [&](int64_t row, int64_t numChunks) {
+				Scalar *rowData = data + layout.base(row);
+				if (layout.inner == 1) {
+					func(row, rowData, numChunks);
+					return;
+				}
+
+				thread_local std::vector<Scalar> buffer;
+				buffer.resize(layout.extent);
+				for (int64_t j = 0; j < layout.extent; ++j) buffer[j] = rowData[j * layout.inner];
+				func(row, buffer.data(), numChunks);
+				for (int64_t j = 0; j < layout.extent; ++j) rowData[j * layout.inner] = buffer[j];
+			};
+
+			if (!parallel || layout.numRows >= threads) {
+				indexingFor(layout.numRows, size, [&](int64_t row) { processRow(row, 1); });
+			} else {
+				for (int64_t row = 0; row < layout.numRows; ++row) processRow(row, threads);
+			}
+		}
+
+		/// Sort the rows of a host array with a sorting network, with one SIMD lane per row
+		template<typename Scalar>
+		void sortShortRows(Scalar *data, const RowLayout &layout) {
+			using Packet			= typename typetraits::TypeInfo<Scalar>::Packet;
+			constexpr int64_t width = typetraits::TypeInfo<Scalar>::packetWidth;
+			const auto network		= sortingNetwork(layout.extent);
+			const int64_t numBlocks = (layout.numRows + width - 1) / width;
+
+			indexingFor(numBlocks, layout.numRows * layout.extent, [&](int64_t block) {
+				Packet rows[sortingNetworkMaxSize];
+				Scalar lane[width];
+				const int64_t first = block * width;
+				const int64_t count = ::librapid::min(width, layout.numRows - first);
+
+				// Transpose the rows into packets, so that packet j holds element j of each row
+				bool hasNan = false;
+				for (int64_t j = 0; j < layout.extent; ++j) {
+					for (int64_t r = 0; r < width; ++r) {
+						lane[r] = r < count ? data[layout.base(first + r) + j * layout.inner]
+											: Scalar(0);
+						if constexpr (std::is_floating_point_v<Scalar>) {
+							hasNan |= lane[r] != lane[r];
+						}
+					}
+					rows[j] = xsimd::load_unaligned(lane);
+				}
+
+				if (hasNan) {
+					// The network does not order NaNs, so sort these rows with SortLess
+					Scalar values[sortingNetworkMaxSize];
+					for (int64_t r = 0; r < count; ++r) {
+						Scalar *row = data + layout.base(first + r);
+						for (int64_t j = 0; j < layout.extent; ++j) {
+							values[j] = row[j * layout.inner];
+						}
+						std::sort(values, values + layout.extent, SortLess());
+						for (int64_t j = 0; j < layout.extent; ++j) {
+							row[j * layout.inner] = values[j];
+						}
+					}
+					return;
+				}
+
+				// Select rather than min/max, which may return either operand when the values
+				// compare equal (such as -0.0 and +0.0), so the rows stay permutations
+				for (const auto &[a, b] : network) {
+					const auto swap	 = rows[b] < rows[a];
+					const Packet low = xsimd::select(swap, rows[b], rows[a]);
+					rows[b]			 = xsimd::select(swap, rows[a], rows[b]);
+					rows[a]			 = low;
+				}
+
+				for (int64_t j = 0; j < layout.extent; ++j) {
+					rows[j].store_unaligned(lane);
+					for (int64_t r = 0; r < count; ++r) {
+						data[layout.base(first + r) + j * layout.inner] = lane[r];
+					}
+				}
+			});
+		}
+
+		/// Sort a contiguous row of n elements
+		template<typename Scalar>
+		void sortRow(Scalar *data, int64_t n, bool stable, int64_t numChunks) {
+			if constexpr (radixSortable<Scalar>) {
+				if (n >= radixSortThreshold) {
+					using Key		   = RadixKey<Scalar>;
+					const int64_t work = numChunks > 1 ? n : 0;
+					std::vector<Key> keys(n);
+					indexingFor(n, work, [&](int64_t i) { keys[i] = toRadixKey(data[i]); });
+					radixSort(keys.data(), nullptr, n, numChunks);
+					indexingFor(
+					  n, work, [&](int64_t i) { data[i] = fromRadixKey<Scalar>(keys[i]); });
+					return;
+				}
+			}
+
+			mergeSort(data, n, SortLess(), stable, numChunks);
+		}
+
+		/// Write the indices which would sort a contiguous row of n elements to `indices`
+		template<typename Scalar>
+		void argsortRow(const Scalar *data, int64_t *indices, int64_t n, bool stable,
+						int64_t numChunks) {
+			for (int64_t i = 0; i < n; ++i) indices[i] = i;
+
+			if constexpr (radixSortable<Scalar>) {
+				if (n >= radixSortThreshold) {
+					using Key		   = RadixKey<Scalar>;
+					const int64_t work = numChunks > 1 ? n : 0;
+					std::vector<Key> keys(n);
+					indexingFor(n, work, [&](int64_t i) { keys[i] = toRadixKey(data[i]); });
+					radixSort(keys.data(), indices, n, numChunks);
+					return;
+				}
+			}
+
+			mergeSort(
+			  indices,
+			  n,
+			  [data](int64_t a, int64_t b) { return SortLess()(data[a], data[b]); },
+			  stable,
+			  numChunks);
+		}
+
+		template<typename ShapeType, typename Scalar>
+		LIBRAPID_NODISCARD auto
+		sortImpl(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array, int64_t axis,
+				 bool stable) -> Array<Scalar, backend::CPU> {
+			const RowLayout layout = rowLayout(array.shape(), axis);
+			Array<Scalar, backend::CPU> result((Shape(array.shape())));
+			Scalar *data = result.storage().data();
+			copyElements(data, array.storage().data(), static_cast<int64_t>(array.size()));
+
+			if constexpr (std::is_arithmetic_v<Scalar> &&
+						  typetraits::TypeInfo<Scalar>::packetWidth > 1) {
+				// A sorting network is not stable, so it is only used when the order of equal
+				// values (such as -0.0 and +0.0) is not required
+				if (!stable && layout.extent > 1 && layout.extent <= sortingNetworkMaxSize &&
+					layout.numRows >= typetraits::TypeInfo<Scalar>::packetWidth) {
+					sortShortRows(data, layout);
+					return result;
+				}
+			}
+
+			forEachRow(data, layout, [&](int64_t, Scalar *row, int64_t numChunks) {
+				sortRow(row, layout.extent, stable, numChunks);
+			});
+			return result;
+		}
+
+		template<typename ShapeType, typename Scalar>
+		LIBRAPID_NODISCARD auto
+		argsortImpl(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array, int64_t axis,
+					bool stable) -> Array<int64_t, backend::CPU> {
+			const RowLayout layout = rowLayout(array.shape(), axis);
+			Array<int64_t, backend::CPU> result((Shape(array.shape())));
+			const Scalar *src = array.storage().data();
+
+			forEachRow(result.storage().data(),
+					   layout,
+					   [&](int64_t row, int64_t *indices, int64_t numChunks) {
+						   const Scalar *rowData = src + layout.base(row);
+						   if (layout.inner == 1) {
+							   argsortRow(rowData, indices, layout.extent, stable, numChunks);
+						   } else {
+							   thread_local std::vector<Scalar> values;
+							   values.resize(layout.extent);
+							   for (int64_t j = 0; j < layout.extent; ++j) {
+								   values[j] = rowData[j * layout.inner];
+							   }
+							   argsortRow(values.data(), indices, layout.extent, stable, numChunks);
+						   }
+					   });
+			return result;
+		}
+	} // namespace detail
+
+	/// \brief Sort an array along an axis
+	///
+	/// Returns a copy of the array with the elements of each row along `axis` in ascending
+	/// order. NaNs are placed at the end. The order of equal elements is not preserved; see
+	/// stableSort().
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to sort
+	/// \param axis The axis to sort along (negative values count from the end)
+	/// \return The sorted array
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto sort(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								 int64_t axis = -1) -> Array<Scalar, backend::CPU> {
+		return detail::sortImpl(array, axis, false);
+	}
+
+	/// \brief Sort an array along an axis, preserving the order of equal elements
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to sort
+	/// \param axis The axis to sort along (negative values count from the end)
+	/// \return The sorted array
+	/// \see sort()
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto
+	stableSort(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array, int64_t axis = -1)
+	  -> Array<Scalar, backend::CPU> {
+		return detail::sortImpl(array, axis, true);
+	}
+
+	/// \brief Return the indices which would sort an array along an axis
+	///
+	/// Each row of the result holds the positions (along `axis`) of the elements of the
+	/// corresponding row of `array`, in ascending order of value. The order of the indices of
+	/// equal elements is unspecified; see stableArgsort().
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to sort
+	/// \param axis The axis to sort along (negative values count from the end)
+	/// \return An array of indices, with the same shape as `array`
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto argsort(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+									int64_t axis = -1) -> Array<int64_t, backend::CPU> {
+		return detail::argsortImpl(array, axis, false);
+	}
+
+	/// \brief Return the indices which would stably sort an array along an axis
+	///
+	/// Equal elements are ordered by their position in the input.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to sort
+	/// \param axis The axis to sort along (negative values count from the end)
+	/// \return An array of indices, with the same shape as `array`
+	/// \see argsort()
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto
+	stableArgsort(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+				  int64_t axis = -1) -> Array<int64_t, backend::CPU> {
+		return detail::argsortImpl(array, axis, true);
+	}
+
+	/// \brief Partially sort an array along an axis
+	///
+	/// In each row of the result, the element at position `kth` is the one which would be
+	/// there if the row were sorted. Every element before it is less than or equal to it, and
+	/// every element after it is greater than or equal to it, in no particular order.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to partition
+	/// \param kth The position to partition around (negative values count from the end)
+	/// \param axis The axis to partition along (negative values count from the end)
+	/// \return The partitioned array
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto
+	partition(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array, int64_t kth,
+			  int64_t axis = -1) -> Array<Scalar, backend::CPU> {
+		const detail::RowLayout layout = detail::rowLayout(array.shape(), axis);
+		if (kth < 0) kth += layout.extent;
+		if (kth < 0 || kth >= layout.extent) {
+			throw std::out_of_range(fmt::format(
+			  "Position {} out of range for axis of length {}", kth, layout.extent));
+		}
+
+		Array<Scalar, backend::CPU> result((Shape(array.shape())));
+		Scalar *data = result.storage().data();
+		detail::copyElements(data, array.storage().data(), static_cast<int64_t>(array.size()));
+		detail::forEachRow(data, layout, [&](int64_t, Scalar *row, int64_t) {
+			std::nth_element(row, row + kth, row + layout.extent, detail::SortLess());
+		});
+		return result;
+	}
+
+	/// \brief Return the k'th smallest element of each row along an axis
+	///
+	/// The result has the shape of `array` with `axis` removed. This is the element at position
+	/// `kth` of the result of partition(), computed in linear time.
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to select from
+	/// \param kth The position in sorted order (negative values count from the end)
+	/// \param axis The axis to select along (negative values count from the end)
+	/// \return The k'th smallest element of each row
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto
+	nthElement(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array, int64_t kth,
+			   int64_t axis = -1) -> Array<Scalar, backend::CPU> {
+		auto partitioned			   = partition(array, kth, axis);
+		const detail::RowLayout layout = detail::rowLayout(array.shape(), axis);
+		if (kth < 0) kth += layout.extent;
+
+		Array<Scalar, backend::CPU> result(detail::replaceAxis(array.shape(), axis, -1));
+		Scalar *out		  = result.storage().data();
+		const Scalar *src = partitioned.storage().data();
+		detail::indexingFor(layout.numRows, layout.numRows, [&](int64_t row) {
+			out[row] = src[layout.base(row) + kth * layout.inner];
+		});
+		return result;
+	}
+
+	/// The result of topK(): the selected values, and their positions along the axis
+	template<typename Scalar>
+	struct TopK {
+		Array<Scalar, backend::CPU> values;
+		Array<int64_t, backend::CPU> indices;
+	};
+
+	/// \brief Return the k largest (or smallest) elements of each row along an axis
+	///
+	/// The result has the shape of `array`, with the length of `axis` replaced by `k`. The
+	/// values in each row are sorted, largest first (or smallest first if `largest` is false),
+	/// and equal values are ordered by position. NaNs are treated as larger than any other
+	/// value.
+	///
+	/// \code{.cpp}
+	/// // The 10 highest-scoring items for each user (scores has shape [users, items])
+	/// auto [best, items] = lrc::topK(scores, 10);
+	/// \endcode
+	///
+	/// \tparam ShapeType The shape type of the array
+	/// \tparam Scalar The scalar type of the array
+	/// \param array The array to select from
+	/// \param k The number of elements to select from each row
+	/// \param axis The axis to select along (negative values count from the end)
+	/// \param largest Select the largest elements if true, otherwise the smallest
+	/// \return The selected values, and their indices along the axis
+	template<typename ShapeType, typename Scalar>
+	LIBRAPID_NODISCARD auto topK(const array::ArrayContainer<ShapeType, Storage<Scalar>> &array,
+								 int64_t k, int64_t axis = -1, bool largest = true)
+	  -> TopK<Scalar> {
+		const detail::RowLayout layout = detail::rowLayout(array.shape(), axis);
+		if (k < 0 || k > layout.extent) {
+			throw std::out_of_range(fmt::format(
+			  "Cannot select {} elements from an axis of length {}", k, layout.extent));
+		}
+
+		const Shape shape = detail::replaceAxis(array.shape(), axis, k);
+		TopK<Scalar> result {Array<Scalar, backend::CPU>(shape),
+							 Array<int64_t, backend::CPU>(shape)};
+		const Scalar *src = array.storage().data();
+		Scalar *values	  = result.values.storage().data();
+		int64_t *indices  = result.indices.storage().data();
+		const int64_t n	  = layout.extent;
+
+		detail::indexingFor(layout.numRows, layout.numRows * n, [&](int64_t row) {
+			const Scalar *rowData = src + layout.base(row);
+			auto value			  = [&](int64_t j) -> const Scalar & {
+				   return rowData[j * layout.inner];
+			};
+
+			// Order by value, then by position
+			auto before = [&](int64_t a, int64_t b) {
+				const bool less	   = detail::SortLess()(value(a), value(b));
+				const bool greater = detail::SortLess()(value(b), value(a));
+				return (largest ? greater : less) || (!less && !greater && a < b);
+			};
+
+			thread_local std::vector<int64_t> order;
+			order.resize(n);
+			for (int64_t j = 0; j < n; ++j) order[j] = j;
+			if (k < n) std::nth_element(order.begin(), order.begin() + k, order.end(), before);
+			std::sort(order.begin(), order.begin() + k, before);
+
+			const int64_t outBase = (row / layout.inner) * k * layout.inner + row % layout.inner;
+			for (int64_t j = 0; j < k; ++j) {
+				values[outBase + j * layout.inner]	= value(order[j]);
+				indices[outBase + j * layout.inner] = order[j];
+			}
+		});
+
+		return result;
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_SORT_HPP
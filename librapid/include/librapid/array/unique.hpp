@@ -0,0 +1,453 @@
+#ifndef LIBRAPID_ARRAY_UNIQUE_HPP
+#define LIBRAPID_ARRAY_UNIQUE_HPP
+
+/*
+ * Distinct values of an array. unique() returns the distinct values in ascending order, and
+ * optionally the number of times each occurs and, for each element, the index of its value in
+ * the result. valueCounts() returns the distinct values in descending order of frequency, and
+ * isin() tests each element for membership of a set of values.
+ *
+ * There are two implementations, chosen automatically:
+ *
+ *  - Integers spanning a range no larger than the input are counted directly into a table
+ *    indexed by `value - min` (or, for isin(), looked up in a bitmap). The counts are
+ *    accumulated in private per-thread tables if the range is small, or with atomic increments
+ *    otherwise (see scatter.hpp).
+ *  - Anything else is radix-partitioned by the high bits of its hash, so that each partition
+ *    can be deduplicated into its own FlatHashMap by one thread, with no synchronisation. The
+ *    distinct values of every partition are then sorted together.
+ *
+ * As with sort(), NaNs are ordered after every other value. unique() treats every NaN as the
+ * same value, but isin() follows operator== and never matches a NaN.
+ */
+
+namespace librapid {
+	/// \brief The result of unique() and valueCounts()
+	///
+	/// Element i of `counts` is the number of occurrences of `values[i]`.
+	/// \tparam Scalar The scalar type of the input
+	template<typename Scalar>
+	struct UniqueResult {
+		/// The distinct values
+		Array<Scalar, backend::CPU> values;
+
+		/// The number of occurrences of each distinct value (empty unless requested)
+		Array<int64_t, backend::CPU> counts;
+
+		/// The index in `values` of each input element's value, with the shape of the input
+		/// (empty unless requested)
+		Array<int64_t, backend::CPU> inverse;
+	};
+
+	namespace detail {
+		/// Hash for distinct values, which hashes every NaN (and both zeros) the same
+		template<typename T>
+		struct UniqueHash {
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE size_t operator()(const T &value) const {
+				if constexpr (std::is_floating_point_v<T>) {
+					if (value != value) return static_cast<size_t>(0x7FF8000000000000ull);
+					return std::hash<T>()(value == T(0) ? T(0) : value);
+				} else {
+					return std::hash<T>()(value);
+				}
+			}
+		};
+
+		/// Equality for distinct values, which treats every NaN as equal
+		struct UniqueEqual {
+			template<typename T>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE bool operator()(const T &a,
+																	  const T &b) const {
+				if constexpr (std::is_floating_point_v<T>) {
+					return a == b || (a != a && b != b);
+				} else {
+					return a == b;
+				}
+			}
+		};
+
+		/// Integer inputs spanning at most this many values (or the input size, if larger) are
+		/// counted in a table rather than hashed
+		constexpr int64_t uniqueDenseMinRange = int64_t(1) << 16;
+
+		/// The smallest and largest of `n` integers, found in parallel for large inputs
+		template<typename T>
+		LIBRAPID_NODISCARD std::pair<T, T> integerRange(const T *data, int64_t n,
+														int64_t numChunks) {
+			std::vector<std::pair<T, T>> partial(numChunks, {data[0], data[0]});
+			indexingFor(numChunks, numChunks > 1 ? n : 0, [&](int64_t chunk) {
+				auto [lo, hi]	  = partial[chunk];
+				const int64_t end = (chunk + 1) * n / numChunks;
+				for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+					lo = data[i] < lo ? data[i] : lo;
+					hi = data[i] > hi ? data[i] : hi;
+				}
+				partial[chunk] = {lo, hi};
+			});
+
+			std::pair<T, T> range = partial[0];
+			for (const auto &[lo, hi] : partial) {
+				range.first	 = ::librapid::min(range.first, lo);
+				range.second = ::librapid::max(range.second, hi);
+			}
+			return range;
+		}
+
+		/// \return The number of values from `lo` to `hi`, or -1 if it exceeds `limit`
+		template<typename T>
+		LIBRAPID_NODISCARD int64_t denseSpan(T lo, T hi, int64_t limit) {
+			const uint64_t span = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+			return span < static_cast<uint64_t>(limit) ? static_cast<int64_t>(span) + 1 : -1;
+		}
+
+		/// unique() for `n` integers in [lo, lo + span), counted into a table
+		template<typename Scalar>
+		void uniqueDense(const Scalar *data, int64_t n, Scalar lo, int64_t span,
+						 int64_t numChunks, bool returnInverse, UniqueResult<Scalar> &result) {
+			auto slot		   = [lo](Scalar value) { return static_cast<int64_t>(value - lo); };
+			const int64_t work = numChunks > 1 ? n : 0;
+
+			std::vector<int64_t> counts(span, 0);
+			if (numChunks == 1) {
+				for (int64_t i = 0; i < n; ++i) ++counts[slot(data[i])];
+			} else if (span * numChunks <= n) {
+				// Each chunk counts into a private table, and the tables are summed
+				std::vector<int64_t> local(span * numChunks, 0);
+				indexingFor(numChunks, work, [&](int64_t chunk) {
+					int64_t *count	  = local.data() + chunk * span;
+					const int64_t end = (chunk + 1) * n / numChunks;
+					for (int64_t i = chunk * n / numChunks; i < end; ++i) ++count[slot(data[i])];
+				});
+				indexingFor(span, span * numChunks, [&](int64_t k) {
+					for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+						counts[k] += local[chunk * span + k];
+					}
+				});
+			} else {
+				indexingFor(n, work, [&](int64_t i) {
+					scatterAtomic<ScatterAddOp>(counts[slot(data[i])], int64_t(1));
+				});
+			}
+
+			// Number the occupied slots in order. Each chunk of the table counts its occupied
+			// slots, and is then numbered from the total of the previous chunks
+			std::vector<int64_t> offsets(numChunks + 1, 0);
+			indexingFor(numChunks, numChunks > 1 ? span : 0, [&](int64_t chunk) {
+				const int64_t end = (chunk + 1) * span / numChunks;
+				for (int64_t k = chunk * span / numChunks; k < end; ++k) {
+					offsets[chunk + 1] += counts[k] > 0;
+				}
+			});
+			for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+				offsets[chunk + 1] += offsets[chunk];
+			}
+
+			const int64_t numUnique = offsets[numChunks];
+			result.values			= Array<Scalar, backend::CPU>(Shape({numUnique}));
+			result.counts			= Array<int64_t, backend::CPU>(Shape({numUnique}));
+			Scalar *outValues		= result.values.storage().data();
+			int64_t *outCounts		= result.counts.storage().data();
+
+			// Each occupied slot's count is replaced by its index in the result
+			indexingFor(numChunks, numChunks > 1 ? span : 0, [&](int64_t chunk) {
+				int64_t index	  = offsets[chunk];
+				const int64_t end = (chunk + 1) * span / numChunks;
+				for (int64_t k = chunk * span / numChunks; k < end; ++k) {
+					if (counts[k] == 0) continue;
+					outValues[index] = static_cast<Scalar>(lo + static_cast<Scalar>(k));
+					outCounts[index] = counts[k];
+					counts[k]		 = index++;
+				}
+			});
+
+			if (returnInverse) {
+				int64_t *inverse = result.inverse.storage().data();
+				indexingFor(n, work, [&](int64_t i) { inverse[i] = counts[slot(data[i])]; });
+			}
+		}
+
+		/// unique() for any hashable values, using radix-partitioned hash tables
+		template<typename Scalar>
+		void uniqueHashed(const Scalar *data, int64_t n, int64_t numChunks, bool returnInverse,
+						  UniqueResult<Scalar> &result) {
+			using Table = FlatHashMap<Scalar, int64_t, UniqueHash<Scalar>, UniqueEqual>;
+			const int64_t work = numChunks > 1 ? n : 0;
+
+			// Enough partitions for each thread to have several, and for each partition's
+			// table to fit in cache when there are many distinct values
+			int64_t bits = 0;
+			if (numChunks > 1) {
+				const auto target = ::librapid::max(numChunks * 8, n >> 20);
+				bits			  = ::librapid::min(
+					 int64_t(10), static_cast<int64_t>(std::bit_width(uint64_t(target - 1))));
+			}
+			const int64_t numPartitions = int64_t(1) << bits;
+			auto partitionOf			= [bits](const Scalar &value) {
+				   const uint64_t hash = flatHashMix(UniqueHash<Scalar>()(value));
+				   return bits == 0 ? int64_t(0) : static_cast<int64_t>(hash >> (64 - bits));
+			};
+
+			// Copy the values into contiguous partitions (keeping their original positions if
+			// the inverse is needed), with a histogram per chunk as in radixSort()
+			std::vector<Scalar> partitioned;
+			std::vector<int64_t> origin;
+			std::vector<int64_t> begin(numPartitions + 1, 0);
+			const Scalar *keys = data;
+			if (numPartitions > 1) {
+				std::vector<int64_t> offsets(numChunks * numPartitions, 0);
+				indexingFor(numChunks, work, [&](int64_t chunk) {
+					int64_t *count	  = offsets.data() + chunk * numPartitions;
+					const int64_t end = (chunk + 1) * n / numChunks;
+					for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+						++count[partitionOf(data[i])];
+					}
+				});
+
+				int64_t running = 0;
+				for (int64_t p = 0; p < numPartitions; ++p) {
+					begin[p] = running;
+					for (int64_t chunk = 0; chunk < numChunks; ++chunk) {
+						const int64_t count					 = offsets[chunk * numPartitions + p];
+						offsets[chunk * numPartitions + p] = running;
+						running += count;
+					}
+				}
+
+				partitioned.resize(n);
+				if (returnInverse) origin.resize(n);
+				indexingFor(numChunks, work, [&](int64_t chunk) {
+					int64_t *offset	  = offsets.data() + chunk * numPartitions;
+					const int64_t end = (chunk + 1) * n / numChunks;
+					for (int64_t i = chunk * n / numChunks; i < end; ++i) {
+						const int64_t pos = offset[partitionOf(data[i])]++;
+						partitioned[pos]  = data[i];
+						if (returnInverse) origin[pos] = i;
+					}
+				});
+				keys = partitioned.data();
+			}
+			begin[numPartitions] = n;
+			auto originOf		 = [&](int64_t pos) { return origin.empty() ? pos : origin[pos]; };
+
+			// Deduplicate each partition, numbering its distinct values in order of appearance
+			int64_t *inverse = returnInverse ? result.inverse.storage().data() : nullptr;
+			std::vector<std::vector<Scalar>> partValues(numPartitions);
+			std::vector<std::vector<int64_t>> partCounts(numPartitions);
+			indexingFor(numPartitions, work, [&](int64_t p) {
+				Table ids;
+				auto &values = partValues[p];
+				auto &counts = partCounts[p];
+				for (int64_t pos = begin[p]; pos < begin[p + 1]; ++pos) {
+					const auto [it, inserted] =
+					  ids.insert({keys[pos], static_cast<int64_t>(values.size())});
+					if (inserted) {
+						values.push_back(keys[pos]);
+						counts.push_back(0);
+					}
+					++counts[it->second];
+					if (inverse) inverse[originOf(pos)] = it->second;
+				}
+			});
+
+			// Concatenate the partitions and sort their distinct values
+			std::vector<int64_t> base(numPartitions + 1, 0);
+			for (int64_t p = 0; p < numPartitions; ++p) {
+				base[p + 1] = base[p] + static_cast<int64_t>(partValues[p].size());
+			}
+			const int64_t numUnique = base[numPartitions];
+
+			std::vector<Scalar> values(numUnique);
+			std::vector<int64_t> counts(numUnique);
+			indexingFor(numPartitions, numChunks > 1 ? numUnique : 0, [&](int64_t p) {
+				std::copy(partValues[p].begin(), partValues[p].end(), values.begin() + base[p]);
+				std::copy(partCounts[p].begin(), partCounts[p].end(), counts.begin() + base[p]);
+			});
+
+			std::vector<int64_t> order(numUnique);
+			argsortRow(values.data(), order.data(), numUnique, false, numChunks);
+
+			result.values	   = Array<Scalar, backend::CPU>(Shape({numUnique}));
+			result.counts	   = Array<int64_t, backend::CPU>(Shape({numUnique}));
+			Scalar *outValues  = result.values.storage().data();
+			int64_t *outCounts = result.counts.storage().data();
+			std::vector<int64_t> rank(inverse ? numUnique : 0);
+			indexingFor(numUnique, numChunks > 1 ? numUnique : 0, [&](int64_t k) {
+				outValues[k] = values[order[k]];
+				outCounts[k] = counts[order[k]];
+				if (inverse) rank[order[k]] = k;
+			});
+
+			if (inverse) {
+				indexingFor(numPartitions, work, [&](int64_t p) {
+					for (int64_t pos = begin[p]; pos < begin[p + 1]; ++pos) {
+						int64_t &index = inverse[originOf(pos)];
+						index		   = rank[base[p] + index];
+					}
+				});
+			}
+		}
+
+		template<typename Scalar>
+		LIBRAPID_NODISCARD auto uniqueImpl(const Scalar *data, const Shape &shape,
+										   bool returnInverse) -> UniqueResult<Scalar> {
+			const int64_t n = static_cast<int64_t>(shape.size());
+			const bool parallel =
+			  static_cast<size_t>(n) > global::multithreadThreshold && global::numThreads > 1;
+			const int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+			UniqueResult<Scalar> result {Array<Scalar, backend::CPU>(Shape({0})),
+										 Array<int64_t, backend::CPU>(Shape({0})),
+										 Array<int64_t, backend::CPU>(Shape({0}))};
+			if (returnInverse) result.inverse = Array<int64_t, backend::CPU>(shape);
+			if (n == 0) return result;
+
+			if constexpr (std::is_integral_v<Scalar> && !std::is_same_v<Scalar, bool>) {
+				const auto [lo, hi] = integerRange(data, n, numChunks);
+				const int64_t span =
+				  denseSpan(lo, hi, ::librapid::max(n, uniqueDenseMinRange));
+				if (span > 0) {
+					uniqueDense(data, n, lo, span, numChunks, returnInverse, result);
+					return result;
+				}
+			}
+
+			uniqueHashed(data, n, numChunks, returnInverse, result);
+			return result;
+		}
+	} // namespace detail
+
+	/// \brief Find the distinct values of an array
+	///
+	/// The distinct values are returned in ascending order, with NaNs last (all NaNs count as
+	/// one value). The array is flattened first.
+	///
+	/// \code{.cpp}
+	/// auto [values, counts, inverse] = lrc::unique(labels, true, true);
+	/// // values[inverse[i]] == labels[i], and counts[j] is the number of labels equal to
+	/// // values[j]
+	/// \endcode
+	///
+	/// \tparam Values The type of the input (std::vector or host Array)
+	/// \param values The values
+	/// \param returnCounts Whether to count the occurrences of each distinct value
+	/// \param returnInverse Whether to find the index of each element's value in the result
+	/// \return The distinct values, and the requested counts and inverse indices
+	template<typename Values>
+	LIBRAPID_NODISCARD auto unique(const Values &values, bool returnCounts = false,
+								   bool returnInverse = false) {
+		const auto [data, shape] = detail::indexListData(values);
+		auto result				 = detail::uniqueImpl(data, shape, returnInverse);
+		if (!returnCounts) result.counts = Array<int64_t, backend::CPU>(Shape({0}));
+		return result;
+	}
+
+	/// \brief Count the occurrences of each distinct value of an array
+	///
+	/// The distinct values are returned with their counts, in descending order of count.
+	/// Values with the same count are in ascending order.
+	///
+	/// \tparam Values The type of the input (std::vector or host Array)
+	/// \param values The values
+	/// \return The distinct values and their counts (the inverse is empty)
+	template<typename Values>
+	LIBRAPID_NODISCARD auto valueCounts(const Values &values) {
+		const auto [data, shape] = detail::indexListData(values);
+		using Scalar			 = std::decay_t<decltype(*data)>;
+		auto sorted				 = detail::uniqueImpl(data, shape, false);
+
+		const int64_t numUnique = static_cast<int64_t>(sorted.values.size());
+		const bool parallel		= static_cast<size_t>(numUnique) > global::multithreadThreshold &&
+							  global::numThreads > 1;
+		const int64_t numChunks = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+
+		// A stable sort by count keeps equal counts in ascending order of value
+		const int64_t *counts = sorted.counts.storage().data();
+		std::vector<int64_t> order(numUnique);
+		for (int64_t k = 0; k < numUnique; ++k) order[k] = k;
+		detail::mergeSort(
+		  order.data(),
+		  numUnique,
+		  [counts](int64_t a, int64_t b) { return counts[a] > counts[b]; },
+		  true,
+		  numChunks);
+
+		UniqueResult<Scalar> result {Array<Scalar, backend::CPU>(Shape({numUnique})),
+									 Array<int64_t, backend::CPU>(Shape({numUnique})),
+									 Array<int64_t, backend::CPU>(Shape({0}))};
+		const Scalar *srcValues = sorted.values.storage().data();
+		Scalar *outValues		= result.values.storage().data();
+		int64_t *outCounts		= result.counts.storage().data();
+		detail::indexingFor(numUnique, parallel ? numUnique : 0, [&](int64_t k) {
+			outValues[k] = srcValues[order[k]];
+			outCounts[k] = counts[order[k]];
+		});
+		return result;
+	}
+
+	/// \brief Test whether each element of an array is in a set of values
+	///
+	/// Elements are compared with operator==, so NaNs are never found.
+	///
+	/// \code{.cpp}
+	/// auto selected = lrc::isin(productIds, std::vector<int64_t> {17, 42, 1000});
+	/// \endcode
+	///
+	/// \tparam Values The type of the input (std::vector or host Array)
+	/// \tparam TestValues The type of the set of values (std::vector or host Array)
+	/// \param values The elements to test
+	/// \param testValues The values to search for
+	/// \return A Mask with the shape of \p values
+	template<typename Values, typename TestValues>
+	LIBRAPID_NODISCARD Mask isin(const Values &values, const TestValues &testValues) {
+		const auto [data, shape]		= detail::indexListData(values);
+		const auto [testData, testShape] = detail::indexListData(testValues);
+		using Scalar					= std::decay_t<decltype(*data)>;
+		static_assert(std::is_same_v<Scalar, std::decay_t<decltype(*testData)>>,
+					  "isin() requires the values and test values to have the same type");
+
+		const int64_t n = static_cast<int64_t>(shape.size());
+		const int64_t m = static_cast<int64_t>(testShape.size());
+		Mask result(shape);
+		if (n == 0 || m == 0) return result;
+
+		// Each word of the result is written by one thread
+		auto *words			   = result.data();
+		const int64_t numWords = (n + 63) / 64;
+		auto packWords		   = [&](auto &&found) {
+			  detail::indexingFor(numWords, n, [&](int64_t w) {
+				  uint64_t word		= 0;
+				  const int64_t end = ::librapid::min(n, (w + 1) * 64);
+				  for (int64_t i = w * 64; i < end; ++i) word |= uint64_t(found(i)) << (i % 64);
+				  words[w] = word;
+			  });
+		};
+
+		if constexpr (std::is_integral_v<Scalar> && !std::is_same_v<Scalar, bool>) {
+			// A bitmap of the test values costs one bit per value in their range
+			const auto [lo, hi] = detail::integerRange(testData, m, 1);
+			const int64_t span	= detail::denseSpan(
+			   lo, hi, ::librapid::max(m * 64, detail::uniqueDenseMinRange * 128));
+			if (span > 0) {
+				std::vector<uint64_t> bitmap((span + 63) / 64, 0);
+				for (int64_t j = 0; j < m; ++j) {
+					const auto k = static_cast<uint64_t>(testData[j]) - static_cast<uint64_t>(lo);
+					bitmap[k / 64] |= uint64_t(1) << (k % 64);
+				}
+				packWords([&](int64_t i) {
+					const auto k = static_cast<uint64_t>(data[i]) - static_cast<uint64_t>(lo);
+					return k < static_cast<uint64_t>(span) && ((bitmap[k / 64] >> (k % 64)) & 1);
+				});
+				return result;
+			}
+		}
+
+		FlatHashSet<Scalar, detail::UniqueHash<Scalar>> set;
+		set.insert(testData, m);
+		auto found = std::make_unique<bool[]>(n);
+		set.contains(data, n, found.get());
+		packWords([&](int64_t i) { return found[i]; });
+		return result;
+	}
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_UNIQUE_HPP
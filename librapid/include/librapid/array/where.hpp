@@ -0,0 +1,280 @@
+#ifndef LIBRAPID_ARRAY_WHERE_HPP
+#define LIBRAPID_ARRAY_WHERE_HPP
+
+/*
+ * Element-wise selection. where(cond, a, b) takes each element from `a` where the condition is
+ * true (nonzero) and from `b` elsewhere. Unlike `cond * a + (1 - cond) * b`, no arithmetic is
+ * done on the operands, so NaNs and infinities in the unselected operand never reach the result.
+ *
+ * where() returns a lazily evaluated detail::Function, so it fuses with the surrounding
+ * expression, and host expressions are evaluated with SIMD blends (xsimd::select). The
+ * condition may be any array expression, or a Mask.
+ *
+ * ArrayContainer::maskedAssign() is the in-place equivalent, which only writes to the selected
+ * elements.
+ */
+
+namespace librapid {
+	namespace detail {
+		/// Compare `Packet::size` elements of a where() condition, starting at `index`, with
+		/// zero. The comparison is done in the condition's own type, since converting it to the
+		/// result type first could round a nonzero value (0.5, for an integer result) to zero
+		/// \tparam Packet The packet type of the result
+		/// \tparam Cond The type of the condition
+		/// \param cond The condition
+		/// \param index The (flat) index of the first element
+		/// \return A boolean packet which is true where the condition is nonzero
+		template<typename Packet, typename Cond>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto whereCondition(const Cond &cond,
+																	  size_t index) {
+			using Scalar	 = typename Packet::value_type;
+			using PacketBool = typename Packet::batch_bool_type;
+
+			if constexpr (std::is_same_v<Cond, Mask>) {
+				return cond.template packetBool<Packet>(index);
+			} else if constexpr (!IsArrayType<Cond>::val) {
+				return PacketBool(cond != Cond(0));
+			} else {
+				using CondScalar = typename typetraits::TypeInfo<Cond>::Scalar;
+				using CondPacket = typename typetraits::TypeInfo<CondScalar>::Packet;
+
+				if constexpr (typetraits::TypeInfo<CondScalar>::packetWidth == Packet::size) {
+					using CondValue = typename CondPacket::value_type;
+					const auto nonzero =
+					  packetExtractor<CondPacket>(cond, index) != CondPacket(CondValue(0));
+					if constexpr (std::is_same_v<CondValue, Scalar>) {
+						return nonzero;
+					} else {
+						return xsimd::batch_bool_cast<Scalar>(nonzero);
+					}
+				} else {
+					// The condition's packets have a different width, so compare one element
+					// at a time
+					Scalar flags[Packet::size];
+					for (size_t i = 0; i < Packet::size; ++i) {
+						flags[i] = scalarExtractor(cond, index + i) != CondScalar(0) ? Scalar(1)
+																					 : Scalar(0);
+					}
+					return Packet::load_unaligned(flags) != Packet(Scalar(0));
+				}
+			}
+		}
+
+		/// Functor selecting between its second and third arguments based on the first
+		struct Where {
+			template<typename C, typename A, typename B>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto operator()(const C &cond, const A &a,
+																	  const B &b) const {
+				if constexpr (typetraits::CanPromote<A, B>) {
+					using Type = typetraits::Promote_t<A, B>;
+					return cond != C(0) ? static_cast<Type>(a) : static_cast<Type>(b);
+				} else {
+					using Type = std::common_type_t<A, B>;
+					return cond != C(0) ? static_cast<Type>(a) : static_cast<Type>(b);
+				}
+			}
+
+			// Only the values are converted to the result's packet type. The condition is read
+			// in its own type (see whereCondition())
+			template<typename Packet, typename Args>
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Packet packetFromArgs(const Args &args,
+																			size_t index) const {
+				const auto &[cond, a, b] = args;
+				return xsimd::select(whereCondition<Packet>(cond, index),
+									 packetExtractor<Packet>(a, index),
+									 packetExtractor<Packet>(b, index));
+			}
+		};
+
+		/// Return the shape of the first array (or Mask) in a list of where() arguments,
+		/// checking that all other arrays have the same shape
+		template<typename First, typename... Rest>
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto whereShape(const First &first,
+																  const Rest &...rest) {
+			if constexpr (IsArrayType<First>::val) {
+				(
+				  [&first](const auto &arg) {
+					  if constexpr (IsArrayType<std::decay_t<decltype(arg)>>::val) {
+						  if (!(first.shape() == arg.shape())) {
+							  throw std::range_error(
+								fmt::format("Shapes must match for where(). {} vs {}",
+											first.shape(),
+											arg.shape()));
+						  }
+					  }
+				  }(rest),
+				  ...);
+				return first.shape();
+			} else {
+				return whereShape(rest...);
+			}
+		}
+	} // namespace detail
+
+	namespace typetraits {
+		template<>
+		struct TypeInfo<::librapid::detail::Where> {
+			static constexpr const char *name		= "where";
+			static constexpr const char *filename	= "where";
+			static constexpr const char *kernelName = "where";
+
+			template<typename... Args>
+			LIBRAPID_NODISCARD static LIBRAPID_ALWAYS_INLINE auto
+			getShape(const std::tuple<Args...> &args) {
+				return std::apply(
+				  [](const auto &...arg) { return ::librapid::detail::whereShape(arg...); },
+				  args);
+			}
+		};
+
+		// xsimd cannot blend complex packets with a real condition
+		template<typename... Args>
+		struct FunctorAllowsVectorisation<::librapid::detail::Where, Args...>
+				: std::bool_constant<!anyArgIsComplex<Args...>> {};
+	} // namespace typetraits
+
+	/// \brief Select elements from one of two values, based on a condition
+	///
+	/// Returns a lazily evaluated function object whose i'th element is `a[i]` if `cond[i]` is
+	/// true (nonzero) and `b[i]` otherwise. Scalars are broadcast to every element. For example,
+	/// to replace NaNs and clip negative values:
+	///
+	/// \code{.cpp}
+	/// auto cleaned = lrc::where(x != x, 0.0f, lrc::where(x < 0.0f, 0.0f, x));
+	/// \endcode
+	///
+	/// The condition may be a Mask, in which case it is expanded one packet at a time.
+	///
+	/// \tparam Cond The condition type
+	/// \tparam A The type of the value selected where the condition is true
+	/// \tparam B The type of the value selected where the condition is false
+	/// \param cond The condition
+	/// \param a Value(s) selected where the condition is true
+	/// \param b Value(s) selected where the condition is false
+	/// \return Function object selecting between `a` and `b`
+	template<typename Cond, typename A, typename B>
+		requires(detail::IsArrayType<std::decay_t<Cond>>::val ||
+				 detail::IsArrayType<std::decay_t<A>>::val ||
+				 detail::IsArrayType<std::decay_t<B>>::val)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto where(Cond &&cond, A &&a, B &&b)
+	  -> detail::Function<typetraits::DescriptorType_t<Cond, A, B>, detail::Where, Cond, A, B> {
+		return detail::makeFunction<typetraits::DescriptorType_t<Cond, A, B>, detail::Where>(
+		  std::forward<Cond>(cond), std::forward<A>(a), std::forward<B>(b));
+	}
+
+	namespace detail {
+		/// Assign `value` to the elements of a host array selected by a Mask. Whole words of
+		/// selected elements are written with packets, empty words are skipped, and the
+		/// remaining elements are found with count-trailing-zeros
+		/// \tparam Scalar The scalar type of the array
+		/// \tparam T The type of the value
+		/// \param data Pointer to the array's data
+		/// \param mask The elements to assign to
+		/// \param value The value (or values) to assign
+		template<typename Scalar, typename T>
+		void maskedAssignHost(Scalar *data, const Mask &mask, const T &value) {
+			using Packet = typename typetraits::TypeInfo<Scalar>::Packet;
+			constexpr int64_t bitsPerElement = Mask::bitsPerElement;
+			constexpr bool vectorise		 = []() {
+				if constexpr (typetraits::TypeInfo<Scalar>::packetWidth <= 1 ||
+							  typetraits::TypeInfo<Scalar>::packetWidth > bitsPerElement) {
+					return false;
+				} else {
+					return typetraits::packetCompatible<Scalar, T>();
+				}
+			}();
+
+			const Mask::ElementType *words = mask.data();
+			const int64_t numWords		   = mask.numWords();
+
+			auto assignWord = [&](int64_t w) {
+				Mask::ElementType word = words[w];
+				const int64_t first	   = w * bitsPerElement;
+
+				if constexpr (vectorise) {
+					if (word == ~Mask::ElementType(0)) {
+						for (int64_t i = first; i < first + bitsPerElement; i += Packet::size) {
+							storeConverted(data + i, packetExtractor<Packet>(value, i));
+						}
+						return;
+					}
+				}
+
+				while (word) {
+					const int64_t i = first + std::countr_zero(word);
+					data[i]			= static_cast<Scalar>(scalarExtractor(value, i));
+					word &= word - 1;
+				}
+			};
+
+			if (static_cast<size_t>(mask.size()) > global::multithreadThreshold &&
+				global::numThreads > 1) {
+#pragma omp parallel for shared(numWords, assignWord) default(none)                                \
+  num_threads(int(global::numThreads))
+				for (int64_t w = 0; w < numWords; ++w) { assignWord(w); }
+			} else {
+				for (int64_t w = 0; w < numWords; ++w) { assignWord(w); }
+			}
+		}
+	} // namespace detail
+
+	namespace array {
+		template<typename ShapeType_, typename StorageType_>
+		template<typename T>
+		auto ArrayContainer<ShapeType_, StorageType_>::maskedAssign(const Mask &mask,
+																	const T &value)
+		  -> ArrayContainer & {
+			// Checked in every build, since a mismatch would write outside the array
+			if (mask.size() != static_cast<int64_t>(m_size)) {
+				throw std::range_error(
+				  fmt::format("Mask of shape {} cannot be applied to an array of shape {}",
+							  mask.shape(),
+							  m_shape));
+			}
+
+			if constexpr (IsArrayType<T>::value) {
+				if (!(value.shape() == m_shape)) {
+					throw std::range_error(fmt::format(
+					  "Shapes must match for maskedAssign(). {} vs {}", value.shape(), m_shape));
+				}
+			}
+
+			if constexpr (typetraits::IsStorage<StorageType_>::value ||
+						  typetraits::IsFixedStorage<StorageType_>::value) {
+				detail::maskedAssignHost(m_storage.data(), mask, value);
+			} else if constexpr (IsArrayType<T>::value) {
+				// Masks live on the host, so device arrays are blended (see where())
+				*this = ::librapid::where(mask, ::librapid::cast<Scalar>(value), *this);
+			} else {
+				*this = ::librapid::where(mask, static_cast<Scalar>(value), *this);
+			}
+
+			return *this;
+		}
+	} // namespace array
+
+	// There are no device kernels for where(), so it is evaluated on the host
+#if defined(LIBRAPID_HAS_OPENCL)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, OpenCLStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Where, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_OPENCL
+
+#if defined(LIBRAPID_HAS_CUDA)
+	namespace detail {
+		template<typename ShapeType_, typename StorageScalar, typename... Args>
+		LIBRAPID_ALWAYS_INLINE void
+		assign(array::ArrayContainer<ShapeType_, CudaStorage<StorageScalar>> &lhs,
+			   const detail::Function<descriptor::Trivial, Where, Args...> &function) {
+			mapAssignOnHost(lhs, function);
+		}
+	} // namespace detail
+#endif // LIBRAPID_HAS_CUDA
+} // namespace librapid
+
+#endif // LIBRAPID_ARRAY_WHERE_HPP
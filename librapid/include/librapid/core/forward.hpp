@@ -28,6 +28,8 @@ namespace librapid {
 		class ArrayContainer;
 	}
 
+	class Mask;
+
 	namespace typetraits {
 		/// Evaluates as true if the input type is an ArrayContainer instance
 		/// \tparam T Input type
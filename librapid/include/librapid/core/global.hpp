@@ -23,6 +23,15 @@ namespace librapid {
         // Number of threads used by LibRapid
         extern size_t numThreads;
 
+        // Should floating-point reductions give the same result for any number of threads? If
+        // so, they are split into blocks of a fixed size, combined in a fixed order (see
+        // array/reduce.hpp). This covers sum(), vector dot products, cumsum(), cumprod(), the
+        // running statistics, groupReduce(), weighted histogram(), histogram2d() and bincount(),
+        // and scatter-reductions with ScatterStrategy::Auto. An explicitly requested
+        // ScatterStrategy::Privatised or Atomic is not covered. This is slower, so is best
+        // enabled only for validation runs
+        extern bool reproducibleReductions;
+
         // Random seed used by LibRapid (when changed, the random number generator is reseeded)
         extern size_t randomSeed;
 
@@ -32,6 +41,14 @@ namespace librapid {
         // Size of a cache line in bytes
         extern size_t cacheLineSize;
 
+        // Results larger than this (in bytes) are written with non-temporal stores, bypassing
+        // the cache. This is initialised from the size of the last-level cache
+        extern size_t streamingStoreThreshold;
+
+        // Number of cache lines ahead of the element being written that streaming assignments
+        // prefetch their inputs. Zero disables the prefetch
+        extern size_t streamingPrefetchDistance;
+
 #if defined(LIBRAPID_HAS_OPENCL)
         // OpenCL device list
         extern std::vector<cl::Device> openclDevices;
@@ -78,6 +95,11 @@ namespace librapid {
     void setNumThreads(size_t numThreads);
     size_t getNumThreads();
 
+    // Make floating-point reductions independent of the number of threads (see
+    // global::reproducibleReductions for the functions covered and the exceptions)
+    void setReproducibleReductions(bool reproducible);
+    bool getReproducibleReductions();
+
     void setSeed(size_t seed);
     size_t getSeed();
 } // namespace librapid
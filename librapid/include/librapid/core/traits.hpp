@@ -30,6 +30,7 @@ namespace librapid {
 			ArrayContainer,
 			ArrayFunction,
 			GeneralArrayView,
+			Mask,
 		};
 
 		constexpr bool sameType(LibRapidType type1, LibRapidType type2) { return type1 == type2; }
@@ -70,6 +70,90 @@ namespace librapid::typetraits {
 	// Detect whether a class has a static constexpr bool member called allowVectorization
 	template<typename T>
 	struct HasAllowVectorisation : public decltype(impl::testAllowVectorisation<T>(1)) {};
+
+	// Detect whether a type is a floating point number. Specialised for LibRapid's own types
+	// (such as half) where they are defined
+	template<typename T>
+	struct IsFloatingPoint : public std::is_floating_point<T> {};
+
+	// Detect whether a type takes part in LibRapid's scalar type promotion rules. This is true
+	// for the built-in numeric types (except bool) and any other IsFloatingPoint type
+	template<typename T>
+	struct IsPromotable
+			: public std::bool_constant<(std::is_arithmetic_v<T> && !std::is_same_v<T, bool>) ||
+										IsFloatingPoint<T>::value> {};
+
+	namespace impl {
+		/// Promote a signed and an unsigned integer. A wider signed type can hold every value
+		/// of the unsigned one. Otherwise, types narrower than 32 bits meet in a signed type
+		/// twice the width of the unsigned one (as they would after C++'s promotion to int), and
+		/// wider ones are unsigned, as in C++
+		template<typename Signed, typename Unsigned>
+		constexpr auto promoteMixedSign() {
+			if constexpr (sizeof(Signed) > sizeof(Unsigned)) {
+				return std::type_identity<Signed> {};
+			} else if constexpr (sizeof(Unsigned) == 1) {
+				return std::type_identity<int16_t> {};
+			} else if constexpr (sizeof(Unsigned) == 2) {
+				return std::type_identity<int32_t> {};
+			} else {
+				return std::type_identity<Unsigned> {};
+			}
+		}
+
+		template<typename A, typename B>
+		constexpr auto promote() {
+			if constexpr (std::is_same_v<A, B>) {
+				return std::type_identity<A> {};
+			} else if constexpr (IsFloatingPoint<A>::value && IsFloatingPoint<B>::value) {
+				// float op double -> double, half op float -> float
+				if constexpr (sizeof(A) == 2 && sizeof(B) == 2) {
+					// half and bfloat16 can't represent each other's values, so they meet in
+					// single precision
+					return std::type_identity<float> {};
+				} else if constexpr (sizeof(A) >= sizeof(B)) {
+					return std::type_identity<A> {};
+				} else {
+					return std::type_identity<B> {};
+				}
+			} else if constexpr (IsFloatingPoint<A>::value) {
+				return std::type_identity<A> {}; // float op int -> float
+			} else if constexpr (IsFloatingPoint<B>::value) {
+				return std::type_identity<B> {}; // int op float -> float
+			} else if constexpr (std::is_signed_v<A> == std::is_signed_v<B>) {
+				// The wider integer wins
+				if constexpr (sizeof(A) >= sizeof(B)) {
+					return std::type_identity<A> {};
+				} else {
+					return std::type_identity<B> {};
+				}
+			} else if constexpr (std::is_signed_v<A>) {
+				return promoteMixedSign<A, B>();
+			} else {
+				return promoteMixedSign<B, A>();
+			}
+		}
+	} // namespace impl
+
+	/// The scalar type resulting from a binary operation between values of type A and B.
+	/// Unlike the C++ rules, small integers are not promoted to int (so int8 + int8 is int8),
+	/// integers combined with a floating point type produce that floating point type, and two
+	/// floating point types produce the wider of the two. A signed and an unsigned integer
+	/// narrower than 32 bits produce a signed type which holds both (int16 and uint16 produce
+	/// int32), so negative values are kept. Only defined when both types are IsPromotable.
+	/// \tparam A The first scalar type
+	/// \tparam B The second scalar type
+	template<typename A, typename B>
+		requires(IsPromotable<A>::value && IsPromotable<B>::value)
+	struct Promote {
+		using Type = typename decltype(impl::promote<A, B>())::type;
+	};
+
+	template<typename A, typename B>
+	using Promote_t = typename Promote<A, B>::Type;
+
+	template<typename A, typename B>
+	constexpr bool CanPromote = IsPromotable<A>::value && IsPromotable<B>::value;
 } // namespace librapid::typetraits
 
 #endif // LIBRAPID_CORE_TYPETRAITS_HPP
\ No newline at end of file
@@ -2,6 +2,45 @@
 #define LIBRAPID_BITSET_HPP
 
 namespace librapid {
+	namespace detail {
+		/// Apply a bitwise operation to n words, so that out[i] = op(out[i], other[i]), one
+		/// packet of words at a time
+		template<typename Op>
+		LIBRAPID_ALWAYS_INLINE void bitsetApply(uint64_t *out, const uint64_t *other, uint64_t n,
+												Op &&op) {
+			constexpr uint64_t width = typetraits::TypeInfo<uint64_t>::packetWidth;
+
+			uint64_t i = 0;
+			if constexpr (width > 1) {
+				for (; i + width <= n; i += width) {
+					op(xsimd::load_unaligned(out + i), xsimd::load_unaligned(other + i))
+					  .store_unaligned(out + i);
+				}
+			}
+			for (; i < n; ++i) { out[i] = op(out[i], other[i]); }
+		}
+
+		/// \return The position of the set bit of \p word with k set bits below it. The word
+		/// must have more than k bits set
+		LIBRAPID_ALWAYS_INLINE uint64_t selectInWord(uint64_t word, uint64_t k) {
+#if defined(__BMI2__) && LIBRAPID_ARCH >= ARCH_AVX2
+			return std::countr_zero(_pdep_u64(uint64_t(1) << k, word));
+#else
+			// Halve the range containing the bit each step, using the popcount of its low half
+			uint64_t pos = 0;
+			for (uint64_t width = 32; width > 0; width >>= 1) {
+				const uint64_t low = std::popcount(word & ((uint64_t(1) << width) - 1));
+				if (k >= low) {
+					k -= low;
+					word >>= width;
+					pos += width;
+				}
+			}
+			return pos;
+#endif
+		}
+	} // namespace detail
+
 	template<uint64_t numBits_ = 64, bool stackAlloc_ = true>
 	class BitSet {
 	public:
@@ -33,7 +72,15 @@ namespace librapid {
 			}
 		}
 
-		BitSet(BitSet &&other) = default;
+		// A heap-allocated source is left with an empty allocation, so it can still be used
+		BitSet(BitSet &&other) noexcept(stackAlloc) {
+			if constexpr (stackAlloc) {
+				m_data = other.m_data;
+			} else {
+				emptyInit();
+				std::swap(m_data, other.m_data);
+			}
+		}
 
 		constexpr BitSet(uint64_t value) {
 			static_assert(numElements > 0, "Not enough bits in BitSet");
@@ -54,8 +101,19 @@ namespace librapid {
 			}
 		}
 
-		BitSet &operator=(const BitSet &other) = default;
-		BitSet &operator=(BitSet &&other)	   = default;
+		BitSet &operator=(const BitSet &other) {
+			if (this != &other) std::copy_n(other.wordData(), numElements, wordData());
+			return *this;
+		}
+
+		BitSet &operator=(BitSet &&other) noexcept {
+			if constexpr (stackAlloc) {
+				m_data = other.m_data;
+			} else {
+				std::swap(m_data, other.m_data);
+			}
+			return *this;
+		}
 
 		~BitSet() {
 			if constexpr (!stackAlloc) delete[] m_data;
@@ -174,21 +232,61 @@ namespace librapid {
 		}
 
 		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE uint64_t popCount() const {
-			uint64_t res = 0;
-			for (uint64_t i = 0; i < numElements; ++i) { res += std::popcount(m_data[i]); }
+			return countWords(numElements);
+		}
+
+		/// \brief Count the set bits before a position
+		///
+		/// This scans the words before \p index. To answer many queries on a large BitSet,
+		/// build a RankSelect directory instead.
+		/// \param index The position, in the range \f$ [0, \mathrm{numBits}] \f$
+		/// \return The number of set bits in \f$ [0, \mathrm{index}) \f$
+		LIBRAPID_NODISCARD uint64_t rank(uint64_t index) const {
+			const uint64_t word = index / bitsPerElement;
+			const uint64_t bit	= index % bitsPerElement;
+			uint64_t res		= countWords(word);
+			if (bit) res += std::popcount(m_data[word] & ((ElementType(1) << bit) - 1));
 			return res;
 		}
 
-		template<uint64_t otherBits = numBits, bool otherStackAlloc = stackAlloc>
-		BitSet &operator|=(const BitSet<otherBits, otherStackAlloc> &other) {
-			constexpr uint64_t otherElements = std::decay_t<decltype(other)>::numElements;
+		/// \brief Find the position of the set bit with \p k set bits before it (the k-th set
+		/// bit, counting from zero)
+		///
+		/// This scans the words up to the result. To answer many queries on a large BitSet,
+		/// build a RankSelect directory instead.
+		/// \param k The number of set bits before the result
+		/// \return The position of the bit, or numBits if fewer than k + 1 bits are set
+		LIBRAPID_NODISCARD uint64_t select(uint64_t k) const {
+			for (uint64_t i = 0; i < numElements; ++i) {
+				const uint64_t count = std::popcount(m_data[i]);
+				if (k < count) return i * bitsPerElement + detail::selectInWord(m_data[i], k);
+				k -= count;
+			}
+			return numBits;
+		}
 
-			uint64_t index = 0;
-			while (index < min(numElements, otherElements)) {
-				m_data[index] |= other.data()[index];
-				++index;
+		/// \brief Call `func(index)` for every set bit, in increasing order of index
+		///
+		/// Each word is scanned with a count-trailing-zeros instruction, so the cost depends on
+		/// the number of set bits rather than the size of the BitSet (plus one test per word).
+		/// \tparam Func The function type
+		/// \param func The function to call
+		template<typename Func>
+		void forEachSetBit(Func &&func) const {
+			for (uint64_t i = 0; i < numElements; ++i) {
+				for (ElementType word = m_data[i]; word; word &= word - 1) {
+					func(i * bitsPerElement + std::countr_zero(word));
+				}
 			}
+		}
 
+		template<uint64_t otherBits = numBits, bool otherStackAlloc = stackAlloc>
+		BitSet &operator|=(const BitSet<otherBits, otherStackAlloc> &other) {
+			constexpr uint64_t otherElements = std::decay_t<decltype(other)>::numElements;
+			detail::bitsetApply(wordData(),
+								other.wordData(),
+								min(numElements, otherElements),
+								[](const auto &a, const auto &b) { return a | b; });
 			return *this;
 		}
 
@@ -199,11 +297,11 @@ namespace librapid {
 
 			constexpr uint64_t otherElements = std::decay_t<decltype(other)>::numElements;
 
-			uint64_t index = 0;
-			while (index < min(numElements, otherElements)) {
-				m_data[index] &= other.data()[index];
-				++index;
-			}
+			uint64_t index = min(numElements, otherElements);
+			detail::bitsetApply(wordData(),
+								other.wordData(),
+								index,
+								[](const auto &a, const auto &b) { return a & b; });
 
 			while (index < numElements) {
 				m_data[index] = 0;
@@ -216,13 +314,23 @@ namespace librapid {
 		template<uint64_t otherBits = numBits, bool otherStackAlloc = stackAlloc>
 		BitSet &operator^=(const BitSet<otherBits, otherStackAlloc> &other) {
 			constexpr uint64_t otherElements = std::decay_t<decltype(other)>::numElements;
+			detail::bitsetApply(wordData(),
+								other.wordData(),
+								min(numElements, otherElements),
+								[](const auto &a, const auto &b) { return a ^ b; });
+			return *this;
+		}
 
-			uint64_t index = 0;
-			while (index < min(numElements, otherElements)) {
-				m_data[index] ^= other.data()[index];
-				++index;
-			}
-
+		/// \brief Clear every bit which is set in \p other (i.e. `*this &= ~other`)
+		/// \param other The bits to clear
+		/// \return A reference to this BitSet
+		template<uint64_t otherBits = numBits, bool otherStackAlloc = stackAlloc>
+		BitSet &andNot(const BitSet<otherBits, otherStackAlloc> &other) {
+			constexpr uint64_t otherElements = std::decay_t<decltype(other)>::numElements;
+			detail::bitsetApply(wordData(),
+								other.wordData(),
+								min(numElements, otherElements),
+								[](const auto &a, const auto &b) { return a & ~b; });
 			return *this;
 		}
 
@@ -337,6 +445,24 @@ namespace librapid {
 		const auto &data() const { return m_data; }
 		auto &data() { return m_data; }
 
+		/// \return A pointer to the words of the BitSet, for either storage type
+		LIBRAPID_NODISCARD const ElementType *wordData() const {
+			if constexpr (stackAlloc) {
+				return m_data.data();
+			} else {
+				return m_data;
+			}
+		}
+
+		/// \return A pointer to the words of the BitSet, for either storage type
+		LIBRAPID_NODISCARD ElementType *wordData() {
+			if constexpr (stackAlloc) {
+				return m_data.data();
+			} else {
+				return m_data;
+			}
+		}
+
 		template<typename Integer = ElementType>
 			requires(std::is_integral_v<Integer>)
 		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int toInt() const {
@@ -359,6 +485,18 @@ namespace librapid {
 		}
 
 	protected:
+		/// \return The number of set bits in the first \p n words. Large heap-allocated sets
+		/// use the runtime-dispatched SIMD kernel
+		LIBRAPID_NODISCARD uint64_t countWords(uint64_t n) const {
+			if constexpr (stackAlloc) {
+				uint64_t res = 0;
+				for (uint64_t i = 0; i < n; ++i) { res += std::popcount(m_data[i]); }
+				return res;
+			} else {
+				return detail::cpu::dispatch::popcount(static_cast<int64_t>(n), m_data);
+			}
+		}
+
 		constexpr uint64_t highMask() const {
 			ElementType res = 0;
 			for (uint64_t i = 0; i < numBits % bitsPerElement; ++i) { res |= 1ULL << i; }
@@ -389,12 +527,155 @@ namespace librapid {
 
 	template<uint64_t numBits, bool stackAlloc>
 	uint64_t popCount(const BitSet<numBits, stackAlloc> &bitset) {
-		uint64_t res = 0;
-		for (uint64_t i = 0; i < BitSet<numBits, stackAlloc>::numElements; ++i) {
-			res += popCount(bitset.data()[i]);
-		}
-		return res;
+		return bitset.popCount();
 	}
+
+	/// \brief A rank/select directory over the bits of a BitSet
+	///
+	/// Rank queries (the number of set bits before a position) take constant time, and select
+	/// queries (the position of the k-th set bit) take logarithmic time. The directory stores
+	/// the number of set bits before each superblock of 65536 bits as a 64-bit count, and the
+	/// number before each block of 512 bits, relative to its superblock, as a 16-bit count.
+	/// This costs about 0.4% of the size of the bits.
+	///
+	/// The directory refers to the words of the BitSet it was built from, so it must not
+	/// outlive the BitSet, and must be rebuilt after the BitSet is modified.
+	///
+	/// \code{.cpp}
+	/// lrc::BitSet<1'000'000'000, false> bits;
+	/// // ... set some bits ...
+	/// lrc::RankSelect index(bits);
+	/// uint64_t before = index.rank(123456789); // Set bits in [0, 123456789)
+	/// uint64_t pos	= index.select(1000);	  // Position of the 1001st set bit
+	/// \endcode
+	class RankSelect {
+	public:
+		static constexpr uint64_t bitsPerWord		  = 64;
+		static constexpr uint64_t wordsPerBlock		  = 8;
+		static constexpr uint64_t blocksPerSuperblock = 128;
+		static constexpr uint64_t bitsPerBlock		  = bitsPerWord * wordsPerBlock;
+		static constexpr uint64_t bitsPerSuperblock	  = bitsPerBlock * blocksPerSuperblock;
+
+		RankSelect() = default;
+
+		/// \brief Build a directory over the bits of a BitSet
+		/// \param bitset The BitSet to index
+		template<uint64_t numBits, bool stackAlloc>
+		explicit RankSelect(const BitSet<numBits, stackAlloc> &bitset) :
+				RankSelect(bitset.wordData(), numBits) {}
+
+		/// \brief Build a directory over \p numBits bits, stored in 64-bit words with bit i in
+		/// bit `i % 64` of word `i / 64`. Bits past the end of the last word are ignored
+		/// \param words The words holding the bits
+		/// \param numBits The number of bits
+		RankSelect(const uint64_t *words, uint64_t numBits) :
+				m_words(words), m_numBits(numBits),
+				m_numWords((numBits + bitsPerWord - 1) / bitsPerWord) {
+			const uint64_t numBlocks = (m_numWords + wordsPerBlock - 1) / wordsPerBlock;
+			const uint64_t numSuperblocks =
+			  (numBlocks + blocksPerSuperblock - 1) / blocksPerSuperblock;
+			m_superblocks.assign(numSuperblocks + 1, 0);
+			m_blocks.assign(numBlocks, 0);
+
+			// Count the bits of each superblock independently, then accumulate the totals
+			auto countSuperblock = [&](int64_t superblock) {
+				const uint64_t firstBlock = superblock * blocksPerSuperblock;
+				const uint64_t lastBlock =
+				  ::librapid::min(firstBlock + blocksPerSuperblock, numBlocks);
+				uint64_t count = 0;
+				for (uint64_t block = firstBlock; block < lastBlock; ++block) {
+					m_blocks[block] = static_cast<uint16_t>(count);
+					const uint64_t lastWord =
+					  ::librapid::min((block + 1) * wordsPerBlock, m_numWords);
+					for (uint64_t w = block * wordsPerBlock; w < lastWord; ++w) {
+						count += std::popcount(word(w));
+					}
+				}
+				m_superblocks[superblock + 1] = count;
+			};
+
+			const int64_t numTasks = static_cast<int64_t>(numSuperblocks);
+			if (m_numWords > global::multithreadThreshold && global::numThreads > 1) {
+#pragma omp parallel for shared(numTasks, countSuperblock) default(none)                           \
+  num_threads(int(global::numThreads))
+				for (int64_t s = 0; s < numTasks; ++s) { countSuperblock(s); }
+			} else {
+				for (int64_t s = 0; s < numTasks; ++s) { countSuperblock(s); }
+			}
+
+			for (uint64_t s = 0; s < numSuperblocks; ++s) {
+				m_superblocks[s + 1] += m_superblocks[s];
+			}
+		}
+
+		/// \return The number of bits indexed
+		LIBRAPID_NODISCARD uint64_t size() const { return m_numBits; }
+
+		/// \return The total number of set bits
+		LIBRAPID_NODISCARD uint64_t count() const {
+			return m_superblocks.empty() ? 0 : m_superblocks.back();
+		}
+
+		/// \brief Count the set bits before a position, in constant time
+		/// \param index The position. Positions past the end count every set bit
+		/// \return The number of set bits in \f$ [0, \mathrm{index}) \f$
+		LIBRAPID_NODISCARD uint64_t rank(uint64_t index) const {
+			if (index >= m_numBits) return count();
+
+			const uint64_t block	= index / bitsPerBlock;
+			const uint64_t lastWord = index / bitsPerWord;
+			const uint64_t bit		= index % bitsPerWord;
+
+			uint64_t res = m_superblocks[index / bitsPerSuperblock] + m_blocks[block];
+			for (uint64_t w = block * wordsPerBlock; w < lastWord; ++w) {
+				res += std::popcount(m_words[w]);
+			}
+			if (bit) res += std::popcount(m_words[lastWord] & ((uint64_t(1) << bit) - 1));
+			return res;
+		}
+
+		/// \brief Find the position of the set bit with \p k set bits before it, with a binary
+		/// search over the superblocks and then over the blocks of one superblock
+		/// \param k The number of set bits before the result
+		/// \return The position of the bit, or `size()` if fewer than k + 1 bits are set
+		LIBRAPID_NODISCARD uint64_t select(uint64_t k) const {
+			if (k >= count()) return m_numBits;
+
+			const auto superBegin	  = m_superblocks.begin();
+			const auto superEnd		  = m_superblocks.end() - 1;
+			const uint64_t superblock = std::upper_bound(superBegin, superEnd, k) - superBegin - 1;
+			k -= m_superblocks[superblock];
+
+			const uint64_t firstBlock = superblock * blocksPerSuperblock;
+			const uint64_t lastBlock =
+			  ::librapid::min(firstBlock + blocksPerSuperblock, uint64_t(m_blocks.size()));
+			const auto blockBegin = m_blocks.begin();
+			const uint64_t block =
+			  std::upper_bound(blockBegin + firstBlock, blockBegin + lastBlock, k) - blockBegin - 1;
+			k -= m_blocks[block];
+
+			for (uint64_t w = block * wordsPerBlock;; ++w) {
+				const uint64_t bits	 = word(w);
+				const uint64_t count = std::popcount(bits);
+				if (k < count) return w * bitsPerWord + detail::selectInWord(bits, k);
+				k -= count;
+			}
+		}
+
+	private:
+		/// \return Word \p w, with any bits past the end cleared
+		LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE uint64_t word(uint64_t w) const {
+			const uint64_t tail = m_numBits % bitsPerWord;
+			if (w + 1 == m_numWords && tail) return m_words[w] & ((uint64_t(1) << tail) - 1);
+			return m_words[w];
+		}
+
+		const uint64_t *m_words = nullptr;
+		uint64_t m_numBits		= 0;
+		uint64_t m_numWords		= 0;
+		std::vector<uint64_t> m_superblocks;
+		std::vector<uint16_t> m_blocks;
+	};
 } // namespace librapid
 
 template<uint64_t numBits, bool stackAlloc, typename Char>
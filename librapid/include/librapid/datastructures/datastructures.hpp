@@ -4,5 +4,6 @@
 #include "set.hpp"
 #include "bitset.hpp"
 #include "map.hpp"
+#include "flatHashMap.hpp"
 
 #endif // LIBRAPID_DATASTRUCTURES_HPP
\ No newline at end of file
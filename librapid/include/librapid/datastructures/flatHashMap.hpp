@@ -0,0 +1,682 @@
+#ifndef LIBRAPID_DATASTRUCTURES_FLAT_HASH_MAP_HPP
+#define LIBRAPID_DATASTRUCTURES_FLAT_HASH_MAP_HPP
+
+namespace librapid {
+	namespace detail {
+		/*
+		 * FlatHashMap and FlatHashSet are open-addressing ("Swiss") hash tables. All slots live
+		 * in one contiguous vector and each slot has a one-byte control value: `ctrlEmpty`,
+		 * `ctrlDeleted`, or the low seven bits of the key's hash if the slot is full. Slots are
+		 * split into aligned groups of `width`, and a lookup compares the control bytes of a
+		 * whole group against the hash in one SIMD comparison, so keys are only compared for
+		 * slots which are very likely to match.
+		 */
+
+		constexpr int8_t ctrlEmpty	 = -128;
+		constexpr int8_t ctrlDeleted = -2;
+
+		/// Mix the bits of a hash. std::hash is the identity for integers on most standard
+		/// libraries, and the table needs well-distributed high and low bits
+		LIBRAPID_ALWAYS_INLINE uint64_t flatHashMix(uint64_t hash) {
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdULL;
+			hash ^= hash >> 33;
+			return hash;
+		}
+
+		/// Extracts the key from a FlatHashMap slot
+		struct FlatHashMapKeyOf {
+			template<typename Slot>
+			LIBRAPID_ALWAYS_INLINE const auto &operator()(const Slot &slot) const {
+				return slot.first;
+			}
+		};
+
+		/// Extracts the key from a FlatHashSet slot
+		struct FlatHashSetKeyOf {
+			template<typename Slot>
+			LIBRAPID_ALWAYS_INLINE const Slot &operator()(const Slot &slot) const {
+				return slot;
+			}
+		};
+
+		/// The table shared by FlatHashMap and FlatHashSet
+		/// \tparam Key The key type
+		/// \tparam Slot The type stored in each slot
+		/// \tparam Hash The hash function
+		/// \tparam KeyEqual The key comparison function
+		/// \tparam KeyOf A function object returning the key of a slot
+		template<typename Key, typename Slot, typename Hash, typename KeyEqual, typename KeyOf>
+		class FlatHashTable {
+		public:
+			static constexpr int64_t packetWidth = typetraits::TypeInfo<int8_t>::packetWidth;
+
+			/// The number of slots in a group. Without SIMD, groups are scanned one byte at a
+			/// time
+			static constexpr int64_t width = packetWidth > 1 ? packetWidth : 16;
+
+			/// Iterates over the full slots of the table, in slot order
+			template<bool IsConst>
+			class Iterator {
+			public:
+				using TablePointer		= std::conditional_t<IsConst, const FlatHashTable *,
+															 FlatHashTable *>;
+				using iterator_category = std::forward_iterator_tag;
+				using value_type		= Slot;
+				using difference_type	= std::ptrdiff_t;
+				using pointer			= std::conditional_t<IsConst, const Slot *, Slot *>;
+				using reference			= std::conditional_t<IsConst, const Slot &, Slot &>;
+
+				Iterator() = default;
+
+				/// Construct an iterator pointing to the first full slot at or after `index`
+				Iterator(TablePointer table, int64_t index) :
+						m_table(table), m_index(table->nextFull(index)) {}
+
+				/// Convert a mutable iterator to a const one
+				operator Iterator<true>() const { return {m_table, m_index}; }
+
+				LIBRAPID_NODISCARD reference operator*() const { return m_table->m_slots[m_index]; }
+				LIBRAPID_NODISCARD pointer operator->() const {
+					return &m_table->m_slots[m_index];
+				}
+
+				Iterator &operator++() {
+					m_index = m_table->nextFull(m_index + 1);
+					return *this;
+				}
+
+				Iterator operator++(int) {
+					Iterator tmp = *this;
+					++(*this);
+					return tmp;
+				}
+
+				LIBRAPID_NODISCARD bool operator==(const Iterator &other) const {
+					return m_index == other.m_index;
+				}
+
+				LIBRAPID_NODISCARD bool operator!=(const Iterator &other) const {
+					return m_index != other.m_index;
+				}
+
+				/// \return The slot this iterator points to
+				LIBRAPID_NODISCARD int64_t index() const { return m_index; }
+
+			private:
+				TablePointer m_table = nullptr;
+				int64_t m_index		 = 0;
+			};
+
+			using iterator		 = Iterator<false>;
+			using const_iterator = Iterator<true>;
+
+			FlatHashTable() = default;
+
+			/// \brief Construct a table with room for at least \p count elements
+			/// \param count The number of elements to reserve space for
+			explicit FlatHashTable(int64_t count) { reserve(count); }
+
+			/// \return The number of elements in the table
+			LIBRAPID_NODISCARD int64_t size() const { return m_size; }
+
+			/// \return True if the table contains no elements
+			LIBRAPID_NODISCARD bool empty() const { return m_size == 0; }
+
+			/// \return The number of slots in the table. The table grows once it is 7/8 full
+			LIBRAPID_NODISCARD int64_t capacity() const { return m_slots.size(); }
+
+			/// \brief Make sure \p count elements can be stored without rehashing
+			/// \param count The number of elements to reserve space for
+			void reserve(int64_t count) {
+				const int64_t required = capacityFor(count);
+				if (required > capacity()) resize(required);
+			}
+
+			/// \brief Rebuild the table with at least \p count slots (rounded up to a power of
+			/// two), or fewer if it is larger than needed. This also removes the markers left
+			/// by erased elements. `rehash(0)` on an empty table releases all of its memory
+			/// \param count The minimum number of slots
+			void rehash(int64_t count) {
+				if (count == 0 && m_size == 0) {
+					m_ctrl	  = {};
+					m_slots	  = {};
+					m_deleted = 0;
+					return;
+				}
+
+				int64_t slots = width;
+				while (slots < count) slots *= 2;
+				resize(::librapid::max(slots, capacityFor(m_size)));
+			}
+
+			/// \brief Remove all elements, keeping the allocated slots
+			void clear() {
+				std::fill(m_ctrl.begin(), m_ctrl.end(), ctrlEmpty);
+				std::fill(m_slots.begin(), m_slots.end(), Slot());
+				m_size	  = 0;
+				m_deleted = 0;
+			}
+
+			/// \brief Check if a key exists in the table
+			/// \param key Key to search for
+			/// \return Boolean
+			LIBRAPID_NODISCARD bool contains(const Key &key) const {
+				return findIndex(key, hashOf(key)) >= 0;
+			}
+
+			/// \brief Find the element with key \p key
+			/// \param key Key to search for
+			/// \return An iterator to the element, or `end()` if it does not exist
+			LIBRAPID_NODISCARD iterator find(const Key &key) {
+				const int64_t index = findIndex(key, hashOf(key));
+				return {this, index >= 0 ? index : capacity()};
+			}
+
+			/// \brief Find the element with key \p key
+			/// \param key Key to search for
+			/// \return An iterator to the element, or `end()` if it does not exist
+			LIBRAPID_NODISCARD const_iterator find(const Key &key) const {
+				const int64_t index = findIndex(key, hashOf(key));
+				return {this, index >= 0 ? index : capacity()};
+			}
+
+			/// \brief Remove the element with key \p key, if it exists
+			/// \param key Key to remove
+			/// \return True if an element was removed
+			bool erase(const Key &key) {
+				const int64_t index = findIndex(key, hashOf(key));
+				if (index < 0) return false;
+				eraseIndex(index);
+				return true;
+			}
+
+			/// \brief Remove the element an iterator points to
+			/// \param it Iterator to a valid element
+			/// \return An iterator to the next element
+			iterator erase(const_iterator it) {
+				eraseIndex(it.index());
+				return {this, it.index() + 1};
+			}
+
+			LIBRAPID_NODISCARD iterator begin() { return {this, 0}; }
+			LIBRAPID_NODISCARD iterator end() { return {this, capacity()}; }
+			LIBRAPID_NODISCARD const_iterator begin() const { return {this, 0}; }
+			LIBRAPID_NODISCARD const_iterator end() const { return {this, capacity()}; }
+
+		protected:
+			/// \return The hash of \p key, with its bits mixed
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE uint64_t hashOf(const Key &key) const {
+				return flatHashMix(static_cast<uint64_t>(m_hash(key)));
+			}
+
+			/// \return The control byte for a full slot holding a key with this hash
+			LIBRAPID_NODISCARD static LIBRAPID_ALWAYS_INLINE int8_t tagOf(uint64_t hash) {
+				return static_cast<int8_t>(hash & 0x7F);
+			}
+
+			/// \return The first group on the probe sequence of a key with this hash
+			LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE int64_t firstGroup(uint64_t hash) const {
+				return static_cast<int64_t>(hash >> 7) & (capacity() / width - 1);
+			}
+
+			// The group scans are templated on the control byte type so that the SIMD branch
+			// is only instantiated when SIMD is available
+
+			/// \return Bit i is set if control byte i of the group equals `value`
+			template<typename Ctrl>
+			LIBRAPID_NODISCARD static LIBRAPID_ALWAYS_INLINE uint64_t match(const Ctrl *ctrl,
+																			Ctrl value) {
+				using Packet = typename typetraits::TypeInfo<Ctrl>::Packet;
+				if constexpr (packetWidth > 1) {
+					return (xsimd::load_unaligned(ctrl) == Packet(value)).mask();
+				} else {
+					uint64_t bits = 0;
+					for (int64_t i = 0; i < width; ++i) bits |= uint64_t(ctrl[i] == value) << i;
+					return bits;
+				}
+			}
+
+			/// \return Bit i is set if slot i of the group is empty or deleted. Both have the
+			/// sign bit set, while full slots do not
+			template<typename Ctrl>
+			LIBRAPID_NODISCARD static LIBRAPID_ALWAYS_INLINE uint64_t matchFree(const Ctrl *ctrl) {
+				using Packet = typename typetraits::TypeInfo<Ctrl>::Packet;
+				if constexpr (packetWidth > 1) {
+					return (xsimd::load_unaligned(ctrl) < Packet(0)).mask();
+				} else {
+					uint64_t bits = 0;
+					for (int64_t i = 0; i < width; ++i) bits |= uint64_t(ctrl[i] < 0) << i;
+					return bits;
+				}
+			}
+
+			/// \brief Find the slot holding \p key
+			/// \param key Key to search for
+			/// \param hash The (mixed) hash of the key
+			/// \return The index of the slot, or -1 if the key does not exist
+			LIBRAPID_NODISCARD int64_t findIndex(const Key &key, uint64_t hash) const {
+				if (m_slots.empty()) return -1;
+
+				// Triangular probing over a power-of-two number of groups visits every group
+				const int64_t groupMask = capacity() / width - 1;
+				const int8_t tag		= tagOf(hash);
+				int64_t group			= firstGroup(hash);
+				for (int64_t step = 1;; ++step) {
+					const int64_t base = group * width;
+					const int8_t *ctrl = m_ctrl.data() + base;
+					for (uint64_t bits = match(ctrl, tag); bits; bits &= bits - 1) {
+						const int64_t index = base + std::countr_zero(bits);
+						if (m_equal(KeyOf()(m_slots[index]), key)) return index;
+					}
+
+					// A key is never stored past a group which has an empty slot
+					if (match(ctrl, ctrlEmpty)) return -1;
+					group = (group + step) & groupMask;
+				}
+			}
+
+			/// \brief Find the first empty or deleted slot on the probe sequence of a hash.
+			/// The table must have at least one free slot
+			/// \param hash The (mixed) hash of a key
+			/// \return The index of the slot
+			LIBRAPID_NODISCARD int64_t findFree(uint64_t hash) const {
+				const int64_t groupMask = capacity() / width - 1;
+				int64_t group			= firstGroup(hash);
+				for (int64_t step = 1;; ++step) {
+					const int64_t base = group * width;
+					const uint64_t bits = matchFree(m_ctrl.data() + base);
+					if (bits) return base + std::countr_zero(bits);
+					group = (group + step) & groupMask;
+				}
+			}
+
+			/// \brief Find the slot holding \p key, or claim a free slot for it. A newly
+			/// claimed slot still holds a default-constructed value, which the caller must
+			/// overwrite
+			/// \param key The key to find or insert
+			/// \return The index of the slot and whether it was newly claimed
+			std::pair<int64_t, bool> findOrClaim(const Key &key) {
+				const uint64_t hash = hashOf(key);
+				int64_t index		= findIndex(key, hash);
+				if (index >= 0) return {index, false};
+
+				if ((m_size + m_deleted + 1) * 8 > capacity() * 7) {
+					// Rebuild in place if most of the used slots are just deleted markers
+					resize(m_deleted > m_size ? capacity() : capacityFor(m_size + 1));
+				}
+
+				index = findFree(hash);
+				m_deleted -= m_ctrl[index] == ctrlDeleted;
+				m_ctrl[index] = tagOf(hash);
+				++m_size;
+				return {index, true};
+			}
+
+			/// \brief Remove the element in a full slot
+			/// \param index The index of the slot
+			void eraseIndex(int64_t index) {
+				// If the group still has an empty slot, no probe sequence has ever passed
+				// through it, so this slot can be marked empty rather than deleted
+				const int64_t base = index - index % width;
+				if (match(m_ctrl.data() + base, ctrlEmpty)) {
+					m_ctrl[index] = ctrlEmpty;
+				} else {
+					m_ctrl[index] = ctrlDeleted;
+					++m_deleted;
+				}
+				m_slots[index] = Slot();
+				--m_size;
+			}
+
+			/// \brief Look up many keys, prefetching the groups of keys a few iterations
+			/// ahead so the cache misses of consecutive lookups overlap. Large batches are
+			/// split into blocks (of a multiple of 64 keys) which are processed in parallel
+			/// \tparam Func Called as `func(i, index)` with the slot index of key i, or -1
+			/// \param keys The keys to look up
+			/// \param n The number of keys
+			/// \param func The function to call for each key
+			template<typename Func>
+			void lookup(const Key *keys, int64_t n, Func &&func) const {
+				if (m_slots.empty()) {
+					for (int64_t i = 0; i < n; ++i) func(i, int64_t(-1));
+					return;
+				}
+
+				constexpr int64_t prefetchDistance = 16;
+				constexpr int64_t blockSize		   = 4096;
+
+				auto lookupBlock = [&](int64_t block) {
+					const int64_t begin = block * blockSize;
+					const int64_t end	= ::librapid::min(begin + blockSize, n);
+
+					uint64_t hashes[prefetchDistance];
+					auto prefetch = [&](int64_t i) {
+						const uint64_t hash			 = hashOf(keys[i]);
+						const int64_t base			 = firstGroup(hash) * width;
+						hashes[i % prefetchDistance] = hash;
+						prefetchRead(m_ctrl.data() + base);
+						prefetchRead(m_slots.data() + base);
+					};
+
+					const int64_t warmup = ::librapid::min(begin + prefetchDistance, end);
+					for (int64_t i = begin; i < warmup; ++i) { prefetch(i); }
+
+					for (int64_t i = begin; i < end; ++i) {
+						const uint64_t hash = hashes[i % prefetchDistance];
+						if (i + prefetchDistance < end) prefetch(i + prefetchDistance);
+						func(i, findIndex(keys[i], hash));
+					}
+				};
+
+				const int64_t numBlocks = (n + blockSize - 1) / blockSize;
+				if (static_cast<size_t>(n) > global::multithreadThreshold &&
+					global::numThreads > 1) {
+#pragma omp parallel for shared(numBlocks, lookupBlock) default(none)                              \
+  num_threads(int(global::numThreads))
+					for (int64_t block = 0; block < numBlocks; ++block) { lookupBlock(block); }
+				} else {
+					for (int64_t block = 0; block < numBlocks; ++block) { lookupBlock(block); }
+				}
+			}
+
+			/// \return The index of the first full slot at or after \p index, or `capacity()`
+			LIBRAPID_NODISCARD int64_t nextFull(int64_t index) const {
+				const int64_t slots = capacity();
+				while (index < slots && m_ctrl[index] < 0) ++index;
+				return index;
+			}
+
+			/// \return The smallest capacity which can hold \p count elements
+			LIBRAPID_NODISCARD static int64_t capacityFor(int64_t count) {
+				if (count <= 0) return 0;
+				int64_t slots = width;
+				while (slots * 7 < count * 8) slots *= 2;
+				return slots;
+			}
+
+			/// \brief Move every element into a new table with \p slots slots
+			/// \param slots The new capacity (a power-of-two multiple of `width`)
+			void resize(int64_t slots) {
+				std::vector<int8_t> oldCtrl = std::move(m_ctrl);
+				std::vector<Slot> oldSlots	= std::move(m_slots);
+
+				m_ctrl.assign(slots, ctrlEmpty);
+				m_slots	  = std::vector<Slot>(slots);
+				m_deleted = 0;
+
+				for (size_t i = 0; i < oldCtrl.size(); ++i) {
+					if (oldCtrl[i] < 0) continue;
+					const uint64_t hash = hashOf(KeyOf()(oldSlots[i]));
+					const int64_t index = findFree(hash);
+					m_ctrl[index]		= tagOf(hash);
+					m_slots[index]		= std::move(oldSlots[i]);
+				}
+			}
+
+			std::vector<int8_t> m_ctrl;
+			std::vector<Slot> m_slots;
+			int64_t m_size	  = 0;
+			int64_t m_deleted = 0;
+			Hash m_hash;
+			KeyEqual m_equal;
+		};
+	} // namespace detail
+
+	/// \brief A hash map storing its elements in one contiguous array of slots
+	///
+	/// FlatHashMap is an open-addressing alternative to UnorderedMap. Lookups compare a group
+	/// of one-byte hash tags with a single SIMD instruction and then touch only the matching
+	/// slots, with no per-element allocation or pointer chasing. Many keys can be looked up at
+	/// once with `find(keys, missing)`, which prefetches ahead and runs in parallel.
+	///
+	/// Unlike `std::unordered_map`, inserting may move elements, which invalidates iterators,
+	/// pointers and references. Both `Key` and `Value` must be default-constructible.
+	///
+	/// \code{.cpp}
+	/// lrc::FlatHashMap<int64_t, int64_t> rowOf;
+	/// rowOf.reserve(ids.size());
+	/// for (int64_t i = 0; i < ids.size(); ++i) rowOf[ids[i]] = i;
+	/// auto rows = rowOf.find(queries, -1); // Array of rows, -1 where an ID is missing
+	/// \endcode
+	/// \tparam Key The key type
+	/// \tparam Value The value type
+	/// \tparam Hash The hash function
+	/// \tparam KeyEqual The key comparison function
+	template<typename Key, typename Value, typename Hash = std::hash<Key>,
+			 typename KeyEqual = std::equal_to<Key>>
+	class FlatHashMap
+			: public detail::FlatHashTable<Key, std::pair<Key, Value>, Hash, KeyEqual,
+										   detail::FlatHashMapKeyOf> {
+	public:
+		using Base = detail::FlatHashTable<Key, std::pair<Key, Value>, Hash, KeyEqual,
+										   detail::FlatHashMapKeyOf>;
+		using value_type	 = std::pair<Key, Value>;
+		using iterator		 = typename Base::iterator;
+		using const_iterator = typename Base::const_iterator;
+
+		using Base::Base;
+		using Base::contains;
+		using Base::find;
+
+		FlatHashMap() = default;
+
+		/// \brief Construct a map from a list of key-value pairs. Later values overwrite
+		/// earlier ones with the same key
+		/// \param init The key-value pairs
+		FlatHashMap(std::initializer_list<value_type> init) {
+			this->reserve(init.size());
+			for (const auto &[key, value] : init) insertOrAssign(key, value);
+		}
+
+		/// \brief Insert a key-value pair if the key does not already exist
+		/// \param pair The key-value pair
+		/// \return An iterator to the element with the key, and true if it was inserted
+		std::pair<iterator, bool> insert(const value_type &pair) {
+			const auto [index, inserted] = this->findOrClaim(pair.first);
+			if (inserted) this->m_slots[index] = pair;
+			return {iterator(this, index), inserted};
+		}
+
+		/// \brief Insert a key-value pair, overwriting the value if the key already exists
+		/// \param key The key
+		/// \param value The value
+		/// \return An iterator to the element, and true if the key was inserted
+		std::pair<iterator, bool> insertOrAssign(const Key &key, const Value &value) {
+			const auto [index, inserted] = this->findOrClaim(key);
+			if (inserted) this->m_slots[index].first = key;
+			this->m_slots[index].second = value;
+			return {iterator(this, index), inserted};
+		}
+
+		/// \brief Access the value of a key, inserting a default-constructed value if the key
+		/// does not exist
+		/// \param key The key
+		/// \return A reference to the value
+		Value &operator[](const Key &key) {
+			const auto [index, inserted] = this->findOrClaim(key);
+			if (inserted) this->m_slots[index].first = key;
+			return this->m_slots[index].second;
+		}
+
+		/// \brief Check if a key exists in the map and, if it does, set \p value to the value of
+		/// the key. The function returns true if the key exists, false otherwise. (If the function
+		/// returns false, \p value will not be modified/initialized, so make sure you check the
+		/// return value!)
+		/// \param key Key to search for
+		/// \param value Value of the key, if it exists (output)
+		/// \return True if the key exists, false otherwise
+		LIBRAPID_NODISCARD bool contains(const Key &key, Value &value) const {
+			const int64_t index = this->findIndex(key, this->hashOf(key));
+			if (index < 0) return false;
+			value = this->m_slots[index].second;
+			return true;
+		}
+
+		/// \brief Get the value of a key. An exception is thrown if the key does not exist
+		/// \param key Key to search for
+		/// \return Value of the key
+		LIBRAPID_NODISCARD const Value &get(const Key &key) const {
+			const int64_t index = this->findIndex(key, this->hashOf(key));
+			if (index < 0) throw std::out_of_range("Key does not exist in FlatHashMap");
+			return this->m_slots[index].second;
+		}
+
+		/// \brief Get the value of a key, or a default value if the key does not exist
+		/// \param key Key to search for
+		/// \param defaultValue Default value to return if the key does not exist
+		/// \return Value of the key, or \p defaultValue if the key does not exist
+		LIBRAPID_NODISCARD Value get(const Key &key, const Value &defaultValue) const {
+			const int64_t index = this->findIndex(key, this->hashOf(key));
+			return index >= 0 ? this->m_slots[index].second : defaultValue;
+		}
+
+		/// \brief Look up the values of many keys at once
+		/// \param keys Pointer to the keys
+		/// \param n The number of keys
+		/// \param out Output buffer with space for \p n values
+		/// \param missing The value written for keys which do not exist
+		void find(const Key *keys, int64_t n, Value *out, const Value &missing) const {
+			this->lookup(keys, n, [&](int64_t i, int64_t index) {
+				out[i] = index >= 0 ? this->m_slots[index].second : missing;
+			});
+		}
+
+		/// \brief Look up the values of an array of keys
+		/// \tparam ShapeType The shape type of the array
+		/// \param keys The keys to look up
+		/// \param missing The value for keys which do not exist
+		/// \return An array of values with the same shape as \p keys
+		template<typename ShapeType>
+		LIBRAPID_NODISCARD auto find(const array::ArrayContainer<ShapeType, Storage<Key>> &keys,
+									 const Value &missing) const {
+			array::ArrayContainer<ShapeType, Storage<Value>> result(keys.shape());
+			find(keys.storage().data(), keys.size(), result.storage().data(), missing);
+			return result;
+		}
+
+		LIBRAPID_NODISCARD std::string str(const std::string &keyFormat   = "{}",
+										   const std::string &valueFormat = "{}") const {
+			std::string str = "[\n";
+			for (const auto &pair : *this) {
+				str += "  " + fmt::format(keyFormat, pair.first);
+				str += ": ";
+				str += fmt::format(valueFormat, pair.second);
+				str += "\n";
+			}
+			str += "]";
+
+			return str;
+		}
+	};
+
+	/// \brief A hash set storing its elements in one contiguous array of slots
+	///
+	/// The set counterpart of FlatHashMap, with the same probing scheme and invalidation
+	/// rules. Elements cannot be modified through iterators. For a set which is kept sorted
+	/// and supports set algebra, see Set.
+	/// \tparam Key The element type
+	/// \tparam Hash The hash function
+	/// \tparam KeyEqual The element comparison function
+	template<typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+	class FlatHashSet
+			: public detail::FlatHashTable<Key, Key, Hash, KeyEqual, detail::FlatHashSetKeyOf> {
+	public:
+		using Base = detail::FlatHashTable<Key, Key, Hash, KeyEqual, detail::FlatHashSetKeyOf>;
+		using value_type	 = Key;
+		using iterator		 = typename Base::const_iterator;
+		using const_iterator = typename Base::const_iterator;
+
+		using Base::Base;
+		using Base::contains;
+
+		FlatHashSet() = default;
+
+		/// \brief Construct a set from a list of elements
+		/// \param init The elements
+		FlatHashSet(std::initializer_list<Key> init) { insert(init.begin(), init.size()); }
+
+		/// \brief Construct a set from a vector
+		/// \param data The elements
+		explicit FlatHashSet(const std::vector<Key> &data) { insert(data.data(), data.size()); }
+
+		/// \brief Construct a set from the elements of an array on the host
+		/// \tparam ShapeType The shape type of the array
+		/// \param arr The array
+		template<typename ShapeType>
+		explicit FlatHashSet(const array::ArrayContainer<ShapeType, Storage<Key>> &arr) {
+			insert(arr.storage().data(), arr.size());
+		}
+
+		/// \brief Insert an element if it does not already exist
+		/// \param key The element
+		/// \return True if the element was inserted
+		bool insert(const Key &key) {
+			const auto [index, inserted] = this->findOrClaim(key);
+			if (inserted) this->m_slots[index] = key;
+			return inserted;
+		}
+
+		/// \brief Insert many elements
+		/// \param keys Pointer to the elements
+		/// \param n The number of elements
+		void insert(const Key *keys, int64_t n) {
+			this->reserve(this->size() + n);
+			for (int64_t i = 0; i < n; ++i) insert(keys[i]);
+		}
+
+		LIBRAPID_NODISCARD const_iterator find(const Key &key) const { return Base::find(key); }
+		LIBRAPID_NODISCARD const_iterator begin() const { return Base::begin(); }
+		LIBRAPID_NODISCARD const_iterator end() const { return Base::end(); }
+
+		/// \brief Check which of many elements exist in the set
+		/// \param keys Pointer to the elements
+		/// \param n The number of elements
+		/// \param out Output buffer with space for \p n booleans
+		void contains(const Key *keys, int64_t n, bool *out) const {
+			this->lookup(keys, n, [&](int64_t i, int64_t index) { out[i] = index >= 0; });
+		}
+
+		/// \brief Check which elements of an array exist in the set
+		/// \tparam ShapeType The shape type of the array
+		/// \param keys The elements to look up
+		/// \return A Mask with the same shape as \p keys
+		template<typename ShapeType, typename MaskType = Mask>
+		LIBRAPID_NODISCARD MaskType
+		contains(const array::ArrayContainer<ShapeType, Storage<Key>> &keys) const {
+			// Lookups run in blocks of a multiple of 64 keys, so each word of the result is
+			// written by a single thread
+			MaskType result(keys.shape());
+			auto *words = result.data();
+			this->lookup(keys.storage().data(), keys.size(), [&](int64_t i, int64_t index) {
+				words[i / 64] |= uint64_t(index >= 0) << (i % 64);
+			});
+			return result;
+		}
+
+		LIBRAPID_NODISCARD std::string str(const std::string &format = "{}") const {
+			std::string str = "(";
+			int64_t count	= 0;
+			for (const auto &key : *this) {
+				str += fmt::format(format, key);
+				if (++count < this->size()) str += ", ";
+			}
+			str += ")";
+
+			return str;
+		}
+	};
+} // namespace librapid
+
+LIBRAPID_SIMPLE_IO_IMPL(typename Key COMMA typename Value COMMA typename Hash COMMA
+						  typename KeyEqual,
+						librapid::FlatHashMap<Key COMMA Value COMMA Hash COMMA KeyEqual>)
+LIBRAPID_SIMPLE_IO_NORANGE(typename Key COMMA typename Value COMMA typename Hash COMMA
+							 typename KeyEqual,
+						   librapid::FlatHashMap<Key COMMA Value COMMA Hash COMMA KeyEqual>)
+LIBRAPID_SIMPLE_IO_IMPL(typename Key COMMA typename Hash COMMA typename KeyEqual,
+						librapid::FlatHashSet<Key COMMA Hash COMMA KeyEqual>)
+LIBRAPID_SIMPLE_IO_NORANGE(typename Key COMMA typename Hash COMMA typename KeyEqual,
+						   librapid::FlatHashSet<Key COMMA Hash COMMA KeyEqual>)
+
+#endif // LIBRAPID_DATASTRUCTURES_FLAT_HASH_MAP_HPP
@@ -2,6 +2,93 @@
 #define LIBRAPID_SET_HPP
 
 namespace librapid {
+	namespace detail {
+		// Defined in array/sort.hpp
+		template<typename Scalar>
+		void sortRow(Scalar *data, int64_t n, bool stable, int64_t numChunks);
+
+		/*
+		 * Merges of two sorted, duplicate-free ranges into `out`, which must have space for
+		 * the largest possible result. Each returns the number of elements written. The loops
+		 * are written without data-dependent branches, so they compile to conditional moves
+		 * rather than unpredictable jumps.
+		 */
+
+		template<typename T>
+		int64_t setUnion(const T *a, int64_t na, const T *b, int64_t nb, T *out) {
+			int64_t i = 0, j = 0, k = 0;
+			while (i < na && j < nb) {
+				const T &x = a[i], &y = b[j];
+				out[k++]   = y < x ? y : x;
+				i += !(y < x);
+				j += !(x < y);
+			}
+			k = std::copy(a + i, a + na, out + k) - out;
+			return std::copy(b + j, b + nb, out + k) - out;
+		}
+
+		template<typename T>
+		int64_t setIntersection(const T *a, int64_t na, const T *b, int64_t nb, T *out) {
+			int64_t i = 0, j = 0, k = 0;
+
+			if constexpr (std::is_integral_v<T> && typetraits::TypeInfo<T>::packetWidth > 1) {
+				// Compare a block of `a` against every element of a block of `b`, then advance
+				// whichever block ends with the smaller value
+				using Packet			= typename typetraits::TypeInfo<T>::Packet;
+				constexpr int64_t width = typetraits::TypeInfo<T>::packetWidth;
+				while (i + width <= na && j + width <= nb) {
+					const Packet block = xsimd::load_unaligned(a + i);
+					auto match		   = block == Packet(b[j]);
+					for (int64_t l = 1; l < width; ++l) match = match | (block == Packet(b[j + l]));
+
+					for (uint64_t bits = match.mask(); bits; bits &= bits - 1) {
+						out[k++] = a[i + std::countr_zero(bits)];
+					}
+
+					const T lastA = a[i + width - 1], lastB = b[j + width - 1];
+					i += lastA <= lastB ? width : 0;
+					j += lastB <= lastA ? width : 0;
+				}
+			}
+
+			while (i < na && j < nb) {
+				const T &x = a[i], &y = b[j];
+				out[k]	   = x;
+				k += !(x < y) && !(y < x);
+				i += !(y < x);
+				j += !(x < y);
+			}
+			return k;
+		}
+
+		template<typename T>
+		int64_t setDifference(const T *a, int64_t na, const T *b, int64_t nb, T *out) {
+			int64_t i = 0, j = 0, k = 0;
+			while (i < na && j < nb) {
+				const T &x = a[i], &y = b[j];
+				out[k]	   = x;
+				k += x < y;
+				i += !(y < x);
+				j += !(x < y);
+			}
+			return std::copy(a + i, a + na, out + k) - out;
+		}
+
+		template<typename T>
+		int64_t setSymmetricDifference(const T *a, int64_t na, const T *b, int64_t nb, T *out) {
+			int64_t i = 0, j = 0, k = 0;
+			while (i < na && j < nb) {
+				const T &x = a[i], &y = b[j];
+				out[k]	   = y < x ? y : x;
+				k += (x < y) || (y < x);
+				i += !(y < x);
+				j += !(x < y);
+			}
+			k = std::copy(a + i, a + na, out + k) - out;
+			return std::copy(b + j, b + nb, out + k) - out;
+		}
+	} // namespace detail
+
 	/// \brief An unordered set of distinct elements of the same type. Elements are stored in
 	/// ascending order and duplicates are removed.
 	///
@@ -11,6 +98,10 @@ namespace librapid {
 	/// mySet = Set(myArr)
 	/// // mySet -> Set(1, 2, 3, 4, 5, 6, 7, 8, 9)
 	/// \endcode
+	///
+	/// Sets are built in bulk (a parallel sort followed by removing duplicates), and the set
+	/// operations are linear merges, so inserting or removing many values at once is much
+	/// faster than doing so one at a time.
 	/// \tparam ElementType_ The type of the elements in the set
 	template<typename ElementType_>
 	class Set {
@@ -51,6 +142,31 @@ namespace librapid {
 			prune();
 		}
 
+		/// \brief Construct a set from an array on the host, copying its data directly
+		/// \tparam ShapeType Shape type of the array
+		/// \tparam Scalar Scalar type of the array
+		/// \param arr The array to construct the set from
+		template<typename ShapeType, typename Scalar>
+		Set(const array::ArrayContainer<ShapeType, Storage<Scalar>> &arr) {
+			const auto data = arr.storage().data();
+			m_data.assign(data, data + arr.size());
+			sort();
+			prune();
+		}
+
+		/// \brief Construct a set from an array with fixed-size storage
+		/// \tparam ShapeType Shape type of the array
+		/// \tparam Scalar Scalar type of the array
+		/// \tparam Dims Dimensions of the storage
+		/// \param arr The array to construct the set from
+		template<typename ShapeType, typename Scalar, size_t... Dims>
+		Set(const array::ArrayContainer<ShapeType, FixedStorage<Scalar, Dims...>> &arr) {
+			const auto data = arr.storage().data();
+			m_data.assign(data, data + arr.size());
+			sort();
+			prune();
+		}
+
 		/// \brief Construct a set from a vector
 		/// \param data The vector to construct the set from
 		Set(const std::vector<ElementType> &data) : m_data(data) {
@@ -91,61 +207,61 @@ namespace librapid {
 		/// \param val The value to check for
 		/// \return True if the value is present, false otherwise
 		LIBRAPID_NODISCARD bool contains(const ElementType &val) const {
-			// Binary search
-
-			int64_t mid;
-			int64_t head = 0;
-			int64_t tail = m_data.size() - 1;
-			bool found	 = false;
-
-			while (!found && head <= tail) {
-				mid = (head + tail) / 2;
-				if (val < m_data[mid]) {
-					tail = mid - 1;
-				} else if (val > m_data[mid]) {
-					head = mid + 1;
-				} else {
-					found = true;
+			const int64_t size = m_data.size();
+			if (size == 0) return false;
+
+			// Branchless binary search for the last element <= val. Each step compiles to a
+			// conditional move, so there are no mispredicted branches
+			const ElementType *data = m_data.data();
+			const ElementType *base = data;
+			int64_t length			= size;
+
+			if constexpr (std::is_integral_v<ElementType> &&
+						  typetraits::TypeInfo<ElementType>::packetWidth > 1) {
+				// Stop when the range fits in a packet, and compare every element at once
+				using Packet			= typename typetraits::TypeInfo<ElementType>::Packet;
+				constexpr int64_t width = typetraits::TypeInfo<ElementType>::packetWidth;
+				if (size >= width) {
+					while (length > width) {
+						const int64_t half = length / 2;
+						base += !(val < base[half]) ? half : 0;
+						length -= half;
+					}
+
+					const ElementType *block = std::min(base, data + size - width);
+					return xsimd::any(Packet(xsimd::load_unaligned(block)) == Packet(val));
 				}
 			}
 
-			return found;
+			while (length > 1) {
+				const int64_t half = length / 2;
+				base += !(val < base[half]) ? half : 0;
+				length -= half;
+			}
+			return !(*base < val) && !(val < *base);
 		}
 
 		/// \brief Insert a value into the set (\f$ S \cup \{\text{val}\} \f$)
 		/// \param val The value to insert
 		/// \return Return a reference to the set
 		Set &insert(const ElementType &val) {
-			if (contains(val)) return *this;
-
-			// Insert into data
-			for (auto it = m_data.begin(); it < m_data.end(); it++) {
-				if (*it > val) {
-					m_data.insert(it, val);
-					return *this;
-				}
-			}
-
-			m_data.emplace_back(val);
+			auto it = std::lower_bound(m_data.begin(), m_data.end(), val);
+			if (it == m_data.end() || val < *it) m_data.insert(it, val);
 			return *this;
 		}
 
 		/// \brief Insert an `std::vector` of values into the set (\f$ S \leftarrow S \cup
 		/// \text{data} \f$)
 		///
-		/// Each element of the vector is inserted into the set.
+		/// The values are sorted and merged into the set in linear time.
 		/// \param data
 		/// \return Reference to the set
-		Set &insert(const std::vector<ElementType> &data) {
-			for (const auto &val : data) { insert(val); }
-			return *this;
-		}
+		Set &insert(const std::vector<ElementType> &data) { return *this = *this | Set(data); }
 
 		/// \brief Insert an initializer list of values into the set (\f$ S \leftarrow S \cup
 		/// \text{data} \f$) \param data \return Reference to the set
 		Set &insert(const std::initializer_list<ElementType> &data) {
-			for (const auto &val : data) { insert(val); }
-			return *this;
+			return *this = *this | Set(data);
 		}
 
 		/// \brief Insert an element into the set (\f$ S \leftarrow S \cup \{\text{val}\} \f$)
@@ -198,24 +314,8 @@ namespace librapid {
 		/// \param val The value to discard
 		/// \return A reference to the set
 		Set &discard(const ElementType &val) {
-			// Binary search
-
-			int64_t mid;
-			int64_t head = 0;
-			int64_t tail = m_data.size() - 1;
-
-			while (head <= tail) {
-				mid = (head + tail) / 2;
-				if (val < m_data[mid]) {
-					tail = mid - 1;
-				} else if (val > m_data[mid]) {
-					head = mid + 1;
-				} else {
-					m_data.erase(m_data.begin() + mid);
-					return *this;
-				}
-			}
-
+			auto it = std::lower_bound(m_data.begin(), m_data.end(), val);
+			if (it != m_data.end() && !(val < *it)) m_data.erase(it);
 			return *this;
 		}
 
@@ -225,10 +325,7 @@ namespace librapid {
 		///
 		/// \param data The vector of values to Discard
 		/// \return A reference to the set
-		Set &discard(const std::vector<ElementType> &data) {
-			for (const auto &val : data) { discard(val); }
-			return *this;
-		}
+		Set &discard(const std::vector<ElementType> &data) { return *this = *this - Set(data); }
 
 		/// \brief Discard an initializer list of values from the set (\f$ S \setminus \text{data}
 		/// \f$)
@@ -238,8 +335,7 @@ namespace librapid {
 		/// \param data The initializer list of values to Discard
 		/// \return A reference to the set
 		Set &discard(const std::initializer_list<ElementType> &data) {
-			for (const auto &val : data) { discard(val); }
-			return *this;
+			return *this = *this - Set(data);
 		}
 
 		/// \brief Remove \p val from the set (\f$ S \setminus \{\text{val}\} \f$)
@@ -260,8 +356,10 @@ namespace librapid {
 		/// \param data The vector of values to remove
 		/// \return A reference to the set
 		Set &remove(const std::vector<ElementType> &data) {
-			for (const auto &val : data) { remove(val); }
-			return *this;
+			for (const auto &val : data) {
+				LIBRAPID_ASSERT(contains(val), "Set does not contain value: {}", val);
+			}
+			return discard(data);
 		}
 
 		/// \brief Remove an initializer list of values from the set (\f$ S \setminus \text{data}
@@ -272,8 +370,10 @@ namespace librapid {
 		/// \param data The initializer list of values to remove
 		/// \return  A reference to the set
 		Set &remove(const std::initializer_list<ElementType> &data) {
-			for (const auto &val : data) { remove(val); }
-			return *this;
+			for (const auto &val : data) {
+				LIBRAPID_ASSERT(contains(val), "Set does not contain value: {}", val);
+			}
+			return discard(data);
 		}
 
 		/// \brief Discard \p val from the set if it exists
@@ -328,34 +428,7 @@ namespace librapid {
 		/// \param other \f$ S_2 \f$
 		/// \return A new set \f$ R = S_1 \cup S_2 \f$
 		LIBRAPID_NODISCARD Set operator|(const Set &other) const {
-			// Union operator
-			Set result;
-
-			// Reserve space for elements (a decent guess)
-			result.reserve(m_data.size() + other.m_data.size());
-
-			int64_t indexA = 0;
-			int64_t indexB = 0;
-
-			while (indexA < m_data.size() && indexB < other.m_data.size()) {
-				if (m_data[indexA] < other.m_data[indexB]) {
-					result.pushBack(m_data[indexA]);
-					++indexA;
-				} else if (m_data[indexA] > other.m_data[indexB]) {
-					result.pushBack(other.m_data[indexB]);
-					++indexB;
-				} else {
-					result.pushBack(m_data[indexA]);
-					++indexA;
-					++indexB;
-				}
-			}
-
-			// Add remaining elements
-			result.insert(result.end(), m_data.begin() + indexA, m_data.end());
-			result.insert(result.end(), other.m_data.begin() + indexB, other.m_data.end());
-
-			return result;
+			return merge(other, size() + other.size(), detail::setUnion<ElementType>);
 		}
 
 		/// \brief Return the intersection of two sets (\f$ R = S_1 \cap S_2 \f$)
@@ -364,29 +437,9 @@ namespace librapid {
 		///
 		/// \param other \f$ S_2 \f$
 		/// \return A new set \f$ R = S_1 \cap S_2 \f$
-		Set operator&(const Set &other) const {
-			// Intersection operator
-			Set result;
-
-			// Reserve space for elements (a decent guess)
-			result.reserve(std::min(m_data.size(), other.m_data.size()));
-
-			int64_t indexA = 0;
-			int64_t indexB = 0;
-
-			while (indexA < m_data.size() && indexB < other.m_data.size()) {
-				if (m_data[indexA] < other.m_data[indexB]) {
-					++indexA;
-				} else if (m_data[indexA] > other.m_data[indexB]) {
-					++indexB;
-				} else {
-					result.pushBack(m_data[indexA]);
-					++indexA;
-					++indexB;
-				}
-			}
-
-			return result;
+		LIBRAPID_NODISCARD Set operator&(const Set &other) const {
+			return merge(
+			  other, std::min(size(), other.size()), detail::setIntersection<ElementType>);
 		}
 
 		/// \brief Return the symmetric difference of two sets (\f$ R = S_1 \oplus S_2 \f$)
@@ -395,30 +448,9 @@ namespace librapid {
 		///
 		/// \param other \f$ S_2 \f$
 		/// \return A new set \f$ R = S_1 \oplus S_2 \f$
-		Set operator^(const Set &other) const {
-			// Symmetric difference operator (elements in either set but not both)
-			Set result;
-
-			// Reserve space for elements (a decent guess)
-			result.reserve(m_data.size() + other.m_data.size());
-
-			int64_t indexA = 0;
-			int64_t indexB = 0;
-
-			while (indexA < m_data.size() && indexB < other.m_data.size()) {
-				if (m_data[indexA] < other.m_data[indexB]) {
-					result.pushBack(m_data[indexA]);
-					++indexA;
-				} else if (m_data[indexA] > other.m_data[indexB]) {
-					result.pushBack(other.m_data[indexB]);
-					++indexB;
-				} else {
-					++indexA;
-					++indexB;
-				}
-			}
-
-			return result;
+		LIBRAPID_NODISCARD Set operator^(const Set &other) const {
+			return merge(
+			  other, size() + other.size(), detail::setSymmetricDifference<ElementType>);
 		}
 
 		/// \brief Return the set difference of two sets (\f$ R = S_1 \setminus S_2 \f$)
@@ -427,32 +459,8 @@ namespace librapid {
 		///
 		/// \param other \f$ S_2 \f$
 		/// \return A new set \f$ R = S_1 \setminus S_2 \f$
-		Set operator-(const Set &other) const {
-			// Set difference
-			Set result;
-
-			// Reserve space for elements (a decent guess)
-			result.reserve(m_data.size() + other.m_data.size());
-
-			int64_t indexA = 0;
-			int64_t indexB = 0;
-
-			while (indexA < m_data.size() && indexB < other.m_data.size()) {
-				if (m_data[indexA] < other.m_data[indexB]) {
-					result.pushBack(m_data[indexA]);
-					++indexA;
-				} else if (m_data[indexA] > other.m_data[indexB]) {
-					++indexB;
-				} else {
-					++indexA;
-					++indexB;
-				}
-			}
-
-			// Add remaining elements
-			result.insert(result.end(), m_data.begin() + indexA, m_data.end());
-
-			return result;
+		LIBRAPID_NODISCARD Set operator-(const Set &other) const {
+			return merge(other, size(), detail::setDifference<ElementType>);
 		}
 
 		LIBRAPID_NODISCARD auto operator<=>(const Set &other) const = default;
@@ -484,17 +492,33 @@ namespace librapid {
 		/// \param elements The number of elements to reserve space for
 		void reserve(size_t elements) { m_data.reserve(elements); }
 
-		/// \brief Sort the underlying vector
-		void sort() { std::sort(m_data.begin(), m_data.end()); }
+		/// \brief Sort the underlying vector (in parallel for large sets)
+		void sort() {
+			const int64_t n		  = m_data.size();
+			const bool parallel	  = static_cast<size_t>(n) > global::multithreadThreshold;
+			const int64_t threads = parallel ? static_cast<int64_t>(global::numThreads) : 1;
+			detail::sortRow(m_data.data(), n, false, threads);
+		}
 
-		/// \brief Remove duplicates from the underlying vector
-		void prune() {
-			std::vector<ElementType> newData;
-			newData.reserve(m_data.size());
-			for (int64_t i = 0; i < m_data.size(); ++i) {
-				if (i == 0 || m_data[i] != m_data[i - 1]) { newData.emplace_back(m_data[i]); }
-			}
-			m_data = newData;
+		/// \brief Remove duplicates from the (sorted) underlying vector
+		void prune() { m_data.erase(std::unique(m_data.begin(), m_data.end()), m_data.end()); }
+
+		/// \brief Merge this set with another, using one of the merges in ``detail``
+		/// \param other The other set
+		/// \param capacity The maximum size of the result
+		/// \param func The merge function
+		/// \return The merged set
+		template<typename Func>
+		LIBRAPID_NODISCARD Set merge(const Set &other, int64_t capacity, Func &&func) const {
+			Set result;
+			result.m_data.resize(capacity);
+			const int64_t n = func(m_data.data(),
+								   size(),
+								   other.m_data.data(),
+								   other.size(),
+								   result.m_data.data());
+			result.m_data.resize(n);
+			return result;
 		}
 
 		/// \brief Add a value to the end of the set if it is known to be the largest element
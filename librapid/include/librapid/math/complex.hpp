@@ -469,6 +469,10 @@ namespace librapid {
 		/// \param other The std::complex value to copy
 		explicit Complex(const std::complex<T> &other) : m_val {other.real(), other.imag()} {}
 
+		/// \brief Convert a complex number to a std::complex
+		/// \return The equivalent std::complex value
+		explicit operator std::complex<T>() const { return {m_val[RE], m_val[IM]}; }
+
 		static constexpr auto size() -> size_t {
 			return typetraits::TypeInfo<Complex>::packetWidth;
 		}
@@ -2057,19 +2061,38 @@ namespace librapid {
 	}
 
 	namespace typetraits {
+		/// Evaluates as true if the input type is a Complex number
+		/// \tparam T Input type
+		template<typename T>
+		struct IsComplex : std::false_type {};
+
+		template<typename T>
+		struct IsComplex<Complex<T>> : std::true_type {};
+
+		template<typename T>
+		struct SimdScalar<Complex<T>> {
+			using Type = std::complex<T>;
+		};
+
 		template<typename T>
 		struct TypeInfo<Complex<T>> {
+			// Complex<float> and Complex<double> are vectorised with xsimd's complex packets,
+			// which hold the real and imaginary components in separate registers
+			static constexpr bool vectorisable =
+			  std::is_same_v<T, float> || std::is_same_v<T, double>;
+
 			static constexpr detail::LibRapidType type = detail::LibRapidType::Scalar;
 			using Scalar							   = Complex<T>;
 			using Backend							   = typename TypeInfo<T>::Backend;
 			using ShapeType							   = std::false_type;
-			using Packet							   = std::false_type;
-			static constexpr int64_t packetWidth	   = 0;
-			static constexpr char name[]			   = "Complex";
-			static constexpr bool supportsArithmetic   = true;
-			static constexpr bool supportsLogical	   = true;
-			static constexpr bool supportsBinary	   = false;
-			static constexpr bool allowVectorisation   = false;
+			using Packet =
+			  std::conditional_t<vectorisable, xsimd::batch<std::complex<T>>, std::false_type>;
+			static constexpr int64_t packetWidth	 = vectorisable ? TypeInfo<T>::packetWidth : 0;
+			static constexpr char name[]			 = "Complex";
+			static constexpr bool supportsArithmetic = true;
+			static constexpr bool supportsLogical	 = true;
+			static constexpr bool supportsBinary	 = false;
+			static constexpr bool allowVectorisation = vectorisable;
 
 #if defined(LIBRAPID_HAS_CUDA)
 			static constexpr cudaDataType_t CudaType = cudaDataType_t::CUDA_C_64F;
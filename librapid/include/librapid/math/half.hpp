@@ -713,19 +713,25 @@ namespace librapid {
 	}
 
 	namespace typetraits {
+		template<>
+		struct IsFloatingPoint<half> : std::true_type {};
+
+		// Arrays of half are evaluated with float packets. Elements are widened to float as they
+		// are loaded and narrowed again as they are stored (see detail::loadConverted and
+		// detail::storeConverted), using the F16C instructions where they are available
 		template<>
 		struct TypeInfo<half> {
 			static constexpr detail::LibRapidType type = detail::LibRapidType::Scalar;
 			using Scalar							   = half;
-			using Packet							   = std::false_type;
+			using Packet							   = typename TypeInfo<float>::Packet;
 			using Backend							   = backend::CPU;
 			using ShapeType							   = std::false_type;
-			static constexpr int64_t packetWidth	   = 1;
+			static constexpr int64_t packetWidth	   = TypeInfo<float>::packetWidth;
 			static constexpr char name[]			   = "half";
 			static constexpr bool supportsArithmetic   = true;
 			static constexpr bool supportsLogical	   = true;
 			static constexpr bool supportsBinary	   = false;
-			static constexpr bool allowVectorisation   = false;
+			static constexpr bool allowVectorisation   = true;
 
 #if defined(LIBRAPID_HAS_CUDA)
 			static constexpr cudaDataType_t CudaType = cudaDataType_t::CUDA_R_16F;
@@ -7,6 +7,7 @@
 #include "coreMath.hpp"
 #include "random.hpp"
 #include "half.hpp"
+#include "bfloat16.hpp"
 #include "multiprec.hpp"
 #include "vector.hpp"
 #include "complex.hpp"
@@ -9,24 +9,30 @@ namespace librapid {
 		template<typename T, uint64_t N>
 		struct SimdVectorStorage;
 
+		// SIMD storage is only used for the built-in arithmetic types. Other types (such as
+		// Complex) may have packets, but cannot be accessed through them element-wise
+		template<typename T>
+		constexpr bool useSimdVectorStorage() {
+			return std::is_arithmetic_v<T> && (typetraits::TypeInfo<T>::packetWidth > 1);
+		}
+
 		template<typename T, uint64_t N>
 		struct VectorStorageType {
-			using type = std::conditional_t<(typetraits::TypeInfo<T>::packetWidth > 1),
-											SimdVectorStorage<T, N>, GenericVectorStorage<T, N>>;
+			using type = std::conditional_t<useSimdVectorStorage<T>(), SimdVectorStorage<T, N>,
+											GenericVectorStorage<T, N>>;
 		};
 
 		template<typename Storage0, typename Storage1>
 		auto vectorStorageTypeMerger() {
 			using Scalar0 = typename typetraits::TypeInfo<Storage0>::Scalar;
 			using Scalar1 = typename typetraits::TypeInfo<Storage1>::Scalar;
-			static constexpr uint64_t packetWidth0 = typetraits::TypeInfo<Scalar0>::packetWidth;
-			static constexpr uint64_t packetWidth1 = typetraits::TypeInfo<Scalar1>::packetWidth;
 			if constexpr (typetraits::TypeInfo<Storage0>::type == detail::LibRapidType::Scalar) {
 				return Storage1 {};
 			} else if constexpr (typetraits::TypeInfo<Storage1>::type ==
 								 detail::LibRapidType::Scalar) {
 				return Storage0 {};
-			} else if constexpr (packetWidth0 > 1 && packetWidth1 > 1) {
+			} else if constexpr (useSimdVectorStorage<Scalar0>() &&
+								 useSimdVectorStorage<Scalar1>()) {
 				return SimdVectorStorage<typename Storage0::Scalar, Storage0::dims> {};
 			} else {
 				return GenericVectorStorage<typename Storage0::Scalar, Storage0::dims> {};
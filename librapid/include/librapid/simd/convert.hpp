@@ -0,0 +1,230 @@
+#ifndef LIBRAPID_SIMD_CONVERT_HPP
+#define LIBRAPID_SIMD_CONVERT_HPP
+
+/*
+ * Conversion loads, used to evaluate expressions whose operands have different scalar types
+ * without leaving the packet path. An int32 array used in a float expression, for example, is
+ * loaded directly into a float packet, rather than being converted element by element.
+ *
+ * The matching conversion stores are used for arrays whose packets have a different type to
+ * their elements, such as half and bfloat16, which are computed with float packets.
+ *
+ * This also maps LibRapid's scalar types onto the types xsimd expects (see SimdScalar).
+ */
+
+// GCC and Clang only provide the F16C intrinsics with -mf16c (which -mavx2 does not imply).
+// MSVC has no F16C flag, but every processor with AVX2 also supports F16C
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+#	define LIBRAPID_HAS_F16C
+#endif
+
+namespace librapid {
+	namespace typetraits {
+		/// The type xsimd uses to represent T. This is T itself, except for types which xsimd
+		/// supports under a different name (such as Complex<T>, which is layout-compatible with
+		/// std::complex<T>)
+		/// \tparam T The LibRapid scalar type
+		template<typename T>
+		struct SimdScalar {
+			using Type = T;
+		};
+	} // namespace typetraits
+} // namespace librapid
+
+namespace librapid::detail {
+	/// Reinterpret a pointer to scalars as a pointer xsimd can load packets from and store
+	/// packets to. See typetraits::SimdScalar
+	/// \tparam T The scalar type
+	/// \param ptr The pointer to convert
+	/// \return The equivalent pointer to typetraits::SimdScalar<T>::Type
+	template<typename T>
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto simdPointer(T *ptr) {
+		return reinterpret_cast<typename typetraits::SimdScalar<T>::Type *>(ptr);
+	}
+
+	template<typename T>
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto simdPointer(const T *ptr) {
+		return reinterpret_cast<const typename typetraits::SimdScalar<T>::Type *>(ptr);
+	}
+
+	/// Load `Packet::size` contiguous elements of type T, converting each of them to the
+	/// packet's scalar type. Conversions from half to float use the F16C instructions where
+	/// they are available, and conversions from bfloat16 to float are a zero-extending shift.
+	/// \tparam Packet The xsimd batch type to load
+	/// \tparam T The scalar type stored in memory
+	/// \param ptr Pointer to the first element to load (need not be aligned)
+	/// \return The converted packet
+	template<typename Packet, typename T>
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE Packet loadConverted(const T *ptr) {
+		using Scalar = typename Packet::value_type;
+
+		if constexpr (std::is_same_v<typename typetraits::SimdScalar<T>::Type, Scalar>) {
+			return Packet::load_unaligned(simdPointer(ptr));
+		} else if constexpr (typetraits::IsComplexSIMD<Packet>::value) {
+			// Real values are given a zero imaginary component
+			return Packet(loadConverted<typename Packet::real_batch>(ptr));
+		} else if constexpr (std::is_same_v<T, half>) {
+#if defined(LIBRAPID_HAS_F16C)
+			if constexpr (std::is_same_v<Scalar, float>) {
+#	if LIBRAPID_ARCH >= ARCH_AVX512
+				if constexpr (Packet::size == 16) {
+					return _mm512_cvtph_ps(
+					  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr)));
+				}
+#	endif
+#	if LIBRAPID_ARCH >= ARCH_AVX
+				if constexpr (Packet::size == 8) {
+					return _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr)));
+				}
+#	endif
+				if constexpr (Packet::size == 4) {
+					return _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr)));
+				}
+			}
+#endif // LIBRAPID_HAS_F16C
+
+			// Software fallback (and half -> double, which goes through float anyway)
+			alignas(Packet::arch_type::alignment()) Scalar buffer[Packet::size];
+			for (size_t i = 0; i < Packet::size; ++i) {
+				buffer[i] = static_cast<Scalar>(static_cast<float>(ptr[i]));
+			}
+			return Packet::load_aligned(buffer);
+		} else if constexpr (std::is_same_v<T, bfloat16>) {
+			if constexpr (std::is_same_v<Scalar, float>) {
+				// A bfloat16 is the upper half of a float, so zero-extend and shift
+#if LIBRAPID_ARCH >= ARCH_AVX512
+				if constexpr (Packet::size == 16) {
+					const __m256i bits =
+					  _mm256_loadu_si256(reinterpret_cast<const __m256i *>(ptr));
+					return _mm512_castsi512_ps(
+					  _mm512_slli_epi32(_mm512_cvtepu16_epi32(bits), 16));
+				}
+#endif
+#if LIBRAPID_ARCH >= ARCH_AVX2
+				if constexpr (Packet::size == 8) {
+					const __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ptr));
+					return _mm256_castsi256_ps(
+					  _mm256_slli_epi32(_mm256_cvtepu16_epi32(bits), 16));
+				}
+#endif
+#if LIBRAPID_ARCH >= ARCH_SSE4_1
+				if constexpr (Packet::size == 4) {
+					const __m128i bits = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(ptr));
+					return _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtepu16_epi32(bits), 16));
+				}
+#endif
+				using Bits = xsimd::batch<uint32_t, typename Packet::arch_type>;
+				return xsimd::bitwise_cast<float>(
+				  Bits::load_unaligned(reinterpret_cast<const uint16_t *>(ptr)) << 16);
+			} else {
+				alignas(Packet::arch_type::alignment()) Scalar buffer[Packet::size];
+				for (size_t i = 0; i < Packet::size; ++i) {
+					buffer[i] = static_cast<Scalar>(static_cast<float>(ptr[i]));
+				}
+				return Packet::load_aligned(buffer);
+			}
+		} else {
+			// xsimd converts between the built-in numeric types as it loads
+			return Packet::load_unaligned(ptr);
+		}
+	}
+
+	/// Store a packet to `Packet::size` contiguous elements of type T, converting each element
+	/// from the packet's scalar type. Conversions from float to half use the F16C instructions
+	/// (rounding to nearest) where they are available. Conversions from float to bfloat16
+	/// round to nearest, ties to even.
+	/// \tparam T The scalar type stored in memory
+	/// \tparam Packet The xsimd batch type to store
+	/// \param ptr Pointer to the first element to store to (need not be aligned)
+	/// \param packet The packet to store
+	template<typename T, typename Packet>
+	LIBRAPID_ALWAYS_INLINE void storeConverted(T *ptr, const Packet &packet) {
+		using Scalar = typename Packet::value_type;
+
+		if constexpr (std::is_same_v<typename typetraits::SimdScalar<T>::Type, Scalar>) {
+			packet.store_unaligned(simdPointer(ptr));
+		} else if constexpr (std::is_same_v<T, half>) {
+#if defined(LIBRAPID_HAS_F16C)
+			if constexpr (std::is_same_v<Scalar, float>) {
+				constexpr int rounding = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC;
+#	if LIBRAPID_ARCH >= ARCH_AVX512
+				if constexpr (Packet::size == 16) {
+					_mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr),
+										_mm512_cvtps_ph(packet, rounding));
+					return;
+				}
+#	endif
+#	if LIBRAPID_ARCH >= ARCH_AVX
+				if constexpr (Packet::size == 8) {
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr),
+									 _mm256_cvtps_ph(packet, rounding));
+					return;
+				}
+#	endif
+				if constexpr (Packet::size == 4) {
+					_mm_storel_epi64(reinterpret_cast<__m128i *>(ptr),
+									 _mm_cvtps_ph(packet, rounding));
+					return;
+				}
+			}
+#endif // LIBRAPID_HAS_F16C
+
+			alignas(Packet::arch_type::alignment()) Scalar buffer[Packet::size];
+			packet.store_aligned(buffer);
+			for (size_t i = 0; i < Packet::size; ++i) {
+				ptr[i] = half(static_cast<float>(buffer[i]));
+			}
+		} else if constexpr (std::is_same_v<T, bfloat16> && std::is_same_v<Scalar, float>) {
+			// Round to nearest (ties to even) by adding 0x7fff plus the lowest bit which is
+			// kept, then keep the upper 16 bits. NaNs are made quiet instead, since rounding
+			// could carry into the exponent and turn them into infinities
+			using Bits			= xsimd::batch<uint32_t, typename Packet::arch_type>;
+			const Bits bits		= xsimd::bitwise_cast<uint32_t>(packet);
+			const Bits rounded	= (bits + (Bits(0x7fff) + ((bits >> 16) & Bits(1)))) >> 16;
+			const Bits quietNaN = (bits >> 16) | Bits(0x0040);
+			const Bits result	= xsimd::select(
+			  xsimd::batch_bool_cast<uint32_t>(xsimd::isnan(packet)), quietNaN, rounded);
+
+			// Narrow each lane to 16 bits. Every value fits, so the saturating packs are exact
+#if LIBRAPID_ARCH >= ARCH_AVX512
+			if constexpr (Packet::size == 16) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i *>(ptr),
+									_mm512_cvtepi32_epi16(result));
+				return;
+			}
+#endif
+#if LIBRAPID_ARCH >= ARCH_AVX2
+			if constexpr (Packet::size == 8) {
+				const __m256i packed =
+				  _mm256_permute4x64_epi64(_mm256_packus_epi32(result, result), 0xd8);
+				_mm_storeu_si128(reinterpret_cast<__m128i *>(ptr),
+								 _mm256_castsi256_si128(packed));
+				return;
+			}
+#endif
+#if LIBRAPID_ARCH >= ARCH_SSE4_1
+			if constexpr (Packet::size == 4) {
+				_mm_storel_epi64(reinterpret_cast<__m128i *>(ptr),
+								 _mm_packus_epi32(result, result));
+				return;
+			}
+#endif
+			alignas(Packet::arch_type::alignment()) uint32_t buffer[Packet::size];
+			result.store_aligned(buffer);
+			for (size_t i = 0; i < Packet::size; ++i) {
+				ptr[i] = bfloat16::fromBits(static_cast<uint16_t>(buffer[i]));
+			}
+		} else if constexpr (std::is_same_v<T, bfloat16>) {
+			alignas(Packet::arch_type::alignment()) Scalar buffer[Packet::size];
+			packet.store_aligned(buffer);
+			for (size_t i = 0; i < Packet::size; ++i) {
+				ptr[i] = bfloat16(static_cast<float>(buffer[i]));
+			}
+		} else {
+			// xsimd converts between the built-in numeric types as it stores
+			packet.store_unaligned(ptr);
+		}
+	}
+} // namespace librapid::detail
+
+#endif // LIBRAPID_SIMD_CONVERT_HPP
@@ -0,0 +1,106 @@
+#ifndef LIBRAPID_SIMD_DISPATCH_HPP
+#define LIBRAPID_SIMD_DISPATCH_HPP
+
+/*
+ * Kernels which are compiled for several instruction sets and selected at runtime, based on
+ * the features of the host processor (see getSimdLevel()). This allows a single binary built
+ * without `-march=native` to make use of AVX2 and AVX-512 where they are available.
+ *
+ * The kernels are implemented in simdDispatch.cpp and operate on contiguous row-major data.
+ */
+
+namespace librapid::detail::cpu::dispatch {
+	/// Transpose rows [rowBegin, rowEnd) of a row-major `rows x cols` matrix, scaling each
+	/// element by alpha. The output is a row-major `cols x rows` matrix.
+	/// \param out Output matrix
+	/// \param in Input matrix
+	/// \param rows Rows in the input matrix
+	/// \param cols Columns in the input matrix
+	/// \param alpha Scaling factor
+	/// \param rowBegin First input row to transpose
+	/// \param rowEnd One past the last input row to transpose
+	void transpose(float *__restrict out, const float *__restrict in, int64_t rows, int64_t cols,
+				   float alpha, int64_t rowBegin, int64_t rowEnd);
+	void transpose(double *__restrict out, const double *__restrict in, int64_t rows,
+				   int64_t cols, double alpha, int64_t rowBegin, int64_t rowEnd);
+
+	/// Compute the sum of n contiguous elements
+	/// \param n Number of elements
+	/// \param x Input data
+	/// \return Sum of the elements
+	LIBRAPID_NODISCARD float sum(int64_t n, const float *x);
+	LIBRAPID_NODISCARD double sum(int64_t n, const double *x);
+
+	/// Compute the dot product of two contiguous vectors
+	/// \param n Number of elements
+	/// \param x First vector
+	/// \param y Second vector
+	/// \return \f$ \sum_i x_i y_i \f$
+	LIBRAPID_NODISCARD float dot(int64_t n, const float *x, const float *y);
+	LIBRAPID_NODISCARD double dot(int64_t n, const double *x, const double *y);
+
+	/// Compute the dot product of two contiguous bfloat16 vectors. The products are accumulated
+	/// in single precision
+	/// \param n Number of elements
+	/// \param x First vector
+	/// \param y Second vector
+	/// \return \f$ \sum_i x_i y_i \f$
+	LIBRAPID_NODISCARD float dot(int64_t n, const bfloat16 *x, const bfloat16 *y);
+
+	/// Compute the dot product of two contiguous vectors of 8-bit integers. The products are
+	/// accumulated exactly in 32-bit integers, using AVX-512 VNNI where it is available. The
+	/// result only overflows for vectors of more than 131072 elements.
+	/// \param n Number of elements
+	/// \param x First vector (signed or unsigned)
+	/// \param y Second vector
+	/// \return \f$ \sum_i x_i y_i \f$
+	LIBRAPID_NODISCARD int32_t dot(int64_t n, const int8_t *x, const int8_t *y);
+	LIBRAPID_NODISCARD int32_t dot(int64_t n, const uint8_t *x, const int8_t *y);
+
+	/// Compute \f$ y = \alpha x + y \f$ for two contiguous vectors
+	/// \param n Number of elements
+	/// \param alpha Scaling factor
+	/// \param x Input vector
+	/// \param y Input/output vector
+	void axpy(int64_t n, float alpha, const float *__restrict x, float *__restrict y);
+	void axpy(int64_t n, double alpha, const double *__restrict x, double *__restrict y);
+
+	/// Compute \f$ y = \alpha x + y \f$ for a contiguous bfloat16 vector x, accumulating into a
+	/// single precision vector y
+	/// \param n Number of elements
+	/// \param alpha Scaling factor
+	/// \param x Input vector
+	/// \param y Input/output vector
+	void axpy(int64_t n, float alpha, const bfloat16 *__restrict x, float *__restrict y);
+
+	/// Gather n elements from arbitrary positions, so that out[i] = src[indices[i]]. This uses
+	/// the AVX2 and AVX-512 integer gather instructions where they are available. Elements are
+	/// copied bit for bit and never pass through floating-point registers, so any trivially
+	/// copyable type of the same size may be gathered. The indices are not checked.
+	/// \param n Number of elements
+	/// \param out Output vector
+	/// \param src Source data
+	/// \param indices Index of each element in src
+	void gather(int64_t n, uint32_t *__restrict out, const uint32_t *__restrict src,
+				const int64_t *__restrict indices);
+	void gather(int64_t n, uint64_t *__restrict out, const uint64_t *__restrict src,
+				const int64_t *__restrict indices);
+
+	/// Count the set bits in n contiguous 64-bit words. The AVX2 and AVX-512 kernels count the
+	/// bits of every byte with an in-register lookup table, which is faster than the scalar
+	/// popcnt instruction for long inputs
+	/// \param n Number of words
+	/// \param x Input words
+	/// \return Total number of set bits
+	LIBRAPID_NODISCARD uint64_t popcount(int64_t n, const uint64_t *x);
+
+	/// Compute \f$ y = \alpha y \f$ for a contiguous vector. If alpha is zero, y is filled with
+	/// zeros (even if it contains NaNs), matching BLAS semantics for \f$ \beta = 0 \f$
+	/// \param n Number of elements
+	/// \param alpha Scaling factor
+	/// \param y Input/output vector
+	void scal(int64_t n, float alpha, float *y);
+	void scal(int64_t n, double alpha, double *y);
+} // namespace librapid::detail::cpu::dispatch
+
+#endif // LIBRAPID_SIMD_DISPATCH_HPP
@@ -2,5 +2,8 @@
 #define LIBRAPID_SIMD
 
 #include "vecOps.hpp"
+#include "dispatch.hpp"
+#include "convert.hpp"
+#include "streaming.hpp"
 
 #endif // LIBRAPID_SIMD
\ No newline at end of file
@@ -0,0 +1,121 @@
+#ifndef LIBRAPID_SIMD_STREAMING_HPP
+#define LIBRAPID_SIMD_STREAMING_HPP
+
+/*
+ * Helpers for writing large results with non-temporal (streaming) stores, which bypass the
+ * cache hierarchy, and for prefetching the inputs of such writes. Streaming stores are only
+ * available on x86, so on other architectures canStreamPacket() is always false.
+ */
+
+#if LIBRAPID_ARCH >= ARCH_SSE2
+#	define LIBRAPID_HAS_STREAMING_STORES
+#endif
+
+namespace librapid::detail {
+	/// Returns true if a Packet can be written with a non-temporal store on this architecture
+	/// \tparam Packet The xsimd batch type to store
+	/// \return True if streamPacket() supports the Packet type
+	template<typename Packet>
+	constexpr bool canStreamPacket() {
+		// Complex packets span two registers and are interleaved as they are stored
+		if (typetraits::IsComplexSIMD<Packet>::value) return false;
+
+#if LIBRAPID_ARCH >= ARCH_AVX512
+		if (sizeof(Packet) == 64) return true;
+#endif
+#if LIBRAPID_ARCH >= ARCH_AVX
+		if (sizeof(Packet) == 32) return true;
+#endif
+#if defined(LIBRAPID_HAS_STREAMING_STORES)
+		if (sizeof(Packet) == 16) return true;
+#endif
+		return false;
+	}
+
+	/// Returns true if a Packet can be written directly to memory holding Scalar values with a
+	/// non-temporal store. This is not the case if the packet must be converted as it is
+	/// stored (for example, the float packets used to compute half arrays)
+	/// \tparam Scalar The scalar type of the destination
+	/// \tparam Packet The xsimd batch type to store
+	/// \return True if streamPacket() can write Packet to Scalar memory
+	template<typename Scalar, typename Packet>
+	constexpr bool canStreamTo() {
+		if constexpr (requires { typename Packet::value_type; }) {
+			return canStreamPacket<Packet>() &&
+				   std::is_same_v<typename typetraits::SimdScalar<Scalar>::Type,
+								  typename Packet::value_type>;
+		} else {
+			return false;
+		}
+	}
+
+	/// Write a packet to memory with a non-temporal store. The destination must be aligned to
+	/// the size of the packet. Call storeFence() once all streaming stores have been issued.
+	/// \tparam Scalar The scalar type of the destination
+	/// \tparam Packet The xsimd batch type to store
+	/// \param ptr Destination pointer
+	/// \param packet Value to store
+	template<typename Scalar, typename Packet>
+		requires(canStreamTo<Scalar, Packet>())
+	LIBRAPID_ALWAYS_INLINE void streamPacket(Scalar *ptr, const Packet &packet) {
+		constexpr bool isFloat	= std::is_same_v<Scalar, float>;
+		constexpr bool isDouble = std::is_same_v<Scalar, double>;
+
+#if LIBRAPID_ARCH >= ARCH_AVX512
+		if constexpr (sizeof(Packet) == 64) {
+			if constexpr (isFloat) {
+				_mm512_stream_ps(ptr, packet);
+			} else if constexpr (isDouble) {
+				_mm512_stream_pd(ptr, packet);
+			} else {
+				_mm512_stream_si512(reinterpret_cast<__m512i *>(ptr), packet);
+			}
+			return;
+		}
+#endif
+#if LIBRAPID_ARCH >= ARCH_AVX
+		if constexpr (sizeof(Packet) == 32) {
+			if constexpr (isFloat) {
+				_mm256_stream_ps(ptr, packet);
+			} else if constexpr (isDouble) {
+				_mm256_stream_pd(ptr, packet);
+			} else {
+				_mm256_stream_si256(reinterpret_cast<__m256i *>(ptr), packet);
+			}
+			return;
+		}
+#endif
+#if defined(LIBRAPID_HAS_STREAMING_STORES)
+		if constexpr (sizeof(Packet) == 16) {
+			if constexpr (isFloat) {
+				_mm_stream_ps(ptr, packet);
+			} else if constexpr (isDouble) {
+				_mm_stream_pd(ptr, packet);
+			} else {
+				_mm_stream_si128(reinterpret_cast<__m128i *>(ptr), packet);
+			}
+		}
+#endif
+	}
+
+	/// Hint to the processor that the cache line containing `ptr` will be read soon. Prefetching
+	/// an invalid address is harmless, so this can safely run past the end of an array.
+	/// \param ptr Address to prefetch
+	LIBRAPID_ALWAYS_INLINE void prefetchRead(const void *ptr) {
+#if defined(LIBRAPID_MSVC) && defined(LIBRAPID_HAS_STREAMING_STORES)
+		_mm_prefetch(reinterpret_cast<const char *>(ptr), _MM_HINT_T0);
+#elif defined(LIBRAPID_GNU) || defined(LIBRAPID_CLANG)
+		__builtin_prefetch(ptr, 0, 3);
+#endif
+	}
+
+	/// Make all previously issued streaming stores globally visible. Non-temporal stores are
+	/// weakly ordered, so this must be called before the written data is read by another thread.
+	LIBRAPID_ALWAYS_INLINE void storeFence() {
+#if defined(LIBRAPID_HAS_STREAMING_STORES)
+		_mm_sfence();
+#endif
+	}
+} // namespace librapid::detail
+
+#endif // LIBRAPID_SIMD_STREAMING_HPP
@@ -14,19 +14,32 @@ namespace librapid {
 
 		template<typename T>
 		concept SIMD = IsSIMD<T>::value;
+
+		/// Evaluates as true if the input type is an xsimd packet of complex numbers. These are
+		/// stored as separate packets of real and imaginary components
+		template<typename T>
+		struct IsComplexSIMD : std::false_type {};
+
+		template<typename T, typename U>
+		struct IsComplexSIMD<xsimd::batch<std::complex<T>, U>> : std::true_type {};
 	} // namespace typetraits
 
 #define IS_FLOATING(TYPE)  std::is_floating_point_v<TYPE>
 
 #define SIMD_OP_IMPL(OP)                                                                           \
-	using Scalar = typename typetraits::TypeInfo<T>::Scalar;                                       \
-	if constexpr (IS_FLOATING(Scalar)) {                                                           \
-		return xsimd::OP(x);                                                                       \
+	if constexpr (typetraits::IsComplexSIMD<T>::value) {                                           \
+		/* Functions with a real result (such as abs) are widened back to a complex packet */      \
+		return T(xsimd::OP(x));                                                                    \
 	} else {                                                                                       \
-		T result;                                                                                  \
-		constexpr uint64_t packetWidth = typetraits::TypeInfo<Scalar>::packetWidth;                \
-		for (size_t i = 0; i < packetWidth; ++i) { result.set(i, std::OP(x.get(i))); }             \
-		return result;                                                                             \
+		using Scalar = typename typetraits::TypeInfo<T>::Scalar;                                   \
+		if constexpr (IS_FLOATING(Scalar)) {                                                       \
+			return xsimd::OP(x);                                                                   \
+		} else {                                                                                   \
+			T result;                                                                              \
+			constexpr uint64_t packetWidth = typetraits::TypeInfo<Scalar>::packetWidth;            \
+			for (size_t i = 0; i < packetWidth; ++i) { result.set(i, std::OP(x.get(i))); }         \
+			return result;                                                                         \
+		}                                                                                          \
 	}
 
 	template<typename T>
@@ -136,6 +149,18 @@ namespace librapid {
 	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto ceil(const T &x) {
 		SIMD_OP_IMPL(ceil)
 	}
+
+	template<typename T>
+		requires(typetraits::IsComplexSIMD<T>::value)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto conj(const T &x) {
+		return xsimd::conj(x);
+	}
+
+	template<typename T>
+		requires(typetraits::IsComplexSIMD<T>::value)
+	LIBRAPID_NODISCARD LIBRAPID_ALWAYS_INLINE auto arg(const T &x) {
+		return T(xsimd::arg(x));
+	}
 } // namespace librapid
 
 #endif // LIBRAPID_SIMD_TRIGONOMETRY
\ No newline at end of file
@@ -6,6 +6,11 @@ namespace librapid {
     /// determined, the return value is 64.
     /// \return Cache line size in bytes
     size_t cacheLineSize();
+
+    /// Returns the size of the largest (last-level) data cache of the processor, in bytes. If
+    /// the cache size cannot be determined, the return value is 8 MiB.
+    /// \return Last-level cache size in bytes
+    size_t cacheSize();
 } // namespace librapid
 
 #endif // LIBRAPID_UTILS_CACHE_LINE_SIZE_HPP
\ No newline at end of file
@@ -0,0 +1,52 @@
+#ifndef LIBRAPID_UTILS_CPU_FEATURES_HPP
+#define LIBRAPID_UTILS_CPU_FEATURES_HPP
+
+namespace librapid {
+	/// Instruction set levels that runtime-dispatched kernels are compiled for. The levels are
+	/// ordered, so a processor supporting one level also supports every level below it.
+	enum class SimdLevel : int { Scalar = 0, SSE42 = 1, AVX2 = 2, AVX512 = 3 };
+
+	/// SIMD-related features of the host processor. A feature is only marked as available if
+	/// the processor reports it *and* the operating system saves the corresponding register
+	/// state on context switches.
+	struct CpuFeatures {
+		bool sse42		= false;
+		bool avx		= false;
+		bool avx2		= false;
+		bool fma		= false;
+		bool f16c		= false;
+		bool avx512f	= false;
+		bool avx512bw	= false;
+		bool avx512dq	= false;
+		bool avx512vl	= false;
+		bool avx512vnni = false;
+		bool avx512bf16 = false;
+		bool avx512fp16 = false;
+	};
+
+	/// Query the SIMD features supported by the host processor. The result is computed once
+	/// and cached, so this is cheap to call repeatedly.
+	/// \return Supported processor features
+	const CpuFeatures &cpuFeatures();
+
+	/// Return the highest SimdLevel supported by the host processor
+	/// \return Highest supported SimdLevel
+	SimdLevel detectSimdLevel();
+
+	/// Return the SimdLevel currently used by runtime-dispatched kernels
+	/// \return Active SimdLevel
+	SimdLevel getSimdLevel();
+
+	/// Set the SimdLevel used by runtime-dispatched kernels. This is mainly useful for testing
+	/// and benchmarking the different kernel variants. Requesting a level which is not
+	/// supported by the host processor will select the highest supported level instead.
+	/// \param level Requested SimdLevel
+	void setSimdLevel(SimdLevel level);
+
+	/// Return a human-readable name for a SimdLevel
+	/// \param level SimdLevel to name
+	/// \return Name of the level (e.g. "AVX2")
+	const char *simdLevelName(SimdLevel level);
+} // namespace librapid
+
+#endif // LIBRAPID_UTILS_CPU_FEATURES_HPP
@@ -2,6 +2,7 @@
 #define LIBRAPID_UTILS
 
 #include "cacheLineSize.hpp"
+#include "cpuFeatures.hpp"
 #include "time.hpp"
 #include "memUtils.hpp"
 #include "consoleSize.hpp"
@@ -23,6 +23,17 @@ namespace librapid {
         sysctlbyname("hw.cachelinesize", &lineSize, &sizeOfLineSize, 0, 0);
         return lineSize;
     }
+
+    size_t cacheSize() {
+        // Apple Silicon has no L3 cache exposed through sysctl, so fall back to L2
+        size_t size       = 0;
+        size_t sizeOfSize = sizeof(size);
+        if (sysctlbyname("hw.l3cachesize", &size, &sizeOfSize, 0, 0) != 0 || size == 0) {
+            sizeOfSize = sizeof(size);
+            if (sysctlbyname("hw.l2cachesize", &size, &sizeOfSize, 0, 0) != 0) size = 0;
+        }
+        return size > 0 ? size : 8 * 1024 * 1024;
+    }
 } // namespace librapid
 
 #elif defined(LIBRAPID_WINDOWS) && !defined(LIBRAPID_NO_WINDOWS_H)
@@ -48,6 +59,30 @@ namespace librapid {
         free(buffer);
         return lineSize;
     }
+
+    size_t cacheSize() {
+        size_t size                                  = 0;
+        DWORD bufferSize                             = 0;
+        DWORD level                                  = 0;
+        SYSTEM_LOGICAL_PROCESSOR_INFORMATION *buffer = 0;
+
+        GetLogicalProcessorInformation(0, &bufferSize);
+        buffer = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION *)malloc(bufferSize);
+        GetLogicalProcessorInformation(&buffer[0], &bufferSize);
+
+        // Find the highest-level data (or unified) cache
+        for (DWORD i = 0; i != bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION); ++i) {
+            const auto &info = buffer[i];
+            if (info.Relationship == RelationCache && info.Cache.Type != CacheInstruction &&
+                info.Cache.Level >= level) {
+                level = info.Cache.Level;
+                size  = info.Cache.Size;
+            }
+        }
+
+        free(buffer);
+        return size > 0 ? size : 8 * 1024 * 1024;
+    }
 } // namespace librapid
 
 #elif defined(LIBRAPID_LINUX)
@@ -63,6 +98,33 @@ namespace librapid {
         }
         return lineSize;
     }
+
+    size_t cacheSize() {
+        // Walk the cache indices and keep the last (highest-level) non-instruction cache
+        size_t size = 0;
+        for (int index = 0; index < 8; ++index) {
+            std::string base = fmt::format("/sys/devices/system/cpu/cpu0/cache/index{}/", index);
+
+            FILE *typeFile = fopen((base + "type").c_str(), "r");
+            if (!typeFile) break;
+            char type[32] = {0};
+            fscanf(typeFile, "%31s", type);
+            fclose(typeFile);
+            if (std::string(type) == "Instruction") continue;
+
+            FILE *sizeFile = fopen((base + "size").c_str(), "r");
+            if (!sizeFile) continue;
+            unsigned int value = 0;
+            char unit          = 0;
+            if (fscanf(sizeFile, "%u%c", &value, &unit) >= 1) {
+                size = value;
+                if (unit == 'K') size *= 1024;
+                if (unit == 'M') size *= 1024 * 1024;
+            }
+            fclose(sizeFile);
+        }
+        return size > 0 ? size : 8 * 1024 * 1024;
+    }
 } // namespace librapid
 
 #else
@@ -72,6 +134,11 @@ namespace librapid {
         // On unknown platforms, return 64
         return 64;
     }
+
+    size_t cacheSize() {
+        // On unknown platforms, assume a typical 8 MiB last-level cache
+        return 8 * 1024 * 1024;
+    }
 } // namespace librapid
 
 #endif
\ No newline at end of file
@@ -0,0 +1,120 @@
+#include <librapid/librapid.hpp>
+
+#if defined(LIBRAPID_MSVC)
+#    include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#    include <cpuid.h>
+#endif
+
+namespace librapid {
+    namespace detail {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        struct CpuidResult {
+            uint32_t eax, ebx, ecx, edx;
+        };
+
+        static CpuidResult cpuid(uint32_t leaf, uint32_t subLeaf) {
+            CpuidResult res {0, 0, 0, 0};
+#    if defined(LIBRAPID_MSVC)
+            int regs[4];
+            __cpuidex(regs, (int)leaf, (int)subLeaf);
+            res = {(uint32_t)regs[0], (uint32_t)regs[1], (uint32_t)regs[2], (uint32_t)regs[3]};
+#    else
+            __cpuid_count(leaf, subLeaf, res.eax, res.ebx, res.ecx, res.edx);
+#    endif
+            return res;
+        }
+
+        static uint64_t xgetbv(uint32_t index) {
+#    if defined(LIBRAPID_MSVC)
+            return _xgetbv(index);
+#    else
+            uint32_t eax, edx;
+            __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+            return ((uint64_t)edx << 32) | eax;
+#    endif
+        }
+
+        static CpuFeatures queryCpuFeatures() {
+            CpuFeatures features;
+
+            uint32_t maxLeaf = cpuid(0, 0).eax;
+            if (maxLeaf < 1) return features;
+
+            auto leaf1 = cpuid(1, 0);
+            auto bit   = [](uint32_t reg, int n) { return ((reg >> n) & 1) != 0; };
+
+            features.sse42 = bit(leaf1.ecx, 20);
+
+            // AVX requires the OS to save the YMM registers (XCR0 bits 1 and 2), and AVX-512
+            // additionally requires the opmask and ZMM state (XCR0 bits 5, 6 and 7)
+            bool osxsave  = bit(leaf1.ecx, 27);
+            uint64_t xcr0 = osxsave ? xgetbv(0) : 0;
+            bool osAvx    = (xcr0 & 0x06) == 0x06;
+            bool osAvx512 = (xcr0 & 0xE6) == 0xE6;
+
+            features.avx  = osAvx && bit(leaf1.ecx, 28);
+            features.fma  = features.avx && bit(leaf1.ecx, 12);
+            features.f16c = features.avx && bit(leaf1.ecx, 29);
+
+            if (maxLeaf >= 7) {
+                auto leaf7 = cpuid(7, 0);
+                features.avx2 = features.avx && bit(leaf7.ebx, 5);
+
+                if (osAvx512) {
+                    features.avx512f    = bit(leaf7.ebx, 16);
+                    features.avx512dq   = features.avx512f && bit(leaf7.ebx, 17);
+                    features.avx512bw   = features.avx512f && bit(leaf7.ebx, 30);
+                    features.avx512vl   = features.avx512f && bit(leaf7.ebx, 31);
+                    features.avx512vnni = features.avx512f && bit(leaf7.ecx, 11);
+                    features.avx512fp16 = features.avx512f && bit(leaf7.edx, 23);
+
+                    if (leaf7.eax >= 1) {
+                        auto leaf71         = cpuid(7, 1);
+                        features.avx512bf16 = features.avx512f && bit(leaf71.eax, 5);
+                    }
+                }
+            }
+
+            return features;
+        }
+#else
+        static CpuFeatures queryCpuFeatures() {
+            // Non-x86 processors only ever use the scalar/compile-time SIMD kernels
+            return {};
+        }
+#endif
+
+        static SimdLevel activeSimdLevel = SimdLevel::Scalar;
+    } // namespace detail
+
+    const CpuFeatures &cpuFeatures() {
+        static const CpuFeatures features = detail::queryCpuFeatures();
+        return features;
+    }
+
+    SimdLevel detectSimdLevel() {
+        const auto &features = cpuFeatures();
+        if (features.avx512f && features.avx512bw && features.avx512dq && features.avx512vl)
+            return SimdLevel::AVX512;
+        if (features.avx2 && features.fma) return SimdLevel::AVX2;
+        if (features.sse42) return SimdLevel::SSE42;
+        return SimdLevel::Scalar;
+    }
+
+    SimdLevel getSimdLevel() { return detail::activeSimdLevel; }
+
+    void setSimdLevel(SimdLevel level) {
+        SimdLevel supported     = detectSimdLevel();
+        detail::activeSimdLevel = (int)level > (int)supported ? supported : level;
+    }
+
+    const char *simdLevelName(SimdLevel level) {
+        switch (level) {
+            case SimdLevel::SSE42: return "SSE4.2";
+            case SimdLevel::AVX2: return "AVX2";
+            case SimdLevel::AVX512: return "AVX512";
+            default: return "Scalar";
+        }
+    }
+} // namespace librapid
@@ -4,14 +4,17 @@
 
 namespace librapid {
     namespace global {
-        bool printOnAssert              = true;
-        size_t multithreadThreshold     = 5000;
-        size_t gemmMultithreadThreshold = 100;
-        size_t gemvMultithreadThreshold = 100;
-        size_t numThreads               = 8;
-        size_t randomSeed               = 0; // Set in PreMain
-        bool reseed                     = false;
-        size_t cacheLineSize            = 64;
+        bool printOnAssert               = true;
+        size_t multithreadThreshold      = 5000;
+        size_t gemmMultithreadThreshold  = 100;
+        size_t gemvMultithreadThreshold  = 100;
+        size_t numThreads                = 8;
+        bool reproducibleReductions      = false;
+        size_t randomSeed                = 0; // Set in PreMain
+        bool reseed                      = false;
+        size_t cacheLineSize             = 64;
+        size_t streamingStoreThreshold   = 8 * 1024 * 1024; // Set in PreMain
+        size_t streamingPrefetchDistance = 8;
 
 #if defined(LIBRAPID_HAS_OPENCL)
         std::vector<cl::Device> openclDevices;
@@ -73,6 +76,12 @@ namespace librapid {
 
     size_t getNumThreads() { return global::numThreads; }
 
+    void setReproducibleReductions(bool reproducible) {
+        global::reproducibleReductions = reproducible;
+    }
+
+    bool getReproducibleReductions() { return global::reproducibleReductions; }
+
     void setSeed(size_t seed) {
         global::randomSeed = seed;
         global::reseed     = true;
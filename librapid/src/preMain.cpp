@@ -13,6 +13,13 @@ namespace librapid::detail {
             preMainRun            = true;
             global::cacheLineSize = cacheLineSize();
 
+            // Writing more than the last-level cache can hold would evict everything else from
+            // it, so results larger than this bypass the cache entirely
+            global::streamingStoreThreshold = cacheSize();
+
+            // Select the best SIMD kernels supported by the host processor
+            setSimdLevel(detectSimdLevel());
+
             // OpenCL compatible devices are detected after this function is called,
             // meaning nothing is found here. The user must call configureOpenCL()
             // manually.
@@ -0,0 +1,1101 @@
+#include <librapid/librapid.hpp>
+
+/*
+ * Runtime-dispatched SIMD kernels. Each kernel is compiled once per supported instruction set
+ * using function-level target attributes, so this file does not require any architecture flags
+ * to be passed to the compiler. The variant to use is selected on every call from
+ * getSimdLevel(), which is initialised in PreMain.
+ */
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    define LIBRAPID_DISPATCH_X86
+#    include <immintrin.h>
+#endif
+
+#if defined(LIBRAPID_MSVC)
+// MSVC allows any intrinsic to be used without additional flags
+#    define LIBRAPID_TARGET_SSE42
+#    define LIBRAPID_TARGET_AVX2
+#    define LIBRAPID_TARGET_AVX512
+#    define LIBRAPID_TARGET_AVX512VNNI
+#else
+#    define LIBRAPID_TARGET_SSE42  __attribute__((target("sse4.2")))
+#    define LIBRAPID_TARGET_AVX2   __attribute__((target("avx2,fma")))
+#    define LIBRAPID_TARGET_AVX512                                                                 \
+        __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl,avx2,fma")))
+#    define LIBRAPID_TARGET_AVX512VNNI                                                             \
+        __attribute__((target("avx512f,avx512dq,avx512bw,avx512vl,avx512vnni,avx2,fma")))
+#endif
+
+namespace librapid::detail::cpu::dispatch {
+    namespace {
+        // ---------------------------------------------------------------------------------- //
+        //                                  Scalar kernels                                    //
+        // ---------------------------------------------------------------------------------- //
+
+        template<typename T>
+        void transposeScalar(T *__restrict out, const T *__restrict in, int64_t rows,
+                             int64_t cols, T alpha, int64_t rowBegin, int64_t rowEnd) {
+            constexpr int64_t blockSize = 16;
+            for (int64_t i = rowBegin; i < rowEnd; i += blockSize) {
+                for (int64_t j = 0; j < cols; j += blockSize) {
+                    for (int64_t row = i; row < i + blockSize && row < rowEnd; ++row) {
+                        for (int64_t col = j; col < j + blockSize && col < cols; ++col) {
+                            out[col * rows + row] = in[row * cols + col] * alpha;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Apply a square micro-kernel to every complete block, and fall back to scalar code for
+        // the ragged edges of the matrix
+        template<int64_t blockSize, typename T, typename Kernel>
+        LIBRAPID_ALWAYS_INLINE void transposeBlocked(T *__restrict out, const T *__restrict in,
+                                                     int64_t rows, int64_t cols, T alpha,
+                                                     int64_t rowBegin, int64_t rowEnd,
+                                                     Kernel &&kernel) {
+            int64_t i = rowBegin;
+            for (; i + blockSize <= rowEnd; i += blockSize) {
+                int64_t j = 0;
+                for (; j + blockSize <= cols; j += blockSize) {
+                    kernel(out + j * rows + i, in + i * cols + j, cols, rows, alpha);
+                }
+
+                for (int64_t row = i; row < i + blockSize; ++row) {
+                    for (int64_t col = j; col < cols; ++col) {
+                        out[col * rows + row] = in[row * cols + col] * alpha;
+                    }
+                }
+            }
+
+            for (; i < rowEnd; ++i) {
+                for (int64_t col = 0; col < cols; ++col) {
+                    out[col * rows + i] = in[i * cols + col] * alpha;
+                }
+            }
+        }
+
+        template<typename T>
+        T sumScalar(int64_t n, const T *x) {
+            T acc[4] = {0, 0, 0, 0};
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += x[i + 0];
+                acc[1] += x[i + 1];
+                acc[2] += x[i + 2];
+                acc[3] += x[i + 3];
+            }
+            for (; i < n; ++i) acc[0] += x[i];
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        template<typename T>
+        T dotScalar(int64_t n, const T *x, const T *y) {
+            T acc[4] = {0, 0, 0, 0};
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += x[i + 0] * y[i + 0];
+                acc[1] += x[i + 1] * y[i + 1];
+                acc[2] += x[i + 2] * y[i + 2];
+                acc[3] += x[i + 3] * y[i + 3];
+            }
+            for (; i < n; ++i) acc[0] += x[i] * y[i];
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        template<typename T>
+        void axpyScalar(int64_t n, T alpha, const T *__restrict x, T *__restrict y) {
+            for (int64_t i = 0; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+        float dotBf16Scalar(int64_t n, const bfloat16 *x, const bfloat16 *y) {
+            float acc[4] = {0, 0, 0, 0};
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += float(x[i + 0]) * float(y[i + 0]);
+                acc[1] += float(x[i + 1]) * float(y[i + 1]);
+                acc[2] += float(x[i + 2]) * float(y[i + 2]);
+                acc[3] += float(x[i + 3]) * float(y[i + 3]);
+            }
+            for (; i < n; ++i) acc[0] += float(x[i]) * float(y[i]);
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        void axpyBf16Scalar(int64_t n, float alpha, const bfloat16 *__restrict x,
+                            float *__restrict y) {
+            for (int64_t i = 0; i < n; ++i) y[i] += alpha * float(x[i]);
+        }
+
+        template<typename T>
+        int32_t dotInt8Scalar(int64_t n, const T *x, const int8_t *y) {
+            int32_t acc[4] = {0, 0, 0, 0};
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += int32_t(x[i + 0]) * int32_t(y[i + 0]);
+                acc[1] += int32_t(x[i + 1]) * int32_t(y[i + 1]);
+                acc[2] += int32_t(x[i + 2]) * int32_t(y[i + 2]);
+                acc[3] += int32_t(x[i + 3]) * int32_t(y[i + 3]);
+            }
+            for (; i < n; ++i) acc[0] += int32_t(x[i]) * int32_t(y[i]);
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        // The gathers copy elements bit for bit with memcpy (and the gather intrinsics, which
+        // may alias anything), so they can move any 4- or 8-byte type
+        template<typename T>
+        LIBRAPID_ALWAYS_INLINE void gatherTail(int64_t i, int64_t n, T *__restrict out,
+                                               const T *__restrict src,
+                                               const int64_t *__restrict indices) {
+            for (; i < n; ++i) std::memcpy(out + i, src + indices[i], sizeof(T));
+        }
+
+        template<typename T>
+        void gatherScalar(int64_t n, T *__restrict out, const T *__restrict src,
+                          const int64_t *__restrict indices) {
+            gatherTail(0, n, out, src, indices);
+        }
+
+        uint64_t popcountScalar(int64_t n, const uint64_t *x) {
+            uint64_t acc[4] = {0, 0, 0, 0};
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += std::popcount(x[i + 0]);
+                acc[1] += std::popcount(x[i + 1]);
+                acc[2] += std::popcount(x[i + 2]);
+                acc[3] += std::popcount(x[i + 3]);
+            }
+            for (; i < n; ++i) acc[0] += std::popcount(x[i]);
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        template<typename T>
+        void scalScalar(int64_t n, T alpha, T *y) {
+            if (alpha == T(0)) {
+                for (int64_t i = 0; i < n; ++i) y[i] = T(0);
+            } else {
+                for (int64_t i = 0; i < n; ++i) y[i] *= alpha;
+            }
+        }
+
+#if defined(LIBRAPID_DISPATCH_X86)
+        // ---------------------------------------------------------------------------------- //
+        //                                  SSE4.2 kernels                                    //
+        // ---------------------------------------------------------------------------------- //
+
+        LIBRAPID_TARGET_SSE42 inline float hsumSse(__m128 v) {
+            __m128 s = _mm_add_ps(v, _mm_movehl_ps(v, v));
+            s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 0x55));
+            return _mm_cvtss_f32(s);
+        }
+
+        LIBRAPID_TARGET_SSE42 inline double hsumSse(__m128d v) {
+            return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+        }
+
+        LIBRAPID_TARGET_SSE42 void transposeSse42(float *__restrict out,
+                                                  const float *__restrict in, int64_t rows,
+                                                  int64_t cols, float alpha, int64_t rowBegin,
+                                                  int64_t rowEnd) {
+            transposeBlocked<4>(
+              out,
+              in,
+              rows,
+              cols,
+              alpha,
+              rowBegin,
+              rowEnd,
+              [](float *o, const float *a, int64_t ldIn, int64_t ldOut, float s)
+                LIBRAPID_TARGET_SSE42 {
+                    __m128 r0 = _mm_loadu_ps(a + 0 * ldIn);
+                    __m128 r1 = _mm_loadu_ps(a + 1 * ldIn);
+                    __m128 r2 = _mm_loadu_ps(a + 2 * ldIn);
+                    __m128 r3 = _mm_loadu_ps(a + 3 * ldIn);
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    __m128 alphaVec = _mm_set1_ps(s);
+                    _mm_storeu_ps(o + 0 * ldOut, _mm_mul_ps(r0, alphaVec));
+                    _mm_storeu_ps(o + 1 * ldOut, _mm_mul_ps(r1, alphaVec));
+                    _mm_storeu_ps(o + 2 * ldOut, _mm_mul_ps(r2, alphaVec));
+                    _mm_storeu_ps(o + 3 * ldOut, _mm_mul_ps(r3, alphaVec));
+                });
+        }
+
+        LIBRAPID_TARGET_SSE42 void transposeSse42(double *__restrict out,
+                                                  const double *__restrict in, int64_t rows,
+                                                  int64_t cols, double alpha, int64_t rowBegin,
+                                                  int64_t rowEnd) {
+            transposeBlocked<2>(
+              out,
+              in,
+              rows,
+              cols,
+              alpha,
+              rowBegin,
+              rowEnd,
+              [](double *o, const double *a, int64_t ldIn, int64_t ldOut, double s)
+                LIBRAPID_TARGET_SSE42 {
+                    __m128d r0 = _mm_loadu_pd(a + 0 * ldIn);
+                    __m128d r1 = _mm_loadu_pd(a + 1 * ldIn);
+                    __m128d alphaVec = _mm_set1_pd(s);
+                    _mm_storeu_pd(o + 0 * ldOut, _mm_mul_pd(_mm_unpacklo_pd(r0, r1), alphaVec));
+                    _mm_storeu_pd(o + 1 * ldOut, _mm_mul_pd(_mm_unpackhi_pd(r0, r1), alphaVec));
+                });
+        }
+
+        LIBRAPID_TARGET_SSE42 float sumSse42(int64_t n, const float *x) {
+            __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm_add_ps(acc0, _mm_loadu_ps(x + i));
+                acc1 = _mm_add_ps(acc1, _mm_loadu_ps(x + i + 4));
+            }
+            float res = hsumSse(_mm_add_ps(acc0, acc1));
+            for (; i < n; ++i) res += x[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_SSE42 double sumSse42(int64_t n, const double *x) {
+            __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc0 = _mm_add_pd(acc0, _mm_loadu_pd(x + i));
+                acc1 = _mm_add_pd(acc1, _mm_loadu_pd(x + i + 2));
+            }
+            double res = hsumSse(_mm_add_pd(acc0, acc1));
+            for (; i < n; ++i) res += x[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_SSE42 float dotSse42(int64_t n, const float *x, const float *y) {
+            __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(y + i)));
+                acc1 = _mm_add_ps(acc1,
+                                  _mm_mul_ps(_mm_loadu_ps(x + i + 4), _mm_loadu_ps(y + i + 4)));
+            }
+            float res = hsumSse(_mm_add_ps(acc0, acc1));
+            for (; i < n; ++i) res += x[i] * y[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_SSE42 double dotSse42(int64_t n, const double *x, const double *y) {
+            __m128d acc0 = _mm_setzero_pd(), acc1 = _mm_setzero_pd();
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(x + i), _mm_loadu_pd(y + i)));
+                acc1 = _mm_add_pd(acc1,
+                                  _mm_mul_pd(_mm_loadu_pd(x + i + 2), _mm_loadu_pd(y + i + 2)));
+            }
+            double res = hsumSse(_mm_add_pd(acc0, acc1));
+            for (; i < n; ++i) res += x[i] * y[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_SSE42 void axpySse42(int64_t n, float alpha, const float *__restrict x,
+                                             float *__restrict y) {
+            __m128 alphaVec = _mm_set1_ps(alpha);
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m128 prod = _mm_mul_ps(alphaVec, _mm_loadu_ps(x + i));
+                _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), prod));
+            }
+            for (; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+        LIBRAPID_TARGET_SSE42 void axpySse42(int64_t n, double alpha, const double *__restrict x,
+                                             double *__restrict y) {
+            __m128d alphaVec = _mm_set1_pd(alpha);
+            int64_t i = 0;
+            for (; i + 2 <= n; i += 2) {
+                __m128d prod = _mm_mul_pd(alphaVec, _mm_loadu_pd(x + i));
+                _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), prod));
+            }
+            for (; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+        // Widen four bfloat16 values to floats. A bfloat16 is the upper half of a float
+        LIBRAPID_TARGET_SSE42 inline __m128 loadBf16Sse(const bfloat16 *x) {
+            __m128i bits = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(x));
+            return _mm_castsi128_ps(_mm_slli_epi32(_mm_cvtepu16_epi32(bits), 16));
+        }
+
+        LIBRAPID_TARGET_SSE42 float dotBf16Sse42(int64_t n, const bfloat16 *x,
+                                                 const bfloat16 *y) {
+            __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm_add_ps(acc0, _mm_mul_ps(loadBf16Sse(x + i), loadBf16Sse(y + i)));
+                acc1 = _mm_add_ps(acc1,
+                                  _mm_mul_ps(loadBf16Sse(x + i + 4), loadBf16Sse(y + i + 4)));
+            }
+            float res = hsumSse(_mm_add_ps(acc0, acc1));
+            for (; i < n; ++i) res += float(x[i]) * float(y[i]);
+            return res;
+        }
+
+        LIBRAPID_TARGET_SSE42 void axpyBf16Sse42(int64_t n, float alpha,
+                                                 const bfloat16 *__restrict x,
+                                                 float *__restrict y) {
+            __m128 alphaVec = _mm_set1_ps(alpha);
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                __m128 prod = _mm_mul_ps(alphaVec, loadBf16Sse(x + i));
+                _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), prod));
+            }
+            for (; i < n; ++i) y[i] += alpha * float(x[i]);
+        }
+
+        LIBRAPID_TARGET_SSE42 inline int32_t hsumSse(__m128i v) {
+            __m128i s = _mm_add_epi32(v, _mm_unpackhi_epi64(v, v));
+            s = _mm_add_epi32(s, _mm_shuffle_epi32(s, 0x55));
+            return _mm_cvtsi128_si32(s);
+        }
+
+        // Sign- or zero-extend eight 8-bit integers to 16 bits
+        LIBRAPID_TARGET_SSE42 inline __m128i loadInt8Sse(const int8_t *x) {
+            return _mm_cvtepi8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x)));
+        }
+
+        LIBRAPID_TARGET_SSE42 inline __m128i loadInt8Sse(const uint8_t *x) {
+            return _mm_cvtepu8_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(x)));
+        }
+
+        // The 8-bit values are widened to 16 bits and multiplied with pmaddwd, which sums
+        // adjacent products into 32-bit lanes. Unlike pmaddubsw, this cannot saturate
+        template<typename T>
+        LIBRAPID_TARGET_SSE42 int32_t dotInt8Sse42(int64_t n, const T *x, const int8_t *y) {
+            __m128i acc0 = _mm_setzero_si128(), acc1 = _mm_setzero_si128();
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm_add_epi32(acc0, _mm_madd_epi16(loadInt8Sse(x + i), loadInt8Sse(y + i)));
+                acc1 = _mm_add_epi32(
+                  acc1, _mm_madd_epi16(loadInt8Sse(x + i + 8), loadInt8Sse(y + i + 8)));
+            }
+            int32_t res = hsumSse(_mm_add_epi32(acc0, acc1));
+            for (; i < n; ++i) res += int32_t(x[i]) * int32_t(y[i]);
+            return res;
+        }
+
+        // The scalar loop again, but compiled with the popcnt instruction (implied by SSE4.2)
+        LIBRAPID_TARGET_SSE42 uint64_t popcountSse42(int64_t n, const uint64_t *x) {
+            uint64_t acc[4] = {0, 0, 0, 0};
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                acc[0] += std::popcount(x[i + 0]);
+                acc[1] += std::popcount(x[i + 1]);
+                acc[2] += std::popcount(x[i + 2]);
+                acc[3] += std::popcount(x[i + 3]);
+            }
+            for (; i < n; ++i) acc[0] += std::popcount(x[i]);
+            return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+        }
+
+        // ---------------------------------------------------------------------------------- //
+        //                                   AVX2 kernels                                     //
+        // ---------------------------------------------------------------------------------- //
+
+        LIBRAPID_TARGET_AVX2 inline float hsumAvx(__m256 v) {
+            return hsumSse(_mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1)));
+        }
+
+        LIBRAPID_TARGET_AVX2 inline double hsumAvx(__m256d v) {
+            return hsumSse(_mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1)));
+        }
+
+        LIBRAPID_TARGET_AVX2 void transposeAvx2(float *__restrict out,
+                                                const float *__restrict in, int64_t rows,
+                                                int64_t cols, float alpha, int64_t rowBegin,
+                                                int64_t rowEnd) {
+            transposeBlocked<8>(
+              out,
+              in,
+              rows,
+              cols,
+              alpha,
+              rowBegin,
+              rowEnd,
+              [](float *o, const float *a, int64_t ldIn, int64_t ldOut, float s)
+                LIBRAPID_TARGET_AVX2 {
+                    // Load rows i and i + 4 into the low and high lanes, so the in-lane
+                    // shuffles below produce complete output rows
+#    define LOAD256_IMPL(LEFT_, RIGHT_)                                                            \
+        _mm256_insertf128_ps(                                                                      \
+          _mm256_castps128_ps256(_mm_loadu_ps(&(LEFT_))), _mm_loadu_ps(&(RIGHT_)), 1)
+
+                    __m256 r0 = LOAD256_IMPL(a[0 * ldIn + 0], a[4 * ldIn + 0]);
+                    __m256 r1 = LOAD256_IMPL(a[1 * ldIn + 0], a[5 * ldIn + 0]);
+                    __m256 r2 = LOAD256_IMPL(a[2 * ldIn + 0], a[6 * ldIn + 0]);
+                    __m256 r3 = LOAD256_IMPL(a[3 * ldIn + 0], a[7 * ldIn + 0]);
+                    __m256 r4 = LOAD256_IMPL(a[0 * ldIn + 4], a[4 * ldIn + 4]);
+                    __m256 r5 = LOAD256_IMPL(a[1 * ldIn + 4], a[5 * ldIn + 4]);
+                    __m256 r6 = LOAD256_IMPL(a[2 * ldIn + 4], a[6 * ldIn + 4]);
+                    __m256 r7 = LOAD256_IMPL(a[3 * ldIn + 4], a[7 * ldIn + 4]);
+
+#    undef LOAD256_IMPL
+
+                    __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+                    __m256 t1 = _mm256_unpackhi_ps(r0, r1);
+                    __m256 t2 = _mm256_unpacklo_ps(r2, r3);
+                    __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+                    __m256 t4 = _mm256_unpacklo_ps(r4, r5);
+                    __m256 t5 = _mm256_unpackhi_ps(r4, r5);
+                    __m256 t6 = _mm256_unpacklo_ps(r6, r7);
+                    __m256 t7 = _mm256_unpackhi_ps(r6, r7);
+
+                    r0 = _mm256_shuffle_ps(t0, t2, 0x44);
+                    r1 = _mm256_shuffle_ps(t0, t2, 0xEE);
+                    r2 = _mm256_shuffle_ps(t1, t3, 0x44);
+                    r3 = _mm256_shuffle_ps(t1, t3, 0xEE);
+                    r4 = _mm256_shuffle_ps(t4, t6, 0x44);
+                    r5 = _mm256_shuffle_ps(t4, t6, 0xEE);
+                    r6 = _mm256_shuffle_ps(t5, t7, 0x44);
+                    r7 = _mm256_shuffle_ps(t5, t7, 0xEE);
+
+                    __m256 alphaVec = _mm256_set1_ps(s);
+                    _mm256_storeu_ps(o + 0 * ldOut, _mm256_mul_ps(r0, alphaVec));
+                    _mm256_storeu_ps(o + 1 * ldOut, _mm256_mul_ps(r1, alphaVec));
+                    _mm256_storeu_ps(o + 2 * ldOut, _mm256_mul_ps(r2, alphaVec));
+                    _mm256_storeu_ps(o + 3 * ldOut, _mm256_mul_ps(r3, alphaVec));
+                    _mm256_storeu_ps(o + 4 * ldOut, _mm256_mul_ps(r4, alphaVec));
+                    _mm256_storeu_ps(o + 5 * ldOut, _mm256_mul_ps(r5, alphaVec));
+                    _mm256_storeu_ps(o + 6 * ldOut, _mm256_mul_ps(r6, alphaVec));
+                    _mm256_storeu_ps(o + 7 * ldOut, _mm256_mul_ps(r7, alphaVec));
+                });
+        }
+
+        LIBRAPID_TARGET_AVX2 void transposeAvx2(double *__restrict out,
+                                                const double *__restrict in, int64_t rows,
+                                                int64_t cols, double alpha, int64_t rowBegin,
+                                                int64_t rowEnd) {
+            transposeBlocked<4>(
+              out,
+              in,
+              rows,
+              cols,
+              alpha,
+              rowBegin,
+              rowEnd,
+              [](double *o, const double *a, int64_t ldIn, int64_t ldOut, double s)
+                LIBRAPID_TARGET_AVX2 {
+#    define LOAD256_IMPL(LEFT_, RIGHT_)                                                            \
+        _mm256_insertf128_pd(                                                                      \
+          _mm256_castpd128_pd256(_mm_loadu_pd(&(LEFT_))), _mm_loadu_pd(&(RIGHT_)), 1)
+
+                    __m256d r0 = LOAD256_IMPL(a[0 * ldIn + 0], a[2 * ldIn + 0]);
+                    __m256d r1 = LOAD256_IMPL(a[1 * ldIn + 0], a[3 * ldIn + 0]);
+                    __m256d r2 = LOAD256_IMPL(a[0 * ldIn + 2], a[2 * ldIn + 2]);
+                    __m256d r3 = LOAD256_IMPL(a[1 * ldIn + 2], a[3 * ldIn + 2]);
+
+#    undef LOAD256_IMPL
+
+                    // After unpacking, each register holds one complete column of the block
+                    __m256d alphaVec = _mm256_set1_pd(s);
+                    _mm256_storeu_pd(o + 0 * ldOut,
+                                     _mm256_mul_pd(_mm256_unpacklo_pd(r0, r1), alphaVec));
+                    _mm256_storeu_pd(o + 1 * ldOut,
+                                     _mm256_mul_pd(_mm256_unpackhi_pd(r0, r1), alphaVec));
+                    _mm256_storeu_pd(o + 2 * ldOut,
+                                     _mm256_mul_pd(_mm256_unpacklo_pd(r2, r3), alphaVec));
+                    _mm256_storeu_pd(o + 3 * ldOut,
+                                     _mm256_mul_pd(_mm256_unpackhi_pd(r2, r3), alphaVec));
+                });
+        }
+
+        LIBRAPID_TARGET_AVX2 float sumAvx2(int64_t n, const float *x) {
+            __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(x + i));
+                acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(x + i + 8));
+            }
+            float res = hsumAvx(_mm256_add_ps(acc0, acc1));
+            for (; i < n; ++i) res += x[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_AVX2 double sumAvx2(int64_t n, const double *x) {
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm256_add_pd(acc0, _mm256_loadu_pd(x + i));
+                acc1 = _mm256_add_pd(acc1, _mm256_loadu_pd(x + i + 4));
+            }
+            double res = hsumAvx(_mm256_add_pd(acc0, acc1));
+            for (; i < n; ++i) res += x[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_AVX2 float dotAvx2(int64_t n, const float *x, const float *y) {
+            __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i), acc0);
+                acc1 =
+                  _mm256_fmadd_ps(_mm256_loadu_ps(x + i + 8), _mm256_loadu_ps(y + i + 8), acc1);
+            }
+            float res = hsumAvx(_mm256_add_ps(acc0, acc1));
+            for (; i < n; ++i) res += x[i] * y[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_AVX2 double dotAvx2(int64_t n, const double *x, const double *y) {
+            __m256d acc0 = _mm256_setzero_pd(), acc1 = _mm256_setzero_pd();
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                acc0 = _mm256_fmadd_pd(_mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i), acc0);
+                acc1 =
+                  _mm256_fmadd_pd(_mm256_loadu_pd(x + i + 4), _mm256_loadu_pd(y + i + 4), acc1);
+            }
+            double res = hsumAvx(_mm256_add_pd(acc0, acc1));
+            for (; i < n; ++i) res += x[i] * y[i];
+            return res;
+        }
+
+        LIBRAPID_TARGET_AVX2 void axpyAvx2(int64_t n, float alpha, const float *__restrict x,
+                                           float *__restrict y) {
+            __m256 alphaVec = _mm256_set1_ps(alpha);
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(
+                  y + i, _mm256_fmadd_ps(alphaVec, _mm256_loadu_ps(x + i), _mm256_loadu_ps(y + i)));
+            }
+            for (; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+        LIBRAPID_TARGET_AVX2 void axpyAvx2(int64_t n, double alpha, const double *__restrict x,
+                                           double *__restrict y) {
+            __m256d alphaVec = _mm256_set1_pd(alpha);
+            int64_t i = 0;
+            for (; i + 4 <= n; i += 4) {
+                _mm256_storeu_pd(
+                  y + i, _mm256_fmadd_pd(alphaVec, _mm256_loadu_pd(x + i), _mm256_loadu_pd(y + i)));
+            }
+            for (; i < n; ++i) y[i] += alpha * x[i];
+        }
+
+        LIBRAPID_TARGET_AVX2 inline __m256 loadBf16Avx(const bfloat16 *x) {
+            __m128i bits = _mm_loadu_si128(reinterpret_cast<const __m128i *>(x));
+            return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_cvtepu16_epi32(bits), 16));
+        }
+
+        LIBRAPID_TARGET_AVX2 float dotBf16Avx2(int64_t n, const bfloat16 *x, const bfloat16 *y) {
+            __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm256_fmadd_ps(loadBf16Avx(x + i), loadBf16Avx(y + i), acc0);
+                acc1 = _mm256_fmadd_ps(loadBf16Avx(x + i + 8), loadBf16Avx(y + i + 8), acc1);
+            }
+            float res = hsumAvx(_mm256_add_ps(acc0, acc1));
+            for (; i < n; ++i) res += float(x[i]) * float(y[i]);
+            return res;
+        }
+
+        LIBRAPID_TARGET_AVX2 void axpyBf16Avx2(int64_t n, float alpha,
+                                               const bfloat16 *__restrict x,
+                                               float *__restrict y) {
+            __m256 alphaVec = _mm256_set1_ps(alpha);
+            int64_t i = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_ps(
+                  y + i, _mm256_fmadd_ps(alphaVec, loadBf16Avx(x + i), _mm256_loadu_ps(y + i)));
+            }
+            for (; i < n; ++i) y[i] += alpha * float(x[i]);
+        }
+
+        LIBRAPID_TARGET_AVX2 inline int32_t hsumAvx(__m256i v) {
+            return hsumSse(
+              _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1)));
+        }
+
+        LIBRAPID_TARGET_AVX2 inline __m256i loadInt8Avx(const int8_t *x) {
+            return _mm256_cvtepi8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x)));
+        }
+
+        LIBRAPID_TARGET_AVX2 inline __m256i loadInt8Avx(const uint8_t *x) {
+            return _mm256_cvtepu8_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i *>(x)));
+        }
+
+        template<typename T>
+        LIBRAPID_TARGET_AVX2 int32_t dotInt8Avx2(int64_t n, const T *x, const int8_t *y) {
+            __m256i acc0 = _mm256_setzero_si256(), acc1 = _mm256_setzero_si256();
+            int64_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                acc0 = _mm256_add_epi32(acc0,
+                                        _mm256_madd_epi16(loadInt8Avx(x + i), loadInt8Avx(y + i)));
+                acc1 = _mm256_add_epi32(
+                  acc1, _mm256_madd_epi16(loadInt8Avx(x + i + 16), loadInt8Avx(y + i + 16)));
+            }
+            int32_t res = hsumAvx(_mm256_add_epi32(acc0, acc1));
+            for (; i < n; ++i) res += int32_t(x[i]) * int32_t(y[i]);
+            return res;
+        }
+
+        LIBRAPID_TARGET_AVX2 inline __m256i loadIndicesAvx(const int64_t *indices) {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices));
+        }
+
+        // Integer gathers, so that no element passes through a floating-point register
+        LIBRAPID_TARGET_AVX2 void gatherAvx2(int64_t n, uint32_t *__restrict out,
+                                             const uint32_t *__restrict src,
+                                             const int64_t *__restrict indices) {
+            const int *base = reinterpret_cast<const int *>(src);
+            int64_t i       = 0;
+            for (; i + 8 <= n; i += 8) {
+                const __m128i lo = _mm256_i64gather_epi32(base, loadIndicesAvx(indices + i), 4);
+                const __m128i hi =
+                  _mm256_i64gather_epi32(base, loadIndicesAvx(indices + i + 4), 4);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                                    _mm256_set_m128i(hi, lo));
+            }
+            gatherTail(i, n, out, src, indices);
+        }
+
+        LIBRAPID_TARGET_AVX2 void gatherAvx2(int64_t n, uint64_t *__restrict out,
+                                             const uint64_t *__restrict src,
+                                             const int64_t *__restrict indices) {
+            const auto *base = reinterpret_cast<const long long *>(src);
+            int64_t i        = 0;
+            for (; i + 8 <= n; i += 8) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                                    _mm256_i64gather_epi64(base, loadIndicesAvx(indices + i), 8));
+                _mm256_storeu_si256(
+                  reinterpret_cast<__m256i *>(out + i + 4),
+                  _mm256_i64gather_epi64(base, loadIndicesAvx(indices + i + 4), 8));
+            }
+            gatherTail(i, n, out, src, indices);
+        }
+
+        // Population counts use a 16-entry lookup table of nibble counts held in a register:
+        // pshufb counts the bits in every byte, and the byte counts are summed into 64-bit
+        // lanes with psadbw. Each byte count is at most 8, so up to 31 vectors of counts are
+        // added before they are widened.
+        LIBRAPID_TARGET_AVX2 inline __m256i popcountBytesAvx2(__m256i v) {
+            const __m256i lookup  = _mm256_broadcastsi128_si256(
+              _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+            const __m256i lowMask = _mm256_set1_epi8(0x0f);
+            const __m256i lo      = _mm256_and_si256(v, lowMask);
+            const __m256i hi      = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+            return _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo),
+                                   _mm256_shuffle_epi8(lookup, hi));
+        }
+
+        LIBRAPID_TARGET_AVX2 uint64_t popcountAvx2(int64_t n, const uint64_t *x) {
+            __m256i acc = _mm256_setzero_si256();
+            int64_t i   = 0;
+            while (i + 4 <= n) {
+                __m256i bytes = _mm256_setzero_si256();
+                for (int64_t j = 0; j < 31 && i + 4 <= n; ++j, i += 4) {
+                    const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(x + i));
+                    bytes           = _mm256_add_epi8(bytes, popcountBytesAvx2(v));
+                }
+                acc = _mm256_add_epi64(acc, _mm256_sad_epu8(bytes, _mm256_setzero_si256()));
+            }
+
+            alignas(32) uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), acc);
+            uint64_t res = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; i < n; ++i) res += std::popcount(x[i]);
+            return res;
+        }
+
+        // ---------------------------------------------------------------------------------- //
+        //                                  AVX-512 kernels                                   //
+        // ---------------------------------------------------------------------------------- //
+
+        // Masked loads handle the tail of each loop, so no scalar remainder is required
+
+        LIBRAPID_TARGET_AVX512 inline __mmask16 tailMask16(int64_t remaining) {
+            return (__mmask16)((1u << remaining) - 1);
+        }
+
+        LIBRAPID_TARGET_AVX512 inline __mmask8 tailMask8(int64_t remaining) {
+            return (__mmask8)((1u << remaining) - 1);
+        }
+
+        // The horizontal sums go through memory, since the lane-extraction intrinsics trigger
+        // spurious -Wuninitialized warnings in some GCC versions
+        LIBRAPID_TARGET_AVX512 inline float hsumAvx512(__m512 v) {
+            alignas(64) float tmp[16];
+            _mm512_store_ps(tmp, v);
+            return hsumAvx(_mm256_add_ps(_mm256_load_ps(tmp), _mm256_load_ps(tmp + 8)));
+        }
+
+        LIBRAPID_TARGET_AVX512 inline double hsumAvx512(__m512d v) {
+            alignas(64) double tmp[8];
+            _mm512_store_pd(tmp, v);
+            return hsumAvx(_mm256_add_pd(_mm256_load_pd(tmp), _mm256_load_pd(tmp + 4)));
+        }
+
+        LIBRAPID_TARGET_AVX512 float sumAvx512(int64_t n, const float *x) {
+            __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+            int64_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+                acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(x + i + 16));
+            }
+            for (; i < n; i += 16) {
+                __mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : tailMask16(n - i);
+                acc0 = _mm512_add_ps(acc0, _mm512_maskz_loadu_ps(mask, x + i));
+            }
+            return hsumAvx512(_mm512_add_ps(acc0, acc1));
+        }
+
+        LIBRAPID_TARGET_AVX512 double sumAvx512(int64_t n, const double *x) {
+            __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm512_add_pd(acc0, _mm512_loadu_pd(x + i));
+                acc1 = _mm512_add_pd(acc1, _mm512_loadu_pd(x + i + 8));
+            }
+            for (; i < n; i += 8) {
+                __mmask8 mask = n - i >= 8 ? (__mmask8)0xFF : tailMask8(n - i);
+                acc0 = _mm512_add_pd(acc0, _mm512_maskz_loadu_pd(mask, x + i));
+            }
+            return hsumAvx512(_mm512_add_pd(acc0, acc1));
+        }
+
+        LIBRAPID_TARGET_AVX512 float dotAvx512(int64_t n, const float *x, const float *y) {
+            __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+            int64_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                acc0 = _mm512_fmadd_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(y + i), acc0);
+                acc1 =
+                  _mm512_fmadd_ps(_mm512_loadu_ps(x + i + 16), _mm512_loadu_ps(y + i + 16), acc1);
+            }
+            for (; i < n; i += 16) {
+                __mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : tailMask16(n - i);
+                acc0 = _mm512_fmadd_ps(
+                  _mm512_maskz_loadu_ps(mask, x + i), _mm512_maskz_loadu_ps(mask, y + i), acc0);
+            }
+            return hsumAvx512(_mm512_add_ps(acc0, acc1));
+        }
+
+        LIBRAPID_TARGET_AVX512 double dotAvx512(int64_t n, const double *x, const double *y) {
+            __m512d acc0 = _mm512_setzero_pd(), acc1 = _mm512_setzero_pd();
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                acc0 = _mm512_fmadd_pd(_mm512_loadu_pd(x + i), _mm512_loadu_pd(y + i), acc0);
+                acc1 =
+                  _mm512_fmadd_pd(_mm512_loadu_pd(x + i + 8), _mm512_loadu_pd(y + i + 8), acc1);
+            }
+            for (; i < n; i += 8) {
+                __mmask8 mask = n - i >= 8 ? (__mmask8)0xFF : tailMask8(n - i);
+                acc0 = _mm512_fmadd_pd(
+                  _mm512_maskz_loadu_pd(mask, x + i), _mm512_maskz_loadu_pd(mask, y + i), acc0);
+            }
+            return hsumAvx512(_mm512_add_pd(acc0, acc1));
+        }
+
+        LIBRAPID_TARGET_AVX512 void axpyAvx512(int64_t n, float alpha, const float *__restrict x,
+                                               float *__restrict y) {
+            __m512 alphaVec = _mm512_set1_ps(alpha);
+            for (int64_t i = 0; i < n; i += 16) {
+                __mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : tailMask16(n - i);
+                __m512 res = _mm512_fmadd_ps(alphaVec,
+                                             _mm512_maskz_loadu_ps(mask, x + i),
+                                             _mm512_maskz_loadu_ps(mask, y + i));
+                _mm512_mask_storeu_ps(y + i, mask, res);
+            }
+        }
+
+        LIBRAPID_TARGET_AVX512 void axpyAvx512(int64_t n, double alpha,
+                                               const double *__restrict x, double *__restrict y) {
+            __m512d alphaVec = _mm512_set1_pd(alpha);
+            for (int64_t i = 0; i < n; i += 8) {
+                __mmask8 mask = n - i >= 8 ? (__mmask8)0xFF : tailMask8(n - i);
+                __m512d res = _mm512_fmadd_pd(alphaVec,
+                                              _mm512_maskz_loadu_pd(mask, x + i),
+                                              _mm512_maskz_loadu_pd(mask, y + i));
+                _mm512_mask_storeu_pd(y + i, mask, res);
+            }
+        }
+
+        LIBRAPID_TARGET_AVX512 inline __m512 loadBf16Avx512(__mmask16 mask, const bfloat16 *x) {
+            __m256i bits = _mm256_maskz_loadu_epi16(mask, x);
+            return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(bits), 16));
+        }
+
+        LIBRAPID_TARGET_AVX512 float dotBf16Avx512(int64_t n, const bfloat16 *x,
+                                                   const bfloat16 *y) {
+            __m512 acc0 = _mm512_setzero_ps(), acc1 = _mm512_setzero_ps();
+            const __mmask16 full = 0xFFFF;
+            int64_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                acc0 = _mm512_fmadd_ps(
+                  loadBf16Avx512(full, x + i), loadBf16Avx512(full, y + i), acc0);
+                acc1 = _mm512_fmadd_ps(
+                  loadBf16Avx512(full, x + i + 16), loadBf16Avx512(full, y + i + 16), acc1);
+            }
+            for (; i < n; i += 16) {
+                __mmask16 mask = n - i >= 16 ? full : tailMask16(n - i);
+                acc0 = _mm512_fmadd_ps(
+                  loadBf16Avx512(mask, x + i), loadBf16Avx512(mask, y + i), acc0);
+            }
+            return hsumAvx512(_mm512_add_ps(acc0, acc1));
+        }
+
+        LIBRAPID_TARGET_AVX512 void axpyBf16Avx512(int64_t n, float alpha,
+                                                   const bfloat16 *__restrict x,
+                                                   float *__restrict y) {
+            __m512 alphaVec = _mm512_set1_ps(alpha);
+            for (int64_t i = 0; i < n; i += 16) {
+                __mmask16 mask = n - i >= 16 ? (__mmask16)0xFFFF : tailMask16(n - i);
+                __m512 res = _mm512_fmadd_ps(
+                  alphaVec, loadBf16Avx512(mask, x + i), _mm512_maskz_loadu_ps(mask, y + i));
+                _mm512_mask_storeu_ps(y + i, mask, res);
+            }
+        }
+
+        LIBRAPID_TARGET_AVX512 inline __mmask32 tailMask32(int64_t remaining) {
+            return (__mmask32)((1ull << remaining) - 1);
+        }
+
+        LIBRAPID_TARGET_AVX512 inline __mmask64 tailMask64(int64_t remaining) {
+            return remaining >= 64 ? ~(__mmask64)0 : (__mmask64)((1ull << remaining) - 1);
+        }
+
+        LIBRAPID_TARGET_AVX512 inline int32_t hsumAvx512(__m512i v) {
+            alignas(64) int32_t tmp[16];
+            _mm512_store_si512(tmp, v);
+            const __m256i lo = _mm256_load_si256(reinterpret_cast<const __m256i *>(tmp));
+            const __m256i hi = _mm256_load_si256(reinterpret_cast<const __m256i *>(tmp + 8));
+            return hsumAvx(_mm256_add_epi32(lo, hi));
+        }
+
+        LIBRAPID_TARGET_AVX512 inline __m512i loadInt8Avx512(__mmask32 mask, const int8_t *x) {
+            return _mm512_cvtepi8_epi16(_mm256_maskz_loadu_epi8(mask, x));
+        }
+
+        LIBRAPID_TARGET_AVX512 inline __m512i loadInt8Avx512(__mmask32 mask, const uint8_t *x) {
+            return _mm512_cvtepu8_epi16(_mm256_maskz_loadu_epi8(mask, x));
+        }
+
+        template<typename T>
+        LIBRAPID_TARGET_AVX512 int32_t dotInt8Avx512(int64_t n, const T *x, const int8_t *y) {
+            __m512i acc0 = _mm512_setzero_si512(), acc1 = _mm512_setzero_si512();
+            const __mmask32 full = 0xFFFFFFFF;
+            int64_t i = 0;
+            for (; i + 64 <= n; i += 64) {
+                acc0 = _mm512_add_epi32(
+                  acc0,
+                  _mm512_madd_epi16(loadInt8Avx512(full, x + i), loadInt8Avx512(full, y + i)));
+                acc1 = _mm512_add_epi32(acc1,
+                                        _mm512_madd_epi16(loadInt8Avx512(full, x + i + 32),
+                                                          loadInt8Avx512(full, y + i + 32)));
+            }
+            for (; i < n; i += 32) {
+                __mmask32 mask = n - i >= 32 ? full : tailMask32(n - i);
+                acc0 = _mm512_add_epi32(
+                  acc0,
+                  _mm512_madd_epi16(loadInt8Avx512(mask, x + i), loadInt8Avx512(mask, y + i)));
+            }
+            return hsumAvx512(_mm512_add_epi32(acc0, acc1));
+        }
+
+        // vpdpbusd multiplies unsigned bytes by signed bytes and accumulates groups of four
+        // products directly into 32-bit lanes, without intermediate saturation. Signed x values
+        // are offset by 128 to make them unsigned, and 128 * sum(y) is subtracted at the end
+        template<typename T>
+        LIBRAPID_TARGET_AVX512VNNI int32_t dotInt8Vnni(int64_t n, const T *x, const int8_t *y) {
+            constexpr bool isSigned = std::is_same_v<T, int8_t>;
+            const __m512i offset    = _mm512_set1_epi8((char)0x80);
+            __m512i acc = _mm512_setzero_si512(), correction = _mm512_setzero_si512();
+            for (int64_t i = 0; i < n; i += 64) {
+                __mmask64 mask = tailMask64(n - i);
+                __m512i xv     = _mm512_maskz_loadu_epi8(mask, x + i);
+                __m512i yv     = _mm512_maskz_loadu_epi8(mask, y + i);
+                if constexpr (isSigned) {
+                    xv         = _mm512_xor_si512(xv, offset);
+                    correction = _mm512_dpbusd_epi32(correction, offset, yv);
+                }
+                acc = _mm512_dpbusd_epi32(acc, xv, yv);
+            }
+            return hsumAvx512(_mm512_sub_epi32(acc, correction));
+        }
+
+        LIBRAPID_TARGET_AVX512 void gatherAvx512(int64_t n, uint32_t *__restrict out,
+                                                 const uint32_t *__restrict src,
+                                                 const int64_t *__restrict indices) {
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                const __m256i lo =
+                  _mm512_i64gather_epi32(_mm512_loadu_si512(indices + i), src, 4);
+                const __m256i hi =
+                  _mm512_i64gather_epi32(_mm512_loadu_si512(indices + i + 8), src, 4);
+                _mm512_storeu_si512(out + i,
+                                    _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+            }
+            gatherTail(i, n, out, src, indices);
+        }
+
+        LIBRAPID_TARGET_AVX512 void gatherAvx512(int64_t n, uint64_t *__restrict out,
+                                                 const uint64_t *__restrict src,
+                                                 const int64_t *__restrict indices) {
+            int64_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                _mm512_storeu_si512(
+                  out + i, _mm512_i64gather_epi64(_mm512_loadu_si512(indices + i), src, 8));
+                _mm512_storeu_si512(
+                  out + i + 8, _mm512_i64gather_epi64(_mm512_loadu_si512(indices + i + 8), src, 8));
+            }
+            gatherTail(i, n, out, src, indices);
+        }
+
+        // The same nibble lookup as popcountAvx2. AVX512-VPOPCNTDQ is not part of any
+        // SimdLevel, so the vpopcntq instruction is not used
+        LIBRAPID_TARGET_AVX512 uint64_t popcountAvx512(int64_t n, const uint64_t *x) {
+            const __m512i lookup  = _mm512_broadcast_i32x4(
+              _mm_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4));
+            const __m512i lowMask = _mm512_set1_epi8(0x0f);
+
+            __m512i acc = _mm512_setzero_si512();
+            int64_t i   = 0;
+            while (i + 8 <= n) {
+                __m512i bytes = _mm512_setzero_si512();
+                for (int64_t j = 0; j < 31 && i + 8 <= n; ++j, i += 8) {
+                    const __m512i v  = _mm512_loadu_si512(x + i);
+                    const __m512i lo = _mm512_and_si512(v, lowMask);
+                    const __m512i hi = _mm512_and_si512(_mm512_srli_epi16(v, 4), lowMask);
+                    bytes            = _mm512_add_epi8(bytes, _mm512_shuffle_epi8(lookup, lo));
+                    bytes            = _mm512_add_epi8(bytes, _mm512_shuffle_epi8(lookup, hi));
+                }
+                acc = _mm512_add_epi64(acc, _mm512_sad_epu8(bytes, _mm512_setzero_si512()));
+            }
+
+            uint64_t res = static_cast<uint64_t>(_mm512_reduce_add_epi64(acc));
+            for (; i < n; ++i) res += std::popcount(x[i]);
+            return res;
+        }
+#endif // LIBRAPID_DISPATCH_X86
+    } // namespace
+
+    // -------------------------------------------------------------------------------------- //
+    //                                    Dispatchers                                         //
+    // -------------------------------------------------------------------------------------- //
+
+    // The AVX-512 level reuses the AVX2 transpose micro-kernels: transposing 16x16 tiles
+    // touches 16 output cache lines per tile, which gives no measurable benefit over 8x8 tiles
+
+#if defined(LIBRAPID_DISPATCH_X86)
+#    define LIBRAPID_DISPATCH_IMPL(SCALAR_, SSE42_, AVX2_, AVX512_, ...)                         \
+        switch (getSimdLevel()) {                                                                  \
+            case SimdLevel::AVX512: return AVX512_(__VA_ARGS__);                                   \
+            case SimdLevel::AVX2: return AVX2_(__VA_ARGS__);                                       \
+            case SimdLevel::SSE42: return SSE42_(__VA_ARGS__);                                     \
+            default: return SCALAR_(__VA_ARGS__);                                                  \
+        }
+#else
+#    define LIBRAPID_DISPATCH_IMPL(SCALAR_, SSE42_, AVX2_, AVX512_, ...)                         \
+        return SCALAR_(__VA_ARGS__);
+#endif
+
+    void transpose(float *__restrict out, const float *__restrict in, int64_t rows, int64_t cols,
+                   float alpha, int64_t rowBegin, int64_t rowEnd) {
+        LIBRAPID_DISPATCH_IMPL(transposeScalar,
+                               transposeSse42,
+                               transposeAvx2,
+                               transposeAvx2,
+                               out,
+                               in,
+                               rows,
+                               cols,
+                               alpha,
+                               rowBegin,
+                               rowEnd)
+    }
+
+    void transpose(double *__restrict out, const double *__restrict in, int64_t rows,
+                   int64_t cols, double alpha, int64_t rowBegin, int64_t rowEnd) {
+        LIBRAPID_DISPATCH_IMPL(transposeScalar,
+                               transposeSse42,
+                               transposeAvx2,
+                               transposeAvx2,
+                               out,
+                               in,
+                               rows,
+                               cols,
+                               alpha,
+                               rowBegin,
+                               rowEnd)
+    }
+
+    float sum(int64_t n, const float *x) {
+        LIBRAPID_DISPATCH_IMPL(sumScalar, sumSse42, sumAvx2, sumAvx512, n, x)
+    }
+
+    double sum(int64_t n, const double *x) {
+        LIBRAPID_DISPATCH_IMPL(sumScalar, sumSse42, sumAvx2, sumAvx512, n, x)
+    }
+
+    float dot(int64_t n, const float *x, const float *y) {
+        LIBRAPID_DISPATCH_IMPL(dotScalar, dotSse42, dotAvx2, dotAvx512, n, x, y)
+    }
+
+    double dot(int64_t n, const double *x, const double *y) {
+        LIBRAPID_DISPATCH_IMPL(dotScalar, dotSse42, dotAvx2, dotAvx512, n, x, y)
+    }
+
+    float dot(int64_t n, const bfloat16 *x, const bfloat16 *y) {
+        LIBRAPID_DISPATCH_IMPL(dotBf16Scalar, dotBf16Sse42, dotBf16Avx2, dotBf16Avx512, n, x, y)
+    }
+
+    void axpy(int64_t n, float alpha, const float *__restrict x, float *__restrict y) {
+        LIBRAPID_DISPATCH_IMPL(axpyScalar, axpySse42, axpyAvx2, axpyAvx512, n, alpha, x, y)
+    }
+
+    void axpy(int64_t n, double alpha, const double *__restrict x, double *__restrict y) {
+        LIBRAPID_DISPATCH_IMPL(axpyScalar, axpySse42, axpyAvx2, axpyAvx512, n, alpha, x, y)
+    }
+
+    void axpy(int64_t n, float alpha, const bfloat16 *__restrict x, float *__restrict y) {
+        LIBRAPID_DISPATCH_IMPL(
+          axpyBf16Scalar, axpyBf16Sse42, axpyBf16Avx2, axpyBf16Avx512, n, alpha, x, y)
+    }
+
+    // SSE4.2 has no gather instruction
+    void gather(int64_t n, uint32_t *__restrict out, const uint32_t *__restrict src,
+                const int64_t *__restrict indices) {
+        LIBRAPID_DISPATCH_IMPL(
+          gatherScalar, gatherScalar, gatherAvx2, gatherAvx512, n, out, src, indices)
+    }
+
+    void gather(int64_t n, uint64_t *__restrict out, const uint64_t *__restrict src,
+                const int64_t *__restrict indices) {
+        LIBRAPID_DISPATCH_IMPL(
+          gatherScalar, gatherScalar, gatherAvx2, gatherAvx512, n, out, src, indices)
+    }
+
+    uint64_t popcount(int64_t n, const uint64_t *x) {
+        LIBRAPID_DISPATCH_IMPL(popcountScalar, popcountSse42, popcountAvx2, popcountAvx512, n, x)
+    }
+
+#if defined(LIBRAPID_DISPATCH_X86)
+    // VNNI is not implied by any SimdLevel, so it is checked separately within the AVX-512 level
+#    define LIBRAPID_DISPATCH_INT8_IMPL(...)                                                     \
+        if (getSimdLevel() == SimdLevel::AVX512 && cpuFeatures().avx512vnni) {                     \
+            return dotInt8Vnni(__VA_ARGS__);                                                       \
+        }                                                                                          \
+        LIBRAPID_DISPATCH_IMPL(                                                                    \
+          dotInt8Scalar, dotInt8Sse42, dotInt8Avx2, dotInt8Avx512, __VA_ARGS__)
+#else
+#    define LIBRAPID_DISPATCH_INT8_IMPL(...) return dotInt8Scalar(__VA_ARGS__);
+#endif
+
+    int32_t dot(int64_t n, const int8_t *x, const int8_t *y) {
+        LIBRAPID_DISPATCH_INT8_IMPL(n, x, y)
+    }
+
+    int32_t dot(int64_t n, const uint8_t *x, const int8_t *y) {
+        LIBRAPID_DISPATCH_INT8_IMPL(n, x, y)
+    }
+
+#undef LIBRAPID_DISPATCH_INT8_IMPL
+
+    // Scaling is memory-bound, so the compiler-vectorised scalar loop is sufficient
+    void scal(int64_t n, float alpha, float *y) { scalScalar(n, alpha, y); }
+
+    void scal(int64_t n, double alpha, double *y) { scalScalar(n, alpha, y); }
+
+#undef LIBRAPID_DISPATCH_IMPL
+} // namespace librapid::detail::cpu::dispatch
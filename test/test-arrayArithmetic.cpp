@@ -215,6 +215,361 @@ TEST_CASE("Test Array -- uint64_t CPU", "[array-lib]") { TEST_ALL(uint64_t, CPU)
 TEST_CASE("Test Array -- float CPU", "[array-lib]") { TEST_ALL(float, CPU); }
 TEST_CASE("Test Array -- double CPU", "[array-lib]") { TEST_ALL(double, CPU); }
 
+TEST_CASE("Test Array -- Streaming Stores CPU", "[array-lib]") {
+	// Force every vectorised assignment through the non-temporal store path, both serial and
+	// multithreaded
+	const size_t streamingThreshold		 = lrc::global::streamingStoreThreshold;
+	const size_t multithreadThreshold	 = lrc::global::multithreadThreshold;
+	lrc::global::streamingStoreThreshold = 0;
+	lrc::global::multithreadThreshold	 = GENERATE_COPY(multithreadThreshold, size_t(0));
+
+	TEST_ALL(int32_t, CPU);
+	TEST_ALL(float, CPU);
+	TEST_ALL(double, CPU);
+
+	lrc::global::streamingStoreThreshold = streamingThreshold;
+	lrc::global::multithreadThreshold	 = multithreadThreshold;
+}
+
+TEST_CASE("Benchmark Array -- Streaming Stores CPU", "[array-lib]") {
+	// A STREAM-style triad, c = a + s * b, on arrays larger than the last-level cache. The
+	// threshold is set to force each path, so the two can be compared at the same size
+	const size_t streamingThreshold = lrc::global::streamingStoreThreshold;
+	const size_t prefetchDistance	= lrc::global::streamingPrefetchDistance;
+	const int64_t elements =
+	  lrc::max(int64_t(1) << 22, static_cast<int64_t>(4 * streamingThreshold / sizeof(double)));
+
+	lrc::Array<double, CPU>::ShapeType shape({elements});
+	lrc::Array<double, CPU> a(shape, 1.0), b(shape, 2.0), c(shape);
+	const double s = 3.0;
+
+	SECTION("Benchmarks") {
+		BENCHMARK("Triad Regular Stores") {
+			lrc::global::streamingStoreThreshold = std::numeric_limits<size_t>::max();
+			c									 = a + b * s;
+			return c.storage()[0];
+		};
+
+		BENCHMARK("Triad Streaming Stores") {
+			lrc::global::streamingStoreThreshold = 0;
+			c									 = a + b * s;
+			return c.storage()[0];
+		};
+
+		BENCHMARK("Triad Streaming Stores (No Prefetch)") {
+			lrc::global::streamingStoreThreshold   = 0;
+			lrc::global::streamingPrefetchDistance = 0;
+			c									   = a + b * s;
+			return c.storage()[0];
+		};
+	}
+
+	lrc::global::streamingStoreThreshold   = streamingThreshold;
+	lrc::global::streamingPrefetchDistance = prefetchDistance;
+	REQUIRE(c.storage()[elements - 1] == 7.0);
+}
+
+#define TEST_EVAL_MANY(SCALAR)                                                                     \
+	SECTION(fmt::format("Test Fused Evaluation [{}]", STRINGIFY(SCALAR))) {                        \
+		lrc::Array<SCALAR, CPU>::ShapeType shape({37, 41});                                        \
+		lrc::Array<SCALAR, CPU> a(shape), b(shape), c(shape);                                      \
+		lrc::Array<SCALAR, CPU> x(shape), y(shape), z(shape);                                      \
+                                                                                                   \
+		for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+			a.storage()[i] = SCALAR(i % 13 + 1);                                                   \
+			b.storage()[i] = SCALAR(i % 7 + 2);                                                    \
+			c.storage()[i] = SCALAR(i % 5);                                                        \
+		}                                                                                          \
+                                                                                                   \
+		auto expectedX = (a * b + c).eval();                                                       \
+		auto expectedY = (a * b - c).eval();                                                       \
+		auto expectedZ = (a + c).eval();                                                           \
+                                                                                                   \
+		lrc::evalMany(lrc::output(x) = a * b + c, lrc::output(y) = a * b - c);                     \
+                                                                                                   \
+		/* Outputs may also appear as inputs, since all results are computed before storing */     \
+		lrc::evalMany(lrc::output(z) = a + c, lrc::output(a) = a * SCALAR(2));                     \
+                                                                                                   \
+		for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+			REQUIRE(x.scalar(i) == expectedX.scalar(i));                                           \
+			REQUIRE(y.scalar(i) == expectedY.scalar(i));                                           \
+			REQUIRE(z.scalar(i) == expectedZ.scalar(i));                                           \
+			REQUIRE(a.scalar(i) == SCALAR(i % 13 + 1) * SCALAR(2));                                \
+		}                                                                                          \
+	}                                                                                              \
+	do {                                                                                           \
+	} while (false)
+
+TEST_CASE("Test Array -- Fused Evaluation CPU", "[array-lib]") {
+	const size_t multithreadThreshold = lrc::global::multithreadThreshold;
+	lrc::global::multithreadThreshold = GENERATE_COPY(multithreadThreshold, size_t(0));
+
+	TEST_EVAL_MANY(int32_t);
+	TEST_EVAL_MANY(float);
+	TEST_EVAL_MANY(double);
+
+	lrc::global::multithreadThreshold = multithreadThreshold;
+}
+
+TEST_CASE("Test Array -- Mixed Types CPU", "[array-lib]") {
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int32_t, float>, float>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<float, double>, double>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int8_t, int8_t>, int8_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int16_t, uint16_t>, int32_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int16_t, uint8_t>, int16_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<uint8_t, int8_t>, int16_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int8_t, uint16_t>, int32_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int32_t, uint32_t>, uint32_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int64_t, uint32_t>, int64_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<int32_t, uint64_t>, uint64_t>);
+	STATIC_REQUIRE(std::is_same_v<lrc::typetraits::Promote_t<lrc::half, float>, float>);
+
+	// Odd sizes, so the scalar tail is exercised too
+	lrc::Array<float, CPU>::ShapeType shape({37, 41});
+	lrc::Array<int32_t, CPU> i32(shape);
+	lrc::Array<float, CPU> f32(shape);
+	lrc::Array<double, CPU> f64(shape);
+
+	for (int64_t i = 0; i < shape.size(); ++i) {
+		i32.storage()[i] = int32_t(i % 17) - 8;
+		f32.storage()[i] = float(i % 11) * 0.5f;
+		f64.storage()[i] = double(i % 7) * 0.25;
+	}
+
+	SECTION("int32 + float") {
+		lrc::Array<float, CPU> res = i32 + f32;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(res.scalar(i) == float(i32.scalar(i)) + f32.scalar(i));
+		}
+	}
+
+	SECTION("float * double") {
+		lrc::Array<double, CPU> res = f32 * f64;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(res.scalar(i) == double(f32.scalar(i)) * f64.scalar(i));
+		}
+	}
+
+	SECTION("Scalar of a different type") {
+		lrc::Array<float, CPU> res = f32 * 3 + i32;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(res.scalar(i) == f32.scalar(i) * 3.0f + float(i32.scalar(i)));
+		}
+	}
+
+	SECTION("Small integers of mixed signedness") {
+		lrc::Array<int16_t, CPU> i16(shape);
+		lrc::Array<uint16_t, CPU> u16(shape);
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			i16.storage()[i] = int16_t(i % 5) - 2;
+			u16.storage()[i] = uint16_t(i % 3);
+		}
+
+		lrc::Array<int32_t, CPU> sum  = i16 + u16;
+		lrc::Array<int32_t, CPU> less = i16 < u16;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(sum.scalar(i) == int32_t(i16.scalar(i)) + int32_t(u16.scalar(i)));
+			REQUIRE(less.scalar(i) == (int32_t(i16.scalar(i)) < int32_t(u16.scalar(i))));
+		}
+	}
+
+	SECTION("cast<T>()") {
+		lrc::Array<float, CPU> res = lrc::cast<float>(i32) * f32;
+		lrc::Array<int32_t, CPU> back = lrc::cast<int32_t>(res);
+		lrc::Array<float, CPU> member = i32.cast<float>();
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(res.scalar(i) == float(i32.scalar(i)) * f32.scalar(i));
+			REQUIRE(back.scalar(i) == int32_t(res.scalar(i)));
+			REQUIRE(member.scalar(i) == float(i32.scalar(i)));
+		}
+	}
+}
+
+#define TEST_COMPLEX(SCALAR)                                                                       \
+	SECTION(fmt::format("Test Complex Arithmetic [{}]", STRINGIFY(SCALAR))) {                      \
+		using Complex = lrc::Complex<SCALAR>;                                                      \
+		lrc::Array<Complex, CPU>::ShapeType shape({37, 41});                                       \
+		lrc::Array<Complex, CPU> a(shape), b(shape);                                               \
+		lrc::Array<SCALAR, CPU> rho(shape), theta(shape);                                          \
+                                                                                                   \
+		for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+			a.storage()[i] = Complex(SCALAR(i % 7) - SCALAR(3.5), SCALAR(i % 5) * SCALAR(0.25));   \
+			b.storage()[i] = Complex(SCALAR(i % 3) + SCALAR(0.5), SCALAR(i % 11) - SCALAR(5));     \
+			rho.storage()[i] = SCALAR(i % 9) * SCALAR(0.5);                                        \
+			theta.storage()[i] = SCALAR(i % 13) * SCALAR(0.25);                                    \
+		}                                                                                          \
+                                                                                                   \
+		lrc::Array<Complex, CPU> sum = a + b, diff = a - b, prod = a * b, quot = a / b;            \
+		lrc::Array<Complex, CPU> scaled = a * Complex(2, -1) + SCALAR(3);                          \
+		lrc::Array<Complex, CPU> conj = lrc::conj(a), exp = lrc::exp(a), log = lrc::log(a);        \
+		lrc::Array<Complex, CPU> abs = lrc::abs(a), arg = lrc::arg(a);                             \
+		lrc::Array<Complex, CPU> polar = lrc::polar(rho, theta);                                   \
+                                                                                                   \
+		auto close = [](const Complex &x, const Complex &y) {                                      \
+			return lrc::abs(x - y) <= SCALAR(tolerance) * lrc::max(SCALAR(1), lrc::abs(y));        \
+		};                                                                                         \
+                                                                                                   \
+		for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+			const Complex x = a.scalar(i), y = b.scalar(i);                                        \
+			REQUIRE(close(sum.scalar(i), x + y));                                                  \
+			REQUIRE(close(diff.scalar(i), x - y));                                                 \
+			REQUIRE(close(prod.scalar(i), x * y));                                                 \
+			REQUIRE(close(quot.scalar(i), x / y));                                                 \
+			REQUIRE(close(scaled.scalar(i), x * Complex(2, -1) + Complex(3)));                     \
+			REQUIRE(close(conj.scalar(i), lrc::conj(x)));                                          \
+			REQUIRE(close(exp.scalar(i), lrc::exp(x)));                                            \
+			REQUIRE(close(log.scalar(i), lrc::log(x)));                                            \
+			REQUIRE(close(abs.scalar(i), Complex(lrc::abs(x))));                                   \
+			REQUIRE(close(arg.scalar(i), Complex(lrc::arg(x))));                                   \
+			REQUIRE(close(polar.scalar(i), lrc::polar(rho.scalar(i), theta.scalar(i))));           \
+		}                                                                                          \
+	}                                                                                              \
+	do {                                                                                           \
+	} while (false)
+
+TEST_CASE("Test Array -- Complex CPU", "[array-lib]") {
+	TEST_COMPLEX(float);
+	TEST_COMPLEX(double);
+}
+
+TEST_CASE("Test Array -- half CPU", "[array-lib]") {
+	STATIC_REQUIRE(lrc::typetraits::TypeInfo<lrc::half>::allowVectorisation);
+
+	// Every value used here is exactly representable as a half, as are the results
+	lrc::Array<lrc::half, CPU>::ShapeType shape({37, 41});
+	lrc::Array<lrc::half, CPU> a(shape), b(shape);
+	lrc::Array<float, CPU> f32(shape);
+
+	for (int64_t i = 0; i < shape.size(); ++i) {
+		a.storage()[i] = lrc::half(float(i % 13) * 0.5f - 3.0f);
+		b.storage()[i] = lrc::half(float(i % 7) * 0.25f);
+		f32.storage()[i] = float(i % 5) - 2.0f;
+	}
+
+	SECTION("Arithmetic") {
+		lrc::Array<lrc::half, CPU> res = a * b + a - b;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			const float x = float(a.scalar(i)), y = float(b.scalar(i));
+			REQUIRE(float(res.scalar(i)) == x * y + x - y);
+		}
+	}
+
+	SECTION("Rounded once") {
+		// Products which are not representable as halves (but are exact in float, so fused
+		// multiply-adds do not change them). The size is not a multiple of the packet width, so
+		// the last elements are evaluated with scalars, which must also compute in float and
+		// round only when the result is stored
+		lrc::Array<lrc::half, CPU> x(shape), y(shape), z(shape);
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			x.storage()[i] = lrc::half(float(i % 29) * 0.173f + 0.31f);
+			y.storage()[i] = lrc::half(float(i % 23) * 0.117f - 1.37f);
+			z.storage()[i] = lrc::half(float(i % 19) * 0.0137f);
+		}
+
+		lrc::Array<lrc::half, CPU> res = x * y + z;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			const float expected = float(x.scalar(i)) * float(y.scalar(i)) + float(z.scalar(i));
+			REQUIRE(float(res.scalar(i)) == float(lrc::half(expected)));
+		}
+	}
+
+	SECTION("half and float") {
+		lrc::Array<float, CPU> res = a * f32;
+		lrc::Array<lrc::half, CPU> narrowed = lrc::cast<lrc::half>(f32 + 1);
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(res.scalar(i) == float(a.scalar(i)) * f32.scalar(i));
+			REQUIRE(float(narrowed.scalar(i)) == f32.scalar(i) + 1.0f);
+		}
+	}
+
+	SECTION("Transpose") {
+		lrc::Array<lrc::half, CPU> res = lrc::transpose(a);
+		REQUIRE(res.shape() == lrc::Array<lrc::half, CPU>::ShapeType({41, 37}));
+		for (int64_t i = 0; i < 37; ++i) {
+			for (int64_t j = 0; j < 41; ++j) {
+				REQUIRE(float(res.scalar(j * 37 + i)) == float(a.scalar(i * 41 + j)));
+			}
+		}
+	}
+}
+
+TEST_CASE("Test Array -- bfloat16 CPU", "[array-lib]") {
+	STATIC_REQUIRE(lrc::typetraits::TypeInfo<lrc::bfloat16>::allowVectorisation);
+	STATIC_REQUIRE(
+	  std::is_same_v<lrc::typetraits::Promote_t<lrc::half, lrc::bfloat16>, float>);
+
+	// Conversions round to nearest, ties to even
+	REQUIRE(lrc::bfloat16(1.0f).bits() == 0x3f80);
+	REQUIRE(lrc::bfloat16(1.00390625f).bits() == 0x3f80);
+	REQUIRE(lrc::bfloat16(1.01171875f).bits() == 0x3f82);
+
+	// Every value used here is exactly representable as a bfloat16, as are the results
+	lrc::Array<lrc::bfloat16, CPU>::ShapeType shape({37, 41});
+	lrc::Array<lrc::bfloat16, CPU> a(shape), b(shape);
+	lrc::Array<float, CPU> f32(shape);
+
+	for (int64_t i = 0; i < shape.size(); ++i) {
+		a.storage()[i]	 = lrc::bfloat16(float(i % 13) * 0.5f - 3.0f);
+		b.storage()[i]	 = lrc::bfloat16(float(i % 7) * 0.25f);
+		f32.storage()[i] = float(i % 5) - 2.0f;
+	}
+
+	SECTION("Arithmetic") {
+		lrc::Array<lrc::bfloat16, CPU> res = a * b + a - b;
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			const float x = float(a.scalar(i)), y = float(b.scalar(i));
+			REQUIRE(float(res.scalar(i)) == x * y + x - y);
+		}
+	}
+
+	SECTION("bfloat16 and float") {
+		lrc::Array<float, CPU> res				= a * f32;
+		lrc::Array<lrc::bfloat16, CPU> narrowed = lrc::cast<lrc::bfloat16>(f32 + 1);
+		for (int64_t i = 0; i < shape.size(); ++i) {
+			REQUIRE(res.scalar(i) == float(a.scalar(i)) * f32.scalar(i));
+			REQUIRE(float(narrowed.scalar(i)) == f32.scalar(i) + 1.0f);
+		}
+	}
+
+	SECTION("Transpose") {
+		lrc::Array<lrc::bfloat16, CPU> res = lrc::transpose(a);
+		REQUIRE(res.shape() == lrc::Array<lrc::bfloat16, CPU>::ShapeType({41, 37}));
+		for (int64_t i = 0; i < 37; ++i) {
+			for (int64_t j = 0; j < 41; ++j) {
+				REQUIRE(float(res.scalar(j * 37 + i)) == float(a.scalar(i * 41 + j)));
+			}
+		}
+	}
+
+	SECTION("Mixed-precision GEMM") {
+		// C (37 x 37) = A * A^T, accumulated in float
+		std::vector<float> c(37 * 37);
+		lrc::linalg::gemm(false,
+						  true,
+						  int64_t(37),
+						  int64_t(37),
+						  int64_t(41),
+						  1.0f,
+						  a.storage().begin(),
+						  int64_t(41),
+						  a.storage().begin(),
+						  int64_t(41),
+						  0.0f,
+						  c.data(),
+						  int64_t(37));
+
+		for (int64_t i = 0; i < 37; ++i) {
+			for (int64_t j = 0; j < 37; ++j) {
+				float expected = 0;
+				for (int64_t p = 0; p < 41; ++p) {
+					expected += float(a.scalar(i * 41 + p)) * float(a.scalar(j * 41 + p));
+				}
+				REQUIRE(c[i * 37 + j] == expected);
+			}
+		}
+	}
+}
+
 #if defined(LIBRAPID_USE_MULTIPREC)
 TEST_CASE("Test Array -- lrc::mpfr CPU", "[array-lib]") { TEST_ALL(lrc::mpfr, CPU); }
 #endif // LIBRAPID_USE_MULTIPREC
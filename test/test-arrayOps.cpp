@@ -58,3 +58,40 @@ TRIG_TEST_IMPL(double, OPENCL)
 TRIG_TEST_IMPL(float, CUDA)
 TRIG_TEST_IMPL(double, CUDA)
 #endif
+
+#define MAP_TEST_IMPL(SCALAR, BACKEND)                                                             \
+    TEST_CASE(fmt::format("Test Map -- {} {}", STRINGIFY(SCALAR), STRINGIFY(BACKEND)),             \
+              "[array-lib]") {                                                                     \
+        auto x = lrc::linspace<SCALAR, BACKEND>(0.1, 0.5, 100, false);                             \
+        auto y = lrc::linspace<SCALAR, BACKEND>(1, 2, 100, false);                                 \
+                                                                                                   \
+        /* Generic lambda -- evaluated with packets */                                             \
+        auto poly = lrc::map([](auto a, auto b) { return a * a + b * SCALAR(2); }, x, y).eval();   \
+                                                                                                   \
+        /* Scalar-only lambda */                                                                   \
+        auto clip =                                                                                \
+          lrc::map([](SCALAR a) { return a < SCALAR(0.3) ? SCALAR(0.3) : a; }, x).eval();          \
+                                                                                                   \
+        /* Combined with other operations and a scalar argument */                                 \
+        auto mixed = (lrc::map([](auto a, auto b) { return a * b; }, x, SCALAR(3)) + y).eval();    \
+                                                                                                   \
+        for (int i = 0; i < x.shape().size(); ++i) {                                               \
+            SCALAR a = x(i), b = y(i);                                                             \
+            REQUIRE(lrc::isClose((SCALAR)poly(i), a * a + b * SCALAR(2), tolerance));              \
+            REQUIRE(lrc::isClose((SCALAR)clip(i), a < SCALAR(0.3) ? SCALAR(0.3) : a, tolerance));  \
+            REQUIRE(lrc::isClose((SCALAR)mixed(i), a * SCALAR(3) + b, tolerance));                 \
+        }                                                                                          \
+    }
+
+MAP_TEST_IMPL(float, CPU)
+MAP_TEST_IMPL(double, CPU)
+
+#if defined(LIBRAPID_HAS_OPENCL)
+MAP_TEST_IMPL(float, OPENCL)
+MAP_TEST_IMPL(double, OPENCL)
+#endif
+
+#if defined(LIBRAPID_HAS_CUDA)
+MAP_TEST_IMPL(float, CUDA)
+MAP_TEST_IMPL(double, CUDA)
+#endif
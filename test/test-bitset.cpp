@@ -0,0 +1,89 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+
+#define TEST_BITSET_IMPL(NUM_BITS, STACK_ALLOC)                                                    \
+    TEST_CASE(fmt::format("Test BitSet Rank and Select -- {} {}", NUM_BITS, STACK_ALLOC),          \
+              "[bitset]") {                                                                        \
+        using BitSet   = lrc::BitSet<NUM_BITS, STACK_ALLOC>;                                       \
+        double density = GENERATE(0.001, 0.3, 0.99);                                              \
+                                                                                                   \
+        BitSet bits;                                                                               \
+        std::vector<uint64_t> ones;                                                                \
+        uint64_t state = 12345;                                                                    \
+        for (uint64_t i = 0; i < NUM_BITS; ++i) {                                                  \
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;                       \
+            if (double(state >> 11) * 0x1.0p-53 < density) {                                       \
+                bits.set(i, true);                                                                 \
+                ones.push_back(i);                                                                 \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        REQUIRE(bits.popCount() == ones.size());                                                   \
+                                                                                                   \
+        std::vector<uint64_t> visited;                                                             \
+        bits.forEachSetBit([&](uint64_t index) { visited.push_back(index); });                     \
+        REQUIRE(visited == ones);                                                                  \
+                                                                                                   \
+        lrc::RankSelect index(bits);                                                               \
+        REQUIRE(index.count() == ones.size());                                                     \
+                                                                                                   \
+        uint64_t before = 0;                                                                       \
+        for (uint64_t i = 0; i <= NUM_BITS; ++i) {                                                 \
+            while (before < ones.size() && ones[before] < i) ++before;                             \
+            REQUIRE(index.rank(i) == before);                                                      \
+            if (i % 97 == 0) { REQUIRE(bits.rank(i) == before); }                                  \
+        }                                                                                          \
+                                                                                                   \
+        for (uint64_t k = 0; k < ones.size(); ++k) {                                               \
+            REQUIRE(index.select(k) == ones[k]);                                                   \
+            if (k % 97 == 0) { REQUIRE(bits.select(k) == ones[k]); }                               \
+        }                                                                                          \
+        REQUIRE(index.select(ones.size()) == NUM_BITS);                                            \
+        REQUIRE(bits.select(ones.size()) == NUM_BITS);                                             \
+    }
+
+TEST_BITSET_IMPL(200, true)
+TEST_BITSET_IMPL(200000, false)
+TEST_BITSET_IMPL(131072, false)
+
+TEST_CASE("Test BitSet Bulk Operations", "[bitset]") {
+    using BitSet = lrc::BitSet<10000, false>;
+    BitSet a, b;
+    a.set(0, 6000, true);
+    b.set(3000, 9000, true);
+
+    BitSet c = a;
+    c &= b;
+    REQUIRE(c.popCount() == 3000);
+    REQUIRE(c.rank(3000) == 0);
+    REQUIRE(c.select(0) == 3000);
+
+    c = a;
+    c |= b;
+    REQUIRE(c.popCount() == 9000);
+
+    c = a;
+    c ^= b;
+    REQUIRE(c.popCount() == 6000);
+
+    c = a;
+    c.andNot(b);
+    REQUIRE(c.popCount() == 3000);
+    REQUIRE(c.select(2999) == 2999);
+
+    BitSet moved(std::move(c));
+    REQUIRE(moved.popCount() == 3000);
+
+    // A moved-from set is empty, and can be assigned to and from
+    REQUIRE(c.popCount() == 0);
+    BitSet empty = a;
+    empty        = c;
+    REQUIRE(empty.popCount() == 0);
+    c = a;
+    REQUIRE(c.popCount() == 6000);
+    REQUIRE(moved.popCount() == 3000);
+}
@@ -0,0 +1,133 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+TEST_CASE("Test FlatHashMap", "[flatHashMap]") {
+    SECTION("Insertion, lookup and erasure") {
+        lrc::FlatHashMap<int64_t, int64_t> map;
+        std::unordered_map<int64_t, int64_t> reference;
+
+        // Interleave insertions and erasures so deleted slots are reused and cleaned up
+        for (int64_t i = 0; i < 100000; ++i) {
+            const int64_t key = (i * 7919) % 5003;
+            if (i % 3 == 2) {
+                REQUIRE(map.erase(key) == (reference.erase(key) == 1));
+            } else {
+                map[key]       = i;
+                reference[key] = i;
+            }
+        }
+
+        REQUIRE(map.size() == int64_t(reference.size()));
+        for (int64_t key = -10; key < 5100; ++key) {
+            auto it = reference.find(key);
+            REQUIRE(map.contains(key) == (it != reference.end()));
+            int64_t value = -1;
+            REQUIRE(map.contains(key, value) == (it != reference.end()));
+            if (it != reference.end()) {
+                REQUIRE(value == it->second);
+                REQUIRE(map.get(key) == it->second);
+            } else {
+                REQUIRE(map.get(key, -1) == -1);
+                REQUIRE_THROWS(map.get(key));
+            }
+        }
+
+        int64_t count = 0;
+        for (const auto &[key, value] : map) {
+            REQUIRE(reference.at(key) == value);
+            ++count;
+        }
+        REQUIRE(count == map.size());
+    }
+
+    SECTION("Insert and insertOrAssign") {
+        lrc::FlatHashMap<std::string, int> map {{"a", 1}, {"b", 2}};
+        REQUIRE(map.size() == 2);
+        auto [it, inserted] = map.insert({"a", 3});
+        REQUIRE(!inserted);
+        REQUIRE(it->second == 1);
+        REQUIRE(map.get("a") == 1);
+        REQUIRE(!map.insertOrAssign("a", 3).second);
+        REQUIRE(map.get("a") == 3);
+        std::tie(it, inserted) = map.insert({"c", 4});
+        REQUIRE(inserted);
+        REQUIRE(map.find("c")->second == 4);
+        REQUIRE(map.find("d") == map.end());
+    }
+
+    SECTION("Reserve, rehash and clear") {
+        lrc::FlatHashMap<int32_t, int32_t> map;
+        map.reserve(1000);
+        const int64_t capacity = map.capacity();
+        REQUIRE(capacity >= 1000);
+        for (int32_t i = 0; i < 1000; ++i) { map[i] = i * 2; }
+        REQUIRE(map.capacity() == capacity);
+
+        for (int32_t i = 0; i < 1000; i += 2) { map.erase(i); }
+        map.rehash(0);
+        REQUIRE(map.size() == 500);
+        REQUIRE(map.capacity() < capacity);
+        for (int32_t i = 0; i < 1000; ++i) { REQUIRE(map.contains(i) == (i % 2 == 1)); }
+
+        map.clear();
+        REQUIRE(map.empty());
+        REQUIRE(!map.contains(1));
+        map.rehash(0);
+        REQUIRE(map.capacity() == 0);
+    }
+
+    SECTION("Batch lookup") {
+        lrc::FlatHashMap<int64_t, int64_t> map;
+        for (int64_t i = 0; i < 20000; ++i) { map[i * 3] = i; }
+
+        const int64_t n = 50000;
+        lrc::Array<int64_t, CPU> keys(lrc::Array<int64_t, CPU>::ShapeType({n}));
+        for (int64_t i = 0; i < n; ++i) { keys.storage()[i] = (i * 104729) % 70000 - 5000; }
+
+        auto rows = map.find(keys, -1);
+        REQUIRE(rows.shape() == keys.shape());
+        for (int64_t i = 0; i < n; ++i) {
+            const int64_t key = keys.scalar(i);
+            REQUIRE(rows.scalar(i) == map.get(key, -1));
+        }
+    }
+
+    SECTION("Formatting") {
+        lrc::FlatHashMap<int, int> map {{1, 2}};
+        REQUIRE(map.str() == "[\n  1: 2\n]");
+        REQUIRE(fmt::format("{}", map) == "[\n  1: 2\n]");
+    }
+}
+
+TEST_CASE("Test FlatHashSet", "[flatHashMap]") {
+    lrc::FlatHashSet<int32_t> set {5, 1, 9, 5, 1};
+    REQUIRE(set.size() == 3);
+    REQUIRE(set.contains(1));
+    REQUIRE(set.contains(5));
+    REQUIRE(set.contains(9));
+    REQUIRE(!set.contains(2));
+    REQUIRE(!set.insert(9));
+    REQUIRE(set.insert(2));
+    REQUIRE(set.erase(1));
+    REQUIRE(!set.erase(1));
+    REQUIRE(set.size() == 3);
+    REQUIRE(fmt::format("{}", lrc::FlatHashSet<int32_t> {7}) == "(7)");
+
+    const int64_t n = 1000;
+    lrc::Array<int32_t, CPU> keys(lrc::Array<int32_t, CPU>::ShapeType({n}));
+    for (int64_t i = 0; i < n; ++i) { keys.storage()[i] = int32_t(i % 12); }
+
+    auto found = set.contains(keys);
+    for (int64_t i = 0; i < n; ++i) {
+        const int32_t key = int32_t(i % 12);
+        REQUIRE(found.get(i) == (key == 2 || key == 5 || key == 9));
+    }
+
+    lrc::FlatHashSet<int32_t> fromArray(keys);
+    REQUIRE(fromArray.size() == 12);
+}
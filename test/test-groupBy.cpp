@@ -0,0 +1,75 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+TEST_CASE("Test Group Reduce", "[groupBy]") {
+    auto op         = GENERATE(lrc::GroupOp::Sum,
+                       lrc::GroupOp::Mean,
+                       lrc::GroupOp::Min,
+                       lrc::GroupOp::Max,
+                       lrc::GroupOp::Count);
+    auto numKeys    = GENERATE(int64_t(1), int64_t(13), int64_t(2500));
+    bool sortKeys   = GENERATE(false, true);
+    const int64_t n = 10007;
+
+    std::vector<int32_t> keys(n);
+    lrc::Array<double, CPU> values(lrc::Array<double, CPU>::ShapeType({n}));
+    for (int64_t i = 0; i < n; ++i) {
+        keys[i]             = int32_t((i * 7919) % numKeys - numKeys / 2);
+        values.storage()[i] = double((i * 31) % 1000) * 0.25;
+    }
+    if (sortKeys) std::sort(keys.begin(), keys.end());
+
+    // Reference results, with the groups in ascending order of key
+    std::map<int32_t, std::vector<double>> reference;
+    for (int64_t i = 0; i < n; ++i) { reference[keys[i]].push_back(values.scalar(i)); }
+
+    auto result = lrc::groupReduce(keys, values, op);
+    REQUIRE(result.keys.size() == reference.size());
+    REQUIRE(result.values.size() == reference.size());
+    REQUIRE(result.counts.size() == reference.size());
+
+    int64_t g = 0;
+    for (const auto &[key, group] : reference) {
+        const double sum = std::accumulate(group.begin(), group.end(), 0.0);
+        double expected  = 0;
+        switch (op) {
+            case lrc::GroupOp::Sum: expected = sum; break;
+            case lrc::GroupOp::Mean: expected = sum / double(group.size()); break;
+            case lrc::GroupOp::Min: expected = *std::min_element(group.begin(), group.end()); break;
+            case lrc::GroupOp::Max: expected = *std::max_element(group.begin(), group.end()); break;
+            case lrc::GroupOp::Count: expected = double(group.size()); break;
+        }
+
+        REQUIRE(result.keys.scalar(g) == key);
+        REQUIRE(result.counts.scalar(g) == int64_t(group.size()));
+        REQUIRE(lrc::isClose(result.values.scalar(g), expected, 1e-9));
+        ++g;
+    }
+}
+
+TEST_CASE("Test Group Reduce Integers", "[groupBy]") {
+    // Integer sums are exact, whichever order the values are added in
+    const int64_t n = 5000;
+    lrc::Array<int64_t, CPU> keys(lrc::Array<int64_t, CPU>::ShapeType({n}));
+    std::vector<int32_t> values(n);
+    for (int64_t i = 0; i < n; ++i) {
+        keys.storage()[i] = i / 7;
+        values[i]         = int32_t(i % 5) - 2;
+    }
+
+    auto sums = lrc::groupReduce(keys, values, lrc::GroupOp::Sum);
+    REQUIRE(sums.keys.size() == size_t((n + 6) / 7));
+    for (int64_t g = 0; g < int64_t(sums.keys.size()); ++g) {
+        int32_t expected = 0;
+        for (int64_t i = g * 7; i < std::min(n, g * 7 + 7); ++i) { expected += values[i]; }
+        REQUIRE(sums.keys.scalar(g) == g);
+        REQUIRE(sums.values.scalar(g) == expected);
+    }
+
+    REQUIRE_THROWS(lrc::groupReduce(keys, std::vector<int32_t>(n - 1), lrc::GroupOp::Sum));
+}
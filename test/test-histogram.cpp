@@ -0,0 +1,115 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+TEST_CASE("Test Histogram", "[histogram]") {
+    auto numBins    = GENERATE(int64_t(1), int64_t(7), int64_t(10000));
+    bool uniform    = GENERATE(false, true);
+    const int64_t n = 100003;
+
+    lrc::Array<double, CPU> values(lrc::Array<double, CPU>::ShapeType({n}));
+    std::vector<double> weights(n);
+    for (int64_t i = 0; i < n; ++i) {
+        values.storage()[i] = double((i * 7919) % 1201) * 0.01 - 1.0;
+        weights[i]          = double(i % 3);
+    }
+    values.storage()[17] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> edges(numBins + 1);
+    for (int64_t b = 0; b <= numBins; ++b) {
+        const double t = double(b) / double(numBins);
+        edges[b]       = 10.0 * (uniform ? t : t * t);
+    }
+
+    auto result   = lrc::histogram(values, edges);
+    auto weighted = lrc::histogram(values, edges, weights);
+    REQUIRE(result.counts.size() == numBins);
+    REQUIRE(result.edges.size() == numBins + 1);
+
+    std::vector<int64_t> counts(numBins, 0);
+    std::vector<double> totals(numBins, 0);
+    for (int64_t i = 0; i < n; ++i) {
+        const double x = values.scalar(i);
+        if (!(x >= edges.front() && x <= edges.back())) continue;
+        int64_t bin = std::upper_bound(edges.begin(), edges.end(), x) - edges.begin() - 1;
+        if (bin == numBins) bin = numBins - 1;
+        ++counts[bin];
+        totals[bin] += weights[i];
+    }
+
+    for (int64_t b = 0; b < numBins; ++b) {
+        REQUIRE(result.counts.scalar(b) == counts[b]);
+        REQUIRE(weighted.counts.scalar(b) == totals[b]);
+    }
+
+    // Uniform bins over the range of the values count every value except the NaN
+    auto spanning = lrc::histogram(values, numBins);
+    int64_t total = 0;
+    for (int64_t b = 0; b < numBins; ++b) { total += spanning.counts.scalar(b); }
+    REQUIRE(total == n - 1);
+    REQUIRE(spanning.edges.scalar(0) == -1.0);
+}
+
+TEST_CASE("Test Histogram 2D", "[histogram]") {
+    std::vector<double> x     = {0.5, 1.5, 1.5, 2.0, 3.0, -1.0};
+    std::vector<double> y     = {0.0, 0.0, 1.0, 1.0, 0.5, 0.0};
+    std::vector<double> w     = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    std::vector<double> edges = {0.0, 1.0, 2.0};
+
+    auto result = lrc::histogram2d(x, y, edges, edges);
+    REQUIRE(result.counts.shape() == lrc::Shape({2, 2}));
+    REQUIRE(result.counts.scalar(0) == 1);
+    REQUIRE(result.counts.scalar(1) == 0);
+    REQUIRE(result.counts.scalar(2) == 1);
+    REQUIRE(result.counts.scalar(3) == 2);
+
+    auto weighted = lrc::histogram2d(x, y, edges, edges, w);
+    REQUIRE(weighted.counts.scalar(3) == 7.0);
+}
+
+TEST_CASE("Test Histogram Mixed Types", "[histogram]") {
+    // Values are compared with integer edges without being truncated, so -0.5 and 20.5 are
+    // outside the edges rather than on them
+    const float nan            = std::numeric_limits<float>::quiet_NaN();
+    const float inf            = std::numeric_limits<float>::infinity();
+    std::vector<float> values  = {9.5f, 10.5f, 20.0f, 20.5f, -0.5f, nan, 1e30f, -inf};
+    std::vector<int32_t> edges = {0, 10, 20};
+
+    auto result = lrc::histogram(values, edges);
+    REQUIRE(result.counts.size() == 2);
+    REQUIRE(result.counts.scalar(0) == 1);
+    REQUIRE(result.counts.scalar(1) == 2);
+}
+
+TEST_CASE("Test Bincount", "[histogram]") {
+    auto maxValue   = GENERATE(int64_t(5), int64_t(1000000));
+    const int64_t n = 100003;
+
+    std::vector<int32_t> values(n);
+    std::vector<float> weights(n);
+    for (int64_t i = 0; i < n; ++i) {
+        values[i]  = int32_t((i * 7919) % maxValue);
+        weights[i] = float(i % 4);
+    }
+
+    auto counts = lrc::bincount(values);
+    auto totals = lrc::bincount(values, weights, maxValue + 10);
+    REQUIRE(totals.size() == maxValue + 10);
+
+    std::vector<int64_t> expected(counts.size(), 0);
+    std::vector<float> expectedTotals(totals.size(), 0);
+    for (int64_t i = 0; i < n; ++i) {
+        ++expected[values[i]];
+        expectedTotals[values[i]] += weights[i];
+    }
+    for (int64_t k = 0; k < static_cast<int64_t>(counts.size()); ++k) {
+        REQUIRE(counts.scalar(k) == expected[k]);
+        REQUIRE(totals.scalar(k) == expectedTotals[k]);
+    }
+
+    REQUIRE_THROWS(lrc::bincount(std::vector<int32_t> {1, -1}));
+}
@@ -0,0 +1,264 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+#define TEST_TAKE(SCALAR)                                                                          \
+    SECTION(fmt::format("Test Take [{}]", STRINGIFY(SCALAR))) {                                    \
+        const int64_t d0 = 5, d1 = 7, d2 = 3;                                                      \
+        lrc::Array<SCALAR, CPU> a(lrc::Array<SCALAR, CPU>::ShapeType({d0, d1, d2}));              \
+        for (int64_t i = 0; i < d0 * d1 * d2; ++i) { a.storage()[i] = SCALAR(i); }                 \
+        auto at = [&](int64_t i, int64_t j, int64_t k) {                                           \
+            return a.scalar((i * d1 + j) * d2 + k);                                                \
+        };                                                                                         \
+                                                                                                   \
+        /* Whole slices along the first axis, with repeats and negative indices */                 \
+        std::vector<int64_t> rows = {4, 0, -1, 2};                                                 \
+        auto t0                   = lrc::take(a, rows);                                            \
+        REQUIRE(t0.shape() == lrc::Array<SCALAR, CPU>::ShapeType({4, d1, d2}));                    \
+        for (int64_t r = 0; r < 4; ++r) {                                                          \
+            const int64_t i = rows[r] < 0 ? rows[r] + d0 : rows[r];                                \
+            for (int64_t j = 0; j < d1; ++j) {                                                     \
+                for (int64_t k = 0; k < d2; ++k) {                                                 \
+                    REQUIRE(t0.scalar((r * d1 + j) * d2 + k) == at(i, j, k));                      \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        /* A middle axis, with a two-dimensional index list */                                     \
+        lrc::Array<int32_t, CPU> cols(lrc::Array<int32_t, CPU>::ShapeType({2, 2}));                \
+        cols.storage()[0] = 6;                                                                     \
+        cols.storage()[1] = 1;                                                                     \
+        cols.storage()[2] = -7;                                                                    \
+        cols.storage()[3] = 1;                                                                     \
+        auto t1 = lrc::take(a, cols, 1);                                                           \
+        REQUIRE(t1.shape() == lrc::Array<SCALAR, CPU>::ShapeType({d0, 2, 2, d2}));                 \
+        for (int64_t i = 0; i < d0; ++i) {                                                         \
+            for (int64_t c = 0; c < 4; ++c) {                                                      \
+                const int64_t j = cols.scalar(c) < 0 ? cols.scalar(c) + d1 : cols.scalar(c);       \
+                for (int64_t k = 0; k < d2; ++k) {                                                 \
+                    REQUIRE(t1.scalar((i * 4 + c) * d2 + k) == at(i, j, k));                       \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        /* Single elements along the last axis are gathered */                                     \
+        std::vector<int64_t> elems;                                                                \
+        for (int64_t e = 0; e < 37; ++e) { elems.push_back((e * 5) % d2); }                        \
+        auto t2 = lrc::take(a, elems, -1);                                                         \
+        REQUIRE(t2.shape() == lrc::Array<SCALAR, CPU>::ShapeType({d0, d1, 37}));                   \
+        for (int64_t i = 0; i < d0; ++i) {                                                         \
+            for (int64_t j = 0; j < d1; ++j) {                                                     \
+                for (int64_t e = 0; e < 37; ++e) {                                                 \
+                    REQUIRE(t2.scalar((i * d1 + j) * 37 + e) == at(i, j, elems[e]));               \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        REQUIRE_THROWS(lrc::take(a, std::vector<int64_t> {5}));                                    \
+        REQUIRE_THROWS(lrc::take(a, std::vector<int64_t> {-8}, 1));                                \
+        REQUIRE_THROWS(lrc::take(a, std::vector<int64_t> {0}, 3));                                 \
+    }
+
+#define TEST_PUT(SCALAR)                                                                           \
+    SECTION(fmt::format("Test Put [{}]", STRINGIFY(SCALAR))) {                                     \
+        const int64_t rows = 6, cols = 4;                                                          \
+        lrc::Array<SCALAR, CPU> a(lrc::Array<SCALAR, CPU>::ShapeType({rows, cols}));               \
+        for (int64_t i = 0; i < rows * cols; ++i) { a.storage()[i] = SCALAR(0); }                  \
+                                                                                                   \
+        /* Row 1 is written twice, so the last write wins */                                       \
+        std::vector<int64_t> indices = {1, -1, 1};                                                 \
+        lrc::Array<SCALAR, CPU> values(lrc::Array<SCALAR, CPU>::ShapeType({3, cols}));             \
+        for (int64_t i = 0; i < 3 * cols; ++i) { values.storage()[i] = SCALAR(i + 1); }            \
+        lrc::put(a, indices, values);                                                              \
+        for (int64_t j = 0; j < cols; ++j) {                                                       \
+            REQUIRE(a.scalar(0 * cols + j) == SCALAR(0));                                          \
+            REQUIRE(a.scalar(1 * cols + j) == values.scalar(2 * cols + j));                        \
+            REQUIRE(a.scalar(5 * cols + j) == values.scalar(1 * cols + j));                        \
+        }                                                                                          \
+                                                                                                   \
+        /* Scalars are written to every selected element */                                        \
+        lrc::put(a, std::vector<int64_t> {0, 2}, SCALAR(9), 1);                                    \
+        for (int64_t i = 0; i < rows; ++i) {                                                       \
+            REQUIRE(a.scalar(i * cols + 0) == SCALAR(9));                                          \
+            REQUIRE(a.scalar(i * cols + 2) == SCALAR(9));                                          \
+        }                                                                                          \
+        REQUIRE(a.scalar(3 * cols + 1) == SCALAR(0));                                              \
+                                                                                                   \
+        REQUIRE_THROWS(lrc::put(a, std::vector<int64_t> {6}, SCALAR(1)));                          \
+        REQUIRE_THROWS(lrc::put(a, std::vector<int64_t> {0, 1}, values));                          \
+    }
+
+#define TEST_COMPRESS(SCALAR)                                                                      \
+    SECTION(fmt::format("Test Compress [{}]", STRINGIFY(SCALAR))) {                                \
+        /* Large enough to cover full, empty and partial mask words */                             \
+        lrc::Array<SCALAR, CPU>::ShapeType shape({17, 31});                                        \
+        lrc::Array<SCALAR, CPU> a(shape);                                                          \
+        for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+            a.storage()[i] = (i >= 64 && i < 192) ? SCALAR(1) : SCALAR((i * 7) % 5);               \
+        }                                                                                          \
+                                                                                                   \
+        auto selected = lrc::compress(a, a > SCALAR(0));                                           \
+        std::vector<SCALAR> expected;                                                              \
+        for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+            if (a.scalar(i) > SCALAR(0)) expected.push_back(a.scalar(i));                          \
+        }                                                                                          \
+                                                                                                   \
+        REQUIRE(selected.ndim() == 1);                                                             \
+        REQUIRE(selected.size() == expected.size());                                               \
+        for (size_t i = 0; i < expected.size(); ++i) {                                             \
+            REQUIRE(selected.scalar(i) == expected[i]);                                            \
+        }                                                                                          \
+                                                                                                   \
+        REQUIRE(lrc::compress(a, lrc::Mask(shape)).size() == 0);                                   \
+        REQUIRE(lrc::compress(a, lrc::Mask(shape, true)).size() == shape.size());                  \
+        REQUIRE_THROWS(lrc::compress(a, lrc::Mask(lrc::Shape({3}))));                              \
+    }
+
+TEST_CASE("Test Take", "[indexing]") {
+    TEST_TAKE(int8_t);
+    TEST_TAKE(int32_t);
+    TEST_TAKE(float);
+    TEST_TAKE(double);
+}
+
+TEST_CASE("Test Put", "[indexing]") {
+    TEST_PUT(int16_t);
+    TEST_PUT(float);
+    TEST_PUT(double);
+}
+
+TEST_CASE("Test Put 1D in Parallel", "[indexing]") {
+    const size_t multithreadThreshold = lrc::global::multithreadThreshold;
+    const size_t numThreads           = lrc::global::numThreads;
+    lrc::global::multithreadThreshold = 0;
+    lrc::global::numThreads           = 4;
+
+    // Many repeated indices, split between threads by target, so the last write must win
+    const int64_t extent = 1000, n = 5000;
+    lrc::Array<int32_t, CPU> a(lrc::Array<int32_t, CPU>::ShapeType({extent}));
+    lrc::Array<int32_t, CPU> values(lrc::Array<int32_t, CPU>::ShapeType({n}));
+    std::vector<int64_t> indices(n);
+    std::vector<int32_t> expected(extent, 0);
+    for (int64_t i = 0; i < extent; ++i) { a.storage()[i] = 0; }
+    for (int64_t j = 0; j < n; ++j) {
+        indices[j]           = (j * 7) % extent;
+        values.storage()[j]  = int32_t(j + 1);
+        expected[indices[j]] = int32_t(j + 1);
+    }
+
+    lrc::put(a, indices, values);
+    for (int64_t i = 0; i < extent; ++i) { REQUIRE(a.scalar(i) == expected[i]); }
+
+    // Integers whose bits are a signalling NaN are gathered unchanged
+    lrc::Array<int32_t, CPU> bits(lrc::Array<int32_t, CPU>::ShapeType({64}));
+    for (int64_t i = 0; i < 64; ++i) { bits.storage()[i] = int32_t(0x7f800001 + i); }
+    std::vector<int64_t> reversed(64);
+    for (int64_t i = 0; i < 64; ++i) { reversed[i] = 63 - i; }
+    auto taken = lrc::take(bits, reversed);
+    for (int64_t i = 0; i < 64; ++i) { REQUIRE(taken.scalar(i) == int32_t(0x7f800001 + 63 - i)); }
+
+    lrc::global::multithreadThreshold = multithreadThreshold;
+    lrc::global::numThreads           = numThreads;
+}
+
+TEST_CASE("Test Compress", "[indexing]") {
+    TEST_COMPRESS(int8_t);
+    TEST_COMPRESS(int64_t);
+    TEST_COMPRESS(float);
+    TEST_COMPRESS(double);
+}
+
+TEST_CASE("Test Gather Kernels", "[indexing]") {
+    const int64_t n = 1029;
+    std::vector<float> srcF(n);
+    std::vector<double> srcD(n);
+    std::vector<int64_t> indices(n);
+    for (int64_t i = 0; i < n; ++i) {
+        srcF[i]    = float(i) * 0.5f;
+        srcD[i]    = double(i) * 0.25;
+        indices[i] = (i * 389) % n;
+    }
+
+    const lrc::SimdLevel originalLevel = lrc::getSimdLevel();
+    for (int level = 0; level <= (int)lrc::detectSimdLevel(); ++level) {
+        lrc::setSimdLevel((lrc::SimdLevel)level);
+
+        SECTION(fmt::format("Gather [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {
+            std::vector<float> outF(n);
+            std::vector<double> outD(n);
+            lrc::detail::cpu::dispatch::gather(n, outF.data(), srcF.data(), indices.data());
+            lrc::detail::cpu::dispatch::gather(n, outD.data(), srcD.data(), indices.data());
+            for (int64_t i = 0; i < n; ++i) {
+                REQUIRE(outF[i] == srcF[indices[i]]);
+                REQUIRE(outD[i] == srcD[indices[i]]);
+            }
+        }
+    }
+    lrc::setSimdLevel(originalLevel);
+}
+
+TEST_CASE("Test Scatter Reductions", "[indexing]") {
+    // Every strategy is run directly, so the parallel paths are used even for small inputs
+    const int64_t n = 2000, cols = 3;
+    auto strategy   = GENERATE(lrc::ScatterStrategy::Auto,
+                             lrc::ScatterStrategy::Deterministic,
+                             lrc::ScatterStrategy::Privatised,
+                             lrc::ScatterStrategy::Sorted,
+                             lrc::ScatterStrategy::Atomic);
+    auto targets    = GENERATE(int64_t(5), int64_t(1500));
+
+    std::vector<int64_t> indices(n);
+    lrc::Array<double, CPU> values(lrc::Array<double, CPU>::ShapeType({n, cols}));
+    lrc::Array<int32_t, CPU> intValues(lrc::Array<int32_t, CPU>::ShapeType({n, cols}));
+    for (int64_t i = 0; i < n; ++i) {
+        indices[i] = (i * 7919) % targets - (i % 2 ? targets : 0);
+        for (int64_t j = 0; j < cols; ++j) {
+            values.storage()[i * cols + j]    = double((i * 31 + j) % 97) * 0.01;
+            intValues.storage()[i * cols + j] = int32_t((i * 53 + j) % 101) - 50;
+        }
+    }
+
+    auto shape = lrc::Array<double, CPU>::ShapeType({targets, cols});
+    lrc::Array<double, CPU> sum(shape, 1.0);
+    lrc::Array<int32_t, CPU> max(shape, 0);
+    lrc::Array<int32_t, CPU> min(shape, 0);
+    lrc::Array<int32_t, CPU> count(lrc::Array<int32_t, CPU>::ShapeType({targets}), 0);
+    lrc::scatterAdd(sum, indices, values, strategy);
+    lrc::scatterMax(max, indices, intValues, strategy);
+    lrc::scatterMin(min, indices, intValues, strategy);
+    lrc::scatterAdd(count, indices, 1, strategy);
+
+    // Reference results from a serial loop
+    std::vector<double> refSum(targets * cols, 1.0);
+    std::vector<int32_t> refMax(targets * cols, 0), refMin(targets * cols, 0);
+    std::vector<int32_t> refCount(targets, 0);
+    for (int64_t i = 0; i < n; ++i) {
+        const int64_t t = indices[i] < 0 ? indices[i] + targets : indices[i];
+        ++refCount[t];
+        for (int64_t j = 0; j < cols; ++j) {
+            refSum[t * cols + j] += values.scalar(i * cols + j);
+            refMax[t * cols + j] = std::max(refMax[t * cols + j], intValues.scalar(i * cols + j));
+            refMin[t * cols + j] = std::min(refMin[t * cols + j], intValues.scalar(i * cols + j));
+        }
+    }
+
+    const bool exact = strategy == lrc::ScatterStrategy::Deterministic ||
+                       strategy == lrc::ScatterStrategy::Sorted;
+    for (int64_t i = 0; i < targets * cols; ++i) {
+        if (exact) {
+            REQUIRE(sum.scalar(i) == refSum[i]);
+        } else {
+            REQUIRE(lrc::isClose(sum.scalar(i), refSum[i], 1e-9));
+        }
+        REQUIRE(max.scalar(i) == refMax[i]);
+        REQUIRE(min.scalar(i) == refMin[i]);
+    }
+    for (int64_t i = 0; i < targets; ++i) { REQUIRE(count.scalar(i) == refCount[i]); }
+
+    REQUIRE_THROWS(lrc::scatterAdd(sum, std::vector<int64_t> {targets}, 1.0));
+    REQUIRE_THROWS(lrc::scatterAdd(sum, std::vector<int64_t> {0, 1}, values));
+}
@@ -0,0 +1,168 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+#define TEST_MASK(SCALAR)                                                                          \
+    SECTION(fmt::format("Test Mask From Comparison [{}]", STRINGIFY(SCALAR))) {                    \
+        /* Prime-dimensioned to force partial packets and words */                                 \
+        lrc::Array<SCALAR, CPU>::ShapeType shape({13, 29});                                        \
+        lrc::Array<SCALAR, CPU> a(shape);                                                          \
+        lrc::Array<SCALAR, CPU> b(shape);                                                          \
+        for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+            a.storage()[i] = SCALAR((i * 37) % 11);                                                \
+            b.storage()[i] = SCALAR((i * 13) % 7);                                                 \
+        }                                                                                          \
+                                                                                                   \
+        lrc::Mask lt(a < b);                                                                       \
+        lrc::Mask eq(a == b);                                                                      \
+        lrc::Mask gt(a > SCALAR(5));                                                               \
+        lrc::Mask nonzero(a);                                                                      \
+        REQUIRE(lt.size() == int64_t(shape.size()));                                               \
+        REQUIRE(lt.shape() == shape);                                                              \
+                                                                                                   \
+        int64_t ltCount = 0;                                                                       \
+        std::vector<int64_t> ltIndices;                                                            \
+        for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+            REQUIRE(lt.get(i) == (a.scalar(i) < b.scalar(i)));                                     \
+            REQUIRE(eq.get(i) == (a.scalar(i) == b.scalar(i)));                                    \
+            REQUIRE(gt.get(i) == (a.scalar(i) > SCALAR(5)));                                       \
+            REQUIRE(nonzero.get(i) == (a.scalar(i) != SCALAR(0)));                                 \
+            if (lt.get(i)) {                                                                       \
+                ++ltCount;                                                                         \
+                ltIndices.push_back(i);                                                            \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        REQUIRE(lt.countNonzero() == ltCount);                                                     \
+        REQUIRE(lrc::countNonzero(lt) == ltCount);                                                 \
+                                                                                                   \
+        std::vector<int64_t> setIndices;                                                           \
+        for (int64_t index : lt.setIndices()) { setIndices.push_back(index); }                     \
+        REQUIRE(setIndices == ltIndices);                                                          \
+                                                                                                   \
+        /* a <= b is the same as (a < b) | (a == b), and a >= b is its complement */               \
+        REQUIRE(lrc::Mask(a <= b) == (lt | eq));                                                   \
+        REQUIRE(lrc::Mask(a >= b) == ~lt);                                                         \
+        REQUIRE((lt & eq).none());                                                                 \
+        REQUIRE((lt ^ eq) == (lt | eq));                                                           \
+        REQUIRE((lt | ~lt).all());                                                                 \
+        REQUIRE((~lt).countNonzero() == int64_t(shape.size()) - ltCount);                          \
+    }
+
+TEST_CASE("Test Mask", "[mask]") {
+    TEST_MASK(int32_t);
+    TEST_MASK(int64_t);
+    TEST_MASK(float);
+    TEST_MASK(double);
+}
+
+TEST_CASE("Test Mask Operations", "[mask]") {
+    lrc::Mask mask(lrc::Shape({200}));
+    REQUIRE(mask.none());
+    REQUIRE(mask.numWords() == 4);
+
+    mask.set(0).set(63).set(64).set(199);
+    REQUIRE(mask.countNonzero() == 4);
+    REQUIRE(mask.get(63));
+    REQUIRE(!mask.get(62));
+
+    std::vector<int64_t> indices(mask.setIndices().begin(), mask.setIndices().end());
+    REQUIRE(indices == std::vector<int64_t> {0, 63, 64, 199});
+
+    mask.set(63, false);
+    REQUIRE(mask.countNonzero() == 3);
+
+    // Bits past the end are never set, even after inversion
+    lrc::Mask full(lrc::Shape({200}), true);
+    REQUIRE(full.countNonzero() == 200);
+    REQUIRE((~full).none());
+    REQUIRE((~mask).countNonzero() == 197);
+
+    REQUIRE_THROWS(mask.get(200));
+    REQUIRE_THROWS(mask & lrc::Mask(lrc::Shape({100})));
+}
+
+TEST_CASE("Test Where", "[mask]") {
+    lrc::Array<float, CPU>::ShapeType shape({11, 23});
+    lrc::Array<float, CPU> a(shape);
+    lrc::Array<float, CPU> b(shape);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    const float inf = std::numeric_limits<float>::infinity();
+    for (int64_t i = 0; i < shape.size(); ++i) {
+        a.storage()[i] = (i % 5 == 0) ? nan : float(i % 13) - 6.0f;
+        b.storage()[i] = (i % 7 == 0) ? inf : float(i % 3);
+    }
+
+    SECTION("Value Condition") {
+        // NaNs in the unselected operand do not reach the result
+        lrc::Array<float, CPU> res = lrc::where(a > b, a, b);
+        for (int64_t i = 0; i < shape.size(); ++i) {
+            const float expected = a.scalar(i) > b.scalar(i) ? a.scalar(i) : b.scalar(i);
+            REQUIRE(res.scalar(i) == expected);
+        }
+
+        // Replace NaNs and clip negative values, fused with the surrounding expression
+        lrc::Array<float, CPU> cleaned = lrc::where(a != a, 0.0f, lrc::where(a < 0, 0.0f, a)) * 2;
+        for (int64_t i = 0; i < shape.size(); ++i) {
+            const float val = a.scalar(i);
+            REQUIRE(cleaned.scalar(i) == ((val != val || val < 0) ? 0.0f : val * 2));
+        }
+    }
+
+    SECTION("Mask Condition") {
+        lrc::Mask mask(a < b);
+        lrc::Array<float, CPU> res = lrc::where(mask, a + 1, -1.0f);
+        for (int64_t i = 0; i < shape.size(); ++i) {
+            REQUIRE(res.scalar(i) == (mask.get(i) ? a.scalar(i) + 1 : -1.0f));
+        }
+    }
+
+    SECTION("Condition Of Another Type") {
+        // A fractional condition is nonzero, even though it would truncate to zero in the
+        // result's type
+        lrc::Array<float, CPU> fraction(shape);
+        lrc::Array<double, CPU> tiny(shape);
+        for (int64_t i = 0; i < shape.size(); ++i) {
+            fraction.storage()[i] = (i % 3 == 0) ? 0.0f : 0.5f;
+            tiny.storage()[i]     = (i % 4 == 0) ? 0.0 : 1e-300;
+        }
+
+        lrc::Array<int32_t, CPU> fromFloat = lrc::where(fraction, int32_t(1), int32_t(2));
+        lrc::Array<float, CPU> fromDouble  = lrc::where(tiny, 1.0f, 2.0f);
+        for (int64_t i = 0; i < shape.size(); ++i) {
+            REQUIRE(fromFloat.scalar(i) == (i % 3 == 0 ? 2 : 1));
+            REQUIRE(fromDouble.scalar(i) == (i % 4 == 0 ? 2.0f : 1.0f));
+        }
+    }
+}
+
+TEST_CASE("Test Masked Assign", "[mask]") {
+    lrc::Array<double, CPU>::ShapeType shape({7, 41});
+    lrc::Array<double, CPU> a(shape);
+    lrc::Array<double, CPU> b(shape);
+    for (int64_t i = 0; i < shape.size(); ++i) {
+        a.storage()[i] = (i % 9 == 0) ? std::numeric_limits<double>::quiet_NaN() : double(i);
+        b.storage()[i] = double(-i);
+    }
+
+    // Replace NaNs in place
+    lrc::Mask isNaN(a != a);
+    a.maskedAssign(isNaN, 0.0);
+    for (int64_t i = 0; i < shape.size(); ++i) {
+        REQUIRE(a.scalar(i) == (i % 9 == 0 ? 0.0 : double(i)));
+    }
+
+    // Whole words are selected here, so some elements are written with packets
+    lrc::Mask lowHalf(lrc::Shape({shape.size()}));
+    for (int64_t i = 0; i < 150; ++i) { lowHalf.set(i); }
+    a.maskedAssign(lowHalf, b * 2);
+    for (int64_t i = 0; i < shape.size(); ++i) {
+        REQUIRE(a.scalar(i) == (i < 150 ? double(-2 * i) : (i % 9 == 0 ? 0.0 : double(i))));
+    }
+
+    REQUIRE_THROWS(a.maskedAssign(lrc::Mask(lrc::Shape({5})), 1.0));
+}
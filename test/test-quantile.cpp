@@ -0,0 +1,109 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+TEST_CASE("Test Quantile", "[quantile]") {
+    auto axis   = GENERATE(int64_t(0), int64_t(1));
+    auto method = GENERATE(lrc::QuantileMethod::Linear,
+                           lrc::QuantileMethod::Lower,
+                           lrc::QuantileMethod::Higher,
+                           lrc::QuantileMethod::Nearest,
+                           lrc::QuantileMethod::Midpoint);
+    const int64_t rows = 37, cols = 1001;
+
+    lrc::Array<double, CPU> values(lrc::Array<double, CPU>::ShapeType({rows, cols}));
+    for (int64_t i = 0; i < rows * cols; ++i) {
+        values.storage()[i] = double((i * 7919) % 613) * 0.25;
+    }
+
+    std::vector<double> qs = {0.0, 0.01, 0.25, 0.5, 0.95, 0.99, 1.0};
+    auto result            = lrc::quantile(values, qs, axis, method);
+    const int64_t numRows  = axis == 0 ? cols : rows;
+    const int64_t n        = axis == 0 ? rows : cols;
+    REQUIRE(result.shape() ==
+            (axis == 0 ? lrc::Shape({int64_t(qs.size()), cols})
+                       : lrc::Shape({rows, int64_t(qs.size())})));
+
+    for (int64_t r = 0; r < numRows; ++r) {
+        std::vector<double> row(n);
+        for (int64_t j = 0; j < n; ++j) {
+            row[j] = values.scalar(axis == 0 ? j * cols + r : r * cols + j);
+        }
+        std::sort(row.begin(), row.end());
+
+        for (int64_t i = 0; i < static_cast<int64_t>(qs.size()); ++i) {
+            const double h   = qs[i] * double(n - 1);
+            const int64_t lo = int64_t(std::floor(h)), hi = int64_t(std::ceil(h));
+            const double t   = h - double(lo);
+            double expected  = 0;
+            switch (method) {
+                case lrc::QuantileMethod::Lower: expected = row[lo]; break;
+                case lrc::QuantileMethod::Higher: expected = row[hi]; break;
+                case lrc::QuantileMethod::Nearest:
+                    expected = (t == 0.5 ? lo % 2 == 0 : t < 0.5) ? row[lo] : row[hi];
+                    break;
+                case lrc::QuantileMethod::Midpoint: expected = (row[lo] + row[hi]) / 2; break;
+                default: expected = row[lo] + (row[hi] - row[lo]) * t; break;
+            }
+
+            const double got =
+              result.scalar(axis == 0 ? i * cols + r : r * int64_t(qs.size()) + i);
+            REQUIRE(std::abs(got - expected) <= 1e-9 * (1 + std::abs(expected)));
+        }
+    }
+}
+
+TEST_CASE("Test Median", "[quantile]") {
+    lrc::Array<int32_t, CPU> odd(lrc::Array<int32_t, CPU>::ShapeType({5}));
+    lrc::Array<int32_t, CPU> even(lrc::Array<int32_t, CPU>::ShapeType({4}));
+    const int32_t oddValues[]  = {5, 1, 4, 2, 3};
+    const int32_t evenValues[] = {5, 1, 4, 2};
+    for (int64_t i = 0; i < 5; ++i) { odd.storage()[i] = oddValues[i]; }
+    for (int64_t i = 0; i < 4; ++i) { even.storage()[i] = evenValues[i]; }
+
+    REQUIRE(lrc::median(odd).scalar(0) == 3.0);
+    REQUIRE(lrc::median(even).scalar(0) == 3.0);
+    REQUIRE(lrc::percentile(even, 100.0).scalar(0) == 5.0);
+    REQUIRE(lrc::percentile(even, 0.0).scalar(0) == 1.0);
+
+    lrc::Array<double, CPU> withNan(lrc::Array<double, CPU>::ShapeType({2, 3}));
+    const double nanValues[] = {1.0, std::numeric_limits<double>::quiet_NaN(), 3.0, 4.0, 6.0, 5.0};
+    for (int64_t i = 0; i < 6; ++i) { withNan.storage()[i] = nanValues[i]; }
+    auto medians = lrc::median(withNan);
+    REQUIRE(std::isnan(medians.scalar(0)));
+    REQUIRE(medians.scalar(1) == 5.0);
+
+    REQUIRE_THROWS(lrc::quantile(withNan, 1.5));
+}
+
+TEST_CASE("Test Quantile Infinite Values", "[quantile]") {
+    const double inf = std::numeric_limits<double>::infinity();
+    lrc::Array<double, CPU> upper(lrc::Array<double, CPU>::ShapeType({2}));
+    lrc::Array<double, CPU> lower(lrc::Array<double, CPU>::ShapeType({2}));
+    lrc::Array<double, CPU> both(lrc::Array<double, CPU>::ShapeType({2}));
+    upper.storage()[0] = 1.0;
+    upper.storage()[1] = inf;
+    lower.storage()[0] = -inf;
+    lower.storage()[1] = 1.0;
+    both.storage()[0]  = inf;
+    both.storage()[1]  = -inf;
+
+    // A quantile which lands on an infinite element is that element
+    REQUIRE(lrc::quantile(upper, 1.0).scalar(0) == inf);
+    REQUIRE(lrc::quantile(upper, 0.0).scalar(0) == 1.0);
+    REQUIRE(lrc::quantile(lower, 0.0).scalar(0) == -inf);
+
+    // Between an infinite and a finite element, the infinite one dominates
+    REQUIRE(lrc::quantile(upper, 0.75).scalar(0) == inf);
+    REQUIRE(lrc::quantile(lower, 0.75).scalar(0) == -inf);
+    REQUIRE(lrc::median(upper).scalar(0) == inf);
+    REQUIRE(lrc::median(lower).scalar(0) == -inf);
+
+    // Opposite infinities have no meaningful midpoint
+    REQUIRE(std::isnan(lrc::median(both).scalar(0)));
+    REQUIRE(lrc::quantile(both, 1.0).scalar(0) == inf);
+}
@@ -0,0 +1,215 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+TEST_CASE("Test Quantization Parameters", "[quantize]") {
+    // int8_t is symmetric
+    auto params = lrc::quantizationParams<int8_t>(-2.0f, 1.0f);
+    REQUIRE(params.zeroPoint == 0);
+    REQUIRE(params.scale == 2.0f / 127.0f);
+
+    // uint8_t covers [min, max], extended to include zero
+    params = lrc::quantizationParams<uint8_t>(1.0f, 5.1f);
+    REQUIRE(params.zeroPoint == 0);
+    REQUIRE(params.scale == 5.1f / 255.0f);
+
+    params = lrc::quantizationParams<uint8_t>(-1.0f, 3.0f);
+    REQUIRE(params.zeroPoint == 64);
+
+    // Values outside the range saturate
+    REQUIRE(lrc::detail::quantizeScalar<int8_t>(100.0f, {0.5f, 0}) == 127);
+    REQUIRE(lrc::detail::quantizeScalar<int8_t>(-100.0f, {0.5f, 0}) == -127);
+    REQUIRE(lrc::detail::quantizeScalar<uint8_t>(-100.0f, {0.5f, 10}) == 0);
+}
+
+TEST_CASE("Test Quantize and Dequantize Expressions", "[quantize]") {
+    lrc::Array<float, CPU>::ShapeType shape({13, 17});
+    lrc::Array<float, CPU> a(shape);
+    for (int64_t i = 0; i < shape.size(); ++i) { a.storage()[i] = float(i % 11) - 5.0f; }
+
+    // Every value is a multiple of the scale, so the round trip is exact
+    const lrc::QuantizationParams params {0.5f, 10};
+    lrc::Array<uint8_t, CPU> q = lrc::quantize<uint8_t>(a + 1, params);
+    lrc::Array<float, CPU> d   = lrc::dequantize(q, params);
+
+    for (int64_t i = 0; i < shape.size(); ++i) {
+        REQUIRE(int(q.scalar(i)) == int((a.scalar(i) + 1) * 2) + 10);
+        REQUIRE(d.scalar(i) == a.scalar(i) + 1);
+    }
+}
+
+TEST_CASE("Test Quantized Matrix", "[quantize]") {
+    const int64_t rows = 7, cols = 45;
+    lrc::Array<float, CPU> matrix(lrc::Array<float, CPU>::ShapeType({rows, cols}));
+    for (int64_t i = 0; i < rows; ++i) {
+        for (int64_t j = 0; j < cols; ++j) {
+            // Each row has a very different magnitude
+            matrix.storage()[i * cols + j] = float((j * 7 + i) % 19 - 9) * float(1 << i);
+        }
+    }
+
+    SECTION("Per Row") {
+        lrc::QuantizedMatrix<int8_t> q(matrix, lrc::QuantizationGranularity::PerRow);
+        REQUIRE(q.granularity() == lrc::QuantizationGranularity::PerRow);
+
+        auto d = q.dequantize();
+        for (int64_t i = 0; i < rows; ++i) {
+            // Each value is rounded to the nearest step
+            const float tolerance = q.params(i).scale * 0.51f;
+            for (int64_t j = 0; j < cols; ++j) {
+                REQUIRE(std::abs(d.scalar(i * cols + j) - matrix.scalar(i * cols + j)) <=
+                        tolerance);
+            }
+        }
+    }
+
+    SECTION("Per Tensor") {
+        lrc::QuantizedMatrix<uint8_t> q(matrix, lrc::QuantizationGranularity::PerTensor);
+        REQUIRE(q.granularity() == lrc::QuantizationGranularity::PerTensor);
+        REQUIRE(q.params(0).scale == q.params(rows - 1).scale);
+
+        // Rounding the zero point may push the largest values one step out of range
+        auto d = q.dequantize();
+        for (int64_t i = 0; i < rows * cols; ++i) {
+            REQUIRE(std::abs(d.scalar(i) - matrix.scalar(i)) <= q.params(0).scale);
+        }
+    }
+}
+
+TEST_CASE("Test Int8 GEMM", "[quantize]") {
+    const int64_t m = 9, n = 23, k = 70;
+    lrc::Array<int8_t, CPU> a(lrc::Array<int8_t, CPU>::ShapeType({m, k}));
+    lrc::Array<int8_t, CPU> b(lrc::Array<int8_t, CPU>::ShapeType({k, n}));
+    for (int64_t i = 0; i < m * k; ++i) { a.storage()[i] = int8_t((i * 37) % 256 - 128); }
+    for (int64_t i = 0; i < k * n; ++i) { b.storage()[i] = int8_t((i * 91) % 255 - 127); }
+
+    auto reference = [&](int64_t i, int64_t j) {
+        int32_t res = 0;
+        for (int64_t p = 0; p < k; ++p) {
+            res += int32_t(a.scalar(i * k + p)) * int32_t(b.scalar(p * n + j));
+        }
+        return res;
+    };
+
+    const lrc::SimdLevel originalLevel = lrc::getSimdLevel();
+    for (int level = 0; level <= (int)lrc::detectSimdLevel(); ++level) {
+        lrc::setSimdLevel((lrc::SimdLevel)level);
+
+        SECTION(fmt::format("GEMM [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {
+            std::vector<int32_t> c(m * n);
+            lrc::linalg::gemm(false,
+                              false,
+                              m,
+                              n,
+                              k,
+                              int32_t(1),
+                              a.storage().begin(),
+                              k,
+                              b.storage().begin(),
+                              n,
+                              int32_t(0),
+                              c.data(),
+                              n);
+
+            for (int64_t i = 0; i < m; ++i) {
+                for (int64_t j = 0; j < n; ++j) { REQUIRE(c[i * n + j] == reference(i, j)); }
+            }
+        }
+
+        SECTION(fmt::format("GEMV [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {
+            // Multiply by the first column of B
+            std::vector<int32_t> y(m, 1);
+            lrc::linalg::gemv(false,
+                              m,
+                              k,
+                              int32_t(2),
+                              a.storage().begin(),
+                              k,
+                              b.storage().begin(),
+                              n,
+                              int32_t(3),
+                              y.data(),
+                              int64_t(1));
+
+            for (int64_t i = 0; i < m; ++i) { REQUIRE(y[i] == 2 * reference(i, 0) + 3); }
+        }
+    }
+    lrc::setSimdLevel(originalLevel);
+
+    // Integral floating-point scale factors are accepted, and fractional ones are rejected
+    // rather than truncated
+    std::vector<int32_t> c(m * n, 1);
+    auto scaledGemm = [&](double alpha, double beta) {
+        lrc::linalg::gemm(false,
+                          false,
+                          m,
+                          n,
+                          k,
+                          alpha,
+                          a.storage().begin(),
+                          k,
+                          b.storage().begin(),
+                          n,
+                          beta,
+                          c.data(),
+                          n);
+    };
+    auto scaledGemv = [&](double alpha, double beta) {
+        lrc::linalg::gemv(false,
+                          m,
+                          k,
+                          alpha,
+                          a.storage().begin(),
+                          k,
+                          b.storage().begin(),
+                          n,
+                          beta,
+                          c.data(),
+                          int64_t(1));
+    };
+
+    scaledGemm(2.0, -1.0);
+    REQUIRE(c[0] == 2 * reference(0, 0) - 1);
+    REQUIRE_THROWS(scaledGemm(0.5, 0.0));
+    REQUIRE_THROWS(scaledGemv(1.0, 0.5));
+}
+
+TEST_CASE("Test Quantized Matmul", "[quantize]") {
+    const int64_t m = 5, n = 11, k = 67;
+    lrc::Array<float, CPU> x(lrc::Array<float, CPU>::ShapeType({m, k}));
+    lrc::Array<float, CPU> w(lrc::Array<float, CPU>::ShapeType({n, k}));
+    for (int64_t i = 0; i < m * k; ++i) { x.storage()[i] = float(i % 13) * 0.25f; }
+    for (int64_t i = 0; i < n * k; ++i) { w.storage()[i] = float(i % 7 - 3) * 0.1f; }
+
+    // Activations are non-negative, so use uint8_t. Weights use int8_t with a scale per row
+    lrc::QuantizedMatrix<uint8_t> qx(x, lrc::QuantizationGranularity::PerTensor);
+    lrc::QuantizedMatrix<int8_t> qw(w, lrc::QuantizationGranularity::PerRow);
+    auto dx = qx.dequantize();
+    auto dw = qw.dequantize();
+
+    // The integer result is exact, so it matches the product of the dequantized matrices
+    auto res = lrc::linalg::quantizedMatmul(qx, qw);
+    REQUIRE(res.shape() == lrc::Array<float, CPU>::ShapeType({m, n}));
+
+    for (int64_t i = 0; i < m; ++i) {
+        for (int64_t j = 0; j < n; ++j) {
+            double expected = 0;
+            for (int64_t p = 0; p < k; ++p) {
+                expected += double(dx.scalar(i * k + p)) * double(dw.scalar(j * k + p));
+            }
+            REQUIRE(lrc::isClose(double(res.scalar(i * n + j)), expected, 1e-3));
+        }
+    }
+
+    // Requantized results
+    const lrc::QuantizationParams outParams {0.05f, 0};
+    auto requantized = lrc::linalg::quantizedMatmul<int8_t>(qx, qw, outParams);
+    for (int64_t i = 0; i < m * n; ++i) {
+        REQUIRE(requantized.scalar(i) ==
+                lrc::detail::quantizeScalar<int8_t>(res.scalar(i), outParams));
+    }
+}
@@ -0,0 +1,149 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+namespace {
+    // Values spanning many orders of magnitude, whose sum depends on the order of addition
+    lrc::Array<double, CPU> reductionValues(int64_t n, int64_t seed) {
+        lrc::Array<double, CPU> values(lrc::Array<double, CPU>::ShapeType({n}));
+        for (int64_t i = 0; i < n; ++i) {
+            const int64_t k     = (i * 7919 + seed) % 100003;
+            values.storage()[i] = std::ldexp(double(k % 2001) - 1000.0, int(k % 41) - 20);
+        }
+        return values;
+    }
+} // namespace
+
+TEST_CASE("Test Sum and Dot", "[reduce]") {
+    auto n = GENERATE(int64_t(0), int64_t(1), int64_t(4097), int64_t(1000003));
+
+    auto x = reductionValues(n, 1);
+    auto y = reductionValues(n, 2);
+
+    long double sum = 0, dot = 0;
+    for (int64_t i = 0; i < n; ++i) {
+        sum += x.scalar(i);
+        dot += (long double)x.scalar(i) * y.scalar(i);
+    }
+
+    const bool reproducible             = lrc::global::reproducibleReductions;
+    lrc::global::reproducibleReductions = GENERATE(false, true);
+    REQUIRE(std::abs(lrc::sum(x) - double(sum)) <= 1e-9 * std::abs(double(sum)) + 1e-9);
+
+    if (n > 0) {
+        lrc::Array<double, CPU> result = lrc::dot(x, y);
+        REQUIRE(std::abs(result.scalar(0) - double(dot)) <= 1e-9 * std::abs(double(dot)) + 1e-9);
+    }
+    lrc::global::reproducibleReductions = reproducible;
+}
+
+TEST_CASE("Test Reproducible Reductions", "[reduce]") {
+    const int64_t n                     = 1000003;
+    const size_t numThreads             = lrc::global::numThreads;
+    const bool reproducible             = lrc::global::reproducibleReductions;
+    lrc::global::reproducibleReductions = true;
+
+    auto x = reductionValues(n, 3);
+    auto y = reductionValues(n, 4);
+
+    double expectedSum = 0, expectedDot = 0, expectedVariance = 0;
+    lrc::Array<double, CPU> expectedScan;
+    for (size_t threads : {1, 2, 3, 8}) {
+        lrc::global::numThreads = threads;
+
+        const double sum             = lrc::sum(x);
+        lrc::Array<double, CPU> dot  = lrc::dot(x, y);
+        lrc::Array<double, CPU> scan = lrc::cumsum(x);
+        const double variance        = lrc::RunningStats<double>().update(x).variance();
+
+        if (threads == 1) {
+            expectedSum      = sum;
+            expectedDot      = dot.scalar(0);
+            expectedVariance = variance;
+            expectedScan     = scan;
+        } else {
+            REQUIRE(sum == expectedSum);
+            REQUIRE(dot.scalar(0) == expectedDot);
+            REQUIRE(variance == expectedVariance);
+            for (int64_t i = 0; i < n; i += 997) {
+                REQUIRE(scan.scalar(i) == expectedScan.scalar(i));
+            }
+            REQUIRE(scan.scalar(n - 1) == expectedScan.scalar(n - 1));
+        }
+    }
+
+    lrc::global::numThreads             = numThreads;
+    lrc::global::reproducibleReductions = reproducible;
+}
+
+TEST_CASE("Test Reproducible Group and Histogram Reductions", "[reduce]") {
+    const int64_t n                     = 1000003;
+    const size_t numThreads             = lrc::global::numThreads;
+    const bool reproducible             = lrc::global::reproducibleReductions;
+    lrc::global::reproducibleReductions = true;
+
+    // Unsorted keys, so groupReduce uses its hash tables, and a few bins with many values each
+    auto weights = reductionValues(n, 7);
+    std::vector<int64_t> keys(n);
+    std::vector<double> values(n);
+    for (int64_t i = 0; i < n; ++i) {
+        keys[i]   = (i * 7919) % 101;
+        values[i] = double(keys[i]) + 0.5;
+    }
+    const std::vector<double> edges {0, 25, 50, 75, 101};
+
+    lrc::Array<double, CPU> expectedGroups, expectedHistogram, expectedBincount;
+    for (size_t threads : {1, 2, 3, 8}) {
+        lrc::global::numThreads = threads;
+
+        auto groups    = lrc::groupReduce(keys, weights, lrc::GroupOp::Sum).values;
+        auto histogram = lrc::histogram(values, edges, weights).counts;
+        auto bincount  = lrc::bincount(keys, weights);
+
+        if (threads == 1) {
+            expectedGroups    = groups;
+            expectedHistogram = histogram;
+            expectedBincount  = bincount;
+        } else {
+            REQUIRE(groups.size() == expectedGroups.size());
+            for (int64_t i = 0; i < int64_t(groups.size()); ++i) {
+                REQUIRE(groups.scalar(i) == expectedGroups.scalar(i));
+                REQUIRE(bincount.scalar(i) == expectedBincount.scalar(i));
+            }
+            for (int64_t i = 0; i < int64_t(histogram.size()); ++i) {
+                REQUIRE(histogram.scalar(i) == expectedHistogram.scalar(i));
+            }
+        }
+    }
+
+    lrc::global::numThreads             = numThreads;
+    lrc::global::reproducibleReductions = reproducible;
+}
+
+TEST_CASE("Benchmark Reproducible Reductions", "[reduce]") {
+    const int64_t n = 10000000;
+    auto x          = reductionValues(n, 5);
+    auto y          = reductionValues(n, 6);
+
+    const bool reproducible = lrc::global::reproducibleReductions;
+    for (bool mode : {false, true}) {
+        lrc::global::reproducibleReductions = mode;
+        const std::string name              = mode ? " (reproducible)" : " (fast)";
+
+        BENCHMARK("Sum 10M" + name) { return lrc::sum(x); };
+
+        BENCHMARK("Dot 10M" + name) {
+            lrc::Array<double, CPU> result = lrc::dot(x, y);
+            return result.scalar(0);
+        };
+
+        BENCHMARK("RunningStats 10M" + name) {
+            return lrc::RunningStats<double>().update(x).variance();
+        };
+    }
+    lrc::global::reproducibleReductions = reproducible;
+}
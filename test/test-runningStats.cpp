@@ -0,0 +1,114 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+namespace {
+    struct Moments {
+        double mean, variance, skewness, kurtosis, min, max;
+    };
+
+    Moments referenceMoments(const std::vector<double> &values) {
+        const double n = double(values.size());
+        double mean = 0, min = values[0], max = values[0];
+        for (double x : values) {
+            mean += x;
+            min = std::min(min, x);
+            max = std::max(max, x);
+        }
+        mean /= n;
+
+        double m2 = 0, m3 = 0, m4 = 0;
+        for (double x : values) {
+            const double d = x - mean;
+            m2 += d * d;
+            m3 += d * d * d;
+            m4 += d * d * d * d;
+        }
+        return {mean, m2 / n, std::sqrt(n) * m3 / std::pow(m2, 1.5), n * m4 / (m2 * m2) - 3,
+                min, max};
+    }
+
+    bool close(double a, double b) { return std::abs(a - b) <= 1e-9 * (1 + std::abs(b)); }
+} // namespace
+
+TEST_CASE("Test RunningStats", "[runningStats]") {
+    auto n = GENERATE(int64_t(1), int64_t(37), int64_t(1025), int64_t(100003));
+
+    // Offset values, which make a naive sum-of-squares variance lose precision
+    std::vector<double> values(n);
+    for (int64_t i = 0; i < n; ++i) {
+        values[i] = 1e6 + std::exp(double((i * 7919) % 1201) / 300.0);
+    }
+
+    lrc::Array<double, CPU> array(lrc::Array<double, CPU>::ShapeType({n}));
+    for (int64_t i = 0; i < n; ++i) { array.storage()[i] = values[i]; }
+
+    lrc::RunningStats<double> whole, first, second;
+    whole.update(array);
+    for (int64_t i = 0; i < n / 3; ++i) { first.update(values[i]); }
+    second.update(values.data() + n / 3, n - n / 3);
+    first.merge(second);
+
+    const Moments expected = referenceMoments(values);
+    for (const auto *stats : {&whole, &first}) {
+        REQUIRE(stats->count() == n);
+        REQUIRE(close(stats->mean(), expected.mean));
+        REQUIRE(close(stats->variance(), expected.variance));
+        REQUIRE(stats->min() == expected.min);
+        REQUIRE(stats->max() == expected.max);
+        if (n > 2) {
+            REQUIRE(close(stats->skewness(), expected.skewness));
+            REQUIRE(close(stats->kurtosis(), expected.kurtosis));
+        }
+    }
+
+    lrc::RunningStats<double> empty;
+    REQUIRE(std::isnan(empty.mean()));
+    REQUIRE(std::isnan(empty.variance()));
+    empty.update(std::vector<int32_t> {1, 2, 3, 4});
+    REQUIRE(empty.mean() == 2.5);
+    REQUIRE(close(empty.variance(1), 5.0 / 3.0));
+}
+
+TEST_CASE("Test RunningColumnStats", "[runningStats]") {
+    auto columns = GENERATE(int64_t(3), int64_t(300));
+    auto blocks  = std::vector<int64_t> {1, 10, 2000, 1};
+
+    lrc::RunningColumnStats<double> stats(lrc::Shape({columns})), other(lrc::Shape({columns}));
+    std::vector<std::vector<double>> values(columns);
+    int64_t seed = 0;
+    for (size_t b = 0; b < blocks.size(); ++b) {
+        const int64_t rows = blocks[b];
+        lrc::Array<float, CPU> block(lrc::Array<float, CPU>::ShapeType({rows, columns}));
+        for (int64_t i = 0; i < rows * columns; ++i) {
+            const float x      = float((seed++ * 7919) % 1009) / 8.0f;
+            block.storage()[i] = x;
+            values[i % columns].push_back(x);
+        }
+        (b % 2 == 0 ? stats : other).update(block);
+    }
+    stats.merge(other);
+    REQUIRE(stats.count() == 2012);
+
+    auto mean     = stats.mean();
+    auto variance = stats.variance();
+    auto skewness = stats.skewness();
+    auto min      = stats.min();
+    auto max      = stats.max();
+    REQUIRE(mean.shape() == lrc::Shape({columns}));
+    for (int64_t k = 0; k < columns; ++k) {
+        const Moments expected = referenceMoments(values[k]);
+        REQUIRE(close(mean.scalar(k), expected.mean));
+        REQUIRE(close(variance.scalar(k), expected.variance));
+        REQUIRE(close(skewness.scalar(k), expected.skewness));
+        REQUIRE(min.scalar(k) == expected.min);
+        REQUIRE(max.scalar(k) == expected.max);
+    }
+
+    lrc::Array<float, CPU> wrong(lrc::Array<float, CPU>::ShapeType({2, columns + 1}));
+    REQUIRE_THROWS(stats.update(wrong));
+}
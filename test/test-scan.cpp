@@ -0,0 +1,88 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+#define TEST_SCAN_IMPL(SCALAR, dims, axis)                                                         \
+    {                                                                                              \
+        lrc::Shape shape(dims);                                                                    \
+        lrc::Array<SCALAR, CPU> a(shape);                                                          \
+        for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+            a.storage()[i] = SCALAR((i * 7919) % 7) - SCALAR(3);                                   \
+        }                                                                                          \
+                                                                                                   \
+        int64_t normAxis = axis;                                                                   \
+        auto layout      = lrc::detail::rowLayout(shape, normAxis);                                \
+        auto sum         = lrc::cumsum(a, axis);                                                   \
+        auto offsets     = lrc::cumsum(a, axis, true);                                             \
+        auto runningMax  = lrc::cummax(a, axis);                                                   \
+        auto runningMin  = lrc::cummin(a, axis, true);                                             \
+        REQUIRE(sum.shape() == a.shape());                                                         \
+                                                                                                   \
+        for (int64_t r = 0; r < layout.numRows; ++r) {                                             \
+            SCALAR total = 0;                                                                      \
+            SCALAR hi    = std::numeric_limits<SCALAR>::lowest();                                  \
+            SCALAR lo    = std::numeric_limits<SCALAR>::max();                                     \
+            if constexpr (std::numeric_limits<SCALAR>::has_infinity) {                             \
+                lo = std::numeric_limits<SCALAR>::infinity();                                      \
+            }                                                                                      \
+            for (int64_t j = 0; j < layout.extent; ++j) {                                          \
+                const int64_t index = layout.base(r) + j * layout.inner;                           \
+                REQUIRE(offsets.scalar(index) == total);                                           \
+                REQUIRE(runningMin.scalar(index) == lo);                                           \
+                total += a.scalar(index);                                                          \
+                hi = std::max(hi, SCALAR(a.scalar(index)));                                        \
+                lo = std::min(lo, SCALAR(a.scalar(index)));                                        \
+                REQUIRE(sum.scalar(index) == total);                                               \
+                REQUIRE(runningMax.scalar(index) == hi);                                           \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+TEST_CASE("Test Scan", "[scan]") {
+    auto dims = GENERATE(std::vector<int64_t> {1},
+                         std::vector<int64_t> {7},
+                         std::vector<int64_t> {100003},
+                         std::vector<int64_t> {3, 1000},
+                         std::vector<int64_t> {1000, 3},
+                         std::vector<int64_t> {5, 9, 300},
+                         std::vector<int64_t> {2, 50000, 2});
+    auto axis = GENERATE(int64_t(-1), int64_t(0));
+
+    // Small integers keep the floating-point sums exact
+    SECTION("int32_t") { TEST_SCAN_IMPL(int32_t, dims, axis); }
+    SECTION("int64_t") { TEST_SCAN_IMPL(int64_t, dims, axis); }
+    SECTION("float") { TEST_SCAN_IMPL(float, dims, axis); }
+    SECTION("double") { TEST_SCAN_IMPL(double, dims, axis); }
+}
+
+TEST_CASE("Test Scan Special Values", "[scan]") {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    lrc::Array<double, CPU> a(lrc::Array<double, CPU>::ShapeType({6}));
+    const double input[] = {2.0, 1.0, 3.0, nan, 5.0, 0.5};
+    for (int64_t i = 0; i < 6; ++i) { a.storage()[i] = input[i]; }
+
+    auto runningMax = lrc::cummax(a);
+    REQUIRE(runningMax.scalar(0) == 2.0);
+    REQUIRE(runningMax.scalar(2) == 3.0);
+    for (int64_t i = 3; i < 6; ++i) { REQUIRE(std::isnan(runningMax.scalar(i))); }
+
+    auto product = lrc::cumprod(a);
+    REQUIRE(product.scalar(2) == 6.0);
+    REQUIRE(std::isnan(product.scalar(5)));
+
+    auto exclusiveProduct = lrc::cumprod(a, -1, true);
+    REQUIRE(exclusiveProduct.scalar(0) == 1.0);
+    REQUIRE(exclusiveProduct.scalar(3) == 6.0);
+
+    // Expressions are evaluated and then scanned
+    lrc::Array<double, CPU> doubled = lrc::cumsum(a * 2.0);
+    REQUIRE(doubled.scalar(0) == 4.0);
+    REQUIRE(doubled.scalar(2) == 12.0);
+
+    REQUIRE_THROWS(lrc::cumsum(a, 1));
+    REQUIRE_THROWS(lrc::cummax(a, -2));
+}
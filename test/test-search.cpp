@@ -0,0 +1,146 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+#define TEST_SEARCH_IMPL(SCALAR, numEdges, uniformEdges)                                           \
+    {                                                                                              \
+        std::vector<SCALAR> edges(numEdges);                                                       \
+        for (int64_t i = 0; i < numEdges; ++i) {                                                   \
+            edges[i] = uniformEdges ? SCALAR(i * 3) : SCALAR((i * 7919) % 301);                    \
+        }                                                                                          \
+        std::sort(edges.begin(), edges.end());                                                     \
+                                                                                                   \
+        const int64_t n = 1009;                                                                    \
+        lrc::Array<SCALAR, CPU> values(lrc::Array<SCALAR, CPU>::ShapeType({n}));                   \
+        for (int64_t i = 0; i < n; ++i) {                                                          \
+            values.storage()[i] = SCALAR((i * 31) % 340) - SCALAR(20);                             \
+        }                                                                                          \
+                                                                                                   \
+        lrc::Array<int64_t, CPU> left  = lrc::searchsorted(edges, values);                         \
+        lrc::Array<int64_t, CPU> right = lrc::searchsorted(edges, values, lrc::SearchSide::Right); \
+        lrc::Array<int64_t, CPU> bins  = lrc::digitize(values, edges);                             \
+                                                                                                   \
+        for (int64_t i = 0; i < n; ++i) {                                                          \
+            const SCALAR value = values.scalar(i);                                                 \
+            auto lower = std::lower_bound(edges.begin(), edges.end(), value) - edges.begin();      \
+            auto upper = std::upper_bound(edges.begin(), edges.end(), value) - edges.begin();      \
+            REQUIRE(left.scalar(i) == lower);                                                      \
+            REQUIRE(right.scalar(i) == upper);                                                     \
+            REQUIRE(bins.scalar(i) == upper);                                                      \
+        }                                                                                          \
+    }
+
+TEST_CASE("Test Search Sorted", "[search]") {
+    auto numEdges     = GENERATE(int64_t(1), int64_t(2), int64_t(17), int64_t(64), int64_t(1000));
+    bool uniformEdges = GENERATE(false, true);
+
+    SECTION("int32_t") { TEST_SEARCH_IMPL(int32_t, numEdges, uniformEdges); }
+    SECTION("int64_t") { TEST_SEARCH_IMPL(int64_t, numEdges, uniformEdges); }
+    SECTION("float") { TEST_SEARCH_IMPL(float, numEdges, uniformEdges); }
+    SECTION("double") { TEST_SEARCH_IMPL(double, numEdges, uniformEdges); }
+}
+
+TEST_CASE("Test Search Special Values", "[search]") {
+    std::vector<double> edges = {-1.0, 0.0, 0.0, 2.5};
+    lrc::Array<double, CPU> values(lrc::Array<double, CPU>::ShapeType({5}));
+    values.storage()[0] = -std::numeric_limits<double>::infinity();
+    values.storage()[1] = 0.0;
+    values.storage()[2] = 2.5;
+    values.storage()[3] = std::numeric_limits<double>::infinity();
+    values.storage()[4] = std::numeric_limits<double>::quiet_NaN();
+
+    lrc::Array<int64_t, CPU> left  = lrc::searchsorted(edges, values);
+    lrc::Array<int64_t, CPU> right = lrc::digitize(values, edges, true);
+    REQUIRE(left.scalar(0) == 0);
+    REQUIRE(left.scalar(1) == 1);
+    REQUIRE(left.scalar(2) == 3);
+    REQUIRE(left.scalar(3) == 4);
+    REQUIRE(left.scalar(4) == 4);
+    for (int64_t i = 0; i < 5; ++i) { REQUIRE(right.scalar(i) == left.scalar(i)); }
+
+    std::vector<double> unsorted = {1.0, 0.0};
+    REQUIRE_THROWS(lrc::searchsorted(unsorted, values));
+}
+
+TEST_CASE("Test Search Mixed Types", "[search]") {
+    // Values are compared with the edges in the common type, so they are never truncated
+    const float inf         = std::numeric_limits<float>::infinity();
+    const float nan         = std::numeric_limits<float>::quiet_NaN();
+    const float input[]     = {10.5f, 9.5f, 10.0f, -0.5f, 1e30f, -1e30f, inf, -inf, nan};
+    const int64_t numValues = 9;
+    lrc::Array<float, CPU> values(lrc::Array<float, CPU>::ShapeType({numValues}));
+    for (int64_t i = 0; i < numValues; ++i) { values.storage()[i] = input[i]; }
+
+    auto uniformEdges = GENERATE(false, true);
+    std::vector<int32_t> edges =
+      uniformEdges ? std::vector<int32_t> {0, 10, 20} : std::vector<int32_t> {0, 1, 10, 21, 50};
+    const int64_t numEdges = static_cast<int64_t>(edges.size());
+
+    lrc::Array<int64_t, CPU> left  = lrc::searchsorted(edges, values);
+    lrc::Array<int64_t, CPU> right = lrc::searchsorted(edges, values, lrc::SearchSide::Right);
+    lrc::Array<int64_t, CPU> bins  = lrc::digitize(values, edges);
+    for (int64_t i = 0; i < numValues; ++i) {
+        const float value = input[i];
+        int64_t lower = 0, upper = 0;
+        if (value != value) {
+            lower = upper = numEdges; // NaNs are placed after every edge
+        } else {
+            for (int32_t edge : edges) {
+                lower += float(edge) < value;
+                upper += float(edge) <= value;
+            }
+        }
+        REQUIRE(left.scalar(i) == lower);
+        REQUIRE(right.scalar(i) == upper);
+        REQUIRE(bins.scalar(i) == upper);
+    }
+
+    // 10.5 lies between the edges 10 and 20, rather than on the edge 10
+    std::vector<int32_t> grid = {0, 10, 20};
+    REQUIRE(lrc::searchsorted(grid, values).eval().scalar(0) == 2);
+    REQUIRE(lrc::digitize(values, grid).eval().scalar(0) == 2);
+
+    // Double values with float points are compared and interpolated in double precision
+    std::vector<float> xp = {0.0f, 1.0f, 3.0f};
+    std::vector<float> fp = {0.0f, 10.0f, 30.0f};
+    lrc::Array<double, CPU> x(lrc::Array<double, CPU>::ShapeType({5}));
+    const double xInput[] = {0.5, 2.0, 1e300, -1e300, std::numeric_limits<double>::quiet_NaN()};
+    for (int64_t i = 0; i < 5; ++i) { x.storage()[i] = xInput[i]; }
+
+    lrc::Array<float, CPU> y = lrc::interp(x, xp, fp, -1.0f, -2.0f);
+    REQUIRE(y.scalar(0) == 5.0f);
+    REQUIRE(y.scalar(1) == 20.0f);
+    REQUIRE(y.scalar(2) == -2.0f);
+    REQUIRE(y.scalar(3) == -1.0f);
+    REQUIRE(y.scalar(4) != y.scalar(4));
+}
+
+TEST_CASE("Test Interp", "[search]") {
+    std::vector<double> xp = {0.0, 1.0, 1.0, 3.0};
+    std::vector<double> fp = {0.0, 10.0, 20.0, 40.0};
+    lrc::Array<double, CPU> x(lrc::Array<double, CPU>::ShapeType({7}));
+    const double input[]    = {-0.5, 0.0, 0.5, 1.0, 2.0, 3.0, 4.0};
+    for (int64_t i = 0; i < 7; ++i) { x.storage()[i] = input[i]; }
+
+    lrc::Array<double, CPU> clamped = lrc::interp(x, xp, fp);
+    const double expected[]         = {0.0, 0.0, 5.0, 20.0, 30.0, 40.0, 40.0};
+    for (int64_t i = 0; i < 7; ++i) { REQUIRE(clamped.scalar(i) == expected[i]); }
+
+    lrc::Array<double, CPU> bounded = lrc::interp(x, xp, fp, -1.0, -2.0);
+    REQUIRE(bounded.scalar(0) == -1.0);
+    REQUIRE(bounded.scalar(6) == -2.0);
+    for (int64_t i = 1; i < 6; ++i) { REQUIRE(bounded.scalar(i) == expected[i]); }
+
+    // The function is lazy, so it can be combined with other operations
+    lrc::Array<double, CPU> scaled = lrc::interp(x * 2.0, xp, fp) + 1.0;
+    REQUIRE(scaled.scalar(1) == 1.0);
+    REQUIRE(scaled.scalar(2) == 21.0);
+    REQUIRE(scaled.scalar(4) == 41.0);
+
+    std::vector<double> shortFp = {0.0};
+    REQUIRE_THROWS(lrc::interp(x, xp, shortFp));
+}
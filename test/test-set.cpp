@@ -75,3 +75,52 @@ TEST_CASE("Integer Sets") {
 	REQUIRE(arrSet.size() == 11);
 	REQUIRE(arrSet == lrc::Set<int>({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}));
 }
+
+TEST_CASE("Bulk Set Operations") {
+	// Large, overlapping sets exercise the vectorised merges and the parallel sort
+	std::vector<int64_t> evens, triples;
+	for (int64_t i = 0; i < 30000; ++i) {
+		evens.push_back((i * 2 * 7919) % 60000);
+		triples.push_back((i * 3 * 7919) % 90000);
+	}
+	lrc::Set<int64_t> a(evens);
+	lrc::Set<int64_t> b(triples);
+	REQUIRE(a.size() == 30000);
+	REQUIRE(b.size() == 30000);
+
+	lrc::Set<int64_t> setUnion = a | b;
+	lrc::Set<int64_t> setIntersection = a & b;
+	lrc::Set<int64_t> setDifference = a - b;
+	lrc::Set<int64_t> setSymmetricDifference = a ^ b;
+
+	// Multiples of 6 below 60000 are in both sets
+	REQUIRE(setIntersection.size() == 10000);
+	REQUIRE(setUnion.size() == 50000);
+	REQUIRE(setDifference.size() == 20000);
+	REQUIRE(setSymmetricDifference.size() == 40000);
+
+	for (int64_t i = -1; i < 90001; ++i) {
+		const bool inA = i >= 0 && i < 60000 && i % 2 == 0;
+		const bool inB = i >= 0 && i < 90000 && i % 3 == 0;
+		REQUIRE(a.contains(i) == inA);
+		REQUIRE(setUnion.contains(i) == (inA || inB));
+		REQUIRE(setIntersection.contains(i) == (inA && inB));
+		REQUIRE(setDifference.contains(i) == (inA && !inB));
+		REQUIRE(setSymmetricDifference.contains(i) == (inA != inB));
+	}
+
+	// Bulk insertion and removal
+	lrc::Set<int64_t> c = a;
+	c.insert(triples);
+	REQUIRE(c == setUnion);
+	c.discard(triples);
+	REQUIRE(c == setDifference);
+
+	// Construction from an array
+	lrc::Array<float, lrc::backend::CPU> arr(lrc::Shape({3, 4}));
+	for (int64_t i = 0; i < 12; ++i) { arr.storage()[i] = float(i % 5) * 0.5f; }
+	lrc::Set<float> floatSet(arr);
+	REQUIRE(floatSet == lrc::Set<float>({0.0f, 0.5f, 1.0f, 1.5f, 2.0f}));
+	REQUIRE(floatSet.contains(1.5f));
+	REQUIRE(!floatSet.contains(1.25f));
+}
@@ -0,0 +1,127 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc    = librapid;
+namespace kernel = lrc::detail::cpu::dispatch;
+
+#define TEST_DISPATCH_IMPL(SCALAR)                                                                 \
+    TEST_CASE(fmt::format("Test SIMD Dispatch -- {}", STRINGIFY(SCALAR)), "[simd]") {             \
+        const lrc::SimdLevel originalLevel = lrc::getSimdLevel();                                  \
+        const int maxLevel                 = (int)lrc::detectSimdLevel();                          \
+                                                                                                   \
+        for (int level = 0; level <= maxLevel; ++level) {                                          \
+            lrc::setSimdLevel((lrc::SimdLevel)level);                                              \
+            REQUIRE((int)lrc::getSimdLevel() == level);                                            \
+                                                                                                   \
+            SECTION(fmt::format("Transpose [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {      \
+                for (int64_t rows : {1, 3, 8, 13, 37}) {                                           \
+                    for (int64_t cols : {1, 4, 9, 16, 41}) {                                       \
+                        std::vector<SCALAR> in(rows * cols), out(rows * cols);                     \
+                        for (int64_t i = 0; i < rows * cols; ++i) in[i] = SCALAR(i % 31) - 7;      \
+                                                                                                   \
+                        kernel::transpose(out.data(), in.data(), rows, cols, SCALAR(2), 0, rows);  \
+                                                                                                   \
+                        for (int64_t r = 0; r < rows; ++r) {                                       \
+                            for (int64_t c = 0; c < cols; ++c) {                                   \
+                                REQUIRE(out[c * rows + r] == in[r * cols + c] * SCALAR(2));        \
+                            }                                                                      \
+                        }                                                                          \
+                    }                                                                              \
+                }                                                                                  \
+            }                                                                                      \
+                                                                                                   \
+            SECTION(fmt::format("Reductions [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {     \
+                for (int64_t n : {0, 1, 7, 16, 33, 1000}) {                                        \
+                    std::vector<SCALAR> x(n), y(n), z(n);                                          \
+                    SCALAR expectedSum = 0, expectedDot = 0;                                       \
+                    for (int64_t i = 0; i < n; ++i) {                                              \
+                        x[i] = SCALAR(i % 7) * SCALAR(0.5);                                        \
+                        y[i] = SCALAR(i % 5);                                                      \
+                        z[i] = y[i];                                                               \
+                        expectedSum += x[i];                                                       \
+                        expectedDot += x[i] * y[i];                                                \
+                    }                                                                              \
+                                                                                                   \
+                    REQUIRE(lrc::isClose(kernel::sum(n, x.data()), expectedSum, 1e-4));            \
+                    REQUIRE(lrc::isClose(kernel::dot(n, x.data(), y.data()), expectedDot, 1e-4));  \
+                                                                                                   \
+                    kernel::axpy(n, SCALAR(3), x.data(), z.data());                                \
+                    for (int64_t i = 0; i < n; ++i) { REQUIRE(z[i] == y[i] + SCALAR(3) * x[i]); }  \
+                }                                                                                  \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        lrc::setSimdLevel(originalLevel);                                                          \
+    }
+
+TEST_DISPATCH_IMPL(float)
+TEST_DISPATCH_IMPL(double)
+
+TEST_CASE("Test SIMD Dispatch -- bfloat16", "[simd]") {
+    const lrc::SimdLevel originalLevel = lrc::getSimdLevel();
+    const int maxLevel                 = (int)lrc::detectSimdLevel();
+
+    for (int level = 0; level <= maxLevel; ++level) {
+        lrc::setSimdLevel((lrc::SimdLevel)level);
+
+        SECTION(fmt::format("Mixed Precision [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {
+            for (int64_t n : {0, 1, 7, 16, 33, 1000}) {
+                std::vector<lrc::bfloat16> x(n), y(n);
+                std::vector<float> z(n);
+                float expectedDot = 0;
+                for (int64_t i = 0; i < n; ++i) {
+                    x[i] = lrc::bfloat16(float(i % 7) * 0.5f);
+                    y[i] = lrc::bfloat16(float(i % 5));
+                    z[i] = float(i % 3);
+                    expectedDot += float(x[i]) * float(y[i]);
+                }
+
+                REQUIRE(kernel::dot(n, x.data(), y.data()) == expectedDot);
+
+                kernel::axpy(n, 3.0f, x.data(), z.data());
+                for (int64_t i = 0; i < n; ++i) {
+                    REQUIRE(z[i] == float(i % 3) + 3.0f * float(x[i]));
+                }
+            }
+        }
+    }
+
+    lrc::setSimdLevel(originalLevel);
+}
+
+TEST_CASE("Test SIMD Dispatch -- popcount", "[simd]") {
+    const lrc::SimdLevel originalLevel = lrc::getSimdLevel();
+    const int maxLevel                 = (int)lrc::detectSimdLevel();
+
+    for (int level = 0; level <= maxLevel; ++level) {
+        lrc::setSimdLevel((lrc::SimdLevel)level);
+
+        SECTION(fmt::format("Popcount [{}]", lrc::simdLevelName(lrc::getSimdLevel()))) {
+            // Long enough to fill the byte counters of the vector kernels several times
+            for (int64_t n : {0, 1, 7, 16, 33, 1000, 5003}) {
+                std::vector<uint64_t> x(n);
+                uint64_t expected = 0;
+                for (int64_t i = 0; i < n; ++i) {
+                    x[i] = i % 3 == 0 ? ~uint64_t(0) : uint64_t(i) * 0x9E3779B97F4A7C15ULL;
+                    expected += std::popcount(x[i]);
+                }
+
+                REQUIRE(kernel::popcount(n, x.data()) == expected);
+            }
+        }
+    }
+
+    lrc::setSimdLevel(originalLevel);
+}
+
+TEST_CASE("Test SIMD Level Clamping", "[simd]") {
+    const lrc::SimdLevel originalLevel = lrc::getSimdLevel();
+
+    // Requesting an unsupported level must never select kernels the processor cannot run
+    lrc::setSimdLevel(lrc::SimdLevel::AVX512);
+    REQUIRE((int)lrc::getSimdLevel() <= (int)lrc::detectSimdLevel());
+
+    lrc::setSimdLevel(originalLevel);
+}
@@ -0,0 +1,157 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+// Values equal to each other, treating NaNs as equal
+template<typename T>
+bool sameValue(T a, T b) {
+    return a == b || (a != a && b != b);
+}
+
+#define TEST_SORT_IMPL(SCALAR, dims, axis)                                                         \
+    {                                                                                              \
+        lrc::Shape shape(dims);                                                                    \
+        lrc::Array<SCALAR, CPU> a(shape);                                                          \
+        for (int64_t i = 0; i < shape.size(); ++i) {                                               \
+            a.storage()[i] = SCALAR((i * 7919) % 201) - SCALAR(100);                               \
+            if constexpr (std::is_floating_point_v<SCALAR>) {                                      \
+                if (i % 97 == 0) a.storage()[i] = std::numeric_limits<SCALAR>::quiet_NaN();        \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        int64_t normAxis = axis;                                                                   \
+        auto layout      = lrc::detail::rowLayout(shape, normAxis);                                \
+        auto sorted      = lrc::sort(a, axis);                                                     \
+        auto stable      = lrc::stableSort(a, axis);                                               \
+        auto indices     = lrc::stableArgsort(a, axis);                                            \
+        auto unstable    = lrc::argsort(a, axis);                                                  \
+        auto kth         = layout.extent / 3;                                                      \
+        auto partitioned = lrc::partition(a, kth, axis);                                           \
+        auto nth         = lrc::nthElement(a, kth, axis);                                          \
+                                                                                                   \
+        for (int64_t r = 0; r < layout.numRows; ++r) {                                             \
+            auto at = [&](int64_t j) { return layout.base(r) + j * layout.inner; };                \
+            std::vector<SCALAR> row;                                                               \
+            for (int64_t j = 0; j < layout.extent; ++j) { row.push_back(a.scalar(at(j))); }        \
+                                                                                                   \
+            std::vector<int64_t> order(layout.extent);                                             \
+            std::iota(order.begin(), order.end(), int64_t(0));                                     \
+            std::stable_sort(order.begin(), order.end(), [&](int64_t x, int64_t y) {               \
+                return lrc::detail::SortLess()(row[x], row[y]);                                    \
+            });                                                                                    \
+                                                                                                   \
+            for (int64_t j = 0; j < layout.extent; ++j) {                                          \
+                const SCALAR expected = row[order[j]];                                             \
+                REQUIRE(sameValue(sorted.scalar(at(j)), expected));                                \
+                REQUIRE(sameValue(stable.scalar(at(j)), expected));                                \
+                REQUIRE(indices.scalar(at(j)) == order[j]);                                        \
+                REQUIRE(sameValue(row[unstable.scalar(at(j))], expected));                         \
+            }                                                                                      \
+                                                                                                   \
+            REQUIRE(sameValue(partitioned.scalar(at(kth)), row[order[kth]]));                      \
+            REQUIRE(sameValue(nth.scalar(r), row[order[kth]]));                                    \
+            for (int64_t j = 0; j < kth; ++j) {                                                    \
+                REQUIRE(!lrc::detail::SortLess()(row[order[kth]], partitioned.scalar(at(j))));     \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+#define TEST_SORT(SCALAR)                                                                          \
+    SECTION(fmt::format("Test Sort [{}]", STRINGIFY(SCALAR))) {                                    \
+        /* Short rows (sorting networks), long rows (radix sorts) and a strided axis */            \
+        for (const auto &dims : std::vector<std::vector<int64_t>> {                                \
+               {5000}, {37, 11}, {3, 700}, {300, 4}}) {                                            \
+            for (int64_t axis : {int64_t(0), int64_t(-1)}) {                                       \
+                TEST_SORT_IMPL(SCALAR, dims, axis)                                                 \
+            }                                                                                      \
+        }                                                                                          \
+    }
+
+TEST_CASE("Test Sort", "[sort]") {
+    TEST_SORT(int8_t);
+    TEST_SORT(uint16_t);
+    TEST_SORT(int32_t);
+    TEST_SORT(int64_t);
+    TEST_SORT(float);
+    TEST_SORT(double);
+}
+
+TEST_CASE("Test Top K", "[sort]") {
+    const int64_t users = 1000, items = 50, k = 5;
+    lrc::Array<float, CPU> scores(lrc::Shape({users, items}));
+    for (int64_t i = 0; i < users * items; ++i) { scores.storage()[i] = float((i * 37) % 23); }
+
+    for (bool largest : {true, false}) {
+        auto [values, indices] = lrc::topK(scores, k, -1, largest);
+        REQUIRE(values.shape() == lrc::Shape({users, k}));
+        REQUIRE(indices.shape() == lrc::Shape({users, k}));
+
+        for (int64_t u = 0; u < users; ++u) {
+            // Order by score, then by position
+            std::vector<int64_t> order(items);
+            std::iota(order.begin(), order.end(), int64_t(0));
+            std::stable_sort(order.begin(), order.end(), [&](int64_t x, int64_t y) {
+                const float sx = scores.scalar(u * items + x), sy = scores.scalar(u * items + y);
+                return largest ? sx > sy : sx < sy;
+            });
+
+            for (int64_t j = 0; j < k; ++j) {
+                REQUIRE(indices.scalar(u * k + j) == order[j]);
+                REQUIRE(values.scalar(u * k + j) == scores.scalar(u * items + order[j]));
+            }
+        }
+    }
+
+    // Along the first axis
+    auto [values, indices] = lrc::topK(scores, 2, 0);
+    REQUIRE(values.shape() == lrc::Shape({2, items}));
+    for (int64_t j = 0; j < items; ++j) {
+        REQUIRE(values.scalar(j) == scores.scalar(indices.scalar(j) * items + j));
+        REQUIRE(values.scalar(j) >= values.scalar(items + j));
+    }
+
+    REQUIRE_THROWS(lrc::topK(scores, items + 1));
+    REQUIRE_THROWS(lrc::partition(scores, items));
+    REQUIRE_THROWS(lrc::sort(scores, 2));
+}
+
+TEST_CASE("Test Sort Signed Zeros", "[sort]") {
+    // Short rows, sorted with a sorting network, holding both signed zeros
+    const int64_t rows = 64, extent = 6;
+    lrc::Array<float, CPU> a(lrc::Shape({rows, extent}));
+    for (int64_t r = 0; r < rows; ++r) {
+        for (int64_t j = 0; j < extent; ++j) {
+            const int64_t k             = (r * 5 + j * 3) % 7;
+            a.storage()[r * extent + j] = k < 2 ? 0.0f : (k < 4 ? -0.0f : float(k) - 5.0f);
+        }
+    }
+
+    auto sorted = lrc::sort(a, -1);
+    auto stable = lrc::stableSort(a, -1);
+    for (int64_t r = 0; r < rows; ++r) {
+        // The zeros of the row, in their original order
+        std::vector<bool> zeroSigns;
+        for (int64_t j = 0; j < extent; ++j) {
+            const float value = a.scalar(r * extent + j);
+            if (value == 0) zeroSigns.push_back(std::signbit(value));
+        }
+
+        std::vector<bool> sortedSigns, stableSigns;
+        for (int64_t j = 0; j < extent; ++j) {
+            const float x = sorted.scalar(r * extent + j), y = stable.scalar(r * extent + j);
+            if (j > 0) REQUIRE(sorted.scalar(r * extent + j - 1) <= x);
+            if (x == 0) sortedSigns.push_back(std::signbit(x));
+            if (y == 0) stableSigns.push_back(std::signbit(y));
+        }
+
+        // Sorting permutes the zeros, and a stable sort keeps them in order
+        REQUIRE(std::count(sortedSigns.begin(), sortedSigns.end(), true) ==
+                std::count(zeroSigns.begin(), zeroSigns.end(), true));
+        REQUIRE(sortedSigns.size() == zeroSigns.size());
+        REQUIRE(stableSigns == zeroSigns);
+    }
+}
@@ -0,0 +1,97 @@
+#include <librapid>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+namespace lrc = librapid;
+using CPU     = lrc::backend::CPU;
+
+#define TEST_UNIQUE_IMPL(SCALAR, range)                                                            \
+    {                                                                                              \
+        const int64_t n = 10007;                                                                   \
+        lrc::Array<SCALAR, CPU> a(lrc::Array<SCALAR, CPU>::ShapeType({n}));                        \
+        for (int64_t i = 0; i < n; ++i) {                                                          \
+            a.storage()[i] = SCALAR((i * 7919) % (range)) - SCALAR((range) / 2);                   \
+        }                                                                                          \
+                                                                                                   \
+        std::map<SCALAR, int64_t> reference;                                                       \
+        for (int64_t i = 0; i < n; ++i) { ++reference[a.scalar(i)]; }                              \
+                                                                                                   \
+        auto result = lrc::unique(a, true, true);                                                  \
+        REQUIRE(result.values.size() == reference.size());                                         \
+        REQUIRE(result.counts.size() == reference.size());                                         \
+        REQUIRE(result.inverse.shape() == a.shape());                                              \
+                                                                                                   \
+        int64_t k = 0;                                                                             \
+        for (const auto &[value, count] : reference) {                                             \
+            REQUIRE(result.values.scalar(k) == value);                                             \
+            REQUIRE(result.counts.scalar(k) == count);                                             \
+            ++k;                                                                                   \
+        }                                                                                          \
+        for (int64_t i = 0; i < n; ++i) {                                                          \
+            REQUIRE(result.values.scalar(result.inverse.scalar(i)) == a.scalar(i));                \
+        }                                                                                          \
+                                                                                                   \
+        auto counts = lrc::valueCounts(a);                                                         \
+        REQUIRE(counts.values.size() == reference.size());                                         \
+        for (int64_t j = 0; j < static_cast<int64_t>(counts.values.size()); ++j) {                 \
+            REQUIRE(counts.counts.scalar(j) == reference[counts.values.scalar(j)]);                \
+            if (j > 0) {                                                                           \
+                REQUIRE(counts.counts.scalar(j) <= counts.counts.scalar(j - 1));                   \
+            }                                                                                      \
+        }                                                                                          \
+                                                                                                   \
+        std::vector<SCALAR> test = {SCALAR(0), SCALAR(1), SCALAR(-3), SCALAR(range)};              \
+        auto found               = lrc::isin(a, test);                                             \
+        REQUIRE(found.shape() == a.shape());                                                       \
+        for (int64_t i = 0; i < n; ++i) {                                                          \
+            bool expected = std::find(test.begin(), test.end(), a.scalar(i)) != test.end();        \
+            REQUIRE(found.get(i) == expected);                                                     \
+        }                                                                                          \
+    }
+
+TEST_CASE("Test Unique", "[unique]") {
+    // Small ranges are counted in a table, and large ranges are hashed
+    auto range = GENERATE(int64_t(1), int64_t(17), int64_t(5000), int64_t(1) << 40);
+
+    SECTION("int64_t") { TEST_UNIQUE_IMPL(int64_t, range); }
+    SECTION("double") { TEST_UNIQUE_IMPL(double, range); }
+    if (range < (int64_t(1) << 31)) {
+        SECTION("int32_t") { TEST_UNIQUE_IMPL(int32_t, int32_t(range)); }
+        SECTION("float") { TEST_UNIQUE_IMPL(float, range); }
+    }
+}
+
+TEST_CASE("Test Unique Special Values", "[unique]") {
+    const double nan          = std::numeric_limits<double>::quiet_NaN();
+    std::vector<double> input = {nan, 2.0, -0.0, nan, 0.0, -1.0, 2.0};
+
+    auto result = lrc::unique(input, true, true);
+    REQUIRE(result.values.size() == 4);
+    REQUIRE(result.values.scalar(0) == -1.0);
+    REQUIRE(result.values.scalar(1) == 0.0);
+    REQUIRE(result.values.scalar(2) == 2.0);
+    REQUIRE(std::isnan(result.values.scalar(3)));
+    REQUIRE(result.counts.scalar(1) == 2);
+    REQUIRE(result.counts.scalar(3) == 2);
+    REQUIRE(result.inverse.scalar(0) == 3);
+    REQUIRE(result.inverse.scalar(4) == 1);
+
+    // Counts are only returned when requested
+    REQUIRE(lrc::unique(input).counts.size() == 0);
+    REQUIRE(lrc::unique(input).inverse.size() == 0);
+
+    // isin() never matches NaN
+    auto found = lrc::isin(input, std::vector<double> {nan, 0.0});
+    REQUIRE(!found.get(0));
+    REQUIRE(found.get(2));
+    REQUIRE(found.get(4));
+
+    std::vector<int64_t> extremes = {std::numeric_limits<int64_t>::min(),
+                                     std::numeric_limits<int64_t>::max(),
+                                     0,
+                                     std::numeric_limits<int64_t>::min()};
+    auto extremeResult            = lrc::unique(extremes, true);
+    REQUIRE(extremeResult.values.size() == 3);
+    REQUIRE(extremeResult.counts.scalar(0) == 2);
+}